@@ -281,4 +281,32 @@ volatile CustomizeTable C = {
 
 };
 
-}
\ No newline at end of file
+CustomizeView CV;
+
+const CustomizeView& ResolveCustomizeTable() {
+    CV.table = const_cast<const CustomizeTable &>(C);
+    const CustomizeTable& t = CV.table;
+
+    auto resolve = [](const pcv::cvb_entry_t* table) {
+        return DvfsTableView { table, pcv::GetDvfsTableEntryCount(table) };
+    };
+
+    CV.eristaCpu = resolve(t.eristaCpuDvfsTable);
+    CV.eristaGpu = resolve(t.eristaGpuDvfsTable);
+    CV.marikoCpu = resolve(t.marikoCpuUV ? t.marikoCpuDvfsTableSLT : t.marikoCpuDvfsTable);
+    switch (t.marikoGpuUV) {
+        case 1:
+            CV.marikoGpu = resolve(t.marikoGpuDvfsTableSLT);
+            break;
+        case 2:
+            CV.marikoGpu = resolve(t.marikoGpuDvfsTableHiOPT);
+            break;
+        default:
+            CV.marikoGpu = resolve(t.marikoGpuDvfsTable);
+            break;
+    }
+
+    return CV;
+}
+
+}
@@ -83,6 +83,32 @@ typedef struct CustomizeTable {
 
 extern volatile CustomizeTable C;
 
+/* Resolved customize view: a non-volatile snapshot of C with the active DVFS
+ * tables (CPU UV / GPU UV modes) chosen and measured once, so that patchers
+ * do not walk volatile memory for every entry count or max frequency.
+ * Refreshed by ResolveCustomizeTable() at the start of each patch run.
+ */
+struct DvfsTableView {
+    const pcv::cvb_entry_t* entries = nullptr;
+    size_t count = 0;
+
+    const pcv::cvb_entry_t* Last() const { return count ? entries + count - 1 : nullptr; }
+    u32 MaxFreq() const { return count ? static_cast<u32>(entries[count - 1].freq) : 0; }
+};
+
+struct CustomizeView {
+    CustomizeTable table;
+
+    DvfsTableView eristaCpu;
+    DvfsTableView eristaGpu;
+    DvfsTableView marikoCpu; // marikoCpuDvfsTableSLT if marikoCpuUV
+    DvfsTableView marikoGpu; // Selected by marikoGpuUV, marikoGpuDvfsTable otherwise
+};
+
+extern CustomizeView CV;
+
+const CustomizeView& ResolveCustomizeTable();
+
 //extern volatile EristaMtcTable EristaMtcTablePlaceholder;
 //extern volatile MarikoMtcTable MarikoMtcTablePlaceholder;
 
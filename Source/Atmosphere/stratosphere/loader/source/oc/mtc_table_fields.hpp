@@ -0,0 +1,1228 @@
+/*
+ * Copyright (C) Switch-OC-Suite
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms and conditions of the GNU General Public License,
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "oc_common.hpp"
+
+/* Field schema of mtc_timing_table.hpp, used by oc_test to decode MTC tables.
+ *
+ * Every member is listed in declaration order, anonymous register groups are
+ * flattened to "group.member" and arrays to "member[i]". The static_asserts at
+ * the bottom fail if a field is added to or removed from the struct layouts.
+ */
+namespace ams::ldr::oc::mtc {
+
+struct Field {
+    const char*  name;
+    u32          offset;
+    u32          size;
+    const Field* sub;       // Timing register block, sub offsets are relative to this field
+    u32          sub_count;
+
+    constexpr bool IsString() const { return !sub && size != sizeof(u32); }
+};
+
+#define MTC_FIELD(T, F)             { #F, offsetof(T, F), sizeof(((T *)nullptr)->F), nullptr, 0 }
+#define MTC_BLOCK(T, F, FIELDS)     { #F, offsetof(T, F), sizeof(((T *)nullptr)->F), FIELDS, std::size(FIELDS) }
+
+constexpr Field MarikoTimingFields[] = {
+    MTC_FIELD(MarikoTiming, emc_rc),
+    MTC_FIELD(MarikoTiming, emc_rfc),
+    MTC_FIELD(MarikoTiming, emc_rfcpb),
+    MTC_FIELD(MarikoTiming, emc_refctrl2),
+    MTC_FIELD(MarikoTiming, emc_rfc_slr),
+    MTC_FIELD(MarikoTiming, emc_ras),
+    MTC_FIELD(MarikoTiming, emc_rp),
+    MTC_FIELD(MarikoTiming, emc_r2w),
+    MTC_FIELD(MarikoTiming, emc_w2r),
+    MTC_FIELD(MarikoTiming, emc_r2p),
+    MTC_FIELD(MarikoTiming, emc_w2p),
+    MTC_FIELD(MarikoTiming, emc_r2r),
+    MTC_FIELD(MarikoTiming, emc_tppd),
+    MTC_FIELD(MarikoTiming, emc_trtm),
+    MTC_FIELD(MarikoTiming, emc_twtm),
+    MTC_FIELD(MarikoTiming, emc_tratm),
+    MTC_FIELD(MarikoTiming, emc_twatm),
+    MTC_FIELD(MarikoTiming, emc_tr2ref),
+    MTC_FIELD(MarikoTiming, emc_ccdmw),
+    MTC_FIELD(MarikoTiming, emc_rd_rcd),
+    MTC_FIELD(MarikoTiming, emc_wr_rcd),
+    MTC_FIELD(MarikoTiming, emc_rrd),
+    MTC_FIELD(MarikoTiming, emc_rext),
+    MTC_FIELD(MarikoTiming, emc_wext),
+    MTC_FIELD(MarikoTiming, emc_wdv_chk),
+    MTC_FIELD(MarikoTiming, emc_wdv),
+    MTC_FIELD(MarikoTiming, emc_wsv),
+    MTC_FIELD(MarikoTiming, emc_wev),
+    MTC_FIELD(MarikoTiming, emc_wdv_mask),
+    MTC_FIELD(MarikoTiming, emc_ws_duration),
+    MTC_FIELD(MarikoTiming, emc_we_duration),
+    MTC_FIELD(MarikoTiming, emc_quse),
+    MTC_FIELD(MarikoTiming, emc_quse_width),
+    MTC_FIELD(MarikoTiming, emc_ibdly),
+    MTC_FIELD(MarikoTiming, emc_obdly),
+    MTC_FIELD(MarikoTiming, emc_einput),
+    MTC_FIELD(MarikoTiming, emc_mrw6),
+    MTC_FIELD(MarikoTiming, emc_einput_duration),
+    MTC_FIELD(MarikoTiming, emc_puterm_extra),
+    MTC_FIELD(MarikoTiming, emc_puterm_width),
+    MTC_FIELD(MarikoTiming, emc_qrst),
+    MTC_FIELD(MarikoTiming, emc_qsafe),
+    MTC_FIELD(MarikoTiming, emc_rdv),
+    MTC_FIELD(MarikoTiming, emc_rdv_mask),
+    MTC_FIELD(MarikoTiming, emc_rdv_early),
+    MTC_FIELD(MarikoTiming, emc_rdv_early_mask),
+    MTC_FIELD(MarikoTiming, emc_refresh),
+    MTC_FIELD(MarikoTiming, emc_burst_refresh_num),
+    MTC_FIELD(MarikoTiming, emc_pre_refresh_req_cnt),
+    MTC_FIELD(MarikoTiming, emc_pdex2wr),
+    MTC_FIELD(MarikoTiming, emc_pdex2rd),
+    MTC_FIELD(MarikoTiming, emc_pchg2pden),
+    MTC_FIELD(MarikoTiming, emc_act2pden),
+    MTC_FIELD(MarikoTiming, emc_ar2pden),
+    MTC_FIELD(MarikoTiming, emc_rw2pden),
+    MTC_FIELD(MarikoTiming, emc_cke2pden),
+    MTC_FIELD(MarikoTiming, emc_pdex2cke),
+    MTC_FIELD(MarikoTiming, emc_pdex2mrr),
+    MTC_FIELD(MarikoTiming, emc_txsr),
+    MTC_FIELD(MarikoTiming, emc_txsrdll),
+    MTC_FIELD(MarikoTiming, emc_tcke),
+    MTC_FIELD(MarikoTiming, emc_tckesr),
+    MTC_FIELD(MarikoTiming, emc_tpd),
+    MTC_FIELD(MarikoTiming, emc_tfaw),
+    MTC_FIELD(MarikoTiming, emc_trpab),
+    MTC_FIELD(MarikoTiming, emc_tclkstable),
+    MTC_FIELD(MarikoTiming, emc_tclkstop),
+    MTC_FIELD(MarikoTiming, emc_mrw7),
+    MTC_FIELD(MarikoTiming, emc_trefbw),
+    MTC_FIELD(MarikoTiming, emc_odt_write),
+    MTC_FIELD(MarikoTiming, emc_fbio_cfg5),
+    MTC_FIELD(MarikoTiming, emc_fbio_cfg7),
+    MTC_FIELD(MarikoTiming, emc_cfg_dig_dll),
+    MTC_FIELD(MarikoTiming, emc_cfg_dig_dll_period),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ib_rxrt),
+    MTC_FIELD(MarikoTiming, emc_cfg_pipe_1),
+    MTC_FIELD(MarikoTiming, emc_cfg_pipe_2),
+    MTC_FIELD(MarikoTiming, emc_pmacro_quse_ddll_rank0_4),
+    MTC_FIELD(MarikoTiming, emc_pmacro_quse_ddll_rank0_5),
+    MTC_FIELD(MarikoTiming, emc_pmacro_quse_ddll_rank1_4),
+    MTC_FIELD(MarikoTiming, emc_pmacro_quse_ddll_rank1_5),
+    MTC_FIELD(MarikoTiming, emc_mrw8),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_long_dq_rank1_4),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_long_dq_rank1_5),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_long_dqs_rank0_0),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_long_dqs_rank0_1),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_long_dqs_rank0_2),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_long_dqs_rank0_3),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_long_dqs_rank0_4),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_long_dqs_rank0_5),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_long_dqs_rank1_0),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_long_dqs_rank1_1),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_long_dqs_rank1_2),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_long_dqs_rank1_3),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_long_dqs_rank1_4),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_long_dqs_rank1_5),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ddll_long_cmd_0),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ddll_long_cmd_1),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ddll_long_cmd_2),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ddll_long_cmd_3),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ddll_long_cmd_4),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ddll_short_cmd_0),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ddll_short_cmd_1),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ddll_short_cmd_2),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_short_dq_rank0_byte0_3),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_short_dq_rank0_byte1_3),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_short_dq_rank0_byte2_3),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_short_dq_rank0_byte3_3),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_short_dq_rank0_byte4_3),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_short_dq_rank0_byte5_3),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_short_dq_rank0_byte6_3),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_short_dq_rank0_byte7_3),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_short_dq_rank0_cmd0_3),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_short_dq_rank0_cmd1_3),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_short_dq_rank0_cmd2_3),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_short_dq_rank0_cmd3_3),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_short_dq_rank1_byte0_3),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_short_dq_rank1_byte1_3),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_short_dq_rank1_byte2_3),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_short_dq_rank1_byte3_3),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_short_dq_rank1_byte4_3),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_short_dq_rank1_byte5_3),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_short_dq_rank1_byte6_3),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_short_dq_rank1_byte7_3),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_short_dq_rank1_cmd0_0),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_short_dq_rank1_cmd0_1),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_short_dq_rank1_cmd0_2),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_short_dq_rank1_cmd0_3),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_short_dq_rank1_cmd1_0),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_short_dq_rank1_cmd1_1),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_short_dq_rank1_cmd1_2),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_short_dq_rank1_cmd1_3),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_short_dq_rank1_cmd2_0),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_short_dq_rank1_cmd2_1),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_short_dq_rank1_cmd2_2),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_short_dq_rank1_cmd2_3),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_short_dq_rank1_cmd3_0),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_short_dq_rank1_cmd3_1),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_short_dq_rank1_cmd3_2),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ob_ddll_short_dq_rank1_cmd3_3),
+    MTC_FIELD(MarikoTiming, emc_txdsrvttgen),
+    MTC_FIELD(MarikoTiming, emc_fdpd_ctrl_dq),
+    MTC_FIELD(MarikoTiming, emc_fdpd_ctrl_cmd),
+    MTC_FIELD(MarikoTiming, emc_fbio_spare),
+    MTC_FIELD(MarikoTiming, emc_zcal_interval),
+    MTC_FIELD(MarikoTiming, emc_zcal_wait_cnt),
+    MTC_FIELD(MarikoTiming, emc_mrs_wait_cnt),
+    MTC_FIELD(MarikoTiming, emc_mrs_wait_cnt2),
+    MTC_FIELD(MarikoTiming, emc_auto_cal_channel),
+    MTC_FIELD(MarikoTiming, emc_pmacro_dll_cfg_0),
+    MTC_FIELD(MarikoTiming, emc_pmacro_dll_cfg_1),
+    MTC_FIELD(MarikoTiming, emc_pmacro_dll_cfg_2),
+    MTC_FIELD(MarikoTiming, emc_pmacro_autocal_cfg_common),
+    MTC_FIELD(MarikoTiming, emc_pmacro_zctrl),
+    MTC_FIELD(MarikoTiming, emc_cfg),
+    MTC_FIELD(MarikoTiming, emc_cfg_pipe),
+    MTC_FIELD(MarikoTiming, emc_dyn_self_ref_control),
+    MTC_FIELD(MarikoTiming, emc_qpop),
+    MTC_FIELD(MarikoTiming, emc_dqs_brlshft_0),
+    MTC_FIELD(MarikoTiming, emc_dqs_brlshft_1),
+    MTC_FIELD(MarikoTiming, emc_cmd_brlshft_2),
+    MTC_FIELD(MarikoTiming, emc_cmd_brlshft_3),
+    MTC_FIELD(MarikoTiming, emc_pmacro_pad_cfg_ctrl),
+    MTC_FIELD(MarikoTiming, emc_pmacro_data_pad_rx_ctrl),
+    MTC_FIELD(MarikoTiming, emc_pmacro_cmd_pad_rx_ctrl),
+    MTC_FIELD(MarikoTiming, emc_pmacro_data_rx_term_mode),
+    MTC_FIELD(MarikoTiming, emc_pmacro_cmd_rx_term_mode),
+    MTC_FIELD(MarikoTiming, emc_pmacro_cmd_pad_tx_ctrl),
+    MTC_FIELD(MarikoTiming, emc_pmacro_data_pad_tx_ctrl),
+    MTC_FIELD(MarikoTiming, emc_pmacro_vttgen_ctrl_0),
+    MTC_FIELD(MarikoTiming, emc_pmacro_vttgen_ctrl_1),
+    MTC_FIELD(MarikoTiming, emc_pmacro_vttgen_ctrl_2),
+    MTC_FIELD(MarikoTiming, emc_pmacro_brick_ctrl_rfu1),
+    MTC_FIELD(MarikoTiming, emc_pmacro_cmd_brick_ctrl_fdpd),
+    MTC_FIELD(MarikoTiming, emc_pmacro_brick_ctrl_rfu2),
+    MTC_FIELD(MarikoTiming, emc_pmacro_data_brick_ctrl_fdpd),
+    MTC_FIELD(MarikoTiming, emc_pmacro_bg_bias_ctrl_0),
+    MTC_FIELD(MarikoTiming, emc_cfg_3),
+    MTC_FIELD(MarikoTiming, emc_pmacro_tx_pwrd_0),
+    MTC_FIELD(MarikoTiming, emc_pmacro_tx_pwrd_1),
+    MTC_FIELD(MarikoTiming, emc_pmacro_tx_pwrd_2),
+    MTC_FIELD(MarikoTiming, emc_pmacro_tx_pwrd_3),
+    MTC_FIELD(MarikoTiming, emc_pmacro_tx_pwrd_4),
+    MTC_FIELD(MarikoTiming, emc_pmacro_tx_pwrd_5),
+    MTC_FIELD(MarikoTiming, emc_config_sample_delay),
+    MTC_FIELD(MarikoTiming, emc_pmacro_tx_sel_clk_src_0),
+    MTC_FIELD(MarikoTiming, emc_pmacro_tx_sel_clk_src_1),
+    MTC_FIELD(MarikoTiming, emc_pmacro_tx_sel_clk_src_2),
+    MTC_FIELD(MarikoTiming, emc_pmacro_tx_sel_clk_src_3),
+    MTC_FIELD(MarikoTiming, emc_pmacro_tx_sel_clk_src_4),
+    MTC_FIELD(MarikoTiming, emc_pmacro_tx_sel_clk_src_5),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ddll_bypass),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ddll_pwrd_0),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ddll_pwrd_1),
+    MTC_FIELD(MarikoTiming, emc_pmacro_ddll_pwrd_2),
+    MTC_FIELD(MarikoTiming, emc_pmacro_cmd_ctrl_0),
+    MTC_FIELD(MarikoTiming, emc_pmacro_cmd_ctrl_1),
+    MTC_FIELD(MarikoTiming, emc_pmacro_cmd_ctrl_2),
+    MTC_FIELD(MarikoTiming, emc_pmacro_data_pi_ctrl),
+    MTC_FIELD(MarikoTiming, emc_pmacro_cmd_pi_ctrl),
+    MTC_FIELD(MarikoTiming, emc_tr_timing_0),
+    MTC_FIELD(MarikoTiming, emc_tr_dvfs),
+    MTC_FIELD(MarikoTiming, emc_tr_ctrl_1),
+    MTC_FIELD(MarikoTiming, emc_tr_rdv),
+    MTC_FIELD(MarikoTiming, emc_tr_qpop),
+    MTC_FIELD(MarikoTiming, emc_tr_rdv_mask),
+    MTC_FIELD(MarikoTiming, emc_mrw14),
+    MTC_FIELD(MarikoTiming, emc_tr_qsafe),
+    MTC_FIELD(MarikoTiming, emc_tr_qrst),
+    MTC_FIELD(MarikoTiming, emc_training_ctrl),
+    MTC_FIELD(MarikoTiming, emc_training_settle),
+    MTC_FIELD(MarikoTiming, emc_training_vref_settle),
+    MTC_FIELD(MarikoTiming, emc_training_ca_fine_ctrl),
+    MTC_FIELD(MarikoTiming, emc_training_ca_ctrl_misc),
+    MTC_FIELD(MarikoTiming, emc_training_ca_ctrl_misc1),
+    MTC_FIELD(MarikoTiming, emc_training_ca_vref_ctrl),
+    MTC_FIELD(MarikoTiming, emc_training_quse_cors_ctrl),
+    MTC_FIELD(MarikoTiming, emc_training_quse_fine_ctrl),
+    MTC_FIELD(MarikoTiming, emc_training_quse_ctrl_misc),
+    MTC_FIELD(MarikoTiming, emc_training_quse_vref_ctrl),
+    MTC_FIELD(MarikoTiming, emc_training_read_fine_ctrl),
+    MTC_FIELD(MarikoTiming, emc_training_read_ctrl_misc),
+    MTC_FIELD(MarikoTiming, emc_training_read_vref_ctrl),
+    MTC_FIELD(MarikoTiming, emc_training_write_fine_ctrl),
+    MTC_FIELD(MarikoTiming, emc_training_write_ctrl_misc),
+    MTC_FIELD(MarikoTiming, emc_training_write_vref_ctrl),
+    MTC_FIELD(MarikoTiming, emc_training_mpc),
+    MTC_FIELD(MarikoTiming, emc_mrw15),
+};
+
+constexpr Field EristaTimingFields[] = {
+    MTC_FIELD(EristaTiming, emc_rc),
+    MTC_FIELD(EristaTiming, emc_rfc),
+    MTC_FIELD(EristaTiming, emc_rfcpb),
+    MTC_FIELD(EristaTiming, emc_refctrl2),
+    MTC_FIELD(EristaTiming, emc_rfc_slr),
+    MTC_FIELD(EristaTiming, emc_ras),
+    MTC_FIELD(EristaTiming, emc_rp),
+    MTC_FIELD(EristaTiming, emc_r2w),
+    MTC_FIELD(EristaTiming, emc_w2r),
+    MTC_FIELD(EristaTiming, emc_r2p),
+    MTC_FIELD(EristaTiming, emc_w2p),
+    MTC_FIELD(EristaTiming, emc_r2r),
+    MTC_FIELD(EristaTiming, emc_tppd),
+    MTC_FIELD(EristaTiming, emc_ccdmw),
+    MTC_FIELD(EristaTiming, emc_rd_rcd),
+    MTC_FIELD(EristaTiming, emc_wr_rcd),
+    MTC_FIELD(EristaTiming, emc_rrd),
+    MTC_FIELD(EristaTiming, emc_rext),
+    MTC_FIELD(EristaTiming, emc_wext),
+    MTC_FIELD(EristaTiming, emc_wdv_chk),
+    MTC_FIELD(EristaTiming, emc_wdv),
+    MTC_FIELD(EristaTiming, emc_wsv),
+    MTC_FIELD(EristaTiming, emc_wev),
+    MTC_FIELD(EristaTiming, emc_wdv_mask),
+    MTC_FIELD(EristaTiming, emc_ws_duration),
+    MTC_FIELD(EristaTiming, emc_we_duration),
+    MTC_FIELD(EristaTiming, emc_quse),
+    MTC_FIELD(EristaTiming, emc_quse_width),
+    MTC_FIELD(EristaTiming, emc_ibdly),
+    MTC_FIELD(EristaTiming, emc_obdly),
+    MTC_FIELD(EristaTiming, emc_einput),
+    MTC_FIELD(EristaTiming, emc_mrw6),
+    MTC_FIELD(EristaTiming, emc_einput_duration),
+    MTC_FIELD(EristaTiming, emc_puterm_extra),
+    MTC_FIELD(EristaTiming, emc_puterm_width),
+    MTC_FIELD(EristaTiming, emc_qrst),
+    MTC_FIELD(EristaTiming, emc_qsafe),
+    MTC_FIELD(EristaTiming, emc_rdv),
+    MTC_FIELD(EristaTiming, emc_rdv_mask),
+    MTC_FIELD(EristaTiming, emc_rdv_early),
+    MTC_FIELD(EristaTiming, emc_rdv_early_mask),
+    MTC_FIELD(EristaTiming, emc_refresh),
+    MTC_FIELD(EristaTiming, emc_burst_refresh_num),
+    MTC_FIELD(EristaTiming, emc_pre_refresh_req_cnt),
+    MTC_FIELD(EristaTiming, emc_pdex2wr),
+    MTC_FIELD(EristaTiming, emc_pdex2rd),
+    MTC_FIELD(EristaTiming, emc_pchg2pden),
+    MTC_FIELD(EristaTiming, emc_act2pden),
+    MTC_FIELD(EristaTiming, emc_ar2pden),
+    MTC_FIELD(EristaTiming, emc_rw2pden),
+    MTC_FIELD(EristaTiming, emc_cke2pden),
+    MTC_FIELD(EristaTiming, emc_pdex2cke),
+    MTC_FIELD(EristaTiming, emc_pdex2mrr),
+    MTC_FIELD(EristaTiming, emc_txsr),
+    MTC_FIELD(EristaTiming, emc_txsrdll),
+    MTC_FIELD(EristaTiming, emc_tcke),
+    MTC_FIELD(EristaTiming, emc_tckesr),
+    MTC_FIELD(EristaTiming, emc_tpd),
+    MTC_FIELD(EristaTiming, emc_tfaw),
+    MTC_FIELD(EristaTiming, emc_trpab),
+    MTC_FIELD(EristaTiming, emc_tclkstable),
+    MTC_FIELD(EristaTiming, emc_tclkstop),
+    MTC_FIELD(EristaTiming, emc_mrw7),
+    MTC_FIELD(EristaTiming, emc_trefbw),
+    MTC_FIELD(EristaTiming, emc_odt_write),
+    MTC_FIELD(EristaTiming, emc_fbio_cfg5),
+    MTC_FIELD(EristaTiming, emc_fbio_cfg7),
+    MTC_FIELD(EristaTiming, emc_cfg_dig_dll),
+    MTC_FIELD(EristaTiming, emc_cfg_dig_dll_period),
+    MTC_FIELD(EristaTiming, emc_pmacro_ib_rxrt),
+    MTC_FIELD(EristaTiming, emc_cfg_pipe_1),
+    MTC_FIELD(EristaTiming, emc_cfg_pipe_2),
+    MTC_FIELD(EristaTiming, emc_pmacro_quse_ddll_rank0_4),
+    MTC_FIELD(EristaTiming, emc_pmacro_quse_ddll_rank0_5),
+    MTC_FIELD(EristaTiming, emc_pmacro_quse_ddll_rank1_4),
+    MTC_FIELD(EristaTiming, emc_pmacro_quse_ddll_rank1_5),
+    MTC_FIELD(EristaTiming, emc_mrw8),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_long_dq_rank1_4),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_long_dq_rank1_5),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_long_dqs_rank0_0),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_long_dqs_rank0_1),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_long_dqs_rank0_2),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_long_dqs_rank0_3),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_long_dqs_rank0_4),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_long_dqs_rank0_5),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_long_dqs_rank1_0),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_long_dqs_rank1_1),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_long_dqs_rank1_2),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_long_dqs_rank1_3),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_long_dqs_rank1_4),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_long_dqs_rank1_5),
+    MTC_FIELD(EristaTiming, emc_pmacro_ddll_long_cmd_0),
+    MTC_FIELD(EristaTiming, emc_pmacro_ddll_long_cmd_1),
+    MTC_FIELD(EristaTiming, emc_pmacro_ddll_long_cmd_2),
+    MTC_FIELD(EristaTiming, emc_pmacro_ddll_long_cmd_3),
+    MTC_FIELD(EristaTiming, emc_pmacro_ddll_long_cmd_4),
+    MTC_FIELD(EristaTiming, emc_pmacro_ddll_short_cmd_0),
+    MTC_FIELD(EristaTiming, emc_pmacro_ddll_short_cmd_1),
+    MTC_FIELD(EristaTiming, emc_pmacro_ddll_short_cmd_2),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_short_dq_rank0_byte0_3),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_short_dq_rank0_byte1_3),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_short_dq_rank0_byte2_3),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_short_dq_rank0_byte3_3),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_short_dq_rank0_byte4_3),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_short_dq_rank0_byte5_3),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_short_dq_rank0_byte6_3),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_short_dq_rank0_byte7_3),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_short_dq_rank0_cmd0_3),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_short_dq_rank0_cmd1_3),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_short_dq_rank0_cmd2_3),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_short_dq_rank0_cmd3_3),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_short_dq_rank1_byte0_3),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_short_dq_rank1_byte1_3),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_short_dq_rank1_byte2_3),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_short_dq_rank1_byte3_3),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_short_dq_rank1_byte4_3),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_short_dq_rank1_byte5_3),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_short_dq_rank1_byte6_3),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_short_dq_rank1_byte7_3),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_short_dq_rank1_cmd0_0),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_short_dq_rank1_cmd0_1),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_short_dq_rank1_cmd0_2),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_short_dq_rank1_cmd0_3),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_short_dq_rank1_cmd1_0),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_short_dq_rank1_cmd1_1),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_short_dq_rank1_cmd1_2),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_short_dq_rank1_cmd1_3),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_short_dq_rank1_cmd2_0),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_short_dq_rank1_cmd2_1),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_short_dq_rank1_cmd2_2),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_short_dq_rank1_cmd2_3),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_short_dq_rank1_cmd3_0),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_short_dq_rank1_cmd3_1),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_short_dq_rank1_cmd3_2),
+    MTC_FIELD(EristaTiming, emc_pmacro_ob_ddll_short_dq_rank1_cmd3_3),
+    MTC_FIELD(EristaTiming, emc_txdsrvttgen),
+    MTC_FIELD(EristaTiming, emc_fdpd_ctrl_dq),
+    MTC_FIELD(EristaTiming, emc_fdpd_ctrl_cmd),
+    MTC_FIELD(EristaTiming, emc_fbio_spare),
+    MTC_FIELD(EristaTiming, emc_zcal_interval),
+    MTC_FIELD(EristaTiming, emc_zcal_wait_cnt),
+    MTC_FIELD(EristaTiming, emc_mrs_wait_cnt),
+    MTC_FIELD(EristaTiming, emc_mrs_wait_cnt2),
+    MTC_FIELD(EristaTiming, emc_auto_cal_channel),
+    MTC_FIELD(EristaTiming, emc_dll_cfg_0),
+    MTC_FIELD(EristaTiming, emc_dll_cfg_1),
+    MTC_FIELD(EristaTiming, emc_pmacro_autocal_cfg_common),
+    MTC_FIELD(EristaTiming, emc_pmacro_zctrl),
+    MTC_FIELD(EristaTiming, emc_cfg),
+    MTC_FIELD(EristaTiming, emc_cfg_pipe),
+    MTC_FIELD(EristaTiming, emc_dyn_self_ref_control),
+    MTC_FIELD(EristaTiming, emc_qpop),
+    MTC_FIELD(EristaTiming, emc_dqs_brlshft_0),
+    MTC_FIELD(EristaTiming, emc_dqs_brlshft_1),
+    MTC_FIELD(EristaTiming, emc_cmd_brlshft_2),
+    MTC_FIELD(EristaTiming, emc_cmd_brlshft_3),
+    MTC_FIELD(EristaTiming, emc_pmacro_pad_cfg_ctrl),
+    MTC_FIELD(EristaTiming, emc_pmacro_data_pad_rx_ctrl),
+    MTC_FIELD(EristaTiming, emc_pmacro_cmd_pad_rx_ctrl),
+    MTC_FIELD(EristaTiming, emc_pmacro_data_rx_term_mode),
+    MTC_FIELD(EristaTiming, emc_pmacro_cmd_rx_term_mode),
+    MTC_FIELD(EristaTiming, emc_pmacro_cmd_pad_tx_ctrl),
+    MTC_FIELD(EristaTiming, emc_pmacro_data_pad_tx_ctrl),
+    MTC_FIELD(EristaTiming, emc_pmacro_common_pad_tx_ctrl),
+    MTC_FIELD(EristaTiming, emc_pmacro_vttgen_ctrl_0),
+    MTC_FIELD(EristaTiming, emc_pmacro_vttgen_ctrl_1),
+    MTC_FIELD(EristaTiming, emc_pmacro_vttgen_ctrl_2),
+    MTC_FIELD(EristaTiming, emc_pmacro_brick_ctrl_rfu1),
+    MTC_FIELD(EristaTiming, emc_pmacro_cmd_brick_ctrl_fdpd),
+    MTC_FIELD(EristaTiming, emc_pmacro_brick_ctrl_rfu2),
+    MTC_FIELD(EristaTiming, emc_pmacro_data_brick_ctrl_fdpd),
+    MTC_FIELD(EristaTiming, emc_pmacro_bg_bias_ctrl_0),
+    MTC_FIELD(EristaTiming, emc_cfg_3),
+    MTC_FIELD(EristaTiming, emc_pmacro_tx_pwrd_0),
+    MTC_FIELD(EristaTiming, emc_pmacro_tx_pwrd_1),
+    MTC_FIELD(EristaTiming, emc_pmacro_tx_pwrd_2),
+    MTC_FIELD(EristaTiming, emc_pmacro_tx_pwrd_3),
+    MTC_FIELD(EristaTiming, emc_pmacro_tx_pwrd_4),
+    MTC_FIELD(EristaTiming, emc_pmacro_tx_pwrd_5),
+    MTC_FIELD(EristaTiming, emc_config_sample_delay),
+    MTC_FIELD(EristaTiming, emc_pmacro_tx_sel_clk_src_0),
+    MTC_FIELD(EristaTiming, emc_pmacro_tx_sel_clk_src_1),
+    MTC_FIELD(EristaTiming, emc_pmacro_tx_sel_clk_src_2),
+    MTC_FIELD(EristaTiming, emc_pmacro_tx_sel_clk_src_3),
+    MTC_FIELD(EristaTiming, emc_pmacro_tx_sel_clk_src_4),
+    MTC_FIELD(EristaTiming, emc_pmacro_tx_sel_clk_src_5),
+    MTC_FIELD(EristaTiming, emc_pmacro_ddll_bypass),
+    MTC_FIELD(EristaTiming, emc_pmacro_ddll_pwrd_0),
+    MTC_FIELD(EristaTiming, emc_pmacro_ddll_pwrd_1),
+    MTC_FIELD(EristaTiming, emc_pmacro_ddll_pwrd_2),
+    MTC_FIELD(EristaTiming, emc_pmacro_cmd_ctrl_0),
+    MTC_FIELD(EristaTiming, emc_pmacro_cmd_ctrl_1),
+    MTC_FIELD(EristaTiming, emc_pmacro_cmd_ctrl_2),
+    MTC_FIELD(EristaTiming, emc_tr_timing_0),
+    MTC_FIELD(EristaTiming, emc_tr_dvfs),
+    MTC_FIELD(EristaTiming, emc_tr_ctrl_1),
+    MTC_FIELD(EristaTiming, emc_tr_rdv),
+    MTC_FIELD(EristaTiming, emc_tr_qpop),
+    MTC_FIELD(EristaTiming, emc_tr_rdv_mask),
+    MTC_FIELD(EristaTiming, emc_mrw14),
+    MTC_FIELD(EristaTiming, emc_tr_qsafe),
+    MTC_FIELD(EristaTiming, emc_tr_qrst),
+    MTC_FIELD(EristaTiming, emc_training_ctrl),
+    MTC_FIELD(EristaTiming, emc_training_settle),
+    MTC_FIELD(EristaTiming, emc_training_vref_settle),
+    MTC_FIELD(EristaTiming, emc_training_ca_fine_ctrl),
+    MTC_FIELD(EristaTiming, emc_training_ca_ctrl_misc),
+    MTC_FIELD(EristaTiming, emc_training_ca_ctrl_misc1),
+    MTC_FIELD(EristaTiming, emc_training_ca_vref_ctrl),
+    MTC_FIELD(EristaTiming, emc_training_quse_cors_ctrl),
+    MTC_FIELD(EristaTiming, emc_training_quse_fine_ctrl),
+    MTC_FIELD(EristaTiming, emc_training_quse_ctrl_misc),
+    MTC_FIELD(EristaTiming, emc_training_quse_vref_ctrl),
+    MTC_FIELD(EristaTiming, emc_training_read_fine_ctrl),
+    MTC_FIELD(EristaTiming, emc_training_read_ctrl_misc),
+    MTC_FIELD(EristaTiming, emc_training_read_vref_ctrl),
+    MTC_FIELD(EristaTiming, emc_training_write_fine_ctrl),
+    MTC_FIELD(EristaTiming, emc_training_write_ctrl_misc),
+    MTC_FIELD(EristaTiming, emc_training_write_vref_ctrl),
+    MTC_FIELD(EristaTiming, emc_training_mpc),
+    MTC_FIELD(EristaTiming, emc_mrw15),
+};
+
+constexpr Field MarikoMtcTableFields[] = {
+    MTC_FIELD(MarikoMtcTable, rev),
+    MTC_FIELD(MarikoMtcTable, dvfs_ver),
+    MTC_FIELD(MarikoMtcTable, rate_khz),
+    MTC_FIELD(MarikoMtcTable, min_volt),
+    MTC_FIELD(MarikoMtcTable, gpu_min_volt),
+    MTC_FIELD(MarikoMtcTable, clock_src),
+    MTC_FIELD(MarikoMtcTable, clk_src_emc),
+    MTC_FIELD(MarikoMtcTable, pll_en_ssc),
+    MTC_FIELD(MarikoMtcTable, needs_training),
+    MTC_FIELD(MarikoMtcTable, training_pattern),
+    MTC_FIELD(MarikoMtcTable, trained),
+    MTC_FIELD(MarikoMtcTable, periodic_training),
+    MTC_FIELD(MarikoMtcTable, trained_dram_clktree_c0d0u0),
+    MTC_FIELD(MarikoMtcTable, trained_dram_clktree_c0d0u1),
+    MTC_FIELD(MarikoMtcTable, trained_dram_clktree_c0d1u0),
+    MTC_FIELD(MarikoMtcTable, trained_dram_clktree_c0d1u1),
+    MTC_FIELD(MarikoMtcTable, trained_dram_clktree_c1d0u0),
+    MTC_FIELD(MarikoMtcTable, trained_dram_clktree_c1d0u1),
+    MTC_FIELD(MarikoMtcTable, trained_dram_clktree_c1d1u0),
+    MTC_FIELD(MarikoMtcTable, trained_dram_clktree_c1d1u1),
+    MTC_FIELD(MarikoMtcTable, current_dram_clktree_c0d0u0),
+    MTC_FIELD(MarikoMtcTable, current_dram_clktree_c0d0u1),
+    MTC_FIELD(MarikoMtcTable, current_dram_clktree_c0d1u0),
+    MTC_FIELD(MarikoMtcTable, current_dram_clktree_c0d1u1),
+    MTC_FIELD(MarikoMtcTable, current_dram_clktree_c1d0u0),
+    MTC_FIELD(MarikoMtcTable, current_dram_clktree_c1d0u1),
+    MTC_FIELD(MarikoMtcTable, current_dram_clktree_c1d1u0),
+    MTC_FIELD(MarikoMtcTable, current_dram_clktree_c1d1u1),
+    MTC_FIELD(MarikoMtcTable, emc_fbio_cfg7),
+    MTC_FIELD(MarikoMtcTable, run_clocks),
+    MTC_FIELD(MarikoMtcTable, tree_margin),
+    MTC_FIELD(MarikoMtcTable, num_burst),
+    MTC_FIELD(MarikoMtcTable, num_burst_per_ch),
+    MTC_FIELD(MarikoMtcTable, num_trim),
+    MTC_FIELD(MarikoMtcTable, num_trim_per_ch),
+    MTC_FIELD(MarikoMtcTable, num_mc_regs),
+    MTC_FIELD(MarikoMtcTable, num_up_down),
+    MTC_FIELD(MarikoMtcTable, vref_num),
+    MTC_FIELD(MarikoMtcTable, training_mod_num),
+    MTC_FIELD(MarikoMtcTable, dram_timing_num),
+    MTC_FIELD(MarikoMtcTable, ptfv_dqsosc_movavg_c0d0u0),
+    MTC_FIELD(MarikoMtcTable, ptfv_dqsosc_movavg_c0d0u1),
+    MTC_FIELD(MarikoMtcTable, ptfv_dqsosc_movavg_c0d1u0),
+    MTC_FIELD(MarikoMtcTable, ptfv_dqsosc_movavg_c0d1u1),
+    MTC_FIELD(MarikoMtcTable, ptfv_dqsosc_movavg_c1d0u0),
+    MTC_FIELD(MarikoMtcTable, ptfv_dqsosc_movavg_c1d0u1),
+    MTC_FIELD(MarikoMtcTable, ptfv_dqsosc_movavg_c1d1u0),
+    MTC_FIELD(MarikoMtcTable, ptfv_dqsosc_movavg_c1d1u1),
+    MTC_FIELD(MarikoMtcTable, ptfv_write_samples),
+    MTC_FIELD(MarikoMtcTable, ptfv_dvfs_samples),
+    MTC_FIELD(MarikoMtcTable, ptfv_movavg_weight),
+    MTC_FIELD(MarikoMtcTable, ptfv_config_ctrl),
+    MTC_BLOCK(MarikoMtcTable, burst_regs, MarikoTimingFields),
+    MTC_FIELD(MarikoMtcTable, burst_perch_regs.emc0_mrw10),
+    MTC_FIELD(MarikoMtcTable, burst_perch_regs.emc1_mrw10),
+    MTC_FIELD(MarikoMtcTable, burst_perch_regs.emc0_mrw11),
+    MTC_FIELD(MarikoMtcTable, burst_perch_regs.emc1_mrw11),
+    MTC_FIELD(MarikoMtcTable, burst_perch_regs.emc0_mrw12),
+    MTC_FIELD(MarikoMtcTable, burst_perch_regs.emc1_mrw12),
+    MTC_FIELD(MarikoMtcTable, burst_perch_regs.emc0_mrw13),
+    MTC_FIELD(MarikoMtcTable, burst_perch_regs.emc1_mrw13),
+    MTC_BLOCK(MarikoMtcTable, shadow_regs_ca_train, MarikoTimingFields),
+    MTC_BLOCK(MarikoMtcTable, shadow_regs_rdwr_train, MarikoTimingFields),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_long_dqs_rank0_0),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_long_dqs_rank0_1),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_long_dqs_rank0_2),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_long_dqs_rank0_3),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_long_dqs_rank1_0),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_long_dqs_rank1_1),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_long_dqs_rank1_2),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_long_dqs_rank1_3),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte0_0),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte0_1),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte0_2),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte1_0),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte1_1),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte1_2),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte2_0),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte2_1),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte2_2),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte3_0),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte3_1),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte3_2),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte4_0),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte4_1),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte4_2),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte5_0),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte5_1),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte5_2),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte6_0),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte6_1),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte6_2),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte7_0),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte7_1),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte7_2),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte0_0),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte0_1),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte0_2),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte1_0),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte1_1),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte1_2),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte2_0),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte2_1),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte2_2),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte3_0),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte3_1),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte3_2),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte4_0),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte4_1),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte4_2),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte5_0),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte5_1),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte5_2),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte6_0),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte6_1),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte6_2),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte7_0),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte7_1),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte7_2),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_vref_dqs_0),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_vref_dqs_1),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_vref_dq_0),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ib_vref_dq_1),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_long_dq_rank0_0),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_long_dq_rank0_1),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_long_dq_rank0_2),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_long_dq_rank0_3),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_long_dq_rank0_4),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_long_dq_rank0_5),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_long_dq_rank1_0),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_long_dq_rank1_1),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_long_dq_rank1_2),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_long_dq_rank1_3),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte0_0),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte0_1),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte0_2),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte1_0),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte1_1),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte1_2),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte2_0),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte2_1),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte2_2),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte3_0),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte3_1),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte3_2),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte4_0),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte4_1),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte4_2),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte5_0),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte5_1),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte5_2),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte6_0),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte6_1),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte6_2),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte7_0),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte7_1),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte7_2),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_cmd0_0),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_cmd0_1),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_cmd0_2),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_cmd1_0),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_cmd1_1),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_cmd1_2),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_cmd2_0),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_cmd2_1),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_cmd2_2),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_cmd3_0),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_cmd3_1),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_cmd3_2),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte0_0),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte0_1),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte0_2),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte1_0),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte1_1),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte1_2),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte2_0),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte2_1),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte2_2),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte3_0),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte3_1),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte3_2),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte4_0),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte4_1),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte4_2),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte5_0),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte5_1),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte5_2),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte6_0),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte6_1),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte6_2),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte7_0),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte7_1),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte7_2),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_quse_ddll_rank0_0),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_quse_ddll_rank0_1),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_quse_ddll_rank0_2),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_quse_ddll_rank0_3),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_quse_ddll_rank1_0),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_quse_ddll_rank1_1),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_quse_ddll_rank1_2),
+    MTC_FIELD(MarikoMtcTable, trim_regs.emc_pmacro_quse_ddll_rank1_3),
+    MTC_FIELD(MarikoMtcTable, trim_perch_regs.emc0_cmd_brlshft_0),
+    MTC_FIELD(MarikoMtcTable, trim_perch_regs.emc1_cmd_brlshft_1),
+    MTC_FIELD(MarikoMtcTable, trim_perch_regs.emc0_data_brlshft_0),
+    MTC_FIELD(MarikoMtcTable, trim_perch_regs.emc1_data_brlshft_0),
+    MTC_FIELD(MarikoMtcTable, trim_perch_regs.emc0_data_brlshft_1),
+    MTC_FIELD(MarikoMtcTable, trim_perch_regs.emc1_data_brlshft_1),
+    MTC_FIELD(MarikoMtcTable, trim_perch_regs.emc0_quse_brlshft_0),
+    MTC_FIELD(MarikoMtcTable, trim_perch_regs.emc1_quse_brlshft_1),
+    MTC_FIELD(MarikoMtcTable, trim_perch_regs.emc0_quse_brlshft_2),
+    MTC_FIELD(MarikoMtcTable, trim_perch_regs.emc1_quse_brlshft_3),
+    MTC_FIELD(MarikoMtcTable, vref_perch_regs.emc0_training_opt_dqs_ib_vref_rank0),
+    MTC_FIELD(MarikoMtcTable, vref_perch_regs.emc1_training_opt_dqs_ib_vref_rank0),
+    MTC_FIELD(MarikoMtcTable, vref_perch_regs.emc0_training_opt_dqs_ib_vref_rank1),
+    MTC_FIELD(MarikoMtcTable, vref_perch_regs.emc1_training_opt_dqs_ib_vref_rank1),
+    MTC_FIELD(MarikoMtcTable, dram_timings.t_rp),
+    MTC_FIELD(MarikoMtcTable, dram_timings.t_fc_lpddr4),
+    MTC_FIELD(MarikoMtcTable, dram_timings.t_rfc),
+    MTC_FIELD(MarikoMtcTable, dram_timings.t_pdex),
+    MTC_FIELD(MarikoMtcTable, dram_timings.rl),
+    MTC_FIELD(MarikoMtcTable, zq_op_cc_long_zcal),
+    MTC_FIELD(MarikoMtcTable, zq_op_cc_short_zcal),
+    MTC_FIELD(MarikoMtcTable, zcal_wait_time_ps_cc_long_zcal),
+    MTC_FIELD(MarikoMtcTable, zcal_wait_time_ps_cc_short_zcal),
+    MTC_FIELD(MarikoMtcTable, tZQCAL_lpddr4),
+    MTC_FIELD(MarikoMtcTable, zqcal_before_cc_cutoff),
+    MTC_FIELD(MarikoMtcTable, opt_cc_short_zcal),
+    MTC_FIELD(MarikoMtcTable, opt_short_zcal),
+    MTC_FIELD(MarikoMtcTable, opt_do_sw_qrst),
+    MTC_FIELD(MarikoMtcTable, save_restore_clkstop_pd),
+    MTC_FIELD(MarikoMtcTable, opt_E90),
+    MTC_FIELD(MarikoMtcTable, cya_allow_ref_cc),
+    MTC_FIELD(MarikoMtcTable, ref_b4_sref_en),
+    MTC_FIELD(MarikoMtcTable, cya_issue_pc_ref),
+    MTC_FIELD(MarikoMtcTable, training_mod_regs.emc0_training_rw_offset_ib_byte0),
+    MTC_FIELD(MarikoMtcTable, training_mod_regs.emc1_training_rw_offset_ib_byte0),
+    MTC_FIELD(MarikoMtcTable, training_mod_regs.emc0_training_rw_offset_ib_byte1),
+    MTC_FIELD(MarikoMtcTable, training_mod_regs.emc1_training_rw_offset_ib_byte1),
+    MTC_FIELD(MarikoMtcTable, training_mod_regs.emc0_training_rw_offset_ib_byte2),
+    MTC_FIELD(MarikoMtcTable, training_mod_regs.emc1_training_rw_offset_ib_byte2),
+    MTC_FIELD(MarikoMtcTable, training_mod_regs.emc0_training_rw_offset_ib_byte3),
+    MTC_FIELD(MarikoMtcTable, training_mod_regs.emc1_training_rw_offset_ib_byte3),
+    MTC_FIELD(MarikoMtcTable, training_mod_regs.emc0_training_rw_offset_ib_misc),
+    MTC_FIELD(MarikoMtcTable, training_mod_regs.emc1_training_rw_offset_ib_misc),
+    MTC_FIELD(MarikoMtcTable, training_mod_regs.emc0_training_rw_offset_ob_byte0),
+    MTC_FIELD(MarikoMtcTable, training_mod_regs.emc1_training_rw_offset_ob_byte0),
+    MTC_FIELD(MarikoMtcTable, training_mod_regs.emc0_training_rw_offset_ob_byte1),
+    MTC_FIELD(MarikoMtcTable, training_mod_regs.emc1_training_rw_offset_ob_byte1),
+    MTC_FIELD(MarikoMtcTable, training_mod_regs.emc0_training_rw_offset_ob_byte2),
+    MTC_FIELD(MarikoMtcTable, training_mod_regs.emc1_training_rw_offset_ob_byte2),
+    MTC_FIELD(MarikoMtcTable, training_mod_regs.emc0_training_rw_offset_ob_byte3),
+    MTC_FIELD(MarikoMtcTable, training_mod_regs.emc1_training_rw_offset_ob_byte3),
+    MTC_FIELD(MarikoMtcTable, training_mod_regs.emc0_training_rw_offset_ob_misc),
+    MTC_FIELD(MarikoMtcTable, training_mod_regs.emc1_training_rw_offset_ob_misc),
+    MTC_FIELD(MarikoMtcTable, save_restore_mod_regs[0]),
+    MTC_FIELD(MarikoMtcTable, save_restore_mod_regs[1]),
+    MTC_FIELD(MarikoMtcTable, save_restore_mod_regs[2]),
+    MTC_FIELD(MarikoMtcTable, save_restore_mod_regs[3]),
+    MTC_FIELD(MarikoMtcTable, save_restore_mod_regs[4]),
+    MTC_FIELD(MarikoMtcTable, save_restore_mod_regs[5]),
+    MTC_FIELD(MarikoMtcTable, save_restore_mod_regs[6]),
+    MTC_FIELD(MarikoMtcTable, save_restore_mod_regs[7]),
+    MTC_FIELD(MarikoMtcTable, save_restore_mod_regs[8]),
+    MTC_FIELD(MarikoMtcTable, save_restore_mod_regs[9]),
+    MTC_FIELD(MarikoMtcTable, save_restore_mod_regs[10]),
+    MTC_FIELD(MarikoMtcTable, save_restore_mod_regs[11]),
+    MTC_FIELD(MarikoMtcTable, burst_mc_regs.mc_emem_arb_cfg),
+    MTC_FIELD(MarikoMtcTable, burst_mc_regs.mc_emem_arb_outstanding_req),
+    MTC_FIELD(MarikoMtcTable, burst_mc_regs.mc_emem_arb_refpb_hp_ctrl),
+    MTC_FIELD(MarikoMtcTable, burst_mc_regs.mc_emem_arb_refpb_bank_ctrl),
+    MTC_FIELD(MarikoMtcTable, burst_mc_regs.mc_emem_arb_timing_rcd),
+    MTC_FIELD(MarikoMtcTable, burst_mc_regs.mc_emem_arb_timing_rp),
+    MTC_FIELD(MarikoMtcTable, burst_mc_regs.mc_emem_arb_timing_rc),
+    MTC_FIELD(MarikoMtcTable, burst_mc_regs.mc_emem_arb_timing_ras),
+    MTC_FIELD(MarikoMtcTable, burst_mc_regs.mc_emem_arb_timing_faw),
+    MTC_FIELD(MarikoMtcTable, burst_mc_regs.mc_emem_arb_timing_rrd),
+    MTC_FIELD(MarikoMtcTable, burst_mc_regs.mc_emem_arb_timing_rap2pre),
+    MTC_FIELD(MarikoMtcTable, burst_mc_regs.mc_emem_arb_timing_wap2pre),
+    MTC_FIELD(MarikoMtcTable, burst_mc_regs.mc_emem_arb_timing_r2r),
+    MTC_FIELD(MarikoMtcTable, burst_mc_regs.mc_emem_arb_timing_w2w),
+    MTC_FIELD(MarikoMtcTable, burst_mc_regs.mc_emem_arb_timing_r2w),
+    MTC_FIELD(MarikoMtcTable, burst_mc_regs.mc_emem_arb_timing_ccdmw),
+    MTC_FIELD(MarikoMtcTable, burst_mc_regs.mc_emem_arb_timing_w2r),
+    MTC_FIELD(MarikoMtcTable, burst_mc_regs.mc_emem_arb_timing_rfcpb),
+    MTC_FIELD(MarikoMtcTable, burst_mc_regs.mc_emem_arb_da_turns),
+    MTC_FIELD(MarikoMtcTable, burst_mc_regs.mc_emem_arb_da_covers),
+    MTC_FIELD(MarikoMtcTable, burst_mc_regs.mc_emem_arb_misc0),
+    MTC_FIELD(MarikoMtcTable, burst_mc_regs.mc_emem_arb_misc1),
+    MTC_FIELD(MarikoMtcTable, burst_mc_regs.mc_emem_arb_misc2),
+    MTC_FIELD(MarikoMtcTable, burst_mc_regs.mc_emem_arb_ring1_throttle),
+    MTC_FIELD(MarikoMtcTable, burst_mc_regs.mc_emem_arb_dhyst_ctrl),
+    MTC_FIELD(MarikoMtcTable, burst_mc_regs.mc_emem_arb_dhyst_timeout_util_0),
+    MTC_FIELD(MarikoMtcTable, burst_mc_regs.mc_emem_arb_dhyst_timeout_util_1),
+    MTC_FIELD(MarikoMtcTable, burst_mc_regs.mc_emem_arb_dhyst_timeout_util_2),
+    MTC_FIELD(MarikoMtcTable, burst_mc_regs.mc_emem_arb_dhyst_timeout_util_3),
+    MTC_FIELD(MarikoMtcTable, burst_mc_regs.mc_emem_arb_dhyst_timeout_util_4),
+    MTC_FIELD(MarikoMtcTable, burst_mc_regs.mc_emem_arb_dhyst_timeout_util_5),
+    MTC_FIELD(MarikoMtcTable, burst_mc_regs.mc_emem_arb_dhyst_timeout_util_6),
+    MTC_FIELD(MarikoMtcTable, burst_mc_regs.mc_emem_arb_dhyst_timeout_util_7),
+    MTC_FIELD(MarikoMtcTable, la_scale_regs.mc_mll_mpcorer_ptsa_rate),
+    MTC_FIELD(MarikoMtcTable, la_scale_regs.mc_ftop_ptsa_rate),
+    MTC_FIELD(MarikoMtcTable, la_scale_regs.mc_ptsa_grant_decrement),
+    MTC_FIELD(MarikoMtcTable, la_scale_regs.mc_latency_allowance_xusb_0),
+    MTC_FIELD(MarikoMtcTable, la_scale_regs.mc_latency_allowance_xusb_1),
+    MTC_FIELD(MarikoMtcTable, la_scale_regs.mc_latency_allowance_tsec_0),
+    MTC_FIELD(MarikoMtcTable, la_scale_regs.mc_latency_allowance_sdmmca_0),
+    MTC_FIELD(MarikoMtcTable, la_scale_regs.mc_latency_allowance_sdmmcaa_0),
+    MTC_FIELD(MarikoMtcTable, la_scale_regs.mc_latency_allowance_sdmmc_0),
+    MTC_FIELD(MarikoMtcTable, la_scale_regs.mc_latency_allowance_sdmmcab_0),
+    MTC_FIELD(MarikoMtcTable, la_scale_regs.mc_latency_allowance_ppcs_0),
+    MTC_FIELD(MarikoMtcTable, la_scale_regs.mc_latency_allowance_ppcs_1),
+    MTC_FIELD(MarikoMtcTable, la_scale_regs.mc_latency_allowance_mpcore_0),
+    MTC_FIELD(MarikoMtcTable, la_scale_regs.mc_latency_allowance_hc_0),
+    MTC_FIELD(MarikoMtcTable, la_scale_regs.mc_latency_allowance_hc_1),
+    MTC_FIELD(MarikoMtcTable, la_scale_regs.mc_latency_allowance_avpc_0),
+    MTC_FIELD(MarikoMtcTable, la_scale_regs.mc_latency_allowance_gpu_0),
+    MTC_FIELD(MarikoMtcTable, la_scale_regs.mc_latency_allowance_gpu2_0),
+    MTC_FIELD(MarikoMtcTable, la_scale_regs.mc_latency_allowance_nvenc_0),
+    MTC_FIELD(MarikoMtcTable, la_scale_regs.mc_latency_allowance_nvdec_0),
+    MTC_FIELD(MarikoMtcTable, la_scale_regs.mc_latency_allowance_vic_0),
+    MTC_FIELD(MarikoMtcTable, la_scale_regs.mc_latency_allowance_vi2_0),
+    MTC_FIELD(MarikoMtcTable, la_scale_regs.mc_latency_allowance_isp2_0),
+    MTC_FIELD(MarikoMtcTable, la_scale_regs.mc_latency_allowance_isp2_1),
+    MTC_FIELD(MarikoMtcTable, unk_0),
+    MTC_FIELD(MarikoMtcTable, vtt_vdda_ctrl_0),
+    MTC_FIELD(MarikoMtcTable, src_clock_div),
+    MTC_FIELD(MarikoMtcTable, vtt_vdda_dual_channel),
+    MTC_FIELD(MarikoMtcTable, vtt_vdda_ctrl_1),
+    MTC_FIELD(MarikoMtcTable, vtt_vdda_ctrl_2),
+    MTC_FIELD(MarikoMtcTable, vtt_vdda_ctrl_3),
+    MTC_FIELD(MarikoMtcTable, vtt_vdda_ctrl_4),
+    MTC_FIELD(MarikoMtcTable, misc_cfg_0),
+    MTC_FIELD(MarikoMtcTable, misc_cfg_1),
+    MTC_FIELD(MarikoMtcTable, misc_cfg_2),
+    MTC_FIELD(MarikoMtcTable, unk_1),
+    MTC_FIELD(MarikoMtcTable, unk_2),
+    MTC_FIELD(MarikoMtcTable, pipe_clk_delay),
+    MTC_FIELD(MarikoMtcTable, clkchange_delay),
+    MTC_FIELD(MarikoMtcTable, pllm_ss_cfg),
+    MTC_FIELD(MarikoMtcTable, pllm_ss_ctrl1),
+    MTC_FIELD(MarikoMtcTable, pllm_ss_ctrl2),
+    MTC_FIELD(MarikoMtcTable, pllmb_ss_cfg),
+    MTC_FIELD(MarikoMtcTable, pllmb_ss_ctrl1),
+    MTC_FIELD(MarikoMtcTable, pllmb_ss_ctrl2),
+    MTC_FIELD(MarikoMtcTable, pllmb_divm),
+    MTC_FIELD(MarikoMtcTable, pllmb_divn),
+    MTC_FIELD(MarikoMtcTable, pllmb_divp),
+    MTC_FIELD(MarikoMtcTable, min_mrs_wait),
+    MTC_FIELD(MarikoMtcTable, ramp_wait),
+    MTC_FIELD(MarikoMtcTable, emc_mrw),
+    MTC_FIELD(MarikoMtcTable, emc_mrw2),
+    MTC_FIELD(MarikoMtcTable, emc_mrw3),
+    MTC_FIELD(MarikoMtcTable, emc_mrw4),
+    MTC_FIELD(MarikoMtcTable, emc_mrw9),
+    MTC_FIELD(MarikoMtcTable, emc_mrs),
+    MTC_FIELD(MarikoMtcTable, emc_emrs),
+    MTC_FIELD(MarikoMtcTable, emc_emrs2),
+    MTC_FIELD(MarikoMtcTable, emc_auto_cal_config),
+    MTC_FIELD(MarikoMtcTable, emc_auto_cal_config2),
+    MTC_FIELD(MarikoMtcTable, emc_auto_cal_config3),
+    MTC_FIELD(MarikoMtcTable, emc_auto_cal_config4),
+    MTC_FIELD(MarikoMtcTable, emc_auto_cal_config5),
+    MTC_FIELD(MarikoMtcTable, emc_auto_cal_config6),
+    MTC_FIELD(MarikoMtcTable, emc_auto_cal_config7),
+    MTC_FIELD(MarikoMtcTable, emc_auto_cal_config8),
+    MTC_FIELD(MarikoMtcTable, emc_cfg_2),
+    MTC_FIELD(MarikoMtcTable, emc_sel_dpd_ctrl),
+    MTC_FIELD(MarikoMtcTable, emc_fdpd_ctrl_cmd_no_ramp),
+    MTC_FIELD(MarikoMtcTable, emc_tr_ctrl_0),
+    MTC_FIELD(MarikoMtcTable, dll_clk_src),
+    MTC_FIELD(MarikoMtcTable, clk_out_enb_x_0_clk_enb_emc_dll),
+    MTC_FIELD(MarikoMtcTable, latency),
+    MTC_FIELD(MarikoMtcTable, pllm_misc1_0_pllm_clamp_ph90),
+};
+
+constexpr Field EristaMtcTableFields[] = {
+    MTC_FIELD(EristaMtcTable, rev),
+    MTC_FIELD(EristaMtcTable, dvfs_ver),
+    MTC_FIELD(EristaMtcTable, rate_khz),
+    MTC_FIELD(EristaMtcTable, min_volt),
+    MTC_FIELD(EristaMtcTable, gpu_min_volt),
+    MTC_FIELD(EristaMtcTable, clock_src),
+    MTC_FIELD(EristaMtcTable, clk_src_emc),
+    MTC_FIELD(EristaMtcTable, needs_training),
+    MTC_FIELD(EristaMtcTable, training_pattern),
+    MTC_FIELD(EristaMtcTable, trained),
+    MTC_FIELD(EristaMtcTable, periodic_training),
+    MTC_FIELD(EristaMtcTable, trained_dram_clktree_c0d0u0),
+    MTC_FIELD(EristaMtcTable, trained_dram_clktree_c0d0u1),
+    MTC_FIELD(EristaMtcTable, trained_dram_clktree_c0d1u0),
+    MTC_FIELD(EristaMtcTable, trained_dram_clktree_c0d1u1),
+    MTC_FIELD(EristaMtcTable, trained_dram_clktree_c1d0u0),
+    MTC_FIELD(EristaMtcTable, trained_dram_clktree_c1d0u1),
+    MTC_FIELD(EristaMtcTable, trained_dram_clktree_c1d1u0),
+    MTC_FIELD(EristaMtcTable, trained_dram_clktree_c1d1u1),
+    MTC_FIELD(EristaMtcTable, current_dram_clktree_c0d0u0),
+    MTC_FIELD(EristaMtcTable, current_dram_clktree_c0d0u1),
+    MTC_FIELD(EristaMtcTable, current_dram_clktree_c0d1u0),
+    MTC_FIELD(EristaMtcTable, current_dram_clktree_c0d1u1),
+    MTC_FIELD(EristaMtcTable, current_dram_clktree_c1d0u0),
+    MTC_FIELD(EristaMtcTable, current_dram_clktree_c1d0u1),
+    MTC_FIELD(EristaMtcTable, current_dram_clktree_c1d1u0),
+    MTC_FIELD(EristaMtcTable, current_dram_clktree_c1d1u1),
+    MTC_FIELD(EristaMtcTable, run_clocks),
+    MTC_FIELD(EristaMtcTable, tree_margin),
+    MTC_FIELD(EristaMtcTable, num_burst),
+    MTC_FIELD(EristaMtcTable, num_burst_per_ch),
+    MTC_FIELD(EristaMtcTable, num_trim),
+    MTC_FIELD(EristaMtcTable, num_trim_per_ch),
+    MTC_FIELD(EristaMtcTable, num_mc_regs),
+    MTC_FIELD(EristaMtcTable, num_up_down),
+    MTC_FIELD(EristaMtcTable, vref_num),
+    MTC_FIELD(EristaMtcTable, training_mod_num),
+    MTC_FIELD(EristaMtcTable, dram_timing_num),
+    MTC_FIELD(EristaMtcTable, ptfv_dqsosc_movavg_c0d0u0),
+    MTC_FIELD(EristaMtcTable, ptfv_dqsosc_movavg_c0d0u1),
+    MTC_FIELD(EristaMtcTable, ptfv_dqsosc_movavg_c0d1u0),
+    MTC_FIELD(EristaMtcTable, ptfv_dqsosc_movavg_c0d1u1),
+    MTC_FIELD(EristaMtcTable, ptfv_dqsosc_movavg_c1d0u0),
+    MTC_FIELD(EristaMtcTable, ptfv_dqsosc_movavg_c1d0u1),
+    MTC_FIELD(EristaMtcTable, ptfv_dqsosc_movavg_c1d1u0),
+    MTC_FIELD(EristaMtcTable, ptfv_dqsosc_movavg_c1d1u1),
+    MTC_FIELD(EristaMtcTable, ptfv_write_samples),
+    MTC_FIELD(EristaMtcTable, ptfv_dvfs_samples),
+    MTC_FIELD(EristaMtcTable, ptfv_movavg_weight),
+    MTC_FIELD(EristaMtcTable, ptfv_config_ctrl),
+    MTC_BLOCK(EristaMtcTable, burst_regs, EristaTimingFields),
+    MTC_FIELD(EristaMtcTable, burst_perch_regs.emc0_mrw10),
+    MTC_FIELD(EristaMtcTable, burst_perch_regs.emc1_mrw10),
+    MTC_FIELD(EristaMtcTable, burst_perch_regs.emc0_mrw11),
+    MTC_FIELD(EristaMtcTable, burst_perch_regs.emc1_mrw11),
+    MTC_FIELD(EristaMtcTable, burst_perch_regs.emc0_mrw12),
+    MTC_FIELD(EristaMtcTable, burst_perch_regs.emc1_mrw12),
+    MTC_FIELD(EristaMtcTable, burst_perch_regs.emc0_mrw13),
+    MTC_FIELD(EristaMtcTable, burst_perch_regs.emc1_mrw13),
+    MTC_BLOCK(EristaMtcTable, shadow_regs_ca_train, EristaTimingFields),
+    MTC_BLOCK(EristaMtcTable, shadow_regs_quse_train, EristaTimingFields),
+    MTC_BLOCK(EristaMtcTable, shadow_regs_rdwr_train, EristaTimingFields),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_long_dqs_rank0_0),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_long_dqs_rank0_1),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_long_dqs_rank0_2),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_long_dqs_rank0_3),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_long_dqs_rank1_0),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_long_dqs_rank1_1),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_long_dqs_rank1_2),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_long_dqs_rank1_3),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte0_0),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte0_1),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte0_2),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte1_0),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte1_1),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte1_2),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte2_0),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte2_1),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte2_2),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte3_0),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte3_1),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte3_2),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte4_0),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte4_1),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte4_2),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte5_0),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte5_1),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte5_2),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte6_0),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte6_1),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte6_2),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte7_0),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte7_1),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank0_byte7_2),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte0_0),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte0_1),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte0_2),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte1_0),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte1_1),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte1_2),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte2_0),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte2_1),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte2_2),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte3_0),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte3_1),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte3_2),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte4_0),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte4_1),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte4_2),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte5_0),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte5_1),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte5_2),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte6_0),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte6_1),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte6_2),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte7_0),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte7_1),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_ddll_short_dq_rank1_byte7_2),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_vref_dqs_0),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_vref_dqs_1),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_vref_dq_0),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ib_vref_dq_1),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_long_dq_rank0_0),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_long_dq_rank0_1),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_long_dq_rank0_2),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_long_dq_rank0_3),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_long_dq_rank0_4),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_long_dq_rank0_5),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_long_dq_rank1_0),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_long_dq_rank1_1),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_long_dq_rank1_2),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_long_dq_rank1_3),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte0_0),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte0_1),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte0_2),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte1_0),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte1_1),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte1_2),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte2_0),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte2_1),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte2_2),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte3_0),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte3_1),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte3_2),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte4_0),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte4_1),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte4_2),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte5_0),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte5_1),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte5_2),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte6_0),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte6_1),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte6_2),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte7_0),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte7_1),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_byte7_2),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_cmd0_0),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_cmd0_1),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_cmd0_2),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_cmd1_0),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_cmd1_1),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_cmd1_2),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_cmd2_0),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_cmd2_1),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_cmd2_2),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_cmd3_0),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_cmd3_1),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank0_cmd3_2),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte0_0),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte0_1),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte0_2),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte1_0),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte1_1),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte1_2),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte2_0),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte2_1),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte2_2),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte3_0),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte3_1),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte3_2),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte4_0),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte4_1),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte4_2),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte5_0),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte5_1),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte5_2),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte6_0),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte6_1),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte6_2),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte7_0),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte7_1),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_ob_ddll_short_dq_rank1_byte7_2),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_quse_ddll_rank0_0),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_quse_ddll_rank0_1),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_quse_ddll_rank0_2),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_quse_ddll_rank0_3),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_quse_ddll_rank1_0),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_quse_ddll_rank1_1),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_quse_ddll_rank1_2),
+    MTC_FIELD(EristaMtcTable, trim_regs.emc_pmacro_quse_ddll_rank1_3),
+    MTC_FIELD(EristaMtcTable, trim_perch_regs.emc0_cmd_brlshft_0),
+    MTC_FIELD(EristaMtcTable, trim_perch_regs.emc1_cmd_brlshft_1),
+    MTC_FIELD(EristaMtcTable, trim_perch_regs.emc0_data_brlshft_0),
+    MTC_FIELD(EristaMtcTable, trim_perch_regs.emc1_data_brlshft_0),
+    MTC_FIELD(EristaMtcTable, trim_perch_regs.emc0_data_brlshft_1),
+    MTC_FIELD(EristaMtcTable, trim_perch_regs.emc1_data_brlshft_1),
+    MTC_FIELD(EristaMtcTable, trim_perch_regs.emc0_quse_brlshft_0),
+    MTC_FIELD(EristaMtcTable, trim_perch_regs.emc1_quse_brlshft_1),
+    MTC_FIELD(EristaMtcTable, trim_perch_regs.emc0_quse_brlshft_2),
+    MTC_FIELD(EristaMtcTable, trim_perch_regs.emc1_quse_brlshft_3),
+    MTC_FIELD(EristaMtcTable, vref_perch_regs.emc0_training_opt_dqs_ib_vref_rank0),
+    MTC_FIELD(EristaMtcTable, vref_perch_regs.emc1_training_opt_dqs_ib_vref_rank0),
+    MTC_FIELD(EristaMtcTable, vref_perch_regs.emc0_training_opt_dqs_ib_vref_rank1),
+    MTC_FIELD(EristaMtcTable, vref_perch_regs.emc1_training_opt_dqs_ib_vref_rank1),
+    MTC_FIELD(EristaMtcTable, dram_timings.t_rp),
+    MTC_FIELD(EristaMtcTable, dram_timings.t_fc_lpddr4),
+    MTC_FIELD(EristaMtcTable, dram_timings.t_rfc),
+    MTC_FIELD(EristaMtcTable, dram_timings.t_pdex),
+    MTC_FIELD(EristaMtcTable, dram_timings.rl),
+    MTC_FIELD(EristaMtcTable, training_mod_regs.emc0_training_rw_offset_ib_byte0),
+    MTC_FIELD(EristaMtcTable, training_mod_regs.emc1_training_rw_offset_ib_byte0),
+    MTC_FIELD(EristaMtcTable, training_mod_regs.emc0_training_rw_offset_ib_byte1),
+    MTC_FIELD(EristaMtcTable, training_mod_regs.emc1_training_rw_offset_ib_byte1),
+    MTC_FIELD(EristaMtcTable, training_mod_regs.emc0_training_rw_offset_ib_byte2),
+    MTC_FIELD(EristaMtcTable, training_mod_regs.emc1_training_rw_offset_ib_byte2),
+    MTC_FIELD(EristaMtcTable, training_mod_regs.emc0_training_rw_offset_ib_byte3),
+    MTC_FIELD(EristaMtcTable, training_mod_regs.emc1_training_rw_offset_ib_byte3),
+    MTC_FIELD(EristaMtcTable, training_mod_regs.emc0_training_rw_offset_ib_misc),
+    MTC_FIELD(EristaMtcTable, training_mod_regs.emc1_training_rw_offset_ib_misc),
+    MTC_FIELD(EristaMtcTable, training_mod_regs.emc0_training_rw_offset_ob_byte0),
+    MTC_FIELD(EristaMtcTable, training_mod_regs.emc1_training_rw_offset_ob_byte0),
+    MTC_FIELD(EristaMtcTable, training_mod_regs.emc0_training_rw_offset_ob_byte1),
+    MTC_FIELD(EristaMtcTable, training_mod_regs.emc1_training_rw_offset_ob_byte1),
+    MTC_FIELD(EristaMtcTable, training_mod_regs.emc0_training_rw_offset_ob_byte2),
+    MTC_FIELD(EristaMtcTable, training_mod_regs.emc1_training_rw_offset_ob_byte2),
+    MTC_FIELD(EristaMtcTable, training_mod_regs.emc0_training_rw_offset_ob_byte3),
+    MTC_FIELD(EristaMtcTable, training_mod_regs.emc1_training_rw_offset_ob_byte3),
+    MTC_FIELD(EristaMtcTable, training_mod_regs.emc0_training_rw_offset_ob_misc),
+    MTC_FIELD(EristaMtcTable, training_mod_regs.emc1_training_rw_offset_ob_misc),
+    MTC_FIELD(EristaMtcTable, save_restore_mod_regs[0]),
+    MTC_FIELD(EristaMtcTable, save_restore_mod_regs[1]),
+    MTC_FIELD(EristaMtcTable, save_restore_mod_regs[2]),
+    MTC_FIELD(EristaMtcTable, save_restore_mod_regs[3]),
+    MTC_FIELD(EristaMtcTable, save_restore_mod_regs[4]),
+    MTC_FIELD(EristaMtcTable, save_restore_mod_regs[5]),
+    MTC_FIELD(EristaMtcTable, save_restore_mod_regs[6]),
+    MTC_FIELD(EristaMtcTable, save_restore_mod_regs[7]),
+    MTC_FIELD(EristaMtcTable, save_restore_mod_regs[8]),
+    MTC_FIELD(EristaMtcTable, save_restore_mod_regs[9]),
+    MTC_FIELD(EristaMtcTable, save_restore_mod_regs[10]),
+    MTC_FIELD(EristaMtcTable, save_restore_mod_regs[11]),
+    MTC_FIELD(EristaMtcTable, burst_mc_regs.mc_emem_arb_cfg),
+    MTC_FIELD(EristaMtcTable, burst_mc_regs.mc_emem_arb_outstanding_req),
+    MTC_FIELD(EristaMtcTable, burst_mc_regs.mc_emem_arb_refpb_hp_ctrl),
+    MTC_FIELD(EristaMtcTable, burst_mc_regs.mc_emem_arb_refpb_bank_ctrl),
+    MTC_FIELD(EristaMtcTable, burst_mc_regs.mc_emem_arb_timing_rcd),
+    MTC_FIELD(EristaMtcTable, burst_mc_regs.mc_emem_arb_timing_rp),
+    MTC_FIELD(EristaMtcTable, burst_mc_regs.mc_emem_arb_timing_rc),
+    MTC_FIELD(EristaMtcTable, burst_mc_regs.mc_emem_arb_timing_ras),
+    MTC_FIELD(EristaMtcTable, burst_mc_regs.mc_emem_arb_timing_faw),
+    MTC_FIELD(EristaMtcTable, burst_mc_regs.mc_emem_arb_timing_rrd),
+    MTC_FIELD(EristaMtcTable, burst_mc_regs.mc_emem_arb_timing_rap2pre),
+    MTC_FIELD(EristaMtcTable, burst_mc_regs.mc_emem_arb_timing_wap2pre),
+    MTC_FIELD(EristaMtcTable, burst_mc_regs.mc_emem_arb_timing_r2r),
+    MTC_FIELD(EristaMtcTable, burst_mc_regs.mc_emem_arb_timing_w2w),
+    MTC_FIELD(EristaMtcTable, burst_mc_regs.mc_emem_arb_timing_r2w),
+    MTC_FIELD(EristaMtcTable, burst_mc_regs.mc_emem_arb_timing_ccdmw),
+    MTC_FIELD(EristaMtcTable, burst_mc_regs.mc_emem_arb_timing_w2r),
+    MTC_FIELD(EristaMtcTable, burst_mc_regs.mc_emem_arb_timing_rfcpb),
+    MTC_FIELD(EristaMtcTable, burst_mc_regs.mc_emem_arb_da_turns),
+    MTC_FIELD(EristaMtcTable, burst_mc_regs.mc_emem_arb_da_covers),
+    MTC_FIELD(EristaMtcTable, burst_mc_regs.mc_emem_arb_misc0),
+    MTC_FIELD(EristaMtcTable, burst_mc_regs.mc_emem_arb_misc1),
+    MTC_FIELD(EristaMtcTable, burst_mc_regs.mc_emem_arb_misc2),
+    MTC_FIELD(EristaMtcTable, burst_mc_regs.mc_emem_arb_ring1_throttle),
+    MTC_FIELD(EristaMtcTable, burst_mc_regs.mc_emem_arb_dhyst_ctrl),
+    MTC_FIELD(EristaMtcTable, burst_mc_regs.mc_emem_arb_dhyst_timeout_util_0),
+    MTC_FIELD(EristaMtcTable, burst_mc_regs.mc_emem_arb_dhyst_timeout_util_1),
+    MTC_FIELD(EristaMtcTable, burst_mc_regs.mc_emem_arb_dhyst_timeout_util_2),
+    MTC_FIELD(EristaMtcTable, burst_mc_regs.mc_emem_arb_dhyst_timeout_util_3),
+    MTC_FIELD(EristaMtcTable, burst_mc_regs.mc_emem_arb_dhyst_timeout_util_4),
+    MTC_FIELD(EristaMtcTable, burst_mc_regs.mc_emem_arb_dhyst_timeout_util_5),
+    MTC_FIELD(EristaMtcTable, burst_mc_regs.mc_emem_arb_dhyst_timeout_util_6),
+    MTC_FIELD(EristaMtcTable, burst_mc_regs.mc_emem_arb_dhyst_timeout_util_7),
+    MTC_FIELD(EristaMtcTable, la_scale_regs.mc_mll_mpcorer_ptsa_rate),
+    MTC_FIELD(EristaMtcTable, la_scale_regs.mc_ftop_ptsa_rate),
+    MTC_FIELD(EristaMtcTable, la_scale_regs.mc_ptsa_grant_decrement),
+    MTC_FIELD(EristaMtcTable, la_scale_regs.mc_latency_allowance_xusb_0),
+    MTC_FIELD(EristaMtcTable, la_scale_regs.mc_latency_allowance_xusb_1),
+    MTC_FIELD(EristaMtcTable, la_scale_regs.mc_latency_allowance_tsec_0),
+    MTC_FIELD(EristaMtcTable, la_scale_regs.mc_latency_allowance_sdmmca_0),
+    MTC_FIELD(EristaMtcTable, la_scale_regs.mc_latency_allowance_sdmmcaa_0),
+    MTC_FIELD(EristaMtcTable, la_scale_regs.mc_latency_allowance_sdmmc_0),
+    MTC_FIELD(EristaMtcTable, la_scale_regs.mc_latency_allowance_sdmmcab_0),
+    MTC_FIELD(EristaMtcTable, la_scale_regs.mc_latency_allowance_ppcs_0),
+    MTC_FIELD(EristaMtcTable, la_scale_regs.mc_latency_allowance_ppcs_1),
+    MTC_FIELD(EristaMtcTable, la_scale_regs.mc_latency_allowance_mpcore_0),
+    MTC_FIELD(EristaMtcTable, la_scale_regs.mc_latency_allowance_hc_0),
+    MTC_FIELD(EristaMtcTable, la_scale_regs.mc_latency_allowance_hc_1),
+    MTC_FIELD(EristaMtcTable, la_scale_regs.mc_latency_allowance_avpc_0),
+    MTC_FIELD(EristaMtcTable, la_scale_regs.mc_latency_allowance_gpu_0),
+    MTC_FIELD(EristaMtcTable, la_scale_regs.mc_latency_allowance_gpu2_0),
+    MTC_FIELD(EristaMtcTable, la_scale_regs.mc_latency_allowance_nvenc_0),
+    MTC_FIELD(EristaMtcTable, la_scale_regs.mc_latency_allowance_nvdec_0),
+    MTC_FIELD(EristaMtcTable, la_scale_regs.mc_latency_allowance_vic_0),
+    MTC_FIELD(EristaMtcTable, la_scale_regs.mc_latency_allowance_vi2_0),
+    MTC_FIELD(EristaMtcTable, la_scale_regs.mc_latency_allowance_isp2_0),
+    MTC_FIELD(EristaMtcTable, la_scale_regs.mc_latency_allowance_isp2_1),
+    MTC_FIELD(EristaMtcTable, min_mrs_wait),
+    MTC_FIELD(EristaMtcTable, emc_mrw),
+    MTC_FIELD(EristaMtcTable, emc_mrw2),
+    MTC_FIELD(EristaMtcTable, emc_mrw3),
+    MTC_FIELD(EristaMtcTable, emc_mrw4),
+    MTC_FIELD(EristaMtcTable, emc_mrw9),
+    MTC_FIELD(EristaMtcTable, emc_mrs),
+    MTC_FIELD(EristaMtcTable, emc_emrs),
+    MTC_FIELD(EristaMtcTable, emc_emrs2),
+    MTC_FIELD(EristaMtcTable, emc_auto_cal_config),
+    MTC_FIELD(EristaMtcTable, emc_auto_cal_config2),
+    MTC_FIELD(EristaMtcTable, emc_auto_cal_config3),
+    MTC_FIELD(EristaMtcTable, emc_auto_cal_config4),
+    MTC_FIELD(EristaMtcTable, emc_auto_cal_config5),
+    MTC_FIELD(EristaMtcTable, emc_auto_cal_config6),
+    MTC_FIELD(EristaMtcTable, emc_auto_cal_config7),
+    MTC_FIELD(EristaMtcTable, emc_auto_cal_config8),
+    MTC_FIELD(EristaMtcTable, emc_cfg_2),
+    MTC_FIELD(EristaMtcTable, emc_sel_dpd_ctrl),
+    MTC_FIELD(EristaMtcTable, emc_fdpd_ctrl_cmd_no_ramp),
+    MTC_FIELD(EristaMtcTable, dll_clk_src),
+    MTC_FIELD(EristaMtcTable, clk_out_enb_x_0_clk_enb_emc_dll),
+    MTC_FIELD(EristaMtcTable, latency),
+};
+
+#undef MTC_FIELD
+#undef MTC_BLOCK
+
+// Fields must be contiguous and cover the whole struct
+constexpr bool CoversStruct(const Field* fields, size_t count, size_t struct_size) {
+    size_t offset = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (fields[i].offset != offset)
+            return false;
+        if (fields[i].sub && !CoversStruct(fields[i].sub, fields[i].sub_count, fields[i].size))
+            return false;
+        offset += fields[i].size;
+    }
+    return offset == struct_size;
+}
+
+static_assert(CoversStruct(MarikoTimingFields,   std::size(MarikoTimingFields),   sizeof(MarikoTiming)));
+static_assert(CoversStruct(EristaTimingFields,   std::size(EristaTimingFields),   sizeof(EristaTiming)));
+static_assert(CoversStruct(MarikoMtcTableFields, std::size(MarikoMtcTableFields), sizeof(MarikoMtcTable)));
+static_assert(CoversStruct(EristaMtcTableFields, std::size(EristaMtcTableFields), sizeof(EristaMtcTable)));
+
+}
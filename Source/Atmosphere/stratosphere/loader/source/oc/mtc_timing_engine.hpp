@@ -0,0 +1,289 @@
+/*
+ * Copyright (C) Switch-OC-Suite
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms and conditions of the GNU General Public License,
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "oc_common.hpp"
+
+/* constexpr MTC timing engine.
+ *
+ * Same formulas as mtc_timing_value.hpp, but as a function of (EMC kHz, presets)
+ * instead of globals evaluated from C at startup. Default presets at common
+ * frequencies are resolved at compile time, anything else is computed on demand.
+ */
+namespace ams::ldr::oc::timing {
+
+struct Presets {
+    u32 one, two, three, four, five, six, seven;
+
+    constexpr bool IsDefault() const {
+        return !(one | two | three | four | five | six | seven);
+    }
+
+    static Presets FromCustomize(const CustomizeTable& t) {
+        return {
+            t.ramTimingPresetOne, t.ramTimingPresetTwo, t.ramTimingPresetThree, t.ramTimingPresetFour,
+            t.ramTimingPresetFive, t.ramTimingPresetSix, t.ramTimingPresetSeven,
+        };
+    }
+};
+
+// Register values written by MemMtcTable{Auto,Custom}Adjust, named after MtcTable fields
+struct EmcTiming {
+    u32 emc_rc;
+    u32 emc_rfc;
+    u32 emc_rfcpb;
+    u32 emc_ras;
+    u32 emc_rp;
+    u32 emc_r2w;
+    u32 emc_w2r;
+    u32 emc_r2p;
+    u32 emc_w2p;
+    u32 emc_trtm;   // Mariko only
+    u32 emc_twtm;   // Mariko only
+    u32 emc_tratm;  // Mariko only
+    u32 emc_twatm;  // Mariko only
+    u32 emc_rd_rcd;
+    u32 emc_wr_rcd;
+    u32 emc_rrd;
+    u32 emc_refresh;
+    u32 emc_pre_refresh_req_cnt;
+    u32 emc_pdex2wr;
+    u32 emc_pdex2rd;
+    u32 emc_pchg2pden;
+    u32 emc_act2pden;
+    u32 emc_ar2pden;
+    u32 emc_rw2pden;
+    u32 emc_cke2pden;
+    u32 emc_pdex2cke;
+    u32 emc_pdex2mrr;
+    u32 emc_txsr;
+    u32 emc_tcke;
+    u32 emc_tckesr;
+    u32 emc_tpd;
+    u32 emc_tfaw;
+    u32 emc_trpab;
+    u32 emc_tclkstable;
+    u32 emc_tclkstop;
+    u32 emc_trefbw;
+
+    u32 mc_emem_arb_cfg; // Mariko only
+    u32 mc_emem_arb_timing_rcd;
+    u32 mc_emem_arb_timing_rp;
+    u32 mc_emem_arb_timing_rc;
+    u32 mc_emem_arb_timing_ras;
+    u32 mc_emem_arb_timing_faw;
+    u32 mc_emem_arb_timing_rrd;
+    u32 mc_emem_arb_timing_rap2pre;
+    u32 mc_emem_arb_timing_wap2pre;
+    u32 mc_emem_arb_timing_r2w;
+    u32 mc_emem_arb_timing_w2r;
+    u32 mc_emem_arb_timing_rfcpb;
+
+    // dram_timings, in ns
+    u32 t_rp;
+    u32 t_rfc;
+
+    constexpr bool operator==(const EmcTiming&) const = default;
+};
+
+namespace impl {
+    // std::ceil / std::floor are not constexpr before C++23
+    constexpr double Ceil(double x) {
+        double i = static_cast<double>(static_cast<int64_t>(x));
+        return i < x ? i + 1 : i;
+    }
+
+    constexpr double Floor(double x) {
+        double i = static_cast<double>(static_cast<int64_t>(x));
+        return i > x ? i - 1 : i;
+    }
+
+    // Preset One
+    constexpr u32 tRCD_values[] = {18, 17, 16, 15, 14, 13};
+    constexpr u32 tRP_values[]  = {18, 17, 16, 15, 14, 13};
+    constexpr u32 tRAS_values[] = {42, 39, 36, 34, 32, 30};
+    // Preset Two
+    constexpr double tRRD_values[] = {10, 7.5, 6, 4, 3};
+    constexpr double tFAW_values[] = {40, 30, 24, 16, 12};
+    // Preset Three
+    constexpr u32 tWR_values[]     = {18, 15, 15, 12, 12, 8};
+    constexpr double tRTP_values[] = {7.5, 7.5, 6, 6, 4, 4};
+    // Preset Four
+    constexpr u32 tRFC_values[] = {140, 120, 100, 80, 70, 60};
+    // Preset Five
+    constexpr u32 tWTR_values[] = {10, 8, 6, 4, 2, 1};
+    // Preset Six
+    constexpr u32 tREFpb_values[] = {488, 976, 1952, 3256, 9999};
+
+    constexpr u32    BL          = 16;
+    constexpr double tDQSCK_max  = 3.5;
+    constexpr double tWPRE       = 1.8;
+    constexpr double tRPST       = 0.4;
+    constexpr double tDQSS_max   = 1.25;
+    constexpr double tDQS2DQ_max = 0.8;
+    constexpr double tXP         = 10;
+    constexpr double tCMDCKE     = 1.75;
+    constexpr u32    tMRWCKEL    = 14;
+    constexpr double tCKELCS     = 5;
+    constexpr double tCSCKEH     = 1.75;
+    constexpr double tCKE        = 7.5;
+    constexpr u32    tSR         = 15;
+    constexpr double tCKCKEH     = 1.75;
+    constexpr u32    numOfRows   = 65536;
+
+    constexpr u32 MC_ARB_DIV = 4;
+    constexpr u32 MC_ARB_SFA = 2;
+}
+
+template<bool isMariko>
+constexpr EmcTiming Calculate(u32 emc_khz, const Presets& p) {
+    using namespace impl;
+
+    // Timings in ns, see mtc_timing_value.hpp for descriptions
+    const u32 tRFCpb    = !p.four  ? 140 : tRFC_values[p.four - 1];
+    const u32 tRFCab    = !p.four  ? 280 : 2 * tRFCpb;
+    const u32 tRAS      = !p.one   ? 42  : tRAS_values[p.one - 1];
+    const u32 tRPpb     = !p.one   ? 18  : tRP_values[p.one - 1];
+    const u32 tRPab     = !p.one   ? 21  : tRPpb + 3;
+    const u32 tRC       = tRPpb + tRAS;
+    const u32 tWTR      = !p.five  ? 10  : tWTR_values[p.five - 1];
+    const double tRTP   = !p.three ? 7.5 : tRTP_values[p.three - 1];
+    const u32 tWR       = !p.three ? 18  : tWR_values[p.three - 1];
+    const u32 tRCD      = !p.one   ? 18  : tRCD_values[p.one - 1];
+    const double tRRD   = !p.two   ? 10. : tRRD_values[p.two - 1];
+    const u32 tREFpb    = !p.six   ? 488 : tREFpb_values[p.six - 1];
+    const double tXSR   = tRFCab + 7.5;
+    const u32 tFAW      = !p.two   ? 40  : tFAW_values[p.two - 1];
+
+    const double tCK_avg = 1000'000. / emc_khz;
+    const u32 WL = 14 - 2 * p.seven;
+    const u32 RL = 32 - 4 * p.seven;
+
+    auto cycles = [tCK_avg](double ns) { return u32(Ceil(ns / tCK_avg)); };
+
+    const u32 R2W = Ceil(RL + Ceil(tDQSCK_max / tCK_avg) + BL / 2 - WL + tWPRE + Floor(tRPST)) + (isMariko ? 0 : 6);
+    const u32 W2R = WL + BL / 2 + 1 + Ceil(tWTR / tCK_avg) - (isMariko ? 0 : 6);
+    const u32 WTP = WL + BL / 2 + 1 + Ceil(tWR / tCK_avg) - (isMariko ? 0 : 8);
+    const u32 RTM = RL + BL / 2 + Ceil(tDQSCK_max / tCK_avg) + Floor(tRPST) + Ceil(7.5 / tCK_avg);
+    const u32 WTM = WL + 1 + BL / 2 + Ceil(7.5 / tCK_avg);
+    const u32 RATM = RTM + Ceil(tRTP / tCK_avg) - 8;
+    const u32 WATM = WTM + Ceil(tWR / tCK_avg);
+    const u32 REFRESH = std::min(u32(65472), u32(Ceil(double(tREFpb) * emc_khz / numOfRows * 1.048 / 2 - 64))) / 4 * 4;
+    const u32 REFBW = std::min(u32(65536), REFRESH + 64);
+    const u32 WTPDEN = WTP + 1 + Ceil(tDQSS_max / tCK_avg) + Ceil(tDQS2DQ_max / tCK_avg) + 6;
+    const double tPDEX2MRR = tXP + (tRCD + 3 * tCK_avg);
+
+    EmcTiming t {};
+    t.emc_rc                  = cycles(tRC);
+    t.emc_rfc                 = cycles(tRFCab);
+    t.emc_rfcpb               = cycles(tRFCpb);
+    t.emc_ras                 = cycles(tRAS);
+    t.emc_rp                  = cycles(tRPpb);
+    t.emc_r2w                 = R2W;
+    t.emc_w2r                 = W2R;
+    t.emc_r2p                 = cycles(tRTP);
+    t.emc_w2p                 = WTP;
+    if constexpr (isMariko) {
+        t.emc_trtm            = RTM;
+        t.emc_twtm            = WTM;
+        t.emc_tratm           = RATM;
+        t.emc_twatm           = WATM;
+    }
+    t.emc_rd_rcd              = cycles(tRCD);
+    t.emc_wr_rcd              = cycles(tRCD);
+    t.emc_rrd                 = cycles(tRRD);
+    t.emc_refresh             = REFRESH;
+    t.emc_pre_refresh_req_cnt = REFRESH / 4;
+    t.emc_pdex2wr             = cycles(tXP);
+    t.emc_pdex2rd             = cycles(tXP);
+    t.emc_pchg2pden           = cycles(tCMDCKE);
+    t.emc_act2pden            = cycles(tMRWCKEL);
+    t.emc_ar2pden             = cycles(tCMDCKE);
+    t.emc_rw2pden             = WTPDEN;
+    t.emc_cke2pden            = cycles(tCKELCS);
+    t.emc_pdex2cke            = cycles(tCSCKEH);
+    t.emc_pdex2mrr            = cycles(tPDEX2MRR);
+    t.emc_txsr                = std::min(cycles(tXSR), u32(0x3fe));
+    t.emc_tcke                = cycles(tCKE) + (isMariko ? 1 : 0);
+    t.emc_tckesr              = cycles(tSR);
+    t.emc_tpd                 = cycles(tCKE);
+    t.emc_tfaw                = cycles(tFAW);
+    t.emc_trpab               = cycles(tRPab);
+    t.emc_tclkstable          = cycles(tCKCKEH);
+    t.emc_tclkstop            = cycles(tCKE) + 8;
+    t.emc_trefbw              = REFBW;
+
+    if constexpr (isMariko)
+        t.mc_emem_arb_cfg     = u32(emc_khz / (33.3 * 1000) / MC_ARB_DIV);
+    t.mc_emem_arb_timing_rcd     = t.emc_rd_rcd / MC_ARB_DIV - 2;
+    t.mc_emem_arb_timing_rp      = t.emc_rp / MC_ARB_DIV - 1 + MC_ARB_SFA;
+    t.mc_emem_arb_timing_rc      = t.emc_rc / MC_ARB_DIV - 1;
+    t.mc_emem_arb_timing_ras     = t.emc_ras / MC_ARB_DIV - 2;
+    t.mc_emem_arb_timing_faw     = t.emc_tfaw / MC_ARB_DIV - 1;
+    t.mc_emem_arb_timing_rrd     = t.emc_rrd / MC_ARB_DIV - 1;
+    t.mc_emem_arb_timing_rap2pre = t.emc_r2p / MC_ARB_DIV;
+    t.mc_emem_arb_timing_wap2pre = WTP / MC_ARB_DIV;
+    t.mc_emem_arb_timing_r2w     = R2W / MC_ARB_DIV - 1 + MC_ARB_SFA;
+    t.mc_emem_arb_timing_w2r     = W2R / MC_ARB_DIV - 1 + MC_ARB_SFA;
+    t.mc_emem_arb_timing_rfcpb   = t.emc_rfcpb / MC_ARB_DIV;
+
+    t.t_rp  = tRPpb;
+    t.t_rfc = tRFCab;
+
+    return t;
+}
+
+template<bool isMariko, size_t N>
+struct PrecomputedTimings {
+    u32       khz[N];
+    EmcTiming timing[N];
+
+    constexpr PrecomputedTimings(const u32 (&list)[N]) : khz(), timing() {
+        for (size_t i = 0; i < N; i++) {
+            khz[i] = list[i];
+            timing[i] = Calculate<isMariko>(list[i], Presets {});
+        }
+    }
+
+    const EmcTiming* Find(u32 emc_khz) const {
+        for (size_t i = 0; i < N; i++) {
+            if (khz[i] == emc_khz)
+                return &timing[i];
+        }
+        return nullptr;
+    }
+};
+
+// Common max EMC clocks, default presets
+constexpr u32 EristaCommonKhz[] = { 1600'000, 1728'000, 1795'200, 1862'400, 1996'800, 2131'200 };
+constexpr u32 MarikoCommonKhz[] = { 1600'000, 1862'400, 1996'800, 2131'200, 2265'600, 2400'000, 2534'400, 2665'600, 2800'000 };
+
+constexpr PrecomputedTimings<false, std::size(EristaCommonKhz)> EristaPrecomputed(EristaCommonKhz);
+constexpr PrecomputedTimings<true,  std::size(MarikoCommonKhz)> MarikoPrecomputed(MarikoCommonKhz);
+
+template<bool isMariko>
+EmcTiming Get(u32 emc_khz, const Presets& p) {
+    if (p.IsDefault()) {
+        const EmcTiming* t = isMariko ? MarikoPrecomputed.Find(emc_khz) : EristaPrecomputed.Find(emc_khz);
+        if (t)
+            return *t;
+    }
+
+    return Calculate<isMariko>(emc_khz, p);
+}
+
+}
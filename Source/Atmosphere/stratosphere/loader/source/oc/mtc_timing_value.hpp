@@ -14,6 +14,8 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  *
  * from GCC preprocessor output
+ *
+ * Superseded by mtc_timing_engine.hpp, kept as the reference for oc_test.
  */
 
 #pragma once
@@ -25,6 +25,8 @@
     #include "oc_test.hpp"
 #endif
 
+#include "oc_simd.hpp"
+#include "patch_cache.hpp"
 #include "customize.hpp"
 
 #define PATCH_OFFSET(offset, value) \
@@ -51,6 +53,11 @@ namespace ams::ldr {
 }
 
 namespace ams::ldr::oc {
+    #ifndef ATMOSPHERE_IS_STRATOSPHERE
+    // Host only: observe patched counts, called from PatcherEntry::CheckResult
+    inline void (*PatcherResultHook)(const char* description, size_t patched_count) = nullptr;
+    #endif
+
     template<typename Pointer>
     struct PatcherEntry {
         using patternFn = bool(*)(Pointer* ptr);
@@ -61,6 +68,11 @@ namespace ams::ldr::oc {
         size_t      maximum_patched_count = 0;
         patternFn   pattern_search_fn = nullptr;
         Pointer     value_search;
+        /* Bits of value_search that are not compared. With pattern_search_fn set,
+         * a nonzero value turns (value_search, value_ignored_bits) into a prefilter
+         * for the scanner, which must accept every word pattern_search_fn accepts.
+         */
+        Pointer     value_ignored_bits {};
 
         size_t      patched_count = 0;
 
@@ -72,15 +84,15 @@ namespace ams::ldr::oc {
             return res;
         }
 
-        Result SearchAndApply(Pointer* ptr) {
-            bool searchOk = false;
-            if (pattern_search_fn) {
-                if (pattern_search_fn(ptr)) searchOk = true;
-            } else {
-                if (value_search == *(ptr)) searchOk = true;
-            }
+        bool Search(Pointer* ptr) {
+            if (pattern_search_fn)
+                return pattern_search_fn(ptr);
+
+            return !((value_search ^ *(ptr)) & ~value_ignored_bits);
+        }
 
-            if (searchOk)
+        Result SearchAndApply(Pointer* ptr) {
+            if (Search(ptr))
                 return Apply(ptr);
 
             R_THROW(ldr::ResultUnsuccessfulPatcher());
@@ -88,6 +100,8 @@ namespace ams::ldr::oc {
 
         Result CheckResult() {
             #ifndef ATMOSPHERE_IS_STRATOSPHERE
+            if (PatcherResultHook)
+                PatcherResultHook(description, patched_count);
             R_UNLESS(patched_count > 0, ldr::ResultUnsuccessfulPatcher());
             #endif
 
@@ -97,4 +111,251 @@ namespace ams::ldr::oc {
             R_SUCCEED();
         }
     };
+
+    enum class PatcherScanMode {
+        Auto,   // Vector unless some predicate entry has no prefilter
+        Vector, // SIMD needle prefilter, then entries in declaration order
+        Word,   // Hashed value lookup per word
+        Linear, // Every entry at every word
+    };
+
+    #ifndef ATMOSPHERE_IS_STRATOSPHERE
+    // Host only: force a scan engine for benchmarking and differential tests
+    inline PatcherScanMode PatcherScanModeOverride = PatcherScanMode::Auto;
+    #endif
+
+    /* Single-pass matcher for a PatcherEntry<u32> set.
+     *
+     * Value patterns are precompiled into an open-addressing hash table mapping
+     * the searched word to a bitmask of entries, and predicate patterns are kept
+     * in a separate mask evaluated per word. Candidates are tried in declaration
+     * order, first success wins, so results match the original nested loop.
+     *
+     * If every entry can be expressed as a (value, ignored bits) needle, words are
+     * first filtered in blocks by simd::WordMatcher, see PatcherEntry::value_ignored_bits.
+     */
+    template<size_t N>
+    class PatcherScanner {
+        static_assert(N > 0 && N <= 32, "Entry mask is limited to 32 patchers");
+
+        static constexpr u32 SlotShift = 6;
+        static constexpr u32 SlotCount = 1u << SlotShift;
+        static_assert(SlotCount >= N * 2);
+
+        struct Slot {
+            u32 value;
+            u32 mask; // 0 = empty
+        };
+
+        PatcherEntry<u32>* entries;
+        uintptr_t base = 0;
+        Slot slots[SlotCount] = {};
+        u32  word_mask = 0;     // Entries not in the hash table, checked per word
+        u32  unfiltered = 0;    // Predicate entries without needle prefilter
+        simd::WordMatcher matcher;
+
+        static constexpr u32 Hash(u32 value) {
+            return (value * 0x9E3779B1u) >> (32 - SlotShift);
+        }
+
+        u32 LookupValue(u32 value) const {
+            for (u32 i = Hash(value); ; i = (i + 1) & (SlotCount - 1)) {
+                const Slot& slot = slots[i];
+                if (!slot.mask)
+                    return 0;
+                if (slot.value == value)
+                    return slot.mask;
+            }
+        }
+
+        void InsertValue(u32 value, u32 bit) {
+            for (u32 i = Hash(value); ; i = (i + 1) & (SlotCount - 1)) {
+                Slot& slot = slots[i];
+                if (!slot.mask || slot.value == value) {
+                    slot.value = value;
+                    slot.mask |= bit;
+                    return;
+                }
+            }
+        }
+
+        bool ApplyAt(u32 index, u32* ptr32) {
+            if (R_FAILED(entries[index].SearchAndApply(ptr32)))
+                return false;
+
+            #ifndef ATMOSPHERE_IS_STRATOSPHERE
+            if (PatchCacheRecorder)
+                PatchCacheRecorder->Record(index, reinterpret_cast<uintptr_t>(ptr32) - base);
+            #endif
+            return true;
+        }
+
+        bool TryApply(u32* ptr32, u32 candidates) {
+            while (candidates) {
+                u32 index = __builtin_ctz(candidates);
+                if (ApplyAt(index, ptr32))
+                    return true;
+                candidates &= candidates - 1;
+            }
+            return false;
+        }
+
+        static constexpr u32 AllEntries = N == 32 ? UINT32_MAX : (1u << N) - 1;
+
+    public:
+        PatcherScanner(PatcherEntry<u32> (&patches)[N]) : entries(patches) {
+            for (u32 i = 0; i < N; i++) {
+                const auto& e = entries[i];
+                const u32 bit = 1u << i;
+
+                if (e.pattern_search_fn || e.value_ignored_bits)
+                    word_mask |= bit;
+                else
+                    InsertValue(e.value_search, bit);
+
+                if (e.pattern_search_fn && !e.value_ignored_bits)
+                    unfiltered |= bit;
+                else
+                    matcher.Add(e.value_search, ~e.value_ignored_bits);
+            }
+        }
+
+        PatcherScanMode DefaultMode() const {
+            return unfiltered ? PatcherScanMode::Word : PatcherScanMode::Vector;
+        }
+
+        /* Replay offsets from a patch cache slot, see patch_cache.hpp.
+         * All cached words are verified before the first write, so a stale slot
+         * leaves the module untouched and begin is returned for a full scan.
+         *
+         * A patcher can still fail after its pattern matched. Records are in scan
+         * order and the ones before it were applied like the full scan would, so
+         * the slot is invalidated and the offset of the failed record is returned
+         * for the full scan to resume there, instead of scanning patched words again.
+         * Returns last + sizeof(u32) when every record applied.
+         */
+        uintptr_t ApplyCached(uintptr_t begin, uintptr_t last, const volatile PatchCacheSlot* slot) {
+            if (!slot)
+                return begin;
+
+            const u32 count = slot->record_count;
+            if (!count || count > PatchCacheRecordLimit)
+                return begin;
+
+            for (u32 i = 0; i < count; i++) {
+                const u32 index  = slot->records[i].entry;
+                const u32 offset = slot->records[i].offset;
+                if (index >= N || offset % sizeof(u32) || offset > last - begin)
+                    return begin;
+                if (i && offset <= slot->records[i - 1].offset)
+                    return begin;
+
+                if (!entries[index].Search(reinterpret_cast<u32 *>(begin + offset)))
+                    return begin;
+            }
+
+            base = begin;
+            for (u32 i = 0; i < count; i++) {
+                const u32 index  = slot->records[i].entry;
+                const u32 offset = slot->records[i].offset;
+                if (!ApplyAt(index, reinterpret_cast<u32 *>(begin + offset))) {
+                    LOGGING("Cached %s failed at 0x%x, scanning from there", entries[index].description, offset);
+                    InvalidatePatchCache(slot);
+                    return begin + offset;
+                }
+            }
+
+            #ifndef ATMOSPHERE_IS_STRATOSPHERE
+            PatchCacheHits++;
+            #endif
+            return last + sizeof(u32);
+        }
+
+        // Cached offsets if the slot is usable, full scan from where the cache stopped otherwise
+        void Scan(uintptr_t begin, uintptr_t last, const volatile PatchCacheSlot* slot) {
+            const uintptr_t resume = ApplyCached(begin, last, slot);
+            if (resume > last)
+                return;
+
+            ScanFrom(begin, resume, last);
+        }
+
+        // Scan words in [from, last], all aligned to sizeof(u32). begin is the module start
+        void ScanFrom(uintptr_t begin, uintptr_t from, uintptr_t last) {
+            base = begin;
+            PatcherScanMode mode = DefaultMode();
+            #ifndef ATMOSPHERE_IS_STRATOSPHERE
+            if (PatchCacheRecorder)
+                PatchCacheRecorder->entry_count = N;
+            if (PatcherScanModeOverride != PatcherScanMode::Auto)
+                mode = PatcherScanModeOverride;
+            if (mode == PatcherScanMode::Vector && unfiltered)
+                mode = PatcherScanMode::Word;
+            #endif
+
+            switch (mode) {
+                case PatcherScanMode::Vector:
+                    return ScanVector(from, last);
+                case PatcherScanMode::Word:
+                    return ScanWord(from, last);
+                default:
+                    return ScanLinear(from, last);
+            }
+        }
+
+        // Scan words in [begin, last], both aligned to sizeof(u32)
+        void Scan(uintptr_t begin, uintptr_t last) {
+            ScanFrom(begin, begin, last);
+        }
+
+        void ScanVector(uintptr_t begin, uintptr_t last) {
+            constexpr size_t lanes = simd::WordMatcher::Lanes;
+            u32* ptr = reinterpret_cast<u32 *>(begin);
+            u32* end = reinterpret_cast<u32 *>(last) + 1;
+
+            while (static_cast<size_t>(end - ptr) >= lanes) {
+                u32* next = ptr + lanes;
+                for (u32 hit = matcher.MatchBlock(ptr); hit; hit &= hit - 1) {
+                    u32 lane = __builtin_ctz(hit);
+                    // Patchers may write ahead, rescan the words after a patched one
+                    if (TryApply(ptr + lane, AllEntries)) {
+                        next = ptr + lane + 1;
+                        break;
+                    }
+                }
+                ptr = next;
+            }
+
+            for (; ptr < end; ptr++) {
+                if (matcher.MatchWord(*ptr))
+                    TryApply(ptr, AllEntries);
+            }
+        }
+
+        void ScanWord(uintptr_t begin, uintptr_t last) {
+            for (uintptr_t ptr = begin; ptr <= last; ptr += sizeof(u32)) {
+                u32* ptr32 = reinterpret_cast<u32 *>(ptr);
+                u32 candidates = LookupValue(*ptr32);
+
+                for (u32 m = word_mask; m; m &= m - 1) {
+                    u32 index = __builtin_ctz(m);
+                    if (entries[index].Search(ptr32))
+                        candidates |= 1u << index;
+                }
+
+                if (candidates)
+                    TryApply(ptr32, candidates);
+            }
+        }
+
+        void ScanLinear(uintptr_t begin, uintptr_t last) {
+            for (uintptr_t ptr = begin; ptr <= last; ptr += sizeof(u32)) {
+                u32* ptr32 = reinterpret_cast<u32 *>(ptr);
+                for (u32 i = 0; i < N; i++) {
+                    if (ApplyAt(i, ptr32))
+                        break;
+                }
+            }
+        }
+    };
 }
@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) Switch-OC-Suite
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms and conditions of the GNU General Public License,
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+/* Erista EMC OC ladder: intermediate steps between 1600 MHz and EmcMaxClock.
+ * Header only without ams/libnx types: pcv::erista::MemFreqMtcTable generates the
+ * tables, sys-clk lists the same steps in its MEM frequency table.
+ */
+namespace emc_oc_ladder {
+
+    constexpr uint32_t StepsKhz[] = { 1728'000, 1795'200, 1862'400, 1996'800, 2131'200 };
+
+    /* Stock tables below 204 MHz (102, 68, 40.8 MHz) are never requested by HOS,
+     * their slots are reused, so at most Slots tables (max included) are generated.
+     */
+    constexpr size_t Slots = 3;
+
+    /* Fills ascending OC steps ending with max_khz, returns the step count.
+     * Intermediate tables are copies of the 1600 MHz one and only get their own timings
+     * when they are auto adjusted (AUTO_ADJ_ALL), otherwise only max_khz is listed.
+     */
+    constexpr size_t Get(uint32_t max_khz, bool auto_adjust, uint32_t (&out)[Slots]) {
+        size_t end = 0;
+        while (auto_adjust && end < std::size(StepsKhz) && StepsKhz[end] < max_khz)
+            end++;
+        size_t begin = end > Slots - 1 ? end - (Slots - 1) : 0;
+
+        size_t count = 0;
+        for (size_t i = begin; i < end; i++)
+            out[count++] = StepsKhz[i];
+        out[count++] = max_khz;
+        return count;
+    }
+
+}
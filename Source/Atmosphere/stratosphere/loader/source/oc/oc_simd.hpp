@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) Switch-OC-Suite
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms and conditions of the GNU General Public License,
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#if defined(OC_SIMD_DISABLE)
+    #define OC_SIMD_SCALAR
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    #include <arm_neon.h>
+    #define OC_SIMD_NEON
+#elif defined(__AVX2__)
+    #include <immintrin.h>
+    #define OC_SIMD_AVX2
+#elif defined(__SSE2__)
+    #include <emmintrin.h>
+    #define OC_SIMD_SSE2
+#else
+    #define OC_SIMD_SCALAR
+#endif
+
+namespace ams::ldr::oc::simd {
+
+/* Compares a block of words against every needle at once.
+ * A needle matches if ((word ^ value) & care) == 0, care being the bits that matter.
+ */
+class WordMatcher {
+    public:
+        #if defined(OC_SIMD_NEON)
+        static constexpr size_t Lanes = 8; // 2 x uint32x4_t
+        static constexpr const char* Name = "NEON";
+        #elif defined(OC_SIMD_AVX2)
+        static constexpr size_t Lanes = 8;
+        static constexpr const char* Name = "AVX2";
+        #elif defined(OC_SIMD_SSE2)
+        static constexpr size_t Lanes = 8; // 2 x __m128i
+        static constexpr const char* Name = "SSE2";
+        #else
+        static constexpr size_t Lanes = 4;
+        static constexpr const char* Name = "Scalar";
+        #endif
+
+        static constexpr size_t NeedleLimit = 32;
+
+    private:
+        u32    values[NeedleLimit];
+        u32    cares[NeedleLimit];
+        size_t count = 0;
+
+    public:
+        size_t Count() const { return count; }
+
+        void Add(u32 value, u32 care) {
+            value &= care;
+            for (size_t i = 0; i < count; i++) {
+                if (values[i] == value && cares[i] == care)
+                    return;
+            }
+
+            if (count >= NeedleLimit)
+                CRASH("Too many needles");
+
+            values[count] = value;
+            cares[count]  = care;
+            count++;
+        }
+
+        bool MatchWord(u32 word) const {
+            for (size_t i = 0; i < count; i++) {
+                if (!((word ^ values[i]) & cares[i]))
+                    return true;
+            }
+            return false;
+        }
+
+        // Bit n set if ptr[n] matches any needle, n < Lanes
+        u32 MatchBlock(const u32* ptr) const {
+        #if defined(OC_SIMD_NEON)
+            uint32x4_t lo = vld1q_u32(ptr);
+            uint32x4_t hi = vld1q_u32(ptr + 4);
+            uint32x4_t hit_lo = vdupq_n_u32(0);
+            uint32x4_t hit_hi = vdupq_n_u32(0);
+            for (size_t i = 0; i < count; i++) {
+                uint32x4_t v = vdupq_n_u32(values[i]);
+                uint32x4_t c = vdupq_n_u32(cares[i]);
+                hit_lo = vorrq_u32(hit_lo, vceqq_u32(vandq_u32(lo, c), v));
+                hit_hi = vorrq_u32(hit_hi, vceqq_u32(vandq_u32(hi, c), v));
+            }
+
+            if (!vmaxvq_u32(vorrq_u32(hit_lo, hit_hi)))
+                return 0;
+
+            const uint32x4_t bits = { 1, 2, 4, 8 };
+            return vaddvq_u32(vandq_u32(hit_lo, bits)) | (vaddvq_u32(vandq_u32(hit_hi, bits)) << 4);
+        #elif defined(OC_SIMD_AVX2)
+            __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ptr));
+            __m256i hit  = _mm256_setzero_si256();
+            for (size_t i = 0; i < count; i++) {
+                __m256i v = _mm256_set1_epi32(static_cast<int>(values[i]));
+                __m256i c = _mm256_set1_epi32(static_cast<int>(cares[i]));
+                hit = _mm256_or_si256(hit, _mm256_cmpeq_epi32(_mm256_and_si256(data, c), v));
+            }
+            return static_cast<u32>(_mm256_movemask_ps(_mm256_castsi256_ps(hit)));
+        #elif defined(OC_SIMD_SSE2)
+            __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr));
+            __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr + 4));
+            __m128i hit_lo = _mm_setzero_si128();
+            __m128i hit_hi = _mm_setzero_si128();
+            for (size_t i = 0; i < count; i++) {
+                __m128i v = _mm_set1_epi32(static_cast<int>(values[i]));
+                __m128i c = _mm_set1_epi32(static_cast<int>(cares[i]));
+                hit_lo = _mm_or_si128(hit_lo, _mm_cmpeq_epi32(_mm_and_si128(lo, c), v));
+                hit_hi = _mm_or_si128(hit_hi, _mm_cmpeq_epi32(_mm_and_si128(hi, c), v));
+            }
+            return static_cast<u32>(_mm_movemask_ps(_mm_castsi128_ps(hit_lo)))
+                 | static_cast<u32>(_mm_movemask_ps(_mm_castsi128_ps(hit_hi))) << 4;
+        #else
+            return MatchBlockScalar(ptr);
+        #endif
+        }
+
+        u32 MatchBlockScalar(const u32* ptr) const {
+            u32 hit = 0;
+            for (size_t lane = 0; lane < Lanes; lane++) {
+                if (MatchWord(ptr[lane]))
+                    hit |= 1u << lane;
+            }
+            return hit;
+        }
+};
+
+}
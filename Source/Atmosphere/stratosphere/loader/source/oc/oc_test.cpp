@@ -17,6 +17,20 @@
 #ifndef ATMOSPHERE_IS_STRATOSPHERE
 #include "oc_test.hpp"
 #include "oc_loader.hpp"
+#include "mtc_timing_engine.hpp"
+#include "mtc_table_fields.hpp"
+#include "mtc_timing_value.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
 void* loadExec(const char* file_loc, size_t* out_size) {
     FILE* fp = fopen(file_loc, "rb");
@@ -80,7 +94,7 @@ Result Test_PcvDvfsTable() {
     assert(GetDvfsTableEntryCount((cvb_entry_t *)(&ams::ldr::oc::C.marikoCpuDvfsTable)) == 21);
     assert(GetDvfsTableEntryCount((cvb_entry_t *)(&ams::ldr::oc::C.marikoCpuDvfsTableSLT)) == 22);
 
-    assert(GetDvfsTableEntryCount((cvb_entry_t *)(&ams::ldr::oc::C.eristaGpuDvfsTable)) == 12);
+    assert(GetDvfsTableEntryCount((cvb_entry_t *)(&ams::ldr::oc::C.eristaGpuDvfsTable)) == 13);
     assert(GetDvfsTableEntryCount((cvb_entry_t *)(&ams::ldr::oc::C.marikoGpuDvfsTable)) == 17);
     assert(GetDvfsTableEntryCount((cvb_entry_t *)(&ams::ldr::oc::C.marikoGpuDvfsTableSLT)) == 17);
     assert(GetDvfsTableEntryCount((cvb_entry_t *)(&ams::ldr::oc::C.marikoGpuDvfsTableHiOPT)) == 17);
@@ -96,12 +110,739 @@ Result Test_PcvDvfsTable() {
         customized_table[i].freq = i + 1;
     }
 
+    // Resolved view must agree with walking C, for every UV mode
+    using ams::ldr::oc::C;
+    auto check_view = [](const ams::ldr::oc::DvfsTableView& view, volatile cvb_entry_t* table) {
+        assert(view.count == GetDvfsTableEntryCount(table));
+        assert(std::memcmp(view.entries, const_cast<cvb_entry_t *>(table), view.count * sizeof(cvb_entry_t)) == 0);
+        assert(std::memcmp(view.Last(), const_cast<cvb_entry_t *>(GetDvfsTableLastEntry(table)), sizeof(cvb_entry_t)) == 0);
+        assert(view.MaxFreq() == GetDvfsTableLastEntry(table)->freq);
+    };
+
+    const u32 cpu_uv = C.marikoCpuUV, gpu_uv = C.marikoGpuUV;
+    for (u32 uv = 0; uv <= 3; uv++) {
+        C.marikoCpuUV = uv;
+        C.marikoGpuUV = uv;
+        const auto& cv = ams::ldr::oc::ResolveCustomizeTable();
+
+        check_view(cv.eristaCpu, C.eristaCpuDvfsTable);
+        check_view(cv.eristaGpu, C.eristaGpuDvfsTable);
+        check_view(cv.marikoCpu, uv ? C.marikoCpuDvfsTableSLT : C.marikoCpuDvfsTable);
+        check_view(cv.marikoGpu, uv == 1 ? C.marikoGpuDvfsTableSLT : uv == 2 ? C.marikoGpuDvfsTableHiOPT : C.marikoGpuDvfsTable);
+    }
+    C.marikoCpuUV = cpu_uv;
+    C.marikoGpuUV = gpu_uv;
+    ams::ldr::oc::ResolveCustomizeTable();
+
+    ams::ldr::oc::DvfsTableView empty = {};
+    assert(!empty.Last() && !empty.MaxFreq());
+
+    R_SUCCEED();
+}
+
+Result Test_SimdWordMatcher() {
+    using namespace ams::ldr::oc;
+
+    simd::WordMatcher matcher;
+    matcher.Add(0x42, UINT32_MAX);
+    matcher.Add(0x52820000, ~0x1Fu);
+    matcher.Add(0x400, ~0xFFu);
+    matcher.Add(0x42, UINT32_MAX); // duplicated
+    assert(matcher.Count() == 3);
+
+    assert(matcher.MatchWord(0x42));
+    assert(!matcher.MatchWord(0x43));
+    assert(matcher.MatchWord(0x5282000B));
+    assert(!matcher.MatchWord(0x5282002B));
+    assert(matcher.MatchWord(0x4CB));
+    assert(!matcher.MatchWord(0x500));
+
+    constexpr size_t words = 4096;
+    u32 buf[words];
+    u32 seed = 0x12345678;
+    for (size_t i = 0; i < words; i++) {
+        seed = seed * 1664525 + 1013904223;
+        switch (seed >> 30) {
+            case 0:  buf[i] = 0x42; break;
+            case 1:  buf[i] = 0x52820000 | (seed & 0x3F); break;
+            case 2:  buf[i] = 0x400 | (seed & 0x1FF); break;
+            default: buf[i] = seed; break;
+        }
+    }
+
+    // Every unaligned start as well
+    constexpr size_t lanes = simd::WordMatcher::Lanes;
+    for (size_t i = 0; i + lanes <= words; i++) {
+        assert(matcher.MatchBlock(buf + i) == matcher.MatchBlockScalar(buf + i));
+    }
+
+    R_SUCCEED();
+}
+
+Result Test_PatcherScanner() {
+    using namespace ams::ldr::oc;
+
+    // Patchers write a marker so that all engines must agree on offsets and order
+    auto markA = [](u32* ptr) -> Result { *ptr = 0xA0000000 | (*ptr & 0xFFFF); R_SUCCEED(); };
+    auto markB = [](u32* ptr) -> Result { *ptr = 0xB0000000 | (*ptr & 0xFFFF); R_SUCCEED(); };
+    // Writes ahead like GpuFreqMaxAsm, the next word must be rescanned
+    auto markAhead = [](u32* ptr) -> Result { *(ptr + 1) = 0x42; *ptr = 0xC0000000; R_SUCCEED(); };
+    auto reject = [](u32* ptr) -> Result { R_THROW(ams::ldr::ResultUnsuccessfulPatcher()); };
+    auto oddFn = [](u32* ptr) { return *ptr < 0x100 && (*ptr & 1); };
+
+    constexpr PatcherScanMode modes[] = { PatcherScanMode::Linear, PatcherScanMode::Word, PatcherScanMode::Vector };
+    constexpr size_t mode_count = sizeof(modes) / sizeof(modes[0]);
+    constexpr size_t words = 4099; // Not a multiple of lanes, exercise the tail
+
+    u32 buf[mode_count][words];
+    for (size_t i = 0; i < words; i++)
+        buf[0][i] = (i * 2654435761u) % 0x1C0;
+    for (size_t m = 1; m < mode_count; m++)
+        std::memcpy(buf[m], buf[0], sizeof(buf[0]));
+
+    for (size_t m = 0; m < mode_count; m++) {
+        PatcherEntry<u32> patches[] = {
+            { "Reject",  reject,    0, nullptr, 0x42 },
+            { "Value A", markA,     0, nullptr, 0x42 },
+            { "Value B", markB,     0, nullptr, 0x17F },
+            { "Odd",     markB,     0, oddFn,   0, 0xFF },
+            { "Value C", markA,     0, nullptr, 0x11 },
+            { "Masked",  markAhead, 0, nullptr, 0x1A0, 0x0F },
+        };
+
+        PatcherScanModeOverride = modes[m];
+        PatcherScanner scanner(patches);
+        scanner.Scan(reinterpret_cast<uintptr_t>(buf[m]), reinterpret_cast<uintptr_t>(&buf[m][words - 1]));
+
+        assert(patches[0].patched_count == 0);
+        assert(patches[1].patched_count > 0);
+        assert(patches[2].patched_count > 0);
+        assert(patches[3].patched_count > 0);
+        // 0x11 is odd, predicate entry comes first
+        assert(patches[4].patched_count == 0);
+        assert(patches[5].patched_count > 0);
+    }
+    PatcherScanModeOverride = PatcherScanMode::Auto;
+
+    for (size_t m = 1; m < mode_count; m++)
+        assert(std::memcmp(buf[0], buf[m], sizeof(buf[0])) == 0);
+
+    R_SUCCEED();
+}
+
+Result Test_PatchCache() {
+    using namespace ams::ldr::oc;
+
+    // Value A fails from failA on, like a patcher rejecting the customized values
+    static u32* failA = nullptr;
+    auto markA = [](u32* ptr) -> Result {
+        R_UNLESS(!failA || ptr < failA, ams::ldr::ResultUnsuccessfulPatcher());
+        *ptr = 0xA0000000 | (*ptr & 0xFFFF);
+        R_SUCCEED();
+    };
+    auto markB = [](u32* ptr) -> Result { *ptr = 0xB0000000 | (*ptr & 0xFFFF); R_SUCCEED(); };
+    auto oddFn = [](u32* ptr) { return *ptr < 0x100 && (*ptr & 1); };
+
+    constexpr size_t words = 1021;
+    u32 stock[words], scanned[words], cached[words];
+    for (size_t i = 0; i < words; i++)
+        stock[i] = 0x10000 | (i * 2654435761u) % 0x1C0; // Matches nothing
+    for (size_t i : { 3, 200, 777, 1020 })
+        stock[i] = 0x42;
+    for (size_t i : { 0, 512 })
+        stock[i] = 0x17F;
+    for (size_t i : { 64, 65, 999 })
+        stock[i] = 0x11;
+
+    auto makePatches = [&](auto& patches) {
+        PatcherEntry<u32> p[] = {
+            { "Value A", markA, 0, nullptr, 0x42 },
+            { "Value B", markB, 0, nullptr, 0x17F },
+            { "Odd",     markB, 0, oddFn,   0, 0xFF },
+        };
+        std::copy(std::begin(p), std::end(p), patches);
+    };
+    const uintptr_t size = sizeof(stock);
+    const u8 module_id[ModuleIdSize] = { 0xDE, 0xAD, 0xBE, 0xEF };
+
+    // Record offsets from a full scan
+    PatchCacheSlot slot = {};
+    {
+        PatcherEntry<u32> patches[3];
+        makePatches(patches);
+        std::memcpy(scanned, stock, size);
+        PatchCacheRecorder = &slot;
+        PatcherScanner scanner(patches);
+        scanner.Scan(reinterpret_cast<uintptr_t>(scanned), reinterpret_cast<uintptr_t>(&scanned[words - 1]));
+        PatchCacheRecorder = nullptr;
+
+        assert(slot.entry_count == 3);
+        assert(slot.record_count == 9);
+        assert(patches[0].patched_count == 4 && patches[1].patched_count == 2 && patches[2].patched_count == 3);
+    }
+
+    std::memcpy(slot.module_id, module_id, sizeof(module_id));
+    slot.cust_rev = CUST_REV;
+    slot.cust_hash = CustomizeTableHash();
+    slot.nso_size = size;
+    std::memcpy(const_cast<PatchCacheSlot *>(&PatchOffsetCache.slots[PatchCacheTarget_PcvMariko]), &slot, sizeof(slot));
+
+    // Key mismatch
+    const u8 other_id[ModuleIdSize] = { 0xDE, 0xAD };
+    assert(FindPatchCache(PatchCacheTarget_PcvMariko, other_id, size, 3) == nullptr);
+    assert(FindPatchCache(PatchCacheTarget_PcvMariko, module_id, size + 4, 3) == nullptr);
+    assert(FindPatchCache(PatchCacheTarget_PcvMariko, module_id, size, 4) == nullptr);
+    assert(FindPatchCache(PatchCacheTarget_PcvErista, module_id, size, 3) == nullptr);
+    assert(FindPatchCache(PatchCacheTarget_PcvMariko, nullptr, size, 3) == nullptr);
+    {
+        volatile CustomizeTable& table = C;
+        const u32 offset = table.commonGpuVoltOffset;
+        table.commonGpuVoltOffset = offset + 5;
+        assert(FindPatchCache(PatchCacheTarget_PcvMariko, module_id, size, 3) == nullptr);
+        table.commonGpuVoltOffset = offset;
+        assert(FindPatchCache(PatchCacheTarget_PcvMariko, module_id, size, 3) != nullptr);
+    }
+
+    // Replay must produce the full scan output
+    {
+        PatcherEntry<u32> patches[3];
+        makePatches(patches);
+        std::memcpy(cached, stock, size);
+        size_t hits = PatchCacheHits;
+        PatcherScanner scanner(patches);
+        scanner.Scan(reinterpret_cast<uintptr_t>(cached), reinterpret_cast<uintptr_t>(&cached[words - 1]),
+                     FindPatchCache(PatchCacheTarget_PcvMariko, module_id, size, 3));
+        assert(PatchCacheHits == hits + 1);
+        assert(std::memcmp(scanned, cached, size) == 0);
+    }
+
+    // Stale offset: nothing is written from the cache, full scan takes over
+    {
+        PatcherEntry<u32> patches[3];
+        makePatches(patches);
+
+        volatile PatchCacheRecord& last_record = PatchOffsetCache.slots[PatchCacheTarget_PcvMariko].records[slot.record_count - 1];
+        u32 stale = 0;
+        while (patches[last_record.entry].Search(&stock[stale]))
+            stale++;
+        last_record.offset = stale * sizeof(u32);
+
+        std::memcpy(cached, stock, size);
+        size_t hits = PatchCacheHits;
+        const uintptr_t begin = reinterpret_cast<uintptr_t>(cached);
+        const uintptr_t last  = reinterpret_cast<uintptr_t>(&cached[words - 1]);
+        auto cache = FindPatchCache(PatchCacheTarget_PcvMariko, module_id, size, 3);
+        assert(cache);
+
+        PatcherScanner scanner(patches);
+        assert(scanner.ApplyCached(begin, last, cache) == begin);
+        assert(std::memcmp(stock, cached, size) == 0);
+        scanner.Scan(begin, last, cache);
+        assert(PatchCacheHits == hits);
+        assert(std::memcmp(scanned, cached, size) == 0);
+    }
+
+    // Patcher failing during replay: the slot is dropped and the scan resumes at the
+    // failed record, same output as a full scan without applying any record twice.
+    // Value B leaves its word matching, so a rescan from the start would count it again
+    std::memcpy(const_cast<PatchCacheSlot *>(&PatchOffsetCache.slots[PatchCacheTarget_PcvMariko]), &slot, sizeof(slot));
+    {
+        auto keepB = [](u32* ptr) -> Result { R_SUCCEED(); };
+        u32 expected[words];
+        PatcherEntry<u32> full[3];
+        makePatches(full);
+        full[1].patcher_fn = keepB;
+        std::memcpy(expected, stock, size);
+        failA = &expected[500];
+        PatcherScanner(full).Scan(reinterpret_cast<uintptr_t>(expected), reinterpret_cast<uintptr_t>(&expected[words - 1]));
+
+        PatcherEntry<u32> patches[3];
+        makePatches(patches);
+        patches[1].patcher_fn = keepB;
+        std::memcpy(cached, stock, size);
+        failA = &cached[500];
+        size_t hits = PatchCacheHits;
+        const uintptr_t begin = reinterpret_cast<uintptr_t>(cached);
+        const uintptr_t last  = reinterpret_cast<uintptr_t>(&cached[words - 1]);
+        auto cache = FindPatchCache(PatchCacheTarget_PcvMariko, module_id, size, 3);
+        assert(cache);
+
+        PatcherScanner scanner(patches);
+        scanner.Scan(begin, last, cache);
+        failA = nullptr;
+        assert(PatchCacheHits == hits);
+        assert(std::memcmp(expected, cached, size) == 0);
+        assert(!FindPatchCache(PatchCacheTarget_PcvMariko, module_id, size, 3));
+        for (size_t i = 0; i < std::size(patches); i++)
+            assert(patches[i].patched_count == full[i].patched_count);
+    }
+
+    std::memset(const_cast<PatchCacheSlot *>(&PatchOffsetCache.slots[PatchCacheTarget_PcvMariko]), 0, sizeof(PatchCacheSlot));
+    R_SUCCEED();
+}
+
+Result Test_MtcTimingEngine() {
+    using namespace ams::ldr::oc;
+
+    // Reference: mtc_timing_value.hpp globals, evaluated from default C
+    const timing::Presets presets = timing::Presets::FromCustomize(const_cast<CustomizeTable&>(C));
+    assert(presets.IsDefault() && TIMING_PRESET_ONE == 0 && TIMING_PRESET_SEVEN == 0);
+
+    auto check = [&](const timing::EmcTiming& t, double tCK_avg, u32 R2W, u32 W2R, u32 WTP, u32 REFRESH, u32 REFBW, u32 WTPDEN, double tPDEX2MRR) {
+        constexpr u32 MC_ARB_DIV = 4;
+        constexpr u32 MC_ARB_SFA = 2;
+        auto cycles = [tCK_avg](double ns) { return u32(CEIL(ns / tCK_avg)); };
+
+        assert(t.emc_rc                  == cycles(tRC));
+        assert(t.emc_rfc                 == cycles(tRFCab));
+        assert(t.emc_rfcpb               == cycles(tRFCpb));
+        assert(t.emc_ras                 == cycles(tRAS));
+        assert(t.emc_rp                  == cycles(tRPpb));
+        assert(t.emc_r2w                 == R2W);
+        assert(t.emc_w2r                 == W2R);
+        assert(t.emc_r2p                 == cycles(tRTP));
+        assert(t.emc_w2p                 == WTP);
+        assert(t.emc_rd_rcd              == cycles(tRCD));
+        assert(t.emc_wr_rcd              == cycles(tRCD));
+        assert(t.emc_rrd                 == cycles(tRRD));
+        assert(t.emc_refresh             == REFRESH);
+        assert(t.emc_pre_refresh_req_cnt == REFRESH / 4);
+        assert(t.emc_pdex2wr             == cycles(tXP));
+        assert(t.emc_pdex2rd             == cycles(tXP));
+        assert(t.emc_pchg2pden           == cycles(tCMDCKE));
+        assert(t.emc_act2pden            == cycles(tMRWCKEL));
+        assert(t.emc_ar2pden             == cycles(tCMDCKE));
+        assert(t.emc_rw2pden             == WTPDEN);
+        assert(t.emc_cke2pden            == cycles(tCKELCS));
+        assert(t.emc_pdex2cke            == cycles(tCSCKEH));
+        assert(t.emc_pdex2mrr            == cycles(tPDEX2MRR));
+        assert(t.emc_txsr                == MIN(cycles(tXSR), (u32)0x3fe));
+        assert(t.emc_tckesr              == cycles(tSR));
+        assert(t.emc_tpd                 == cycles(tCKE));
+        assert(t.emc_tfaw                == cycles(tFAW));
+        assert(t.emc_trpab               == cycles(tRPab));
+        assert(t.emc_tclkstable          == cycles(tCKCKEH));
+        assert(t.emc_tclkstop            == cycles(tCKE) + 8);
+        assert(t.emc_trefbw              == REFBW);
+
+        assert(t.mc_emem_arb_timing_rcd     == u32(CEIL(cycles(tRCD) / MC_ARB_DIV) - 2));
+        assert(t.mc_emem_arb_timing_rp      == u32(CEIL(cycles(tRPpb) / MC_ARB_DIV) - 1 + MC_ARB_SFA));
+        assert(t.mc_emem_arb_timing_rc      == u32(CEIL(cycles(tRC) / MC_ARB_DIV) - 1));
+        assert(t.mc_emem_arb_timing_ras     == u32(CEIL(cycles(tRAS) / MC_ARB_DIV) - 2));
+        assert(t.mc_emem_arb_timing_faw     == u32(CEIL(cycles(tFAW) / MC_ARB_DIV) - 1));
+        assert(t.mc_emem_arb_timing_rrd     == u32(CEIL(cycles(tRRD) / MC_ARB_DIV) - 1));
+        assert(t.mc_emem_arb_timing_rap2pre == u32(CEIL(cycles(tRTP) / MC_ARB_DIV)));
+        assert(t.mc_emem_arb_timing_wap2pre == u32(CEIL(WTP / MC_ARB_DIV)));
+        assert(t.mc_emem_arb_timing_r2w     == u32(CEIL(R2W / MC_ARB_DIV) - 1 + MC_ARB_SFA));
+        assert(t.mc_emem_arb_timing_w2r     == u32(CEIL(W2R / MC_ARB_DIV) - 1 + MC_ARB_SFA));
+        assert(t.mc_emem_arb_timing_rfcpb   == u32(CEIL(cycles(tRFCpb) / MC_ARB_DIV)));
+
+        assert(t.t_rp  == tRPpb);
+        assert(t.t_rfc == tRFCab);
+    };
+
+    {
+        using namespace pcv::erista;
+        const timing::EmcTiming t = timing::Calculate<false>(C.eristaEmcMaxClock, presets);
+        check(t, tCK_avg, R2W, W2R, WTP, REFRESH, REFBW, WTPDEN, tPDEX2MRR);
+        assert(t.emc_tcke == u32(CEIL(tCKE / tCK_avg)));
+        assert(t == timing::Get<false>(C.eristaEmcMaxClock, presets));
+    }
+    {
+        using namespace pcv::mariko;
+        const timing::EmcTiming t = timing::Calculate<true>(C.marikoEmcMaxClock, presets);
+        check(t, tCK_avg, R2W, W2R, WTP, REFRESH, REFBW, WTPDEN, tPDEX2MRR);
+        assert(t.emc_tcke  == u32(CEIL(tCKE / tCK_avg)) + 1);
+        assert(t.emc_trtm  == RTM);
+        assert(t.emc_twtm  == WTM);
+        assert(t.emc_tratm == RATM);
+        assert(t.emc_twatm == WATM);
+        assert(t.mc_emem_arb_cfg == u32(C.marikoEmcMaxClock / (33.3 * 1000) / 4));
+        assert(t == timing::Get<true>(C.marikoEmcMaxClock, presets));
+    }
+
+    // Compile-time tables must match runtime evaluation
+    for (size_t i = 0; i < std::size(timing::EristaCommonKhz); i++)
+        assert(timing::EristaPrecomputed.timing[i] == timing::Calculate<false>(timing::EristaCommonKhz[i], {}));
+    for (size_t i = 0; i < std::size(timing::MarikoCommonKhz); i++)
+        assert(timing::MarikoPrecomputed.timing[i] == timing::Calculate<true>(timing::MarikoCommonKhz[i], {}));
+
+    // Non-default presets bypass the tables
+    timing::Presets tight = { 6, 5, 6, 6, 6, 5, 1 };
+    assert(timing::Get<true>(timing::MarikoCommonKhz[0], tight) == timing::Calculate<true>(timing::MarikoCommonKhz[0], tight));
+    assert(!(timing::Get<true>(timing::MarikoCommonKhz[0], tight) == *timing::MarikoPrecomputed.Find(timing::MarikoCommonKhz[0])));
+
+    R_SUCCEED();
+}
+
+Result Test_EmcOcLadder() {
+    using namespace ams::ldr::oc;
+    using namespace ams::ldr::oc::pcv::erista;
+
+    u32 ladder[EmcOcLadderSlots];
+    auto check_ladder = [&](u32 max_khz, std::initializer_list<u32> expected) {
+        assert(GetEmcOcLadder(max_khz, ladder) == expected.size());
+        assert(std::equal(expected.begin(), expected.end(), ladder));
+    };
+    check_ladder(1728'000, { 1728'000 });
+    check_ladder(1862'400, { 1728'000, 1795'200, 1862'400 });
+    check_ladder(2131'200, { 1862'400, 1996'800, 2131'200 });
+    check_ladder(2000'000, { 1862'400, 1996'800, 2000'000 });
+    check_ladder(2400'000, { 1996'800, 2131'200, 2400'000 });
+
+    // Synthetic stock tables in pcv order, ascending rate in memory
+    constexpr u32 stock_khz[] = { 40800, 68000, 102000, 204000, 408000, 665600, 800000, 1065600, 1331200, 1600000 };
+    constexpr size_t count = std::size(stock_khz);
+    auto stock = std::make_unique<EristaMtcTable[]>(count);
+    auto tables = std::make_unique<EristaMtcTable[]>(count);
+    for (size_t i = 0; i < count; i++) {
+        std::memset(&stock[i], int(i + 1), sizeof(EristaMtcTable));
+        stock[i].rev      = MTC_TABLE_REV;
+        stock[i].rate_khz = stock_khz[i];
+    }
+
+    // Diff generated table against what a single AutoAdjust of the 1600 MHz table gives
+    auto diff_words = [](const EristaMtcTable& a, const EristaMtcTable& b) {
+        const u32* pa = reinterpret_cast<const u32 *>(&a);
+        const u32* pb = reinterpret_cast<const u32 *>(&b);
+        size_t diff = 0;
+        for (size_t i = 0; i < sizeof(EristaMtcTable) / sizeof(u32); i++)
+            diff += pa[i] != pb[i];
+        return diff;
+    };
+
+    const u32 max_clock = C.eristaEmcMaxClock;
+    for (u32 max_khz : { 1862'400u, 2131'200u, 1728'000u }) {
+        C.eristaEmcMaxClock = max_khz;
+        std::memcpy(tables.get(), stock.get(), count * sizeof(EristaMtcTable));
+        assert(R_SUCCEEDED(MemFreqMtcTable(&tables[count - 1].rate_khz)));
+
+        const size_t steps = GetEmcOcLadder(max_khz, ladder);
+        for (size_t i = 0; i < count; i++) {
+            if (i < count - steps) {
+                // Stock tables shifted down, lowest ones discarded
+                assert(diff_words(tables[i], stock[i + steps]) == 0);
+                continue;
+            }
+
+            EristaMtcTable expected;
+            std::memcpy(&expected, &stock[count - 1], sizeof(EristaMtcTable));
+            MemMtcTableAutoAdjust(&expected, ladder[i - (count - steps)]);
+            expected.rate_khz = ladder[i - (count - steps)];
+            assert(diff_words(tables[i], expected) == 0);
+            assert(diff_words(tables[i], stock[count - 1]) > 1);
+        }
+        assert(tables[count - 1].rate_khz == max_khz);
+    }
+
+    // Without auto adjust, only the max table as before the ladder: the 1600 MHz timings
+    // are kept and would not be valid at any intermediate step
+    const u32 mtc_conf = C.mtcConf;
+    for (u32 conf : { CUSTOM_ADJ_ALL, NO_ADJ_ALL, CUSTOMIZED_ALL }) {
+        C.mtcConf = conf;
+        C.eristaEmcMaxClock = 2131'200;
+        assert(GetEmcOcLadder(C.eristaEmcMaxClock, ladder) == 1 && ladder[0] == 2131'200);
+
+        std::memcpy(tables.get(), stock.get(), count * sizeof(EristaMtcTable));
+        assert(R_SUCCEEDED(MemFreqMtcTable(&tables[count - 1].rate_khz)));
+        for (size_t i = 0; i < count - 1; i++)
+            assert(diff_words(tables[i], stock[i + 1]) == 0);
+        assert(tables[count - 1].rate_khz == 2131'200);
+        assert(diff_words(tables[count - 1], stock[count - 1]) == 1);
+    }
+    C.mtcConf = mtc_conf;
+
+    C.eristaEmcMaxClock = pcv::EmcClkOSLimit;
+    std::memcpy(tables.get(), stock.get(), count * sizeof(EristaMtcTable));
+    assert(R_SUCCEEDED(MemFreqMtcTable(&tables[count - 1].rate_khz)));
+    assert(std::memcmp(tables.get(), stock.get(), count * sizeof(EristaMtcTable)) == 0);
+    C.eristaEmcMaxClock = max_clock;
+
+    R_SUCCEED();
+}
+
+namespace mtc {
+    using namespace ams::ldr::oc;
+    namespace schema = ams::ldr::oc::mtc;
+    using schema::Field;
+
+    struct Layout {
+        const char*  soc;
+        u32          rev;
+        size_t       size;
+        const Field* fields;
+        size_t       field_count;
+    } layouts[] = {
+        { "Erista", pcv::erista::MTC_TABLE_REV, sizeof(EristaMtcTable), schema::EristaMtcTableFields, std::size(schema::EristaMtcTableFields) },
+        { "Mariko", pcv::mariko::MTC_TABLE_REV, sizeof(MarikoMtcTable), schema::MarikoMtcTableFields, std::size(schema::MarikoMtcTableFields) },
+    };
+
+    struct Table {
+        const Layout* layout;
+        size_t        offset;
+        u32           rate_khz;
+    };
+
+    bool isCString(const u8* p, size_t size) {
+        size_t len = strnlen(reinterpret_cast<const char *>(p), size);
+        if (!len || len == size)
+            return false;
+        return std::all_of(p, p + len, [](u8 c) { return std::isprint(c); });
+    }
+
+    // MTC tables start with rev, followed by dvfs_ver / clock_src strings and a plausible rate
+    std::vector<Table> locate(const void* buf, size_t size) {
+        const u8* p = reinterpret_cast<const u8 *>(buf);
+        std::vector<Table> tables;
+        for (size_t off = 0; off + sizeof(MarikoMtcTable) <= size; off += sizeof(u32)) {
+            u32 rev;
+            std::memcpy(&rev, p + off, sizeof(u32));
+            for (auto& l : layouts) {
+                if (rev != l.rev || off + l.size > size)
+                    continue;
+                // Both layouts share the header up to clock_src
+                u32 rate_khz;
+                std::memcpy(&rate_khz, p + off + offsetof(EristaMtcTable, rate_khz), sizeof(u32));
+                if (rate_khz < 10'000 || rate_khz > 4'266'000)
+                    continue;
+                if (!isCString(p + off + offsetof(EristaMtcTable, dvfs_ver), sizeof(EristaMtcTable::dvfs_ver)) ||
+                    !isCString(p + off + offsetof(EristaMtcTable, clock_src), sizeof(EristaMtcTable::clock_src)))
+                    continue;
+
+                tables.push_back({ &l, off, rate_khz });
+                off += l.size - sizeof(u32);
+                break;
+            }
+        }
+        return tables;
+    }
+
+    // Calls fn(name, offset, field) for every leaf field, offsets relative to table start
+    template<typename Fn>
+    void visit(const Field* fields, size_t count, size_t base, const std::string& prefix, Fn&& fn) {
+        for (size_t i = 0; i < count; i++) {
+            const Field& f = fields[i];
+            if (f.sub)
+                visit(f.sub, f.sub_count, base + f.offset, prefix + f.name + ".", fn);
+            else
+                fn(prefix + f.name, base + f.offset, f);
+        }
+    }
+
+    u32 readWord(const u8* p) {
+        u32 v;
+        std::memcpy(&v, p, sizeof(u32));
+        return v;
+    }
+
+    void dumpCsv(const u8* p, const std::vector<Table>& tables) {
+        printf("soc,offset,rate_khz,field,value\n");
+        for (auto& t : tables) {
+            visit(t.layout->fields, t.layout->field_count, 0, "", [&](const std::string& name, size_t offset, const Field& f) {
+                const u8* v = p + t.offset + offset;
+                if (f.IsString())
+                    printf("%s,0x%zX,%u,%s,\"%.*s\"\n", t.layout->soc, t.offset, t.rate_khz, name.c_str(), int(f.size), v);
+                else
+                    printf("%s,0x%zX,%u,%s,0x%08X\n", t.layout->soc, t.offset, t.rate_khz, name.c_str(), readWord(v));
+            });
+        }
+    }
+
+    // Columnar: one value array per field, tables grouped by SoC
+    void dumpJson(const u8* p, const std::vector<Table>& tables) {
+        printf("{\n");
+        bool first_soc = true;
+        for (auto& l : layouts) {
+            std::vector<const Table *> group;
+            for (auto& t : tables) {
+                if (t.layout == &l)
+                    group.push_back(&t);
+            }
+            if (group.empty())
+                continue;
+
+            printf("%s  \"%s\": {\n    \"offset\": [", first_soc ? "" : ",\n", l.soc);
+            first_soc = false;
+            for (size_t i = 0; i < group.size(); i++)
+                printf("%s%zu", i ? ", " : "", group[i]->offset);
+            printf("],\n    \"fields\": {");
+
+            bool first_field = true;
+            visit(l.fields, l.field_count, 0, "", [&](const std::string& name, size_t offset, const Field& f) {
+                printf("%s\n      \"%s\": [", first_field ? "" : ",", name.c_str());
+                first_field = false;
+                for (size_t i = 0; i < group.size(); i++) {
+                    const u8* v = p + group[i]->offset + offset;
+                    if (f.IsString())
+                        printf("%s\"%.*s\"", i ? ", " : "", int(strnlen(reinterpret_cast<const char *>(v), f.size)), v);
+                    else
+                        printf("%s%u", i ? ", " : "", readWord(v));
+                }
+                printf("]");
+            });
+            printf("\n    }\n  }");
+        }
+        printf("\n}\n");
+    }
+
+    // Per register diff of the same table in two executables, returns number of differing fields
+    size_t diff(const u8* stock, const u8* patched, const Table& t, FILE* out = stdout) {
+        size_t count = 0;
+        visit(t.layout->fields, t.layout->field_count, 0, "", [&](const std::string& name, size_t offset, const Field& f) {
+            const u8* a = stock + t.offset + offset;
+            const u8* b = patched + t.offset + offset;
+            if (!std::memcmp(a, b, f.size))
+                return;
+
+            count++;
+            if (!out)
+                return;
+            if (f.IsString())
+                fprintf(out, "%s,0x%zX,%u,%s,\"%.*s\",\"%.*s\"\n", t.layout->soc, t.offset, t.rate_khz, name.c_str(), int(f.size), a, int(f.size), b);
+            else
+                fprintf(out, "%s,0x%zX,%u,%s,0x%08X,0x%08X\n", t.layout->soc, t.offset, t.rate_khz, name.c_str(), readWord(a), readWord(b));
+        });
+        return count;
+    }
+
+    int run(int argc, char** argv) {
+        const bool dump = argc >= 4 && !strcmp(argv[2], "dump") && (argc == 4 || (argc == 5 && (!strcmp(argv[4], "csv") || !strcmp(argv[4], "json"))));
+        const bool diff_opt = (argc == 4 || argc == 5) && !strcmp(argv[2], "diff");
+        if (!dump && !diff_opt) {
+            fprintf(stderr, "Usage:\n"\
+                            "    %s  mtc  dump  <pcv_exec_path>  [csv | json]\n"\
+                            "    %s  mtc  diff  <pcv_exec_path>  [patched_exec_path]\n\n"\
+                            "    diff : Without patched_exec_path, compare against Erista / Mariko tables patched in memory\n"
+                            , argv[0], argv[0]);
+            return -1;
+        }
+
+        size_t file_size;
+        u8* file_buffer = reinterpret_cast<u8 *>(loadExec(argv[3], &file_size));
+        std::vector<Table> tables = locate(file_buffer, file_size);
+        if (tables.empty()) {
+            fprintf(stderr, "No MTC table found in \"%s\"\n", argv[3]);
+            return -1;
+        }
+        fprintf(stderr, "Found %zu MTC tables\n", tables.size());
+
+        if (dump) {
+            if (argc == 5 && !strcmp(argv[4], "json"))
+                dumpJson(file_buffer, tables);
+            else
+                dumpCsv(file_buffer, tables);
+            free(file_buffer);
+            return 0;
+        }
+
+        // Patched copy for each SoC, or the same file for both
+        u8* patched[std::size(layouts)] = {};
+        if (argc == 5) {
+            size_t patched_size;
+            patched[0] = reinterpret_cast<u8 *>(loadExec(argv[4], &patched_size));
+            if (patched_size != file_size) {
+                fprintf(stderr, "Size mismatch: \"%s\" (%zu B) vs \"%s\" (%zu B)\n", argv[3], file_size, argv[4], patched_size);
+                return -1;
+            }
+            patched[1] = patched[0];
+        } else {
+            pcv::SafetyCheck();
+            LoggingMuted = true;
+            void (*patch[])(uintptr_t, size_t, const u8*) = { &pcv::erista::Patch, &pcv::mariko::Patch };
+            for (size_t i = 0; i < std::size(layouts); i++) {
+                patched[i] = reinterpret_cast<u8 *>(malloc(file_size));
+                std::memcpy(patched[i], file_buffer, file_size);
+                patch[i](reinterpret_cast<uintptr_t>(patched[i]), file_size, nullptr);
+            }
+            LoggingMuted = false;
+        }
+
+        printf("soc,offset,rate_khz,field,stock,patched\n");
+        size_t fields = 0, changed = 0;
+        for (auto& t : tables) {
+            size_t n = diff(file_buffer, patched[t.layout - layouts], t);
+            fields += n;
+            changed += n != 0;
+        }
+        fprintf(stderr, "%zu fields differ in %zu of %zu tables\n", fields, changed, tables.size());
+
+        if (patched[0] != patched[1])
+            free(patched[1]);
+        free(patched[0]);
+        free(file_buffer);
+        return 0;
+    }
+}
+
+
+Result Test_MtcTableLocator() {
+    using namespace ams::ldr::oc;
+
+    // Erista at an unaligned-to-table offset, followed by two adjacent Mariko tables
+    constexpr size_t erista_off = 0x104, mariko_off = erista_off + sizeof(EristaMtcTable) + 0x40;
+    std::vector<u8> buf(mariko_off + 2 * sizeof(MarikoMtcTable) + 0x100, 0);
+    for (size_t i = 0; i < buf.size(); i += sizeof(u32)) {
+        u32 filler = pcv::mariko::MTC_TABLE_REV;
+        std::memcpy(&buf[i], &filler, sizeof(u32));
+    }
+
+    auto* erista = reinterpret_cast<EristaMtcTable *>(&buf[erista_off]);
+    std::memset(erista, 0, sizeof(EristaMtcTable));
+    erista->rev = pcv::erista::MTC_TABLE_REV;
+    erista->rate_khz = 1600'000;
+    std::strcpy(erista->dvfs_ver, "synthetic");
+    std::strcpy(erista->clock_src, "pllm_ud");
+    erista->burst_regs.emc_rc = 0x12;
+    erista->burst_mc_regs.mc_emem_arb_timing_rc = 0x34;
+
+    for (size_t i = 0; i < 2; i++) {
+        auto* mariko = reinterpret_cast<MarikoMtcTable *>(&buf[mariko_off + i * sizeof(MarikoMtcTable)]);
+        std::memset(mariko, 0, sizeof(MarikoMtcTable));
+        mariko->rev = pcv::mariko::MTC_TABLE_REV;
+        mariko->rate_khz = i ? 1600'000 : 1331'200;
+        std::strcpy(mariko->dvfs_ver, "synthetic");
+        std::strcpy(mariko->clock_src, "pllmb_ud");
+    }
+
+    auto tables = ::mtc::locate(buf.data(), buf.size());
+    assert(tables.size() == 3);
+    assert(!std::strcmp(tables[0].layout->soc, "Erista") && tables[0].offset == erista_off && tables[0].rate_khz == 1600'000);
+    assert(!std::strcmp(tables[1].layout->soc, "Mariko") && tables[1].offset == mariko_off && tables[1].rate_khz == 1331'200);
+    assert(!std::strcmp(tables[2].layout->soc, "Mariko") && tables[2].offset == mariko_off + sizeof(MarikoMtcTable));
+
+    // Decoded names map to the struct layout
+    size_t words = 0, strings = 0;
+    ::mtc::visit(tables[0].layout->fields, tables[0].layout->field_count, 0, "", [&](const std::string& name, size_t offset, const ::mtc::Field& f) {
+        f.IsString() ? strings++ : words++;
+        if (name == "burst_regs.emc_rc")
+            assert(offset == offsetof(EristaMtcTable, burst_regs.emc_rc) && ::mtc::readWord(&buf[erista_off + offset]) == 0x12);
+        if (name == "burst_mc_regs.mc_emem_arb_timing_rc")
+            assert(::mtc::readWord(&buf[erista_off + offset]) == 0x34);
+        if (name == "save_restore_mod_regs[11]")
+            assert(offset == offsetof(EristaMtcTable, save_restore_mod_regs[11]));
+    });
+    assert(strings == 2);
+    assert(words == (sizeof(EristaMtcTable) - sizeof(EristaMtcTable::dvfs_ver) - sizeof(EristaMtcTable::clock_src)) / sizeof(u32));
+
+    // Per register diff
+    std::vector<u8> patched = buf;
+    reinterpret_cast<EristaMtcTable *>(&patched[erista_off])->burst_regs.emc_rc = 0x15;
+    reinterpret_cast<EristaMtcTable *>(&patched[erista_off])->shadow_regs_ca_train.emc_rc = 0x15;
+    assert(::mtc::diff(buf.data(), patched.data(), tables[0], nullptr) == 2);
+    assert(::mtc::diff(buf.data(), patched.data(), tables[1], nullptr) == 0);
+
     R_SUCCEED();
 }
 
 void unitTest() {
     UnitTest test[] = {
-        { "PCV DVFS Table", &Test_PcvDvfsTable }
+        { "PCV DVFS Table", &Test_PcvDvfsTable },
+        { "SIMD Word Matcher", &Test_SimdWordMatcher },
+        { "Patcher Scanner", &Test_PatcherScanner },
+        { "Patch Cache", &Test_PatchCache },
+        { "MTC Timing Engine", &Test_MtcTimingEngine },
+        { "EMC OC Ladder", &Test_EmcOcLadder },
+        { "MTC Table Locator", &Test_MtcTableLocator },
     };
 
     for (auto &t : test) {
@@ -109,12 +850,592 @@ void unitTest() {
     }
 }
 
+void benchPcv(const void* file_buffer, size_t file_size) {
+    using namespace ams::ldr::oc;
+    using clock = std::chrono::steady_clock;
+
+    constexpr int iterations = 16;
+    struct {
+        const char* soc;
+        void (*patch)(uintptr_t mapped_nso, size_t nso_size, const u8* module_id);
+    } targets[] = {
+        { "Erista", &pcv::erista::Patch },
+        { "Mariko", &pcv::mariko::Patch },
+    };
+
+    struct {
+        const char*     name;
+        PatcherScanMode mode;
+    } engines[] = {
+        { "linear", PatcherScanMode::Linear },
+        { "word",   PatcherScanMode::Word },
+        { "vector", PatcherScanMode::Vector },
+    };
+    constexpr size_t engine_count = sizeof(engines) / sizeof(engines[0]);
+
+    void* buf[engine_count];
+    for (auto& b : buf)
+        b = malloc(file_size);
+    const double file_mb = double(file_size) / (1024 * 1024);
+
+    printf("Benchmarking pcv: %.2f MB, %d iterations, %s\n", file_mb, iterations, simd::WordMatcher::Name);
+    LoggingMuted = true;
+    for (auto& t : targets) {
+        double ms[engine_count] = {};
+        for (size_t e = 0; e < engine_count; e++) {
+            PatcherScanModeOverride = engines[e].mode;
+            for (int i = 0; i < iterations; i++) {
+                std::memcpy(buf[e], file_buffer, file_size);
+                auto start = clock::now();
+                t.patch(reinterpret_cast<uintptr_t>(buf[e]), file_size, nullptr);
+                ms[e] += std::chrono::duration<double, std::milli>(clock::now() - start).count();
+            }
+            ms[e] /= iterations;
+        }
+
+        for (size_t e = 0; e < engine_count; e++) {
+            printf("  %s  %-8s  %8.3f ms/NSO  %8.1f MB/s  %6.2fx\n",
+                   t.soc, engines[e].name, ms[e], file_mb / (ms[e] / 1000), ms[0] / ms[e]);
+
+            // Differential check: every engine must patch the same offsets
+            if (std::memcmp(buf[0], buf[e], file_size))
+                CRASH("Patched output differs between engines");
+        }
+    }
+    LoggingMuted = false;
+    PatcherScanModeOverride = PatcherScanMode::Auto;
+
+    for (auto& b : buf)
+        free(b);
+}
+
+namespace batch {
+    using ams::ldr::oc::CustomizeTable;
+
+    constexpr struct {
+        const char* name;
+        size_t      offset;
+    } CustFields[] = {
+        #define CUST_FIELD(field) { #field, offsetof(CustomizeTable, field) }
+        CUST_FIELD(mtcConf),
+        CUST_FIELD(commonCpuBoostClock),
+        CUST_FIELD(commonEmcMemVolt),
+        CUST_FIELD(eristaCpuMaxVolt),
+        CUST_FIELD(eristaEmcMaxClock),
+        CUST_FIELD(marikoCpuMaxVolt),
+        CUST_FIELD(marikoEmcMaxClock),
+        CUST_FIELD(marikoEmcVddqVolt),
+        CUST_FIELD(marikoCpuUV),
+        CUST_FIELD(marikoGpuUV),
+        CUST_FIELD(commonGpuVoltOffset),
+        CUST_FIELD(marikoEmcDvbShift),
+        CUST_FIELD(ramTimingPresetOne),
+        CUST_FIELD(ramTimingPresetTwo),
+        CUST_FIELD(ramTimingPresetThree),
+        CUST_FIELD(ramTimingPresetFour),
+        CUST_FIELD(ramTimingPresetFive),
+        CUST_FIELD(ramTimingPresetSix),
+        CUST_FIELD(ramTimingPresetSeven),
+        #undef CUST_FIELD
+    };
+
+    // CustomizeTable scalar overrides, one "field = value" per line
+    struct Variant {
+        std::string name;
+        std::vector<std::pair<size_t, u32>> overrides;
+
+        void Apply() const {
+            volatile u8* base = reinterpret_cast<volatile u8 *>(&ams::ldr::oc::C);
+            for (const auto& [offset, value] : overrides)
+                *reinterpret_cast<volatile u32 *>(base + offset) = value;
+        }
+    };
+
+    Variant loadVariant(const char* path) {
+        FILE* fp = fopen(path, "r");
+        if (!fp) {
+            fprintf(stderr, "Cannot open variant: \"%s\"\n", path);
+            exit(-1);
+        }
+
+        Variant v;
+        const char* slash = strrchr(path, '/');
+        v.name = slash ? slash + 1 : path;
+
+        char line[256];
+        int line_no = 0;
+        while (fgets(line, sizeof(line), fp)) {
+            line_no++;
+            if (char* comment = strpbrk(line, "#;"))
+                *comment = '\0';
+
+            char key[64];
+            char value[64];
+            if (sscanf(line, " %63[A-Za-z0-9_] = %63s", key, value) != 2) {
+                if (strspn(line, " \t\r\n") != strlen(line)) {
+                    fprintf(stderr, "%s:%d: expected \"field = value\"\n", path, line_no);
+                    exit(-1);
+                }
+                continue;
+            }
+
+            auto field = std::find_if(std::begin(CustFields), std::end(CustFields),
+                                      [&](const auto& f) { return !strcmp(f.name, key); });
+            if (field == std::end(CustFields)) {
+                fprintf(stderr, "%s:%d: unknown field \"%s\"\n", path, line_no, key);
+                exit(-1);
+            }
+            v.overrides.emplace_back(field->offset, static_cast<u32>(strtoul(value, nullptr, 0)));
+        }
+
+        fclose(fp);
+        return v;
+    }
+
+    struct MappedExec {
+        std::string path;
+        void*       base;
+        size_t      size;
+    };
+
+    // Private writable mapping: never written by the parent, copy-on-write in every job
+    std::vector<MappedExec> mapDirectory(const char* dir_path) {
+        DIR* dir = opendir(dir_path);
+        if (!dir) {
+            fprintf(stderr, "Cannot open directory: \"%s\"\n", dir_path);
+            exit(-1);
+        }
+
+        std::vector<std::string> paths;
+        while (dirent* ent = readdir(dir)) {
+            std::string path = std::string(dir_path) + "/" + ent->d_name;
+            struct stat st;
+            if (stat(path.c_str(), &st) || !S_ISREG(st.st_mode) || st.st_size < 8192)
+                continue;
+            paths.push_back(path);
+        }
+        closedir(dir);
+        std::sort(paths.begin(), paths.end());
+
+        std::vector<MappedExec> execs;
+        for (const auto& path : paths) {
+            int fd = open(path.c_str(), O_RDONLY);
+            struct stat st;
+            if (fd < 0 || fstat(fd, &st)) {
+                fprintf(stderr, "Cannot open file: \"%s\"\n", path.c_str());
+                exit(-1);
+            }
+
+            size_t size = st.st_size;
+            void* base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+            close(fd);
+            if (base == MAP_FAILED) {
+                fprintf(stderr, "mmap failed: \"%s\"\n", path.c_str());
+                exit(-1);
+            }
+            execs.push_back({ path, base, size });
+        }
+        return execs;
+    }
+
+    struct Report {
+        static constexpr size_t EntryLimit = 32;
+
+        double ms;
+        u32    entry_count;
+        struct {
+            char description[24];
+            u32  patched_count;
+        } entries[EntryLimit];
+    };
+
+    Report g_report;
+    int    g_report_fd = -1;
+
+    // Also reached through CRASH() -> exit(), so failed jobs keep their partial counts
+    void sendReport() {
+        // Fits in PIPE_BUF, written atomically
+        static_assert(sizeof(Report) <= PIPE_BUF);
+        write(g_report_fd, &g_report, sizeof(g_report));
+    }
+
+    void recordResult(const char* description, size_t patched_count) {
+        if (g_report.entry_count >= Report::EntryLimit)
+            return;
+
+        auto& e = g_report.entries[g_report.entry_count++];
+        strncpy(e.description, description, sizeof(e.description) - 1);
+        e.description[sizeof(e.description) - 1] = '\0';
+        e.patched_count = static_cast<u32>(patched_count);
+    }
+
+    enum Soc { Erista, Mariko };
+
+    struct Job {
+        size_t exec;
+        Soc    soc;
+        size_t variant;
+
+        pid_t  pid = -1;
+        int    fd = -1;
+        int    status = 0;
+        bool   reported = false;
+        Report report = {};
+    };
+
+    // Runs in the forked worker, which owns its copy of C and of the mapping
+    [[noreturn]] void runJob(bool is_pcv, const MappedExec& exec, Soc soc, const Variant& variant, int fd) {
+        using namespace ams::ldr::oc;
+        using clock = std::chrono::steady_clock;
+
+        LoggingMuted = true;
+        PatcherResultHook = &recordResult;
+        g_report_fd = fd;
+        atexit(&sendReport);
+        variant.Apply();
+
+        uintptr_t base = reinterpret_cast<uintptr_t>(exec.base);
+        auto start = clock::now();
+        if (is_pcv) {
+            pcv::SafetyCheck();
+            if (soc == Erista)
+                pcv::erista::Patch(base, exec.size);
+            else
+                pcv::mariko::Patch(base, exec.size);
+        } else {
+            ptm::Patch(base, exec.size);
+        }
+        g_report.ms = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+        exit(0);
+    }
+
+    void reap(std::vector<Job>& jobs, size_t& running) {
+        int status;
+        pid_t pid = wait(&status);
+        if (pid < 0)
+            return;
+
+        for (auto& job : jobs) {
+            if (job.pid != pid)
+                continue;
+
+            job.status = status;
+            job.reported = read(job.fd, &job.report, sizeof(job.report)) == sizeof(job.report);
+            close(job.fd);
+            running--;
+            return;
+        }
+    }
+
+    int run(int argc, char** argv) {
+        using clock = std::chrono::steady_clock;
+
+        if (argc < 4 || (strcmp(argv[2], "pcv") && strcmp(argv[2], "ptm"))) {
+            fprintf(stderr, "Usage:\n"\
+                            "    %s  batch  pcv | ptm  <exec_dir>  [variant ...]\n\n"\
+                            "    variant : File of \"field = value\" CustomizeTable overrides\n"
+                            , argv[0]);
+            return -1;
+        }
+
+        const bool is_pcv = !strcmp(argv[2], "pcv");
+        std::vector<MappedExec> execs = mapDirectory(argv[3]);
+        if (execs.empty()) {
+            fprintf(stderr, "No executable found in \"%s\"\n", argv[3]);
+            return -1;
+        }
+
+        std::vector<Variant> variants = { { "default", {} } };
+        for (int i = 4; i < argc; i++)
+            variants.push_back(loadVariant(argv[i]));
+
+        // ptm is only patched for Mariko
+        std::vector<Soc> socs = is_pcv ? std::vector<Soc>{ Erista, Mariko } : std::vector<Soc>{ Mariko };
+        std::vector<Job> jobs;
+        for (size_t e = 0; e < execs.size(); e++)
+            for (Soc soc : socs)
+                for (size_t v = 0; v < variants.size(); v++)
+                    jobs.push_back({ e, soc, v });
+
+        const size_t workers = std::max(1L, sysconf(_SC_NPROCESSORS_ONLN));
+        printf("Running %zu jobs on %zu workers...\n", jobs.size(), workers);
+        fflush(stdout);
+
+        auto start = clock::now();
+        size_t running = 0;
+        for (auto& job : jobs) {
+            while (running >= workers)
+                reap(jobs, running);
+
+            int fds[2];
+            if (pipe(fds)) {
+                perror("pipe");
+                return -1;
+            }
+
+            pid_t pid = fork();
+            if (pid < 0) {
+                perror("fork");
+                return -1;
+            }
+
+            if (pid == 0) {
+                close(fds[0]);
+                runJob(is_pcv, execs[job.exec], job.soc, variants[job.variant], fds[1]);
+            }
+
+            close(fds[1]);
+            job.pid = pid;
+            job.fd = fds[0];
+            running++;
+        }
+        while (running)
+            reap(jobs, running);
+        double wall_ms = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+        size_t failed = 0;
+        printf("\n%-4s  %-32s  %-6s  %-16s  %-6s  %9s  %s\n", "Job", "File", "SoC", "Variant", "Result", "Time(ms)", "Patched");
+        for (size_t i = 0; i < jobs.size(); i++) {
+            const Job& job = jobs[i];
+            bool ok = job.reported && WIFEXITED(job.status) && WEXITSTATUS(job.status) == 0;
+            failed += !ok;
+
+            u32 total = 0;
+            for (u32 e = 0; e < job.report.entry_count; e++)
+                total += job.report.entries[e].patched_count;
+
+            const std::string& path = execs[job.exec].path;
+            const char* file = path.c_str() + path.rfind('/') + 1;
+            printf("%-4zu  %-32s  %-6s  %-16s  %-6s  %9.3f  %u in %u entries\n",
+                   i, file, job.soc == Erista ? "Erista" : "Mariko", variants[job.variant].name.c_str(),
+                   ok ? "OK" : "FAIL", job.report.ms, total, job.report.entry_count);
+        }
+
+        printf("\nPatch counts per entry:\n");
+        for (size_t i = 0; i < jobs.size(); i++) {
+            const Job& job = jobs[i];
+            if (!job.reported)
+                continue;
+
+            printf("%-4zu ", i);
+            for (u32 e = 0; e < job.report.entry_count; e++)
+                printf(" %s: %u%s", job.report.entries[e].description, job.report.entries[e].patched_count,
+                       e + 1 == job.report.entry_count ? "" : ",");
+            printf("\n");
+        }
+
+        printf("\n%zu / %zu jobs passed in %.1f ms\n", jobs.size() - failed, jobs.size(), wall_ms);
+
+        for (auto& exec : execs)
+            munmap(exec.base, exec.size);
+
+        return failed ? -1 : 0;
+    }
+}
+
+namespace cache {
+    using namespace ams::ldr::oc;
+
+    // NT_GNU_BUILD_ID note, which NSO module_id is taken from (zero padded)
+    bool findModuleId(const void* buf, size_t size, u8 (&module_id)[ModuleIdSize]) {
+        const u8* p = reinterpret_cast<const u8 *>(buf);
+        for (size_t off = 0; off + 16 <= size; off += sizeof(u32)) {
+            u32 namesz, descsz, type;
+            std::memcpy(&namesz, p + off,     sizeof(u32));
+            std::memcpy(&descsz, p + off + 4, sizeof(u32));
+            std::memcpy(&type,   p + off + 8, sizeof(u32));
+            if (namesz != 4 || type != 3 || !descsz || descsz > ModuleIdSize || std::memcmp(p + off + 12, "GNU", 4))
+                continue;
+            if (off + 16 + descsz > size)
+                break;
+
+            std::memset(module_id, 0, ModuleIdSize);
+            std::memcpy(module_id, p + off + 16, descsz);
+            return true;
+        }
+        return false;
+    }
+
+    // Placeholder offset in a loader.kip or a standalone cache file, -1 if missing
+    long locateCache(const void* buf, size_t size) {
+        const u8* p = reinterpret_cast<const u8 *>(buf);
+        for (size_t off = 0; off + sizeof(PatchCache) <= size; off += sizeof(u32)) {
+            u32 header[2];
+            std::memcpy(header, p + off, sizeof(header));
+            if (header[0] == PATCH_CACHE_MAGIC && header[1] == PatchCacheTarget_Count)
+                return off;
+        }
+        return -1;
+    }
+
+    // Customize table in a loader.kip, -1 if missing
+    long locateCustomize(const void* buf, size_t size) {
+        const u8* p = reinterpret_cast<const u8 *>(buf);
+        for (size_t off = 0; off + sizeof(CustomizeTable) <= size; off += sizeof(u32)) {
+            u32 rev;
+            std::memcpy(&rev, p + off + 4, sizeof(rev));
+            if (!std::memcmp(p + off, "CUST", 4) && rev == CUST_REV)
+                return off;
+        }
+        return -1;
+    }
+
+    struct Target {
+        const char*      soc;
+        PatchCacheTarget target;
+        void (*patch)(uintptr_t mapped_nso, size_t nso_size, const u8* module_id);
+    } targets[] = {
+        { "Erista", PatchCacheTarget_PcvErista, &pcv::erista::Patch },
+        { "Mariko", PatchCacheTarget_PcvMariko, &pcv::mariko::Patch },
+    };
+
+    // Patched output with and without the loaded cache must be identical
+    bool verify(const void* file_buffer, size_t file_size, const u8* module_id) {
+        void* scanned = malloc(file_size);
+        void* cached  = malloc(file_size);
+        bool ok = true;
+
+        LoggingMuted = true;
+        for (auto& t : targets) {
+            std::memcpy(scanned, file_buffer, file_size);
+            t.patch(reinterpret_cast<uintptr_t>(scanned), file_size, nullptr);
+
+            std::memcpy(cached, file_buffer, file_size);
+            size_t hits = PatchCacheHits;
+            t.patch(reinterpret_cast<uintptr_t>(cached), file_size, module_id);
+
+            bool hit = PatchCacheHits != hits;
+            bool same = !std::memcmp(scanned, cached, file_size);
+            printf("  %s  %-5s  %s\n", t.soc, hit ? "hit" : "miss", same ? "identical" : "DIFFERS");
+            ok &= hit && same;
+        }
+        LoggingMuted = false;
+
+        free(scanned);
+        free(cached);
+        return ok;
+    }
+
+    int run(int argc, char** argv) {
+        if (argc != 5 || (strcmp(argv[2], "emit") && strcmp(argv[2], "verify"))) {
+            fprintf(stderr, "Usage:\n"\
+                            "    %s  cache  emit | verify  <pcv_exec_path>  <cache_path>\n\n"\
+                            "    cache_path : loader.kip to update in place, or a standalone cache file\n"
+                            , argv[0]);
+            return -1;
+        }
+
+        const bool emit = !strcmp(argv[2], "emit");
+        const char* exec_path  = argv[3];
+        const char* cache_path = argv[4];
+
+        size_t file_size;
+        void* file_buffer = loadExec(exec_path, &file_size);
+
+        u8 module_id[ModuleIdSize];
+        if (!findModuleId(file_buffer, file_size, module_id)) {
+            fprintf(stderr, "No GNU build ID in \"%s\"\n", exec_path);
+            return -1;
+        }
+        printf("Module ID: ");
+        for (u8 b : module_id)
+            printf("%02X", b);
+        printf("\n");
+
+        volatile PatchCache& cache = PatchOffsetCache;
+
+        // Existing file: kip or previous cache, updated in place
+        std::vector<u8> out;
+        long cache_offset = -1;
+        if (FILE* fp = fopen(cache_path, "rb")) {
+            fseek(fp, 0, SEEK_END);
+            out.resize(ftell(fp));
+            fseek(fp, 0, SEEK_SET);
+            fread(out.data(), out.size(), 1, fp);
+            fclose(fp);
+
+            cache_offset = locateCache(out.data(), out.size());
+            if (cache_offset < 0) {
+                fprintf(stderr, "No patch cache placeholder in \"%s\"\n", cache_path);
+                return -1;
+            }
+            std::memcpy(const_cast<PatchCache *>(&cache), out.data() + cache_offset, sizeof(PatchCache));
+
+            // Slots are keyed on the customize table, record with the one loader.kip carries
+            long cust_offset = locateCustomize(out.data(), out.size());
+            if (cust_offset >= 0)
+                std::memcpy(const_cast<CustomizeTable *>(&C), out.data() + cust_offset, sizeof(CustomizeTable));
+            else
+                printf("No customize table in \"%s\", using the default one\n", cache_path);
+        } else if (!emit) {
+            fprintf(stderr, "Cannot open file: \"%s\"\n", cache_path);
+            return -1;
+        }
+
+        pcv::SafetyCheck();
+
+        if (emit) {
+            LoggingMuted = true;
+            void* buf = malloc(file_size);
+            for (auto& t : targets) {
+                PatchCacheSlot slot = {};
+                std::memcpy(buf, file_buffer, file_size);
+                PatchCacheRecorder = &slot;
+                t.patch(reinterpret_cast<uintptr_t>(buf), file_size, nullptr);
+                PatchCacheRecorder = nullptr;
+
+                if (slot.record_count > PatchCacheRecordLimit) {
+                    fprintf(stderr, "%s: %u patched offsets exceed the cache limit (%zu)\n", t.soc, slot.record_count, PatchCacheRecordLimit);
+                    return -1;
+                }
+
+                std::memcpy(slot.module_id, module_id, ModuleIdSize);
+                slot.cust_rev = CUST_REV;
+                slot.cust_hash = CustomizeTableHash();
+                slot.nso_size = static_cast<u32>(file_size);
+                std::memcpy(const_cast<PatchCacheSlot *>(&cache.slots[t.target]), &slot, sizeof(slot));
+                printf("  %s  %u offsets from %u entries\n", t.soc, slot.record_count, slot.entry_count);
+            }
+            free(buf);
+            LoggingMuted = false;
+
+            if (cache_offset < 0) {
+                cache_offset = 0;
+                out.resize(sizeof(PatchCache));
+            }
+            std::memcpy(out.data() + cache_offset, const_cast<PatchCache *>(&cache), sizeof(PatchCache));
+            saveExec(cache_path, out.data(), out.size());
+        }
+
+        printf("Verifying cache...\n");
+        bool ok = verify(file_buffer, file_size, module_id);
+        free(file_buffer);
+        if (!ok) {
+            fprintf(stderr, "Cache verification failed!\n");
+            return -1;
+        }
+
+        printf("Passed!\n\n");
+        return 0;
+    }
+}
+
 int main(int argc, char** argv) {
     unitTest();
 
+    if (argc > 1 && !strcmp(argv[1], "batch"))
+        return batch::run(argc, argv);
+
+    if (argc > 1 && !strcmp(argv[1], "cache"))
+        return cache::run(argc, argv);
+
+    if (argc > 1 && !strcmp(argv[1], "mtc"))
+        return mtc::run(argc, argv);
+
     const char* pcv_opt    = "pcv";
     const char* ptm_opt    = "ptm";
     const char* save_opt   = "-s";
+    const char* bench_opt  = "-b";
     const char* mariko_ext = ".mariko";
     const char* erista_ext = ".erista";
     enum EXE_OPTION {
@@ -130,22 +1451,33 @@ int main(int argc, char** argv) {
         if (!strcmp(argv[1], ptm_opt))
             exe_opt = EXE_PTM;
     }
-    if ((argc != 3 && argc != 4) || exe_opt == UNKNOWN) {
-        fprintf(stderr, "Usage:\n"\
-                        "    %s  %s | %s  [%s]  <exec_path>\n\n"\
-                        "    %s : Save patched executable with extension \"%s\" / \"%s\"\n"
-                        , argv[0], pcv_opt, ptm_opt, save_opt
-                        , save_opt, mariko_ext, erista_ext);
-        return -1;
-    }
 
     bool save_patched = false;
+    bool bench = false;
     char* exec_path = argv[2];
-    if (argc == 4 && !strcmp(argv[2], save_opt)) {
-        save_patched = true;
+    if (argc == 4) {
+        save_patched = !strcmp(argv[2], save_opt);
+        bench = !strcmp(argv[2], bench_opt) && exe_opt == EXE_PCV;
         exec_path = argv[3];
     }
 
+    if ((argc != 3 && argc != 4) || exe_opt == UNKNOWN || (argc == 4 && !save_patched && !bench)) {
+        fprintf(stderr, "Usage:\n"\
+                        "    %s  %s | %s  [%s | %s]  <exec_path>\n"\
+                        "    %s  batch  %s | %s  <exec_dir>  [variant ...]\n"\
+                        "    %s  cache  emit | verify  <%s_exec_path>  <cache_path>\n"\
+                        "    %s  mtc  dump | diff  <%s_exec_path>  [...]\n\n"\
+                        "    %s : Save patched executable with extension \"%s\" / \"%s\"\n"
+                        "    %s : Benchmark and cross-check patcher scan engines (%s only)\n"
+                        , argv[0], pcv_opt, ptm_opt, save_opt, bench_opt
+                        , argv[0], pcv_opt, ptm_opt
+                        , argv[0], pcv_opt
+                        , argv[0], pcv_opt
+                        , save_opt, mariko_ext, erista_ext
+                        , bench_opt, pcv_opt);
+        return -1;
+    }
+
     size_t file_size;
     void* file_buffer = loadExec(exec_path, &file_size);
 
@@ -155,6 +1487,9 @@ int main(int argc, char** argv) {
     if (exe_opt == EXE_PCV) {
         ams::ldr::oc::pcv::SafetyCheck();
 
+        if (bench)
+            benchPcv(file_buffer, file_size);
+
         {
             void* erista_buf = malloc(file_size);
             std::memcpy(erista_buf, file_buffer, file_size);
@@ -26,6 +26,9 @@
 #include <cstdlib>
 #include <cstring>
 #include <cctype>
+#include <array>
+#include <chrono>
+#include <iterator>
 
 typedef uint8_t  u8;
 typedef uint16_t u16;
@@ -36,7 +39,9 @@ typedef int      Result;
 
 #define R_SUCCEEDED(arg)   (arg == 0)
 #define R_FAILED(arg)      (arg != 0)
-#define LOGGING(fmt, ...)  { printf(fmt "\n", ##__VA_ARGS__); }
+inline bool LoggingMuted = false;
+
+#define LOGGING(fmt, ...)  { if (!LoggingMuted) printf(fmt "\n", ##__VA_ARGS__); }
 #define CRASH(msg, ...)    { fprintf(stderr, "%s\nFailed in %s!\n", msg, __PRETTY_FUNCTION__); exit(-1); }
 #define R_SUCCEED()        { return 0; }
 #define R_THROW(err)       { return err; }
@@ -62,6 +67,25 @@ typedef int      Result;
         }                                                           \
     }                                                               \
 
+// I2C stubs, there is no PMIC on host
+typedef enum {
+    I2cDevice_Max77812_2 = 0x22,
+} I2cDevice;
+
+typedef enum {
+    I2cTransactionOption_All = 3,
+} I2cTransactionOption;
+
+typedef struct {
+    I2cDevice device;
+} I2cSession;
+
+inline Result i2cInitialize() { return 0; }
+inline void   i2cExit() { }
+inline Result i2cOpenSession(I2cSession* s, I2cDevice dev) { s->device = dev; return 0; }
+inline Result i2csessionSendAuto(I2cSession*, const void*, size_t, I2cTransactionOption) { return 0; }
+inline void   i2csessionClose(I2cSession*) { }
+
 typedef struct UnitTest {
     using Func = Result(*)();
 
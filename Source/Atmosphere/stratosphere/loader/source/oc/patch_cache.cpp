@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) Switch-OC-Suite
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms and conditions of the GNU General Public License,
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "customize.hpp"
+
+namespace ams::ldr::oc {
+
+// Nonzero magic keeps the placeholder in .data, so it is present in loader.kip
+volatile PatchCache PatchOffsetCache = {};
+
+u32 CustomizeTableHash() {
+    const volatile u8* p = reinterpret_cast<const volatile u8 *>(&C);
+    u32 hash = 0x811C9DC5;
+    for (size_t i = 0; i < sizeof(CustomizeTable); i++)
+        hash = (hash ^ p[i]) * 0x01000193;
+    return hash;
+}
+
+const volatile PatchCacheSlot* FindPatchCache(PatchCacheTarget target, const u8* module_id, size_t nso_size, size_t entry_count) {
+    if (!module_id || target >= PatchCacheTarget_Count)
+        return nullptr;
+
+    if (PatchOffsetCache.magic != PATCH_CACHE_MAGIC || PatchOffsetCache.slot_count != PatchCacheTarget_Count)
+        return nullptr;
+
+    const volatile PatchCacheSlot* slot = &PatchOffsetCache.slots[target];
+    if (!slot->record_count || slot->record_count > PatchCacheRecordLimit)
+        return nullptr;
+
+    if (slot->cust_rev != CUST_REV || slot->nso_size != nso_size || slot->entry_count != entry_count)
+        return nullptr;
+
+    if (slot->cust_hash != CustomizeTableHash())
+        return nullptr;
+
+    for (size_t i = 0; i < ModuleIdSize; i++) {
+        if (slot->module_id[i] != module_id[i])
+            return nullptr;
+    }
+
+    return slot;
+}
+
+void InvalidatePatchCache(const volatile PatchCacheSlot* slot) {
+    if (slot)
+        const_cast<volatile PatchCacheSlot *>(slot)->record_count = 0;
+}
+
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) Switch-OC-Suite
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms and conditions of the GNU General Public License,
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+namespace ams::ldr::oc {
+
+/* Patch offset cache, keyed by NSO build ID (module_id) and CUST_REV.
+ *
+ * pcv is launched before SD card is mounted, so the cache lives in loader.kip
+ * itself like CustomizeTable: a placeholder tagged with PATCH_CACHE_MAGIC that
+ * the host tool ("test cache") locates and fills in. Cached offsets are only
+ * hints, every word is verified with the entry's own pattern before anything
+ * is written and the full scan is used on any mismatch.
+ *
+ * Patchers also depend on the customize table, so slots are keyed on a hash of
+ * it as well: editing the values in loader.kip turns the slot into a miss.
+ */
+constexpr u32    PATCH_CACHE_MAGIC     = 0x4350434F; // OCPC
+constexpr size_t ModuleIdSize          = 0x20;
+constexpr size_t PatchCacheRecordLimit = 64;
+
+enum PatchCacheTarget : u32 {
+    PatchCacheTarget_PcvErista = 0,
+    PatchCacheTarget_PcvMariko = 1,
+
+    PatchCacheTarget_Count,
+};
+
+struct PatchCacheRecord {
+    u16 entry;  // Index in the PatcherEntry array
+    u16 reserved;
+    u32 offset; // Byte offset from mapped_nso
+};
+
+struct PatchCacheSlot {
+    u8  module_id[ModuleIdSize];
+    u32 cust_rev;
+    u32 cust_hash;    // CustomizeTableHash of the table the offsets were recorded with
+    u32 nso_size;
+    u32 entry_count;  // Size of the PatcherEntry array, catches patcher list changes
+    u32 record_count; // 0 = empty, > PatchCacheRecordLimit = overflowed, unusable
+    PatchCacheRecord records[PatchCacheRecordLimit];
+
+    void Record(u32 entry, u32 offset) {
+        if (record_count < PatchCacheRecordLimit)
+            records[record_count] = { static_cast<u16>(entry), 0, offset };
+        record_count++;
+    }
+};
+
+struct PatchCache {
+    u32 magic = PATCH_CACHE_MAGIC;
+    u32 slot_count = PatchCacheTarget_Count;
+    PatchCacheSlot slots[PatchCacheTarget_Count];
+};
+
+extern volatile PatchCache PatchOffsetCache;
+
+// FNV-1a of the customize table bytes, as stored in loader.kip
+u32 CustomizeTableHash();
+
+// Slot for this exact module and customize table, nullptr if there is none
+const volatile PatchCacheSlot* FindPatchCache(PatchCacheTarget target, const u8* module_id, size_t nso_size, size_t entry_count);
+
+// Turns the slot into a miss for the rest of this boot
+void InvalidatePatchCache(const volatile PatchCacheSlot* slot);
+
+#ifndef ATMOSPHERE_IS_STRATOSPHERE
+// Host only: successful applications are appended here while scanning
+inline PatchCacheSlot* PatchCacheRecorder = nullptr;
+// Host only: number of patcher runs served from the cache
+inline size_t PatchCacheHits = 0;
+#endif
+
+}
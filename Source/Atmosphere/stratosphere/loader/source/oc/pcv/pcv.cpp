@@ -71,7 +71,9 @@ Result MemVoltHandler(u32* ptr) {
 }
 
 void SafetyCheck() {
-    if (C.custRev != CUST_REV)
+    // Validate the snapshot that patchers will read
+    const CustomizeView& cv = ResolveCustomizeTable();
+    if (cv.table.custRev != CUST_REV)
         CRASH("Triggered");
 
     struct sValidator {
@@ -93,37 +95,18 @@ void SafetyCheck() {
         }
     };
 
-    u32 eristaCpuDvfsMaxFreq = static_cast<u32>(GetDvfsTableLastEntry(C.eristaCpuDvfsTable)->freq);
-    u32 marikoCpuDvfsMaxFreq = static_cast<u32>(C.marikoCpuUV ? GetDvfsTableLastEntry(C.marikoCpuDvfsTableSLT)->freq : GetDvfsTableLastEntry(C.marikoCpuDvfsTable)->freq);
-    u32 eristaGpuDvfsMaxFreq = static_cast<u32>(GetDvfsTableLastEntry(C.eristaGpuDvfsTable)->freq);
-    u32 marikoGpuDvfsMaxFreq;
-    switch (C.marikoGpuUV) {
-        case 0: 
-            marikoGpuDvfsMaxFreq = static_cast<u32>(GetDvfsTableLastEntry(C.marikoGpuDvfsTable)->freq);
-            break;
-        case 1: 
-            marikoGpuDvfsMaxFreq = static_cast<u32>(GetDvfsTableLastEntry(C.marikoGpuDvfsTableSLT)->freq);
-            break;
-        case 2: 
-            marikoGpuDvfsMaxFreq = static_cast<u32>(GetDvfsTableLastEntry(C.marikoGpuDvfsTableHiOPT)->freq);
-            break;
-        default: 
-            marikoGpuDvfsMaxFreq = static_cast<u32>(GetDvfsTableLastEntry(C.marikoGpuDvfsTable)->freq);
-            break;
-    }
-    
     sValidator validators[] = {
-        { C.commonCpuBoostClock, 1020'000, 3000'000, true },
-        { C.commonEmcMemVolt,    1100'000, 1250'000 },
-        { C.eristaCpuMaxVolt,        1100,     1300 },
-        { C.eristaEmcMaxClock,   1600'000, 2131'200 },
-        { C.marikoCpuMaxVolt,        1100,     1300 },
-        { C.marikoEmcMaxClock,   1600'000, 2800'000 },
-        { C.marikoEmcVddqVolt,    550'000,  650'000 },
-        { eristaCpuDvfsMaxFreq,  1785'000, 3000'000 },
-        { marikoCpuDvfsMaxFreq,  1785'000, 3000'000 },
-        { eristaGpuDvfsMaxFreq,   768'000, 1536'000 },
-        { marikoGpuDvfsMaxFreq,   768'000, 1536'000 },
+        { cv.table.commonCpuBoostClock, 1020'000, 3000'000, true },
+        { cv.table.commonEmcMemVolt,    1100'000, 1250'000 },
+        { cv.table.eristaCpuMaxVolt,        1100,     1300 },
+        { cv.table.eristaEmcMaxClock,   1600'000, 2131'200 },
+        { cv.table.marikoCpuMaxVolt,        1100,     1300 },
+        { cv.table.marikoEmcMaxClock,   1600'000, 2800'000 },
+        { cv.table.marikoEmcVddqVolt,    550'000,  650'000 },
+        { cv.eristaCpu.MaxFreq(),       1785'000, 3000'000, true },
+        { cv.marikoCpu.MaxFreq(),       1785'000, 3000'000, true },
+        { cv.eristaGpu.MaxFreq(),        768'000, 1536'000, true },
+        { cv.marikoGpu.MaxFreq(),        768'000, 1536'000, true },
     };
 
     for (auto& i : validators) {
@@ -132,14 +115,14 @@ void SafetyCheck() {
     }
 }
 
-void Patch(uintptr_t mapped_nso, size_t nso_size) {
+void Patch(uintptr_t mapped_nso, size_t nso_size, const u8* module_id) {
     #ifdef ATMOSPHERE_IS_STRATOSPHERE
     SafetyCheck();
     bool isMariko = (spl::GetSocType() == spl::SocType_Mariko);
     if (isMariko)
-        mariko::Patch(mapped_nso, nso_size);
+        mariko::Patch(mapped_nso, nso_size, module_id);
     else
-        erista::Patch(mapped_nso, nso_size);
+        erista::Patch(mapped_nso, nso_size, module_id);
     #endif
 }
 
@@ -20,6 +20,7 @@
 
 #include "../oc_common.hpp"
 #include "pcv_common.hpp"
+#include "../oc_emc_ladder.hpp"
 
 namespace ams::ldr::oc::pcv {
 
@@ -114,7 +115,7 @@ namespace mariko {
 
     constexpr u32 MTC_TABLE_REV = 3;
 
-    void Patch(uintptr_t mapped_nso, size_t nso_size);
+    void Patch(uintptr_t mapped_nso, size_t nso_size, const u8* module_id = nullptr);
 
 }
 
@@ -149,6 +150,10 @@ namespace erista {
         return (val == 1132 || val == 1170 || val == 1227);
     }
 
+    // Scanner prefilter: all of the above are 0x4xx
+    constexpr u32 CpuMaxVoltPrefilter     = 0x400;
+    constexpr u32 CpuMaxVoltPrefilterMask = 0xFF;
+
     constexpr u32 GpuClkPllLimit  = 921'600'000;
 
     /* GPU Max Clock asm Pattern:
@@ -195,25 +200,37 @@ namespace erista {
 
     constexpr u32 MTC_TABLE_REV = 7;
 
-    void Patch(uintptr_t mapped_nso, size_t nso_size);
+    /* EMC OC ladder, shared with sys-clk (see oc_emc_ladder.hpp).
+     * Intermediate steps only with AUTO_ADJ_ALL, the only mode giving them their own timings.
+     */
+    constexpr size_t EmcOcLadderSlots = emc_oc_ladder::Slots;
+
+    inline size_t GetEmcOcLadder(u32 max_khz, u32 (&out)[EmcOcLadderSlots]) {
+        return emc_oc_ladder::Get(max_khz, C.mtcConf == AUTO_ADJ_ALL, out);
+    }
+
+    void MemMtcTableAutoAdjust(EristaMtcTable* table, u32 emc_khz);
+    Result MemFreqMtcTable(u32* ptr);
+
+    void Patch(uintptr_t mapped_nso, size_t nso_size, const u8* module_id = nullptr);
 }
 
 template<bool isMariko>
 Result CpuFreqCvbTable(u32* ptr) {
     cvb_entry_t* default_table = isMariko ? (cvb_entry_t *)(&mariko::CpuCvbTableDefault) : (cvb_entry_t *)(&erista::CpuCvbTableDefault);
-    cvb_entry_t* customize_table = const_cast<cvb_entry_t *>(isMariko ? (C.marikoCpuUV ? C.marikoCpuDvfsTableSLT : C.marikoCpuDvfsTable) : C.eristaCpuDvfsTable);
+    const DvfsTableView& customize = isMariko ? CV.marikoCpu : CV.eristaCpu;
 
-    u32 cpu_max_volt = isMariko ? C.marikoCpuMaxVolt : C.eristaCpuMaxVolt;
+    u32 cpu_max_volt = isMariko ? CV.table.marikoCpuMaxVolt : CV.table.eristaCpuMaxVolt;
     u32 cpu_freq_threshold = 1020'000;
     if (isMariko) {
-        cpu_freq_threshold = C.marikoCpuUV ? 2193'000 : 2091'000;
+        cpu_freq_threshold = CV.table.marikoCpuUV ? 2193'000 : 2091'000;
     } else {
         cpu_freq_threshold = cpu_max_volt >= 1235 ? 1887'000 : 1428'000;
     }
 
     size_t default_entry_count = GetDvfsTableEntryCount(default_table);
     size_t default_table_size = default_entry_count * sizeof(cvb_entry_t);
-    size_t customize_entry_count = GetDvfsTableEntryCount(customize_table);
+    size_t customize_entry_count = customize.count;
     size_t customize_table_size = customize_entry_count * sizeof(cvb_entry_t);
 
     // Validate existing table
@@ -222,7 +239,7 @@ Result CpuFreqCvbTable(u32* ptr) {
     bool validated = std::memcmp(cpu_cvb_table_head, default_table, default_table_size) == 0;
     R_UNLESS(validated, ldr::ResultInvalidCpuDvfs());
 
-    std::memcpy(cpu_cvb_table_head, static_cast<void *>(customize_table), customize_table_size);
+    std::memcpy(cpu_cvb_table_head, customize.entries, customize_table_size);
 
     // Patch CPU max volt
     if (cpu_max_volt) {
@@ -245,29 +262,11 @@ Result CpuFreqCvbTable(u32* ptr) {
 template<bool isMariko>
 Result GpuFreqCvbTable(u32* ptr) {
     cvb_entry_t* default_table = isMariko ? (cvb_entry_t *)(&mariko::GpuCvbTableDefault) : (cvb_entry_t *)(&erista::GpuCvbTableDefault);
-    cvb_entry_t* customize_table;
-    if (isMariko) {
-        switch (C.marikoGpuUV) {
-            case 0: 
-                customize_table = const_cast<cvb_entry_t *>(C.marikoGpuDvfsTable);
-                break;
-            case 1:
-                customize_table = const_cast<cvb_entry_t *>(C.marikoGpuDvfsTableSLT);
-                break;
-            case 2:
-                customize_table = const_cast<cvb_entry_t *>(C.marikoGpuDvfsTableHiOPT);
-                break;
-            default:
-                customize_table = const_cast<cvb_entry_t *>(C.marikoGpuDvfsTable);
-                break;
-        }
-    } else {
-        customize_table = const_cast<cvb_entry_t *>(C.eristaGpuDvfsTable);
-    }
+    const DvfsTableView& customize = isMariko ? CV.marikoGpu : CV.eristaGpu;
 
     size_t default_entry_count = GetDvfsTableEntryCount(default_table);
     size_t default_table_size = default_entry_count * sizeof(cvb_entry_t);
-    size_t customize_entry_count = GetDvfsTableEntryCount(customize_table);
+    size_t customize_entry_count = customize.count;
     size_t customize_table_size = customize_entry_count * sizeof(cvb_entry_t);
 
     // Validate existing table
@@ -276,13 +275,13 @@ Result GpuFreqCvbTable(u32* ptr) {
     bool validated = std::memcmp(gpu_cvb_table_head, default_table, default_table_size) == 0;
     R_UNLESS(validated, ldr::ResultInvalidGpuDvfs());
 
-    std::memcpy(gpu_cvb_table_head, (void*)customize_table, customize_table_size);
+    std::memcpy(gpu_cvb_table_head, customize.entries, customize_table_size);
 
     // Patch GPU volt
-    if (isMariko && C.marikoGpuUV == 3) {
+    if (isMariko && CV.table.marikoGpuUV == 3) {
         cvb_entry_t* entry = static_cast<cvb_entry_t *>(gpu_cvb_table_head);
         for (size_t i = 0; i < customize_entry_count; i++) {
-            PATCH_OFFSET(&(entry->cvb_pll_param.c0), C.marikoGpuVoltArray[i] * 1000);
+            PATCH_OFFSET(&(entry->cvb_pll_param.c0), CV.table.marikoGpuVoltArray[i] * 1000);
             PATCH_OFFSET(&(entry->cvb_pll_param.c1), 0);
             PATCH_OFFSET(&(entry->cvb_pll_param.c2), 0);
             PATCH_OFFSET(&(entry->cvb_pll_param.c3), 0);
@@ -291,10 +290,10 @@ Result GpuFreqCvbTable(u32* ptr) {
             entry++;
         }
     }
-    else if (C.commonGpuVoltOffset) {
+    else if (CV.table.commonGpuVoltOffset) {
         cvb_entry_t* entry = static_cast<cvb_entry_t *>(gpu_cvb_table_head);
         for (size_t i = 0; i < customize_entry_count; i++) {
-            PATCH_OFFSET(&(entry->cvb_pll_param.c0), (entry->cvb_pll_param.c0 - C.commonGpuVoltOffset*1000));
+            PATCH_OFFSET(&(entry->cvb_pll_param.c0), (entry->cvb_pll_param.c0 - CV.table.commonGpuVoltOffset*1000));
             entry++;
         }
     }
@@ -326,6 +325,6 @@ Result MemMtcCustomizeTable(T* dst, T* src) {
 };
 
 void SafetyCheck();
-void Patch(uintptr_t mapped_nso, size_t nso_size);
+void Patch(uintptr_t mapped_nso, size_t nso_size, const u8* module_id = nullptr);
 
 }
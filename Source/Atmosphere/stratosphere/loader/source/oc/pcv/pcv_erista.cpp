@@ -17,7 +17,7 @@
  */
 
 #include "pcv.hpp"
-#include "../mtc_timing_value.hpp"
+#include "../mtc_timing_engine.hpp"
 
 namespace ams::ldr::oc::pcv::erista {
 
@@ -47,7 +47,7 @@ Result GpuFreqMaxAsm(u32* ptr32) {
     if (rd != asm_get_rd(ins2))
         R_THROW(ldr::ResultInvalidGpuFreqMaxPattern());
 
-    u32 max_clock = GetDvfsTableLastEntry(C.eristaGpuDvfsTable)->freq;
+    u32 max_clock = CV.eristaGpu.MaxFreq();
            
     u32 asm_patch[2] = {
         asm_set_rd(asm_set_imm16(asm_pattern[0], max_clock), rd),
@@ -73,141 +73,140 @@ Result GpuFreqPllLimit(u32* ptr) {
     R_SUCCEED();
 }
 
-void MemMtcTableAutoAdjust(EristaMtcTable* table) {
+void MemMtcTableAutoAdjust(EristaMtcTable* table, u32 emc_khz) {
     if (C.mtcConf != AUTO_ADJ_ALL)
     	return;
 
+    const timing::Presets presets = timing::Presets::FromCustomize(CV.table);
+    const timing::EmcTiming t = timing::Get<false>(emc_khz, presets);
+
     #define WRITE_PARAM_ALL_REG(TABLE, PARAM, VALUE) \
     TABLE->burst_regs.PARAM = VALUE;                 \
     TABLE->shadow_regs_ca_train.PARAM = VALUE;       \
     TABLE->shadow_regs_quse_train.PARAM = VALUE;     \
     TABLE->shadow_regs_rdwr_train.PARAM = VALUE;
- 
-    #define GET_CYCLE_CEIL(PARAM)   u32(CEIL(double(PARAM) / tCK_avg))
-
-    WRITE_PARAM_ALL_REG(table, emc_rc,                  GET_CYCLE_CEIL(tRC));
-    WRITE_PARAM_ALL_REG(table, emc_rfc,                 GET_CYCLE_CEIL(tRFCab));
-    WRITE_PARAM_ALL_REG(table, emc_rfcpb,               GET_CYCLE_CEIL(tRFCpb));
-    WRITE_PARAM_ALL_REG(table, emc_ras,                 GET_CYCLE_CEIL(tRAS));
-    WRITE_PARAM_ALL_REG(table, emc_rp,                  GET_CYCLE_CEIL(tRPpb));
-    WRITE_PARAM_ALL_REG(table, emc_r2w,                 R2W);
-    WRITE_PARAM_ALL_REG(table, emc_w2r,                 W2R);
-    WRITE_PARAM_ALL_REG(table, emc_r2p,                 GET_CYCLE_CEIL(tRTP));
-    WRITE_PARAM_ALL_REG(table, emc_w2p,                 WTP);
-    WRITE_PARAM_ALL_REG(table, emc_rd_rcd,              GET_CYCLE_CEIL(tRCD));
-    WRITE_PARAM_ALL_REG(table, emc_wr_rcd,              GET_CYCLE_CEIL(tRCD));
-    WRITE_PARAM_ALL_REG(table, emc_rrd,                 GET_CYCLE_CEIL(tRRD));
-    WRITE_PARAM_ALL_REG(table, emc_refresh,             REFRESH);
-    WRITE_PARAM_ALL_REG(table, emc_pre_refresh_req_cnt, REFRESH / 4);
-    WRITE_PARAM_ALL_REG(table, emc_pdex2wr,             GET_CYCLE_CEIL(tXP));
-    WRITE_PARAM_ALL_REG(table, emc_pdex2rd,             GET_CYCLE_CEIL(tXP));
-    WRITE_PARAM_ALL_REG(table, emc_pchg2pden,           GET_CYCLE_CEIL(tCMDCKE));
-    WRITE_PARAM_ALL_REG(table, emc_act2pden,            GET_CYCLE_CEIL(tMRWCKEL));
-    WRITE_PARAM_ALL_REG(table, emc_ar2pden,             GET_CYCLE_CEIL(tCMDCKE));
-    WRITE_PARAM_ALL_REG(table, emc_rw2pden,             WTPDEN);
-    WRITE_PARAM_ALL_REG(table, emc_cke2pden,            GET_CYCLE_CEIL(tCKELCS));
-    WRITE_PARAM_ALL_REG(table, emc_pdex2cke,            GET_CYCLE_CEIL(tCSCKEH));
-    WRITE_PARAM_ALL_REG(table, emc_pdex2mrr,            GET_CYCLE_CEIL(tPDEX2MRR));
-    WRITE_PARAM_ALL_REG(table, emc_txsr,                MIN(GET_CYCLE_CEIL(tXSR), (u32)0x3fe));
-    WRITE_PARAM_ALL_REG(table, emc_txsrdll,             MIN(GET_CYCLE_CEIL(tXSR), (u32)0x3fe));
-    WRITE_PARAM_ALL_REG(table, emc_tcke,                GET_CYCLE_CEIL(tCKE));
-    WRITE_PARAM_ALL_REG(table, emc_tckesr,              GET_CYCLE_CEIL(tSR));
-    WRITE_PARAM_ALL_REG(table, emc_tpd,                 GET_CYCLE_CEIL(tCKE));
-    WRITE_PARAM_ALL_REG(table, emc_tfaw,                GET_CYCLE_CEIL(tFAW));
-    WRITE_PARAM_ALL_REG(table, emc_trpab,               GET_CYCLE_CEIL(tRPab));
-    WRITE_PARAM_ALL_REG(table, emc_tclkstable,          GET_CYCLE_CEIL(tCKCKEH));
-    WRITE_PARAM_ALL_REG(table, emc_tclkstop,            GET_CYCLE_CEIL(tCKE)+8);
-    WRITE_PARAM_ALL_REG(table, emc_trefbw,              REFBW);
+
+    WRITE_PARAM_ALL_REG(table, emc_rc,                  t.emc_rc);
+    WRITE_PARAM_ALL_REG(table, emc_rfc,                 t.emc_rfc);
+    WRITE_PARAM_ALL_REG(table, emc_rfcpb,               t.emc_rfcpb);
+    WRITE_PARAM_ALL_REG(table, emc_ras,                 t.emc_ras);
+    WRITE_PARAM_ALL_REG(table, emc_rp,                  t.emc_rp);
+    WRITE_PARAM_ALL_REG(table, emc_r2w,                 t.emc_r2w);
+    WRITE_PARAM_ALL_REG(table, emc_w2r,                 t.emc_w2r);
+    WRITE_PARAM_ALL_REG(table, emc_r2p,                 t.emc_r2p);
+    WRITE_PARAM_ALL_REG(table, emc_w2p,                 t.emc_w2p);
+    WRITE_PARAM_ALL_REG(table, emc_rd_rcd,              t.emc_rd_rcd);
+    WRITE_PARAM_ALL_REG(table, emc_wr_rcd,              t.emc_wr_rcd);
+    WRITE_PARAM_ALL_REG(table, emc_rrd,                 t.emc_rrd);
+    WRITE_PARAM_ALL_REG(table, emc_refresh,             t.emc_refresh);
+    WRITE_PARAM_ALL_REG(table, emc_pre_refresh_req_cnt, t.emc_pre_refresh_req_cnt);
+    WRITE_PARAM_ALL_REG(table, emc_pdex2wr,             t.emc_pdex2wr);
+    WRITE_PARAM_ALL_REG(table, emc_pdex2rd,             t.emc_pdex2rd);
+    WRITE_PARAM_ALL_REG(table, emc_pchg2pden,           t.emc_pchg2pden);
+    WRITE_PARAM_ALL_REG(table, emc_act2pden,            t.emc_act2pden);
+    WRITE_PARAM_ALL_REG(table, emc_ar2pden,             t.emc_ar2pden);
+    WRITE_PARAM_ALL_REG(table, emc_rw2pden,             t.emc_rw2pden);
+    WRITE_PARAM_ALL_REG(table, emc_cke2pden,            t.emc_cke2pden);
+    WRITE_PARAM_ALL_REG(table, emc_pdex2cke,            t.emc_pdex2cke);
+    WRITE_PARAM_ALL_REG(table, emc_pdex2mrr,            t.emc_pdex2mrr);
+    WRITE_PARAM_ALL_REG(table, emc_txsr,                t.emc_txsr);
+    WRITE_PARAM_ALL_REG(table, emc_txsrdll,             t.emc_txsr);
+    WRITE_PARAM_ALL_REG(table, emc_tcke,                t.emc_tcke);
+    WRITE_PARAM_ALL_REG(table, emc_tckesr,              t.emc_tckesr);
+    WRITE_PARAM_ALL_REG(table, emc_tpd,                 t.emc_tpd);
+    WRITE_PARAM_ALL_REG(table, emc_tfaw,                t.emc_tfaw);
+    WRITE_PARAM_ALL_REG(table, emc_trpab,               t.emc_trpab);
+    WRITE_PARAM_ALL_REG(table, emc_tclkstable,          t.emc_tclkstable);
+    WRITE_PARAM_ALL_REG(table, emc_tclkstop,            t.emc_tclkstop);
+    WRITE_PARAM_ALL_REG(table, emc_trefbw,              t.emc_trefbw);
 
     #define WRITE_PARAM_BURST_MC_REG(TABLE, PARAM, VALUE)   TABLE->burst_mc_regs.PARAM = VALUE;
-    
-    constexpr u32 MC_ARB_DIV = 4;
-    constexpr u32 MC_ARB_SFA = 2;
-    table->burst_mc_regs.mc_emem_arb_timing_rcd     = CEIL(GET_CYCLE_CEIL(tRCD) / MC_ARB_DIV) - 2;
-    table->burst_mc_regs.mc_emem_arb_timing_rp      = CEIL(GET_CYCLE_CEIL(tRPpb) / MC_ARB_DIV) - 1 + MC_ARB_SFA;
-    table->burst_mc_regs.mc_emem_arb_timing_rc      = CEIL(GET_CYCLE_CEIL(tRC) / MC_ARB_DIV) - 1;
-    table->burst_mc_regs.mc_emem_arb_timing_ras     = CEIL(GET_CYCLE_CEIL(tRAS) / MC_ARB_DIV) - 2;
-    table->burst_mc_regs.mc_emem_arb_timing_faw     = CEIL(GET_CYCLE_CEIL(tFAW) / MC_ARB_DIV) - 1;
-    table->burst_mc_regs.mc_emem_arb_timing_rrd     = CEIL(GET_CYCLE_CEIL(tRRD) / MC_ARB_DIV) - 1;
-    table->burst_mc_regs.mc_emem_arb_timing_rap2pre = CEIL(GET_CYCLE_CEIL(tRTP) / MC_ARB_DIV);
-    table->burst_mc_regs.mc_emem_arb_timing_wap2pre = CEIL(WTP / MC_ARB_DIV);
+
+    table->burst_mc_regs.mc_emem_arb_timing_rcd     = t.mc_emem_arb_timing_rcd;
+    table->burst_mc_regs.mc_emem_arb_timing_rp      = t.mc_emem_arb_timing_rp;
+    table->burst_mc_regs.mc_emem_arb_timing_rc      = t.mc_emem_arb_timing_rc;
+    table->burst_mc_regs.mc_emem_arb_timing_ras     = t.mc_emem_arb_timing_ras;
+    table->burst_mc_regs.mc_emem_arb_timing_faw     = t.mc_emem_arb_timing_faw;
+    table->burst_mc_regs.mc_emem_arb_timing_rrd     = t.mc_emem_arb_timing_rrd;
+    table->burst_mc_regs.mc_emem_arb_timing_rap2pre = t.mc_emem_arb_timing_rap2pre;
+    table->burst_mc_regs.mc_emem_arb_timing_wap2pre = t.mc_emem_arb_timing_wap2pre;
     //table->burst_mc_regs.mc_emem_arb_timing_r2r     = CEIL(table->burst_regs.emc_rext / MC_ARB_DIV) - 1 + MC_ARB_SFA;
     //table->burst_mc_regs.mc_emem_arb_timing_w2w     = CEIL(table->burst_regs.emc_wext / MC_ARB_DIV) - 1 + MC_ARB_SFA;
-    table->burst_mc_regs.mc_emem_arb_timing_r2w     = CEIL(R2W / MC_ARB_DIV) - 1 + MC_ARB_SFA;
-    table->burst_mc_regs.mc_emem_arb_timing_w2r     = CEIL(W2R / MC_ARB_DIV) - 1 + MC_ARB_SFA;
-    table->burst_mc_regs.mc_emem_arb_timing_rfcpb   = CEIL(GET_CYCLE_CEIL(tRFCpb) / MC_ARB_DIV);
+    table->burst_mc_regs.mc_emem_arb_timing_r2w     = t.mc_emem_arb_timing_r2w;
+    table->burst_mc_regs.mc_emem_arb_timing_w2r     = t.mc_emem_arb_timing_w2r;
+    table->burst_mc_regs.mc_emem_arb_timing_rfcpb   = t.mc_emem_arb_timing_rfcpb;
     //table->burst_mc_regs.mc_emem_arb_timing_ccdmw   = CEIL(tCCDMW / MC_ARB_DIV) -1 + MC_ARB_SFA;
 }
 
 void MemMtcTableCustomAdjust(EristaMtcTable* table) {
     if (C.mtcConf != CUSTOM_ADJ_ALL)
     	return;
-       
-    constexpr u32 MC_ARB_DIV = 4;
-    constexpr u32 MC_ARB_SFA = 2;
-
-    if (TIMING_PRESET_ONE) {
-        WRITE_PARAM_ALL_REG(table, emc_rc,       GET_CYCLE_CEIL(tRC));
-        WRITE_PARAM_ALL_REG(table, emc_ras,      GET_CYCLE_CEIL(tRAS));
-        WRITE_PARAM_ALL_REG(table, emc_rp,       GET_CYCLE_CEIL(tRPpb));
-        WRITE_PARAM_ALL_REG(table, emc_trpab,    GET_CYCLE_CEIL(tRPab));
-        WRITE_PARAM_ALL_REG(table, emc_rd_rcd,   GET_CYCLE_CEIL(tRCD));
-        WRITE_PARAM_ALL_REG(table, emc_wr_rcd,   GET_CYCLE_CEIL(tRCD));
-        WRITE_PARAM_ALL_REG(table, emc_pdex2mrr, GET_CYCLE_CEIL(tPDEX2MRR));
-
-        table->burst_mc_regs.mc_emem_arb_timing_rcd     = CEIL(GET_CYCLE_CEIL(tRCD) / MC_ARB_DIV - 2);
-        table->burst_mc_regs.mc_emem_arb_timing_rc      = CEIL(GET_CYCLE_CEIL(tRC) / MC_ARB_DIV - 1);
-        table->burst_mc_regs.mc_emem_arb_timing_rp      = CEIL(GET_CYCLE_CEIL(tRPpb) / MC_ARB_DIV - 1 + MC_ARB_SFA);
-        table->burst_mc_regs.mc_emem_arb_timing_ras     = CEIL(GET_CYCLE_CEIL(tRAS) / MC_ARB_DIV - 2);
+
+    const timing::Presets presets = timing::Presets::FromCustomize(CV.table);
+    const timing::EmcTiming t = timing::Get<false>(C.eristaEmcMaxClock, presets);
+
+    if (presets.one) {
+        WRITE_PARAM_ALL_REG(table, emc_rc,       t.emc_rc);
+        WRITE_PARAM_ALL_REG(table, emc_ras,      t.emc_ras);
+        WRITE_PARAM_ALL_REG(table, emc_rp,       t.emc_rp);
+        WRITE_PARAM_ALL_REG(table, emc_trpab,    t.emc_trpab);
+        WRITE_PARAM_ALL_REG(table, emc_rd_rcd,   t.emc_rd_rcd);
+        WRITE_PARAM_ALL_REG(table, emc_wr_rcd,   t.emc_wr_rcd);
+        WRITE_PARAM_ALL_REG(table, emc_pdex2mrr, t.emc_pdex2mrr);
+
+        table->burst_mc_regs.mc_emem_arb_timing_rcd     = t.mc_emem_arb_timing_rcd;
+        table->burst_mc_regs.mc_emem_arb_timing_rc      = t.mc_emem_arb_timing_rc;
+        table->burst_mc_regs.mc_emem_arb_timing_rp      = t.mc_emem_arb_timing_rp;
+        table->burst_mc_regs.mc_emem_arb_timing_ras     = t.mc_emem_arb_timing_ras;
     }
 
-    if (TIMING_PRESET_TWO) {
-        WRITE_PARAM_ALL_REG(table, emc_tfaw,     GET_CYCLE_CEIL(tFAW));
-        WRITE_PARAM_ALL_REG(table, emc_rrd,      GET_CYCLE_CEIL(tRRD));
+    if (presets.two) {
+        WRITE_PARAM_ALL_REG(table, emc_tfaw,     t.emc_tfaw);
+        WRITE_PARAM_ALL_REG(table, emc_rrd,      t.emc_rrd);
 
-        table->burst_mc_regs.mc_emem_arb_timing_faw     = CEIL(GET_CYCLE_CEIL(tFAW) / MC_ARB_DIV) - 1;
-        table->burst_mc_regs.mc_emem_arb_timing_rrd     = CEIL(GET_CYCLE_CEIL(tRRD) / MC_ARB_DIV) - 1;
+        table->burst_mc_regs.mc_emem_arb_timing_faw     = t.mc_emem_arb_timing_faw;
+        table->burst_mc_regs.mc_emem_arb_timing_rrd     = t.mc_emem_arb_timing_rrd;
     }
 
-    if (TIMING_PRESET_THREE) {
-        WRITE_PARAM_ALL_REG(table, emc_r2p,      GET_CYCLE_CEIL(tRTP));
-        WRITE_PARAM_ALL_REG(table, emc_w2p,      WTP);
-        WRITE_PARAM_ALL_REG(table, emc_rw2pden,  WTPDEN);
+    if (presets.three) {
+        WRITE_PARAM_ALL_REG(table, emc_r2p,      t.emc_r2p);
+        WRITE_PARAM_ALL_REG(table, emc_w2p,      t.emc_w2p);
+        WRITE_PARAM_ALL_REG(table, emc_rw2pden,  t.emc_rw2pden);
 
-        table->burst_mc_regs.mc_emem_arb_timing_rap2pre = CEIL(GET_CYCLE_CEIL(tRTP) / MC_ARB_DIV);
-        table->burst_mc_regs.mc_emem_arb_timing_wap2pre = CEIL(WTP / MC_ARB_DIV);
+        table->burst_mc_regs.mc_emem_arb_timing_rap2pre = t.mc_emem_arb_timing_rap2pre;
+        table->burst_mc_regs.mc_emem_arb_timing_wap2pre = t.mc_emem_arb_timing_wap2pre;
     }
 
-    if (TIMING_PRESET_FOUR) {
-        WRITE_PARAM_ALL_REG(table, emc_rfc,      GET_CYCLE_CEIL(tRFCab));
-        WRITE_PARAM_ALL_REG(table, emc_rfcpb,    GET_CYCLE_CEIL(tRFCpb));
-        WRITE_PARAM_ALL_REG(table, emc_txsr,     MIN(GET_CYCLE_CEIL(tXSR), (u32)0x3fe));
-        WRITE_PARAM_ALL_REG(table, emc_txsrdll,  MIN(GET_CYCLE_CEIL(tXSR), (u32)0x3fe));
+    if (presets.four) {
+        WRITE_PARAM_ALL_REG(table, emc_rfc,      t.emc_rfc);
+        WRITE_PARAM_ALL_REG(table, emc_rfcpb,    t.emc_rfcpb);
+        WRITE_PARAM_ALL_REG(table, emc_txsr,     t.emc_txsr);
+        WRITE_PARAM_ALL_REG(table, emc_txsrdll,  t.emc_txsr);
 
-        table->burst_mc_regs.mc_emem_arb_timing_rfcpb   = CEIL(GET_CYCLE_CEIL(tRFCpb) / MC_ARB_DIV);
+        table->burst_mc_regs.mc_emem_arb_timing_rfcpb   = t.mc_emem_arb_timing_rfcpb;
     }
 
-    if (TIMING_PRESET_FIVE) {
-        WRITE_PARAM_ALL_REG(table, emc_w2r, W2R);
+    if (presets.five) {
+        WRITE_PARAM_ALL_REG(table, emc_w2r, t.emc_w2r);
 
-        table->burst_mc_regs.mc_emem_arb_timing_w2r     = CEIL(W2R / MC_ARB_DIV) - 1 + MC_ARB_SFA;
+        table->burst_mc_regs.mc_emem_arb_timing_w2r     = t.mc_emem_arb_timing_w2r;
     }
 
-    if (TIMING_PRESET_SIX) {
-        WRITE_PARAM_ALL_REG(table, emc_refresh,  REFRESH);
-        WRITE_PARAM_ALL_REG(table, emc_pre_refresh_req_cnt, REFRESH / 4);
-        WRITE_PARAM_ALL_REG(table, emc_trefbw,   REFBW);
+    if (presets.six) {
+        WRITE_PARAM_ALL_REG(table, emc_refresh,  t.emc_refresh);
+        WRITE_PARAM_ALL_REG(table, emc_pre_refresh_req_cnt, t.emc_pre_refresh_req_cnt);
+        WRITE_PARAM_ALL_REG(table, emc_trefbw,   t.emc_trefbw);
     }
 
-    if (TIMING_PRESET_SEVEN) {
-        WRITE_PARAM_ALL_REG(table, emc_r2w,      R2W);
-        WRITE_PARAM_ALL_REG(table, emc_w2r,      W2R);
-        WRITE_PARAM_ALL_REG(table, emc_w2p,      WTP);
-        WRITE_PARAM_ALL_REG(table, emc_rw2pden,  WTPDEN);
+    if (presets.seven) {
+        WRITE_PARAM_ALL_REG(table, emc_r2w,      t.emc_r2w);
+        WRITE_PARAM_ALL_REG(table, emc_w2r,      t.emc_w2r);
+        WRITE_PARAM_ALL_REG(table, emc_w2p,      t.emc_w2p);
+        WRITE_PARAM_ALL_REG(table, emc_rw2pden,  t.emc_rw2pden);
         
-        table->burst_mc_regs.mc_emem_arb_timing_wap2pre = CEIL(WTP / MC_ARB_DIV);
-        table->burst_mc_regs.mc_emem_arb_timing_r2w     = CEIL(R2W / MC_ARB_DIV) - 1 + MC_ARB_SFA;
-        table->burst_mc_regs.mc_emem_arb_timing_w2r     = CEIL(W2R / MC_ARB_DIV) - 1 + MC_ARB_SFA;
+        table->burst_mc_regs.mc_emem_arb_timing_wap2pre = t.mc_emem_arb_timing_wap2pre;
+        table->burst_mc_regs.mc_emem_arb_timing_r2w     = t.mc_emem_arb_timing_r2w;
+        table->burst_mc_regs.mc_emem_arb_timing_w2r     = t.mc_emem_arb_timing_w2r;
     }
 
     u32 DA_TURNS = 0;
@@ -239,12 +238,24 @@ Result MemFreqMtcTable(u32* ptr) {
     if (C.eristaEmcMaxClock <= EmcClkOSLimit)
         R_SKIP();
 
-    // Make room for new mtc table, discarding useless 40.8 MHz table
-    // 40800 overwritten by 68000, ..., 1331200 overwritten by 1600000, leaving table_list[0] not overwritten
-    for (u32 i = khz_list_size - 1; i > 0; i--)
-        std::memcpy(static_cast<void *>(table_list[i]), static_cast<void *>(table_list[i - 1]), sizeof(EristaMtcTable));
+    // Max only unless timings are auto adjusted, as copies of the 1600 MHz table would keep its timings
+    u32 ladder[EmcOcLadderSlots];
+    const size_t ladder_size = GetEmcOcLadder(C.eristaEmcMaxClock, ladder);
+
+    // Make room for new mtc tables, discarding useless tables below 204 MHz
+    // e.g. 2 steps: 40800 overwritten by 102000, ..., 1065600 overwritten by 1600000, leaving table_list[0, 1] not overwritten
+    for (u32 i = khz_list_size - 1; i >= ladder_size; i--)
+        std::memcpy(static_cast<void *>(table_list[i]), static_cast<void *>(table_list[i - ladder_size]), sizeof(EristaMtcTable));
+
+    // Intermediate steps from the unmodified 1600000 table, in ascending order below table_list[0]
+    for (u32 i = 1; i < ladder_size; i++) {
+        EristaMtcTable* table = table_list[i];
+        std::memcpy(static_cast<void *>(table), static_cast<void *>(table_list[ladder_size]), sizeof(EristaMtcTable));
+        MemMtcTableAutoAdjust(table, ladder[ladder_size - 1 - i]);
+        table->rate_khz = ladder[ladder_size - 1 - i];
+    }
 
-    MemMtcTableAutoAdjust(table_list[0]);
+    MemMtcTableAutoAdjust(table_list[0], C.eristaEmcMaxClock);
     PATCH_OFFSET(ptr, C.eristaEmcMaxClock);
 
     // Handle customize table replacement
@@ -264,15 +275,16 @@ Result MemFreqMax(u32* ptr) {
     R_SUCCEED();
 }
 
-void Patch(uintptr_t mapped_nso, size_t nso_size) {
+void Patch(uintptr_t mapped_nso, size_t nso_size, const u8* module_id) {
+    ResolveCustomizeTable();
     u32 CpuCvbDefaultMaxFreq = static_cast<u32>(GetDvfsTableLastEntry(CpuCvbTableDefault)->freq);
     u32 GpuCvbDefaultMaxFreq = static_cast<u32>(GetDvfsTableLastEntry(GpuCvbTableDefault)->freq);
 
     PatcherEntry<u32> patches[] = {
         { "CPU Freq Table", CpuFreqCvbTable<false>, 1, nullptr, CpuCvbDefaultMaxFreq },
-        { "CPU Volt Limit", &CpuVoltRange,          0, &CpuMaxVoltPatternFn },
+        { "CPU Volt Limit", &CpuVoltRange,          0, &CpuMaxVoltPatternFn, CpuMaxVoltPrefilter, CpuMaxVoltPrefilterMask },
         { "GPU Freq Table", GpuFreqCvbTable<false>, 1, nullptr, GpuCvbDefaultMaxFreq },
-        { "GPU Freq Asm",   &GpuFreqMaxAsm,         2, &GpuMaxClockPatternFn },
+        { "GPU Freq Asm",   &GpuFreqMaxAsm,         2, &GpuMaxClockPatternFn, asm_pattern[0], 0x1F },
         { "GPU Freq PLL",   &GpuFreqPllLimit,       1, nullptr, GpuClkPllLimit },
         { "MEM Freq Mtc",   &MemFreqMtcTable,       0, nullptr, EmcClkOSLimit },
         { "MEM Freq Max",   &MemFreqMax,            0, nullptr, EmcClkOSLimit },
@@ -280,16 +292,9 @@ void Patch(uintptr_t mapped_nso, size_t nso_size) {
         { "MEM Volt",       &MemVoltHandler,        2, nullptr, MemVoltHOS },
     };
 
-    for (uintptr_t ptr = mapped_nso;
-         ptr <= mapped_nso + nso_size - sizeof(EristaMtcTable);
-         ptr += sizeof(u32))
-    {
-        u32* ptr32 = reinterpret_cast<u32 *>(ptr);
-        for (auto& entry : patches) {
-            if (R_SUCCEEDED(entry.SearchAndApply(ptr32)))
-                break;
-        }
-    }
+    PatcherScanner scanner(patches);
+    scanner.Scan(mapped_nso, mapped_nso + nso_size - sizeof(EristaMtcTable),
+                 FindPatchCache(PatchCacheTarget_PcvErista, module_id, nso_size, std::size(patches)));
 
     for (auto& entry : patches) {
         LOGGING("%s Count: %zu", entry.description, entry.patched_count);
@@ -17,7 +17,7 @@
  */
 
 #include "pcv.hpp"
-#include "../mtc_timing_value.hpp"
+#include "../mtc_timing_engine.hpp"
 
 namespace ams::ldr::oc::pcv::mariko {
 
@@ -29,12 +29,8 @@ Result CpuFreqVdd(u32* ptr) {
     R_UNLESS(entry->step_mv == 5000,    ldr::ResultInvalidCpuFreqVddEntry());
     R_UNLESS(entry->max_mv == 1525'000, ldr::ResultInvalidCpuFreqVddEntry());
 
-    if (C.marikoCpuUV) {
-        PATCH_OFFSET(ptr, GetDvfsTableLastEntry(C.marikoCpuDvfsTableSLT)->freq);
-    } else {
-        PATCH_OFFSET(ptr, GetDvfsTableLastEntry(C.marikoCpuDvfsTable)->freq);
-    }
-    
+    PATCH_OFFSET(ptr, CV.marikoCpu.MaxFreq());
+
     R_SUCCEED();
 }
 
@@ -44,12 +40,12 @@ Result CpuVoltRange(u32* ptr) {
         if (min_volt_got != mv)
             continue;
 
-        if (!C.marikoCpuMaxVolt)
+        if (!CV.table.marikoCpuMaxVolt)
             R_SKIP();
 
-        PATCH_OFFSET(ptr, C.marikoCpuMaxVolt);
+        PATCH_OFFSET(ptr, CV.table.marikoCpuMaxVolt);
         // Patch vmin for slt
-        if (C.marikoCpuUV) {
+        if (CV.table.marikoCpuUV) {
             if (*(ptr-5) == 620) {
                 PATCH_OFFSET((ptr-5), 600);
             }
@@ -71,10 +67,10 @@ Result CpuVoltDfll(u32* ptr) {
     R_UNLESS(entry->tune1_low == 0x012207FF,   ldr::ResultInvalidCpuVoltDfllEntry());
     R_UNLESS(entry->tune1_high == 0x03FFF7FF,    ldr::ResultInvalidCpuVoltDfllEntry());
 
-    if (C.marikoCpuUV) {
-        if (C.marikoCpuUV == 1) {
+    if (CV.table.marikoCpuUV) {
+        if (CV.table.marikoCpuUV == 1) {
             PATCH_OFFSET(&(entry->tune0_low), 0x0000FF90); //process_id 0
-        } else if (C.marikoCpuUV == 2) {
+        } else if (CV.table.marikoCpuUV == 2) {
             PATCH_OFFSET(&(entry->tune0_low), 0x0000FFA0); //process_id 1
         }
         PATCH_OFFSET(&(entry->tune0_high), 0x0000FFFF);
@@ -96,21 +92,7 @@ Result GpuFreqMaxAsm(u32* ptr32) {
     if (rd != asm_get_rd(ins2))
         R_THROW(ldr::ResultInvalidGpuFreqMaxPattern());
 
-    u32 max_clock;
-    switch(C.marikoGpuUV) {
-        case 0: 
-            max_clock = GetDvfsTableLastEntry(C.marikoGpuDvfsTable)->freq;
-            break;
-        case 1: 
-            max_clock = GetDvfsTableLastEntry(C.marikoGpuDvfsTableSLT)->freq;
-            break;
-        case 2: 
-            max_clock = GetDvfsTableLastEntry(C.marikoGpuDvfsTableHiOPT)->freq;
-            break;
-        default: 
-            max_clock = GetDvfsTableLastEntry(C.marikoGpuDvfsTable)->freq;
-            break;
-    }
+    u32 max_clock = CV.marikoGpu.MaxFreq();
     u32 asm_patch[2] = {
         asm_set_rd(asm_set_imm16(asm_pattern[0], max_clock), rd),
         asm_set_rd(asm_set_imm16(asm_pattern[1], max_clock >> 16), rd)
@@ -156,9 +138,12 @@ void MemMtcTableAutoAdjust(MarikoMtcTable* table, const MarikoMtcTable* ref) {
     if (C.mtcConf != AUTO_ADJ_ALL)
     	return;
 
+    const timing::Presets presets = timing::Presets::FromCustomize(CV.table);
+    const timing::EmcTiming t = timing::Get<true>(C.marikoEmcMaxClock, presets);
+
     // scale with linear interpolation
     #define ADJUST_PROP(TARGET, REF)                                                                        \
-        (u32)(CEIL((REF + ((C.marikoEmcMaxClock-EmcClkOSAlt)*(TARGET-REF))/(EmcClkOSLimit-EmcClkOSAlt))))
+        (u32)(std::ceil((REF + ((C.marikoEmcMaxClock-EmcClkOSAlt)*(TARGET-REF))/(EmcClkOSLimit-EmcClkOSAlt))))
 
     #define ADJUST_PARAM(TARGET, REF)     \
         TARGET = ADJUST_PROP(TARGET, REF);
@@ -180,47 +165,46 @@ void MemMtcTableAutoAdjust(MarikoMtcTable* table, const MarikoMtcTable* ref) {
         WRITE_PARAM_CA_TRAIN_REG(TABLE, PARAM, VALUE)   \
         WRITE_PARAM_RDWR_TRAIN_REG(TABLE, PARAM, VALUE)
 
-    #define GET_CYCLE_CEIL(PARAM) u32(CEIL(double(PARAM) / tCK_avg))
    
-    WRITE_PARAM_ALL_REG(table, emc_rc,                  GET_CYCLE_CEIL(tRC));
-    WRITE_PARAM_ALL_REG(table, emc_rfc,                 GET_CYCLE_CEIL(tRFCab));
-    WRITE_PARAM_ALL_REG(table, emc_rfcpb,               GET_CYCLE_CEIL(tRFCpb));
-    WRITE_PARAM_ALL_REG(table, emc_ras,                 GET_CYCLE_CEIL(tRAS));
-    WRITE_PARAM_ALL_REG(table, emc_rp,                  GET_CYCLE_CEIL(tRPpb));
-    WRITE_PARAM_ALL_REG(table, emc_r2w,                 R2W);
-    WRITE_PARAM_ALL_REG(table, emc_w2r,                 W2R);
-    WRITE_PARAM_ALL_REG(table, emc_r2p,                 GET_CYCLE_CEIL(tRTP));
-    WRITE_PARAM_ALL_REG(table, emc_w2p,                 WTP);
-    WRITE_PARAM_ALL_REG(table, emc_trtm,                RTM);
-    WRITE_PARAM_ALL_REG(table, emc_twtm,                WTM);
-    WRITE_PARAM_ALL_REG(table, emc_tratm,               RATM);
-    WRITE_PARAM_ALL_REG(table, emc_twatm,               WATM);
+    WRITE_PARAM_ALL_REG(table, emc_rc,                  t.emc_rc);
+    WRITE_PARAM_ALL_REG(table, emc_rfc,                 t.emc_rfc);
+    WRITE_PARAM_ALL_REG(table, emc_rfcpb,               t.emc_rfcpb);
+    WRITE_PARAM_ALL_REG(table, emc_ras,                 t.emc_ras);
+    WRITE_PARAM_ALL_REG(table, emc_rp,                  t.emc_rp);
+    WRITE_PARAM_ALL_REG(table, emc_r2w,                 t.emc_r2w);
+    WRITE_PARAM_ALL_REG(table, emc_w2r,                 t.emc_w2r);
+    WRITE_PARAM_ALL_REG(table, emc_r2p,                 t.emc_r2p);
+    WRITE_PARAM_ALL_REG(table, emc_w2p,                 t.emc_w2p);
+    WRITE_PARAM_ALL_REG(table, emc_trtm,                t.emc_trtm);
+    WRITE_PARAM_ALL_REG(table, emc_twtm,                t.emc_twtm);
+    WRITE_PARAM_ALL_REG(table, emc_tratm,               t.emc_tratm);
+    WRITE_PARAM_ALL_REG(table, emc_twatm,               t.emc_twatm);
     //WRITE_PARAM_ALL_REG(table, emc_tr2ref,              GET_CYCLE_CEIL(tR2REF));
-    WRITE_PARAM_ALL_REG(table, emc_rd_rcd,              GET_CYCLE_CEIL(tRCD));
-    WRITE_PARAM_ALL_REG(table, emc_wr_rcd,              GET_CYCLE_CEIL(tRCD));
-    WRITE_PARAM_ALL_REG(table, emc_rrd,                 GET_CYCLE_CEIL(tRRD));
+    WRITE_PARAM_ALL_REG(table, emc_rd_rcd,              t.emc_rd_rcd);
+    WRITE_PARAM_ALL_REG(table, emc_wr_rcd,              t.emc_wr_rcd);
+    WRITE_PARAM_ALL_REG(table, emc_rrd,                 t.emc_rrd);
     WRITE_PARAM_ALL_REG(table, emc_rext,                26);
-    WRITE_PARAM_ALL_REG(table, emc_refresh,             REFRESH);
-    WRITE_PARAM_ALL_REG(table, emc_pre_refresh_req_cnt, REFRESH / 4);
-    WRITE_PARAM_ALL_REG(table, emc_pdex2wr,             GET_CYCLE_CEIL(tXP));
-    WRITE_PARAM_ALL_REG(table, emc_pdex2rd,             GET_CYCLE_CEIL(tXP));
-    WRITE_PARAM_ALL_REG(table, emc_pchg2pden,           GET_CYCLE_CEIL(tCMDCKE));
-    WRITE_PARAM_ALL_REG(table, emc_act2pden,            GET_CYCLE_CEIL(tMRWCKEL));
-    WRITE_PARAM_ALL_REG(table, emc_ar2pden,             GET_CYCLE_CEIL(tCMDCKE));
-    WRITE_PARAM_ALL_REG(table, emc_rw2pden,             WTPDEN);
-    WRITE_PARAM_ALL_REG(table, emc_cke2pden,            GET_CYCLE_CEIL(tCKELCS));
+    WRITE_PARAM_ALL_REG(table, emc_refresh,             t.emc_refresh);
+    WRITE_PARAM_ALL_REG(table, emc_pre_refresh_req_cnt, t.emc_pre_refresh_req_cnt);
+    WRITE_PARAM_ALL_REG(table, emc_pdex2wr,             t.emc_pdex2wr);
+    WRITE_PARAM_ALL_REG(table, emc_pdex2rd,             t.emc_pdex2rd);
+    WRITE_PARAM_ALL_REG(table, emc_pchg2pden,           t.emc_pchg2pden);
+    WRITE_PARAM_ALL_REG(table, emc_act2pden,            t.emc_act2pden);
+    WRITE_PARAM_ALL_REG(table, emc_ar2pden,             t.emc_ar2pden);
+    WRITE_PARAM_ALL_REG(table, emc_rw2pden,             t.emc_rw2pden);
+    WRITE_PARAM_ALL_REG(table, emc_cke2pden,            t.emc_cke2pden);
     //WRITE_PARAM_ALL_REG(table, emc_pdex2cke,            GET_CYCLE_CEIL(tCSCKEH));
-    WRITE_PARAM_ALL_REG(table, emc_pdex2mrr,            GET_CYCLE_CEIL(tPDEX2MRR));
-    WRITE_PARAM_ALL_REG(table, emc_txsr,                MIN(GET_CYCLE_CEIL(tXSR), (u32)0x3fe));
-    WRITE_PARAM_ALL_REG(table, emc_txsrdll,             MIN(GET_CYCLE_CEIL(tXSR), (u32)0x3fe));
-    WRITE_PARAM_ALL_REG(table, emc_tcke,                GET_CYCLE_CEIL(tCKE) + 1);
-    WRITE_PARAM_ALL_REG(table, emc_tckesr,              GET_CYCLE_CEIL(tSR));
-    WRITE_PARAM_ALL_REG(table, emc_tpd,                 GET_CYCLE_CEIL(tCKE));
-    WRITE_PARAM_ALL_REG(table, emc_tfaw,                GET_CYCLE_CEIL(tFAW));
-    WRITE_PARAM_ALL_REG(table, emc_trpab,               GET_CYCLE_CEIL(tRPab));
+    WRITE_PARAM_ALL_REG(table, emc_pdex2mrr,            t.emc_pdex2mrr);
+    WRITE_PARAM_ALL_REG(table, emc_txsr,                t.emc_txsr);
+    WRITE_PARAM_ALL_REG(table, emc_txsrdll,             t.emc_txsr);
+    WRITE_PARAM_ALL_REG(table, emc_tcke,                t.emc_tcke);
+    WRITE_PARAM_ALL_REG(table, emc_tckesr,              t.emc_tckesr);
+    WRITE_PARAM_ALL_REG(table, emc_tpd,                 t.emc_tpd);
+    WRITE_PARAM_ALL_REG(table, emc_tfaw,                t.emc_tfaw);
+    WRITE_PARAM_ALL_REG(table, emc_trpab,               t.emc_trpab);
     //WRITE_PARAM_ALL_REG(table, emc_tclkstable,          GET_CYCLE_CEIL(tCKCKEH));
-    WRITE_PARAM_ALL_REG(table, emc_tclkstop,            GET_CYCLE_CEIL(tCKE) + 8);
-    WRITE_PARAM_ALL_REG(table, emc_trefbw,              REFBW);
+    WRITE_PARAM_ALL_REG(table, emc_tclkstop,            t.emc_tclkstop);
+    WRITE_PARAM_ALL_REG(table, emc_trefbw,              t.emc_trefbw);
 
     ADJUST_PARAM_ALL_REG(table, emc_dyn_self_ref_control, ref);
 
@@ -228,7 +212,7 @@ void MemMtcTableAutoAdjust(MarikoMtcTable* table, const MarikoMtcTable* ref) {
     #define CLEAR_BIT(BITS, HIGH, LOW)  \
         BITS = BITS & ~( ((1u << HIGH) << 1u) - (1u << LOW) );
     
-    #define ADJUST(TARGET)              (u32)CEIL(TARGET * (C.marikoEmcMaxClock / EmcClkOSLimit))
+    #define ADJUST(TARGET)              (u32)std::ceil(TARGET * (C.marikoEmcMaxClock / EmcClkOSLimit))
     #define ADJUST_INVERSE(TARGET)      (u32)(TARGET * (EmcClkOSLimit / 1000) / (C.marikoEmcMaxClock / 1000))
     
     // Burst MC Regs
@@ -237,19 +221,19 @@ void MemMtcTableAutoAdjust(MarikoMtcTable* table, const MarikoMtcTable* ref) {
     constexpr u32 MC_ARB_DIV = 4;
     constexpr u32 MC_ARB_SFA = 2;
 
-    WRITE_PARAM_BURST_MC_REG(table, mc_emem_arb_cfg,            C.marikoEmcMaxClock / (33.3 * 1000) / MC_ARB_DIV); //CYCLES_PER_UPDATE: The number of mcclk cycles per deadline timer update
-    WRITE_PARAM_BURST_MC_REG(table, mc_emem_arb_timing_rcd,     CEIL(GET_CYCLE_CEIL(tRCD) / MC_ARB_DIV) - 2)
-    WRITE_PARAM_BURST_MC_REG(table, mc_emem_arb_timing_rp,      CEIL(GET_CYCLE_CEIL(tRPpb) / MC_ARB_DIV) - 1 + MC_ARB_SFA)
-    WRITE_PARAM_BURST_MC_REG(table, mc_emem_arb_timing_rc,      CEIL(GET_CYCLE_CEIL(tRC) / MC_ARB_DIV) - 1)
-    WRITE_PARAM_BURST_MC_REG(table, mc_emem_arb_timing_ras,     CEIL(GET_CYCLE_CEIL(tRAS) / MC_ARB_DIV) - 2)
-    WRITE_PARAM_BURST_MC_REG(table, mc_emem_arb_timing_faw,     CEIL(GET_CYCLE_CEIL(tFAW) / MC_ARB_DIV) - 1)
-    WRITE_PARAM_BURST_MC_REG(table, mc_emem_arb_timing_rrd,     CEIL(GET_CYCLE_CEIL(tRRD) / MC_ARB_DIV) - 1)
-    WRITE_PARAM_BURST_MC_REG(table, mc_emem_arb_timing_rap2pre, CEIL(GET_CYCLE_CEIL(tRTP) / MC_ARB_DIV))
-    WRITE_PARAM_BURST_MC_REG(table, mc_emem_arb_timing_wap2pre, CEIL((WTP) / MC_ARB_DIV))
-    WRITE_PARAM_BURST_MC_REG(table, mc_emem_arb_timing_r2r,     CEIL(table->burst_regs.emc_rext / MC_ARB_DIV) - 1 + MC_ARB_SFA)
-    WRITE_PARAM_BURST_MC_REG(table, mc_emem_arb_timing_r2w,     CEIL((R2W) / MC_ARB_DIV) - 1 + MC_ARB_SFA)
-    WRITE_PARAM_BURST_MC_REG(table, mc_emem_arb_timing_w2r,     CEIL((W2R) / MC_ARB_DIV) - 1 + MC_ARB_SFA)
-    WRITE_PARAM_BURST_MC_REG(table, mc_emem_arb_timing_rfcpb,   CEIL(GET_CYCLE_CEIL(tRFCpb) / MC_ARB_DIV))
+    WRITE_PARAM_BURST_MC_REG(table, mc_emem_arb_cfg,            t.mc_emem_arb_cfg); //CYCLES_PER_UPDATE: The number of mcclk cycles per deadline timer update
+    WRITE_PARAM_BURST_MC_REG(table, mc_emem_arb_timing_rcd,     t.mc_emem_arb_timing_rcd)
+    WRITE_PARAM_BURST_MC_REG(table, mc_emem_arb_timing_rp,      t.mc_emem_arb_timing_rp)
+    WRITE_PARAM_BURST_MC_REG(table, mc_emem_arb_timing_rc,      t.mc_emem_arb_timing_rc)
+    WRITE_PARAM_BURST_MC_REG(table, mc_emem_arb_timing_ras,     t.mc_emem_arb_timing_ras)
+    WRITE_PARAM_BURST_MC_REG(table, mc_emem_arb_timing_faw,     t.mc_emem_arb_timing_faw)
+    WRITE_PARAM_BURST_MC_REG(table, mc_emem_arb_timing_rrd,     t.mc_emem_arb_timing_rrd)
+    WRITE_PARAM_BURST_MC_REG(table, mc_emem_arb_timing_rap2pre, t.mc_emem_arb_timing_rap2pre)
+    WRITE_PARAM_BURST_MC_REG(table, mc_emem_arb_timing_wap2pre, t.mc_emem_arb_timing_wap2pre)
+    WRITE_PARAM_BURST_MC_REG(table, mc_emem_arb_timing_r2r,     std::ceil(table->burst_regs.emc_rext / MC_ARB_DIV) - 1 + MC_ARB_SFA)
+    WRITE_PARAM_BURST_MC_REG(table, mc_emem_arb_timing_r2w,     t.mc_emem_arb_timing_r2w)
+    WRITE_PARAM_BURST_MC_REG(table, mc_emem_arb_timing_w2r,     t.mc_emem_arb_timing_w2r)
+    WRITE_PARAM_BURST_MC_REG(table, mc_emem_arb_timing_rfcpb,   t.mc_emem_arb_timing_rfcpb)
 
     u32 DA_TURNS = 0;
     DA_TURNS |= u8(table->burst_mc_regs.mc_emem_arb_timing_r2w / 2) << 16; //R2W TURN
@@ -318,8 +302,8 @@ void MemMtcTableAutoAdjust(MarikoMtcTable* table, const MarikoMtcTable* ref) {
     table->pllmb_ss_ctrl1 = 0x0b55fe01;
     table->pllmb_ss_ctrl2 = 0x10170b55;
 
-    table->dram_timings.t_rp = tRPpb;
-    table->dram_timings.t_rfc = tRFCab;
+    table->dram_timings.t_rp = t.t_rp;
+    table->dram_timings.t_rfc = t.t_rfc;
     //table->dram_timings.rl = 32;
 
     table->emc_cfg_2 = 0x0011083d;
@@ -328,79 +312,79 @@ void MemMtcTableAutoAdjust(MarikoMtcTable* table, const MarikoMtcTable* ref) {
 void MemMtcTableCustomAdjust(MarikoMtcTable* table) {
     if (C.mtcConf != CUSTOM_ADJ_ALL)
     	return;
-       
-    constexpr u32 MC_ARB_DIV = 4;
-    constexpr u32 MC_ARB_SFA = 2;
 
-    if (TIMING_PRESET_ONE) {
-        WRITE_PARAM_ALL_REG(table, emc_rc,      GET_CYCLE_CEIL(tRC));
-        WRITE_PARAM_ALL_REG(table, emc_ras,     GET_CYCLE_CEIL(tRAS));
-        WRITE_PARAM_ALL_REG(table, emc_rp,      GET_CYCLE_CEIL(tRPpb));
-        WRITE_PARAM_ALL_REG(table, emc_trpab,   GET_CYCLE_CEIL(tRPab));
-        WRITE_PARAM_ALL_REG(table, emc_rd_rcd,  GET_CYCLE_CEIL(tRCD));
-        WRITE_PARAM_ALL_REG(table, emc_wr_rcd,  GET_CYCLE_CEIL(tRCD));
-        WRITE_PARAM_ALL_REG(table, emc_pdex2mrr,GET_CYCLE_CEIL(tPDEX2MRR));
-
-        table->burst_mc_regs.mc_emem_arb_timing_rcd     = CEIL(GET_CYCLE_CEIL(tRCD) / MC_ARB_DIV) - 2;
-        table->burst_mc_regs.mc_emem_arb_timing_rc      = CEIL(GET_CYCLE_CEIL(tRC) / MC_ARB_DIV) - 1;
-        table->burst_mc_regs.mc_emem_arb_timing_rp      = CEIL(GET_CYCLE_CEIL(tRPpb) / MC_ARB_DIV) - 1 + MC_ARB_SFA;
-        table->burst_mc_regs.mc_emem_arb_timing_ras     = CEIL(GET_CYCLE_CEIL(tRAS) / MC_ARB_DIV) - 2;
+    const timing::Presets presets = timing::Presets::FromCustomize(CV.table);
+    const timing::EmcTiming t = timing::Get<true>(C.marikoEmcMaxClock, presets);
+
+    if (presets.one) {
+        WRITE_PARAM_ALL_REG(table, emc_rc,      t.emc_rc);
+        WRITE_PARAM_ALL_REG(table, emc_ras,     t.emc_ras);
+        WRITE_PARAM_ALL_REG(table, emc_rp,      t.emc_rp);
+        WRITE_PARAM_ALL_REG(table, emc_trpab,   t.emc_trpab);
+        WRITE_PARAM_ALL_REG(table, emc_rd_rcd,  t.emc_rd_rcd);
+        WRITE_PARAM_ALL_REG(table, emc_wr_rcd,  t.emc_wr_rcd);
+        WRITE_PARAM_ALL_REG(table, emc_pdex2mrr,t.emc_pdex2mrr);
+
+        table->burst_mc_regs.mc_emem_arb_timing_rcd     = t.mc_emem_arb_timing_rcd;
+        table->burst_mc_regs.mc_emem_arb_timing_rc      = t.mc_emem_arb_timing_rc;
+        table->burst_mc_regs.mc_emem_arb_timing_rp      = t.mc_emem_arb_timing_rp;
+        table->burst_mc_regs.mc_emem_arb_timing_ras     = t.mc_emem_arb_timing_ras;
         
     }
     
-    if (TIMING_PRESET_TWO) {
-        WRITE_PARAM_ALL_REG(table, emc_tfaw,    GET_CYCLE_CEIL(tFAW));
-        WRITE_PARAM_ALL_REG(table, emc_rrd,     GET_CYCLE_CEIL(tRRD));
+    if (presets.two) {
+        WRITE_PARAM_ALL_REG(table, emc_tfaw,    t.emc_tfaw);
+        WRITE_PARAM_ALL_REG(table, emc_rrd,     t.emc_rrd);
 
-        table->burst_mc_regs.mc_emem_arb_timing_faw     = CEIL(GET_CYCLE_CEIL(tFAW) / MC_ARB_DIV) - 1;
-        table->burst_mc_regs.mc_emem_arb_timing_rrd     = CEIL(GET_CYCLE_CEIL(tRRD) / MC_ARB_DIV) - 1;
+        table->burst_mc_regs.mc_emem_arb_timing_faw     = t.mc_emem_arb_timing_faw;
+        table->burst_mc_regs.mc_emem_arb_timing_rrd     = t.mc_emem_arb_timing_rrd;
     }
 
-    if (TIMING_PRESET_THREE) {
-        WRITE_PARAM_ALL_REG(table, emc_r2p,     GET_CYCLE_CEIL(tRTP));
-        WRITE_PARAM_ALL_REG(table, emc_w2p,     WTP);
-        WRITE_PARAM_ALL_REG(table, emc_tratm,   RATM);
-        WRITE_PARAM_ALL_REG(table, emc_twatm,   WATM);
-        WRITE_PARAM_ALL_REG(table, emc_rw2pden, WTPDEN);
+    if (presets.three) {
+        WRITE_PARAM_ALL_REG(table, emc_r2p,     t.emc_r2p);
+        WRITE_PARAM_ALL_REG(table, emc_w2p,     t.emc_w2p);
+        WRITE_PARAM_ALL_REG(table, emc_tratm,   t.emc_tratm);
+        WRITE_PARAM_ALL_REG(table, emc_twatm,   t.emc_twatm);
+        WRITE_PARAM_ALL_REG(table, emc_rw2pden, t.emc_rw2pden);
 
-        table->burst_mc_regs.mc_emem_arb_timing_rap2pre = CEIL(GET_CYCLE_CEIL(tRTP) / MC_ARB_DIV);
-        table->burst_mc_regs.mc_emem_arb_timing_wap2pre = CEIL(WTP / MC_ARB_DIV);
+        table->burst_mc_regs.mc_emem_arb_timing_rap2pre = t.mc_emem_arb_timing_rap2pre;
+        table->burst_mc_regs.mc_emem_arb_timing_wap2pre = t.mc_emem_arb_timing_wap2pre;
     }
 
-    if (TIMING_PRESET_FOUR) {
-        WRITE_PARAM_ALL_REG(table, emc_rfc,     GET_CYCLE_CEIL(tRFCab));
-        WRITE_PARAM_ALL_REG(table, emc_rfcpb,   GET_CYCLE_CEIL(tRFCpb));
-        WRITE_PARAM_ALL_REG(table, emc_txsr,    MIN(GET_CYCLE_CEIL(tXSR), (u32)0x3fe));
-        WRITE_PARAM_ALL_REG(table, emc_txsrdll, MIN(GET_CYCLE_CEIL(tXSR), (u32)0x3fe));
+    if (presets.four) {
+        WRITE_PARAM_ALL_REG(table, emc_rfc,     t.emc_rfc);
+        WRITE_PARAM_ALL_REG(table, emc_rfcpb,   t.emc_rfcpb);
+        WRITE_PARAM_ALL_REG(table, emc_txsr,    t.emc_txsr);
+        WRITE_PARAM_ALL_REG(table, emc_txsrdll, t.emc_txsr);
 
-        table->burst_mc_regs.mc_emem_arb_timing_rfcpb   = CEIL(GET_CYCLE_CEIL(tRFCpb) / MC_ARB_DIV);
+        table->burst_mc_regs.mc_emem_arb_timing_rfcpb   = t.mc_emem_arb_timing_rfcpb;
     }
 
-    if (TIMING_PRESET_FIVE) {
-        WRITE_PARAM_ALL_REG(table, emc_w2r, W2R);
+    if (presets.five) {
+        WRITE_PARAM_ALL_REG(table, emc_w2r, t.emc_w2r);
 
-        table->burst_mc_regs.mc_emem_arb_timing_w2r     = CEIL(W2R / MC_ARB_DIV) - 1 + MC_ARB_SFA;
+        table->burst_mc_regs.mc_emem_arb_timing_w2r     = t.mc_emem_arb_timing_w2r;
     }
 
-    if (TIMING_PRESET_SIX) {
-        WRITE_PARAM_ALL_REG(table, emc_refresh, REFRESH);
-        WRITE_PARAM_ALL_REG(table, emc_pre_refresh_req_cnt, REFRESH / 4);
-        WRITE_PARAM_ALL_REG(table, emc_trefbw,  REFBW);
+    if (presets.six) {
+        WRITE_PARAM_ALL_REG(table, emc_refresh, t.emc_refresh);
+        WRITE_PARAM_ALL_REG(table, emc_pre_refresh_req_cnt, t.emc_pre_refresh_req_cnt);
+        WRITE_PARAM_ALL_REG(table, emc_trefbw,  t.emc_trefbw);
     }
 
-    if (TIMING_PRESET_SEVEN) {
-        WRITE_PARAM_ALL_REG(table, emc_r2w,     R2W);
-        WRITE_PARAM_ALL_REG(table, emc_w2r,     W2R);
-        WRITE_PARAM_ALL_REG(table, emc_w2p,     WTP);
-        WRITE_PARAM_ALL_REG(table, emc_trtm,    RTM);
-        WRITE_PARAM_ALL_REG(table, emc_twtm,    WTM);
-        WRITE_PARAM_ALL_REG(table, emc_tratm,   RATM);
-        WRITE_PARAM_ALL_REG(table, emc_twatm,   WATM);
-        WRITE_PARAM_ALL_REG(table, emc_rw2pden, WTPDEN);
-
-        table->burst_mc_regs.mc_emem_arb_timing_wap2pre = CEIL(WTP / MC_ARB_DIV);
-        table->burst_mc_regs.mc_emem_arb_timing_r2w     = CEIL(R2W / MC_ARB_DIV) - 1 + MC_ARB_SFA;
-        table->burst_mc_regs.mc_emem_arb_timing_w2r     = CEIL(W2R / MC_ARB_DIV) - 1 + MC_ARB_SFA;
+    if (presets.seven) {
+        WRITE_PARAM_ALL_REG(table, emc_r2w,     t.emc_r2w);
+        WRITE_PARAM_ALL_REG(table, emc_w2r,     t.emc_w2r);
+        WRITE_PARAM_ALL_REG(table, emc_w2p,     t.emc_w2p);
+        WRITE_PARAM_ALL_REG(table, emc_trtm,    t.emc_trtm);
+        WRITE_PARAM_ALL_REG(table, emc_twtm,    t.emc_twtm);
+        WRITE_PARAM_ALL_REG(table, emc_tratm,   t.emc_tratm);
+        WRITE_PARAM_ALL_REG(table, emc_twatm,   t.emc_twatm);
+        WRITE_PARAM_ALL_REG(table, emc_rw2pden, t.emc_rw2pden);
+
+        table->burst_mc_regs.mc_emem_arb_timing_wap2pre = t.mc_emem_arb_timing_wap2pre;
+        table->burst_mc_regs.mc_emem_arb_timing_r2w     = t.mc_emem_arb_timing_r2w;
+        table->burst_mc_regs.mc_emem_arb_timing_w2r     = t.mc_emem_arb_timing_w2r;
     }
 
     u32 DA_TURNS = 0;
@@ -588,7 +572,8 @@ Result EmcVddqVolt(u32* ptr) {
     R_SUCCEED();
 }
 
-void Patch(uintptr_t mapped_nso, size_t nso_size) {
+void Patch(uintptr_t mapped_nso, size_t nso_size, const u8* module_id) {
+    ResolveCustomizeTable();
     u32 CpuCvbDefaultMaxFreq = static_cast<u32>(GetDvfsTableLastEntry(CpuCvbTableDefault)->freq);
     u32 GpuCvbDefaultMaxFreq = static_cast<u32>(GetDvfsTableLastEntry(GpuCvbTableDefault)->freq);
 
@@ -598,7 +583,7 @@ void Patch(uintptr_t mapped_nso, size_t nso_size) {
         { "CPU Volt Limit", &CpuVoltRange,         13, nullptr, CpuVoltOfficial },
         { "CPU Volt Dfll",  &CpuVoltDfll,           1, nullptr, 0x0000FFCF },
         { "GPU Freq Table", GpuFreqCvbTable<true>,  1, nullptr, GpuCvbDefaultMaxFreq },
-        { "GPU Freq Asm",   &GpuFreqMaxAsm,         2, &GpuMaxClockPatternFn },
+        { "GPU Freq Asm",   &GpuFreqMaxAsm,         2, &GpuMaxClockPatternFn, asm_pattern[0], 0x1F },
         //{ "GPU Freq PLL",   &GpuFreqPllLimit,       1, nullptr, GpuClkPllLimit },
         { "MEM Freq Mtc",   &MemFreqMtcTable,       0, nullptr, EmcClkOSLimit },
         { "MEM Freq Dvb",   &MemFreqDvbTable,       1, nullptr, EmcClkOSLimit },
@@ -608,16 +593,9 @@ void Patch(uintptr_t mapped_nso, size_t nso_size) {
         { "MEM Vdd2",       &MemVoltHandler,        2, nullptr, MemVdd2Default }
     };
 
-    for (uintptr_t ptr = mapped_nso;
-         ptr <= mapped_nso + nso_size - sizeof(MarikoMtcTable);
-         ptr += sizeof(u32))
-    {
-        u32* ptr32 = reinterpret_cast<u32 *>(ptr);
-        for (auto& entry : patches) {
-            if (R_SUCCEEDED(entry.SearchAndApply(ptr32)))
-                break;
-        }
-    }
+    PatcherScanner scanner(patches);
+    scanner.Scan(mapped_nso, mapped_nso + nso_size - sizeof(MarikoMtcTable),
+                 FindPatchCache(PatchCacheTarget_PcvMariko, module_id, nso_size, std::size(patches)));
 
     for (auto& entry : patches) {
         LOGGING("%s Count: %zu", entry.description, entry.patched_count);
@@ -60,7 +60,7 @@ namespace ams::ldr {"""),
 
                 /* Apply pcv and ptm patches. */
                 if (g_is_pcv)
-                    oc::pcv::Patch(map_address, nso_size);
+                    oc::pcv::Patch(map_address, nso_size, nso_header->module_id);
                 if (g_is_ptm)
                     oc::ptm::Patch(map_address, nso_size);
             }""")])
@@ -39,6 +39,7 @@ Result sysclkIpcGetFrequencyTable(SysClkModule module, SysClkProfile profile, Sy
 Result sysclkIpcGetIsMariko(bool* out_is_mariko);
 Result sysclkIpcGetBatteryChargingDisabledOverride(bool* out_is_true);
 Result sysclkIpcSetBatteryChargingDisabledOverride(bool toggle_true);
+Result sysclkIpcGetGovernorStats(SysClkGovernorStats* out_stats);
 
 static inline Result sysclkIpcRemoveOverride(SysClkModule module)
 {
@@ -116,6 +116,20 @@ inline SysClkOcGovernorConfig ToggleGovernor(SysClkOcGovernorConfig prev, SysClk
     return (SysClkOcGovernorConfig)((prev & ~(1 << shift)) | state << shift);
 }
 
+typedef struct
+{
+    uint64_t applied;               // SetHz calls made by the governor
+    uint64_t suppressedThreshold;   // within up/down hysteresis
+    uint64_t suppressedResidency;   // current step held for less than min residency
+    uint64_t suppressedRate;        // over transitions per second cap
+    uint64_t delayedMs;             // total time suppressed steps waited before being applied
+} SysClkGovernorModuleStats;
+
+typedef struct
+{
+    SysClkGovernorModuleStats modules[SysClkModule_EnumMax];
+} SysClkGovernorStats;
+
 typedef struct
 {
     union {
@@ -26,6 +26,11 @@ typedef enum {
     SysClkConfigValue_ChargingLimitPercentage,
     SysClkConfigValue_GovernorExperimental,
     SysClkConfigValue_GovernorHandheldOnly,
+    SysClkConfigValue_GovernorUpThreshold,
+    SysClkConfigValue_GovernorDownThreshold,
+    SysClkConfigValue_GovernorMinResidencyMs,
+    SysClkConfigValue_GovernorMaxTransitions,
+    SysClkConfigValue_GovernorEnergyModel,
     SysClkConfigValue_EnumMax,
 } SysClkConfigValue;
 
@@ -57,6 +62,16 @@ static inline const char* sysclkFormatConfigValue(SysClkConfigValue val, bool pr
             return pretty ? "Frequency Governor (Experimental)" : "governor_experimental";
         case SysClkConfigValue_GovernorHandheldOnly:
             return pretty ? "Frequency Governor Handheld Only" : "governor_handheld_only";
+        case SysClkConfigValue_GovernorUpThreshold:
+            return pretty ? "Governor Up Threshold (permille)" : "governor_up_threshold";
+        case SysClkConfigValue_GovernorDownThreshold:
+            return pretty ? "Governor Down Threshold (permille)" : "governor_down_threshold";
+        case SysClkConfigValue_GovernorMinResidencyMs:
+            return pretty ? "Governor Min Residency (ms)" : "governor_min_residency_ms";
+        case SysClkConfigValue_GovernorMaxTransitions:
+            return pretty ? "Governor Max Transitions (/s)" : "governor_max_transitions";
+        case SysClkConfigValue_GovernorEnergyModel:
+            return pretty ? "Governor Energy Model" : "governor_energy_model";
         default:
             return NULL;
     }
@@ -74,6 +89,11 @@ static inline uint64_t sysclkDefaultConfigValue(SysClkConfigValue val)
         case SysClkConfigValue_GovernorExperimental:
         case SysClkConfigValue_GovernorHandheldOnly:
         case SysClkConfigValue_AutoCPUBoost:
+        case SysClkConfigValue_GovernorUpThreshold:
+        case SysClkConfigValue_GovernorDownThreshold:
+        case SysClkConfigValue_GovernorMinResidencyMs:
+        case SysClkConfigValue_GovernorMaxTransitions:
+        case SysClkConfigValue_GovernorEnergyModel:
             return 0ULL;
         case SysClkConfigValue_SyncReverseNXMode:
             return 1ULL;
@@ -100,11 +120,19 @@ static inline uint64_t sysclkValidConfigValue(SysClkConfigValue val, uint64_t in
         case SysClkConfigValue_AllowUnsafeFrequencies:
         case SysClkConfigValue_GovernorExperimental:
         case SysClkConfigValue_GovernorHandheldOnly:
+        case SysClkConfigValue_GovernorEnergyModel:
             return (input & 0x1) == input;
         case SysClkConfigValue_ChargingCurrentLimit:
             return (input >= 100 && input <= CHARGING_CURRENT_MA_LIMIT && input % 100 == 0);
         case SysClkConfigValue_ChargingLimitPercentage:
             return (input <= 100 && input >= 20);
+        case SysClkConfigValue_GovernorUpThreshold:
+        case SysClkConfigValue_GovernorDownThreshold:
+            return input <= 500;
+        case SysClkConfigValue_GovernorMinResidencyMs:
+            return input <= 1000;
+        case SysClkConfigValue_GovernorMaxTransitions:
+            return input <= 200;
         default:
             return false;
     }
@@ -11,8 +11,10 @@ Result I2cRead_OutU16(I2cDevice dev, u8 reg, u16 *out);
 
 // Max17050 fuel gauge
 float I2c_Max17050_GetBatteryCurrent();
+float I2c_Max17050_GetBatteryVoltage();
 
 const u8 MAX17050_CURRENT_REG = 0x0A;
+const u8 MAX17050_AVG_VCELL_REG = 0x19;
 
 // Buck Converter
 typedef enum I2c_BuckConverter_Reg {
@@ -13,7 +13,7 @@
 #include <stdint.h>
 #include "clocks.h"
 
-#define SYSCLK_IPC_API_VERSION 2
+#define SYSCLK_IPC_API_VERSION 3
 #define SYSCLK_IPC_SERVICE_NAME "sysclkOC"
 
 enum SysClkIpcCmd
@@ -34,6 +34,7 @@ enum SysClkIpcCmd
     SysClkIpcCmd_GetIsMariko = 13,
     SysClkIpcCmd_GetBatteryChargingDisabledOverride = 14,
     SysClkIpcCmd_SetBatteryChargingDisabledOverride = 15,
+    SysClkIpcCmd_GetGovernorStats = 16,
 };
 
 typedef struct
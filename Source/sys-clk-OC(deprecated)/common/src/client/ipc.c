@@ -143,3 +143,8 @@ Result sysclkIpcSetBatteryChargingDisabledOverride(bool toggle_true)
 {
     return serviceDispatchIn(&g_sysclkSrv, SysClkIpcCmd_SetBatteryChargingDisabledOverride, toggle_true);
 }
+
+Result sysclkIpcGetGovernorStats(SysClkGovernorStats* out_stats)
+{
+    return serviceDispatchOut(&g_sysclkSrv, SysClkIpcCmd_GetGovernorStats, *out_stats);
+}
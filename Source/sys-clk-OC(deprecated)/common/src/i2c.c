@@ -83,6 +83,16 @@ float I2c_Max17050_GetBatteryCurrent() {
     return (s16)val * (1.5625 / (SenseResistor * CGain));
 }
 
+float I2c_Max17050_GetBatteryVoltage() {
+    u16 val;
+    Result res = I2cRead_OutU16(I2cDevice_Max17050, MAX17050_AVG_VCELL_REG, &val);
+    if (res)
+        return 0.f;
+
+    // 0.625 mV per LSB on bits 15:3
+    return (val >> 3) * 0.625;
+}
+
 u32 I2c_BuckConverter_MultiplierToMvOut(const I2c_BuckConverter_Domain* domain, u8 multiplier) {
     return (domain->uv_min + domain->uv_step * multiplier) / 1000;
 }
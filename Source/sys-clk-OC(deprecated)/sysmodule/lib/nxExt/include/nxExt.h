@@ -13,3 +13,5 @@
 #include "nxExt/apm_ext.h"
 #include "nxExt/ipc_server.h"
 #include "nxExt/cpp/lockable_mutex.h"
+#include "nxExt/cpp/lockable_rwlock.h"
+#include "nxExt/cpp/counting_semaphore.h"
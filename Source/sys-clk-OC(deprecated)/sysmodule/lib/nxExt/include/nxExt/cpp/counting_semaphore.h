@@ -0,0 +1,63 @@
+/*
+ * --------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <p-sam@d3vs.net>, <natinusala@gmail.com>, <m4x@m4xw.net>
+ * wrote this file. As long as you retain this notice you can do whatever you
+ * want with this stuff. If you meet any of us some day, and you think this
+ * stuff is worth it, you can buy us a beer in return.  - The sys-clk authors
+ * --------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+
+#include <switch.h>
+
+class CountingSemaphore
+{
+public:
+    CountingSemaphore(u64 count = 0)
+    {
+        semaphoreInit(&this->s, count);
+    }
+
+    virtual ~CountingSemaphore() {}
+
+    void Wait()
+    {
+        semaphoreWait(&this->s);
+    }
+
+    bool TryWait()
+    {
+        return semaphoreTryWait(&this->s);
+    }
+
+    void Signal()
+    {
+        semaphoreSignal(&this->s);
+    }
+
+    // std::counting_semaphore aliases
+
+    void acquire()
+    {
+        this->Wait();
+    }
+
+    bool try_acquire()
+    {
+        return this->TryWait();
+    }
+
+    void release()
+    {
+        this->Signal();
+    }
+
+private:
+    Semaphore s;
+};
+
+#endif
@@ -0,0 +1,75 @@
+/*
+ * --------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <p-sam@d3vs.net>, <natinusala@gmail.com>, <m4x@m4xw.net>
+ * wrote this file. As long as you retain this notice you can do whatever you
+ * want with this stuff. If you meet any of us some day, and you think this
+ * stuff is worth it, you can buy us a beer in return.  - The sys-clk authors
+ * --------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+
+#include <mutex>
+#include <shared_mutex>
+#include <switch.h>
+
+class LockableRwLock
+{
+public:
+    LockableRwLock()
+    {
+        rwlockInit(&this->l);
+    }
+
+    virtual ~LockableRwLock() {}
+
+    void ReadLock()
+    {
+        rwlockReadLock(&this->l);
+    }
+
+    void ReadUnlock()
+    {
+        rwlockReadUnlock(&this->l);
+    }
+
+    void WriteLock()
+    {
+        rwlockWriteLock(&this->l);
+    }
+
+    void WriteUnlock()
+    {
+        rwlockWriteUnlock(&this->l);
+    }
+
+    // snake_case aliases in order to implement SharedLockable
+
+    void lock()
+    {
+        this->WriteLock();
+    }
+
+    void unlock()
+    {
+        this->WriteUnlock();
+    }
+
+    void lock_shared()
+    {
+        this->ReadLock();
+    }
+
+    void unlock_shared()
+    {
+        this->ReadUnlock();
+    }
+
+private:
+    RwLock l;
+};
+
+#endif
@@ -20,6 +20,7 @@ extern "C"
 #include <switch.h>
 
 #define IPC_SERVER_EXT_RESPONSE_MAX_DATA_SIZE (0x100 - 0x10 - sizeof(IpcServerRawHeader))
+#define IPC_SERVER_EXT_MESSAGE_SIZE 0x100
 
 typedef struct
 {
@@ -37,6 +38,10 @@ typedef struct
     Handle handles[MAX_WAIT_OBJECTS];
     u32 max;
     u32 count;
+    Mutex parkedMutex;
+    Handle parked[MAX_WAIT_OBJECTS]; // Sessions waiting for ipcServerReply, not listened to
+    u32 parkedCount;
+    Event wakeEvent;                 // Fired by ipcServerReply
 } IpcServer;
 
 typedef struct
@@ -52,11 +57,23 @@ typedef struct
     IpcServerRequestData data;
 } IpcServerRequest;
 
+// Request handed off the listening thread, replied to by ipcServerReply from any thread.
+// Buffers of the request stay mapped until then.
+typedef struct
+{
+    Handle session;
+    u8 message[IPC_SERVER_EXT_MESSAGE_SIZE] __attribute__((aligned(16)));
+} IpcServerDeferredRequest;
+
 typedef Result (*IpcServerRequestHandler)(void* userdata, const IpcServerRequest* r, u8* out_data, size_t* out_dataSize);
+// Return true after keeping a copy of d to reply later, false to have the request handled inline
+typedef bool (*IpcServerDeferHandler)(void* userdata, const IpcServerRequest* r, const IpcServerDeferredRequest* d);
 
 Result ipcServerInit(IpcServer* server, const char* name, u32 max_sessions);
 Result ipcServerExit(IpcServer* server);
 Result ipcServerProcess(IpcServer* server, IpcServerRequestHandler handler, void* userdata);
+Result ipcServerProcessEx(IpcServer* server, IpcServerRequestHandler handler, IpcServerDeferHandler defer, void* userdata);
+Result ipcServerReply(IpcServer* server, IpcServerDeferredRequest* d, IpcServerRequestHandler handler, void* userdata);
 Result ipcServerParseCommand(const IpcServerRequest* r, size_t *out_datasize, void** out_data, u64* out_cmd);
 
 #ifdef __cplusplus
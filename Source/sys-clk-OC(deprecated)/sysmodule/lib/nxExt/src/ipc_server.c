@@ -21,12 +21,24 @@ Result ipcServerInit(IpcServer* server, const char* name, u32 max_sessions)
     server->srvName = smEncodeName(name);
     server->max = max_sessions + 1;
     server->count = 0;
+    server->parkedCount = 0;
+    mutexInit(&server->parkedMutex);
 
-    Result rc = smRegisterService(&server->handles[0], server->srvName, false, max_sessions);
+    Result rc = eventCreate(&server->wakeEvent, false);
+    if(R_FAILED(rc))
+    {
+        return rc;
+    }
+
+    rc = smRegisterService(&server->handles[0], server->srvName, false, max_sessions);
     if(R_SUCCEEDED(rc))
     {
         server->count = 1;
     }
+    else
+    {
+        eventClose(&server->wakeEvent);
+    }
     return rc;
 }
 
@@ -37,6 +49,7 @@ Result ipcServerExit(IpcServer* server)
         svcCloseHandle(server->handles[i]);
     }
     server->count = 0;
+    eventClose(&server->wakeEvent);
     return smUnregisterService(server->srvName);
 }
 
@@ -69,10 +82,8 @@ static Result _ipcServerDeleteSession(IpcServer* server, u32 index)
     return 0;
 }
 
-static Result _ipcServerParseRequest(IpcServerRequest* r)
+static Result _ipcServerParseRequest(IpcServerRequest* r, u8* base)
 {
-    u8* base = armGetTls();
-
     r->hipc = hipcParseRequest(base);
     r->data.cmdId = 0;
     r->data.size = 0;
@@ -128,7 +139,57 @@ static Result _ipcServerProcessNewSession(IpcServer* server)
     return rc;
 }
 
-static Result _ipcServerProcessSession(IpcServer* server, IpcServerRequestHandler handler, void* userdata, u32 handleIndex)
+// Caller holds parkedMutex
+static bool _ipcServerIsParked(IpcServer* server, Handle session)
+{
+    for(u32 i = 0; i < server->parkedCount; i++)
+    {
+        if(server->parked[i] == session)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void _ipcServerSetParked(IpcServer* server, Handle session, bool parked)
+{
+    mutexLock(&server->parkedMutex);
+    if(parked)
+    {
+        server->parked[server->parkedCount++] = session;
+    }
+    else
+    {
+        for(u32 i = 0; i < server->parkedCount; i++)
+        {
+            if(server->parked[i] == session)
+            {
+                server->parked[i] = server->parked[--server->parkedCount];
+                break;
+            }
+        }
+    }
+    mutexUnlock(&server->parkedMutex);
+}
+
+static bool _ipcServerDefer(IpcServer* server, IpcServerDeferHandler defer, void* userdata, const IpcServerRequest* r, u32 handleIndex)
+{
+    IpcServerDeferredRequest d;
+    d.session = server->handles[handleIndex];
+    memcpy(d.message, armGetTls(), sizeof(d.message));
+
+    // Parked first, the reply may come before defer returns
+    _ipcServerSetParked(server, d.session, true);
+    if(defer(userdata, r, &d))
+    {
+        return true;
+    }
+    _ipcServerSetParked(server, d.session, false);
+    return false;
+}
+
+static Result _ipcServerProcessSession(IpcServer* server, IpcServerRequestHandler handler, IpcServerDeferHandler defer, void* userdata, u32 handleIndex)
 {
     s32 unusedIndex;
     IpcServerRequest r;
@@ -139,7 +200,7 @@ static Result _ipcServerProcessSession(IpcServer* server, IpcServerRequestHandle
     Result rc = svcReplyAndReceive(&unusedIndex, &server->handles[handleIndex], 1, 0, UINT64_MAX);
     if(R_SUCCEEDED(rc))
     {
-        rc = _ipcServerParseRequest(&r);
+        rc = _ipcServerParseRequest(&r, armGetTls());
     }
 
     if(R_SUCCEEDED(rc))
@@ -147,11 +208,13 @@ static Result _ipcServerProcessSession(IpcServer* server, IpcServerRequestHandle
         switch(r.hipc.meta.type)
         {
             case CmifCommandType_Request:
-                _ipcServerPrepareResponse(
-                    handler(userdata, &r, data, &dataSize),
-                    data,
-                    dataSize
-                );
+                if(defer && _ipcServerDefer(server, defer, userdata, &r, handleIndex))
+                {
+                    return 0;
+                }
+                // Separate statement: dataSize is only known once the handler returned
+                rc = handler(userdata, &r, data, &dataSize);
+                _ipcServerPrepareResponse(rc, data, dataSize);
                 break;
             case CmifCommandType_Close:
                 _ipcServerPrepareResponse(0, NULL, 0);
@@ -179,19 +242,50 @@ static Result _ipcServerProcessSession(IpcServer* server, IpcServerRequestHandle
 
 Result ipcServerProcess(IpcServer* server, IpcServerRequestHandler handler, void* userdata)
 {
-    s32 handleIndex = -1;
-    Result rc = svcWaitSynchronization(&handleIndex, server->handles, server->count, UINT64_MAX);
+    return ipcServerProcessEx(server, handler, NULL, userdata);
+}
+
+Result ipcServerProcessEx(IpcServer* server, IpcServerRequestHandler handler, IpcServerDeferHandler defer, void* userdata)
+{
+    // Parked sessions are left out until replied to, the wake event is only needed then
+    Handle handles[MAX_WAIT_OBJECTS];
+    u32 indices[MAX_WAIT_OBJECTS];
+    s32 count = 0;
 
-    if(R_SUCCEEDED(rc) && (handleIndex < 0 || handleIndex >= server->count))
+    mutexLock(&server->parkedMutex);
+    for(u32 i = 0; i < server->count; i++)
+    {
+        if(!_ipcServerIsParked(server, server->handles[i]))
+        {
+            indices[count] = i;
+            handles[count++] = server->handles[i];
+        }
+    }
+    if(server->parkedCount)
+    {
+        indices[count] = UINT32_MAX;
+        handles[count++] = server->wakeEvent.revent;
+    }
+    mutexUnlock(&server->parkedMutex);
+
+    s32 waitIndex = -1;
+    Result rc = svcWaitSynchronization(&waitIndex, handles, count, UINT64_MAX);
+
+    if(R_SUCCEEDED(rc) && (waitIndex < 0 || waitIndex >= count))
     {
         rc = MAKERESULT(Module_Libnx, LibnxError_NotFound);
     }
 
     if(R_SUCCEEDED(rc))
     {
-        if(handleIndex)
+        u32 handleIndex = indices[waitIndex];
+        if(handleIndex == UINT32_MAX)
         {
-            rc = _ipcServerProcessSession(server, handler, userdata, handleIndex);
+            eventClear(&server->wakeEvent);
+        }
+        else if(handleIndex)
+        {
+            rc = _ipcServerProcessSession(server, handler, defer, userdata, handleIndex);
         }
         else
         {
@@ -202,3 +296,30 @@ Result ipcServerProcess(IpcServer* server, IpcServerRequestHandler handler, void
     return rc;
 }
 
+Result ipcServerReply(IpcServer* server, IpcServerDeferredRequest* d, IpcServerRequestHandler handler, void* userdata)
+{
+    s32 unusedIndex;
+    IpcServerRequest r;
+    size_t dataSize = 0;
+    u8 data[IPC_SERVER_EXT_RESPONSE_MAX_DATA_SIZE];
+
+    // Response goes through the message buffer of the calling thread
+    Result rc = _ipcServerParseRequest(&r, d->message);
+    if(R_SUCCEEDED(rc))
+    {
+        rc = handler(userdata, &r, data, &dataSize);
+    }
+    _ipcServerPrepareResponse(rc, data, dataSize);
+
+    rc = svcReplyAndReceive(&unusedIndex, &d->session, 0, d->session, 0);
+    if(rc == KERNELRESULT(TimedOut))
+    {
+        rc = 0;
+    }
+
+    // A failed reply (client gone) is seen by the listener on its next wait
+    _ipcServerSetParked(server, d->session, false);
+    eventFire(&server->wakeEvent);
+
+    return rc;
+}
@@ -0,0 +1,300 @@
+/*
+ * --------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <p-sam@d3vs.net>, <natinusala@gmail.com>, <m4x@m4xw.net>
+ * wrote this file. As long as you retain this notice you can do whatever you
+ * want with this stuff. If you meet any of us some day, and you think this
+ * stuff is worth it, you can buy us a beer in return.  - The sys-clk authors
+ * --------------------------------------------------------------------------
+ */
+
+// Config load, reload, save and lookup cost on a large config.ini.
+//
+// "minIni" is the previous Config: ini_browse into std::map keyed by (tid, profile, module),
+// full reload on every mtime change, ini_putsection (whole file rewrite) on every SetProfiles.
+// "store" is ConfigStore (src/config_store.h): packed per title entries in a hash map,
+// reload diffed against the current state, edits written back in one pass.
+//
+// Usage: config_bench [-t titles] [-e edits] [-o ini_path]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <malloc.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <map>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <minIni.h>
+#include "config_store.h"
+
+using Clock = std::chrono::steady_clock;
+
+// Heap bytes in use, to compare the in-memory footprint (sysmodule heap is 320 KiB)
+static size_t HeapBytes() { return mallinfo2().uordblks; }
+
+typedef struct {
+    uint32_t titles = 1000;
+    uint32_t edits = 20;
+    const char* path = "config_bench.ini";
+} Options;
+
+static uint64_t TitleId(uint32_t i) { return 0x0100000000010000ULL + ((uint64_t)i << 13); }
+
+static void GenerateIni(const Options& opt, std::mt19937& rng) {
+    FILE* fp = fopen(opt.path, "w");
+    fprintf(fp, "; generated by config_bench\n[values]\npolling_interval_ms=300\nauto_cpu_boost=1\n\n");
+    fprintf(fp, "[governor]\ngovernor_headroom=400\n\n");
+    const uint32_t mhz[SysClkModule_EnumMax] = { 1785, 921, 1600 };
+    for (uint32_t i = 0; i < opt.titles; i++) {
+        fprintf(fp, "[%016llX]\n", (unsigned long long)TitleId(i));
+        for (int profile = 0; profile < SysClkProfile_EnumMax; profile++) {
+            for (int module = 0; module < SysClkModule_EnumMax; module++) {
+                if (rng() % 3)
+                    continue;
+                fprintf(fp, "%s_%s=%u\n", sysclkFormatProfile((SysClkProfile)profile, false),
+                        sysclkFormatModule((SysClkModule)module, false), mhz[module] - (uint32_t)(rng() % 4) * 100);
+            }
+        }
+        if (i % 4 == 0)
+            fprintf(fp, "governor_config=%u\n", (unsigned)(rng() % 3));
+        if (i % 50 == 0)
+            fprintf(fp, "governor_cpu_half_life_ms=%u\n", 20 + (unsigned)(rng() % 40));
+        fprintf(fp, "\n");
+    }
+    fclose(fp);
+}
+
+struct LegacyConfig {
+    std::map<std::tuple<uint64_t, SysClkProfile, SysClkModule>, uint32_t> profileMhzMap;
+    std::map<uint64_t, uint8_t> profileCountMap;
+    std::map<uint64_t, SysClkOcGovernorConfig> profileGovernorMap;
+    uint64_t configValues[SysClkConfigValue_EnumMax];
+
+    static int BrowseIniFunc(const char* section, const char* key, const char* value, void* userdata) {
+        LegacyConfig* config = (LegacyConfig*)userdata;
+        if (!strcmp(section, CONFIG_VAL_SECTION)) {
+            for (unsigned int kval = 0; kval < SysClkConfigValue_EnumMax; kval++) {
+                if (!strcmp(key, sysclkFormatConfigValue((SysClkConfigValue)kval, false)))
+                    config->configValues[kval] = strtoul(value, NULL, 0);
+            }
+            return 1;
+        }
+        uint64_t tid = strtoul(section, NULL, 16);
+        if (!tid || strlen(section) != 16)
+            return 1;
+        if (!strcmp(key, CONFIG_KEY_TITLE_GOVERNOR_CONFIG)) {
+            config->profileGovernorMap[tid] = (SysClkOcGovernorConfig)strtoul(value, NULL, 0);
+            return 1;
+        }
+        for (unsigned int profile = 0; profile < SysClkProfile_EnumMax; profile++) {
+            const char* profileCode = sysclkFormatProfile((SysClkProfile)profile, false);
+            size_t len = strlen(profileCode);
+            if (strncmp(key, profileCode, len) || key[len] != '_')
+                continue;
+            for (unsigned int module = 0; module < SysClkModule_EnumMax; module++) {
+                if (!strcmp(key + len + 1, sysclkFormatModule((SysClkModule)module, false))) {
+                    config->profileMhzMap[std::make_tuple(tid, (SysClkProfile)profile, (SysClkModule)module)] = strtoul(value, NULL, 10);
+                    config->profileCountMap[tid]++;
+                }
+            }
+        }
+        return 1;
+    }
+
+    void Load(const char* path) {
+        profileMhzMap.clear();
+        profileCountMap.clear();
+        profileGovernorMap.clear();
+        ini_browse(&BrowseIniFunc, this, path);
+    }
+
+    uint32_t FindMhz(uint64_t tid, SysClkProfile profile, SysClkModule module) const {
+        auto it = profileMhzMap.find(std::make_tuple(tid, profile, module));
+        return it != profileMhzMap.end() ? it->second : 0;
+    }
+
+    bool SetProfiles(const char* path, uint64_t tid, const SysClkTitleProfileList* profiles) {
+        constexpr int maxKeys = (int)SysClkProfile_EnumMax * (int)SysClkModule_EnumMax + 1;
+        char keysStr[maxKeys][0x40], valuesStr[maxKeys][0x10];
+        const char* keys[maxKeys + 1];
+        const char* values[maxKeys + 1];
+        int n = 0;
+        for (unsigned int profile = 0; profile < SysClkProfile_EnumMax; profile++) {
+            for (unsigned int module = 0; module < SysClkModule_EnumMax; module++) {
+                uint32_t mhz = profiles->mhzMap[profile][module];
+                if (!mhz)
+                    continue;
+                snprintf(keysStr[n], 0x40, "%s_%s", sysclkFormatProfile((SysClkProfile)profile, false), sysclkFormatModule((SysClkModule)module, false));
+                snprintf(valuesStr[n], 0x10, "%u", mhz);
+                keys[n] = keysStr[n];
+                values[n] = valuesStr[n];
+                n++;
+                profileMhzMap[std::make_tuple(tid, (SysClkProfile)profile, (SysClkModule)module)] = mhz;
+            }
+        }
+        keys[n] = values[n] = NULL;
+        char section[17];
+        snprintf(section, sizeof(section), "%016llX", (unsigned long long)tid);
+        return ini_putsection(section, keys, values, path);
+    }
+};
+
+template <typename F>
+static double TimeMs(int reps, F fn) {
+    auto begin = Clock::now();
+    for (int i = 0; i < reps; i++)
+        fn();
+    return std::chrono::duration<double, std::milli>(Clock::now() - begin).count() / reps;
+}
+
+static SysClkTitleProfileList MakeProfiles(std::mt19937& rng) {
+    SysClkTitleProfileList profiles = {};
+    profiles.mhzMap[SysClkProfile_Docked][SysClkModule_GPU] = 768 + (rng() % 4) * 76;
+    profiles.mhzMap[SysClkProfile_Handheld][SysClkModule_CPU] = 1020 + (rng() % 4) * 204;
+    profiles.governorConfig = SysClkOcGovernorConfig_Default;
+    return profiles;
+}
+
+static void Touch(const char* path) {
+    FILE* fp = fopen(path, "a");
+    fputs("\n", fp);
+    fclose(fp);
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc) {
+            fprintf(stderr, "Usage: %s [-t titles] [-e edits] [-o ini_path]\n", argv[0]);
+            return -1;
+        }
+        if (!strcmp(argv[i], "-t"))
+            opt.titles = std::max(1, atoi(argv[++i]));
+        else if (!strcmp(argv[i], "-e"))
+            opt.edits = std::max(1, atoi(argv[++i]));
+        else if (!strcmp(argv[i], "-o"))
+            opt.path = argv[++i];
+        else {
+            fprintf(stderr, "Usage: %s [-t titles] [-e edits] [-o ini_path]\n", argv[0]);
+            return -1;
+        }
+    }
+
+    std::mt19937 rng(42);
+    GenerateIni(opt, rng);
+    FILE* fp = fopen(opt.path, "rb");
+    fseek(fp, 0, SEEK_END);
+    printf("%u titles, %ld bytes, %u edits per burst\n", opt.titles, ftell(fp), opt.edits);
+    fclose(fp);
+
+    // Load and footprint
+    size_t heap = HeapBytes();
+    LegacyConfig* legacy = new LegacyConfig();
+    legacy->Load(opt.path);
+    size_t legacy_heap = HeapBytes() - heap;
+    heap = HeapBytes();
+    ConfigStore* store = new ConfigStore();
+    store->Load(opt.path);
+    size_t store_heap = HeapBytes() - heap;
+
+    double legacy_load = TimeMs(20, [&] { legacy->Load(opt.path); });
+    double store_load = TimeMs(20, [&] { store->Load(opt.path); });
+    printf("load          minIni %8.2f ms  store %8.2f ms\n", legacy_load, store_load);
+    printf("heap          minIni %8zu B   store %8zu B\n", legacy_heap, store_heap);
+
+    // Reload after an unrelated touch: the previous Config re-applied everything
+    ConfigStoreDiff diff = {};
+    double store_reload = TimeMs(20, [&] {
+        Touch(opt.path);
+        ConfigStore fresh;
+        fresh.Load(opt.path);
+        diff = fresh.Diff(*store);
+        *store = std::move(fresh);
+    });
+    printf("reload        minIni %8.2f ms  store %8.2f ms  (diff: %zu added, %zu removed, %zu changed, apply: %s)\n",
+           legacy_load, store_reload, diff.added, diff.removed, diff.changed, diff.Any() ? "yes" : "no");
+
+    // Burst of edits from the overlay
+    std::vector<std::pair<uint64_t, SysClkTitleProfileList>> edits;
+    for (uint32_t i = 0; i < opt.edits; i++)
+        edits.push_back({ TitleId(rng() % opt.titles), MakeProfiles(rng) });
+
+    double legacy_save = TimeMs(3, [&] {
+        for (auto& [tid, profiles] : edits)
+            legacy->SetProfiles(opt.path, tid, &profiles);
+    });
+    double store_save = TimeMs(3, [&] {
+        for (auto& [tid, profiles] : edits)
+            store->SetTitle(tid, &profiles);
+        store->Save(opt.path);
+    });
+    printf("edit burst    minIni %8.2f ms  store %8.2f ms\n", legacy_save, store_save);
+
+    // Both read back the same file
+    legacy->Load(opt.path);
+    ConfigStore check;
+    check.Load(opt.path);
+    size_t mismatches = check.Diff(*store).Any() ? 1 : 0;
+    for (uint32_t i = 0; i < opt.titles; i++) {
+        const ConfigTitle* title = check.FindTitle(TitleId(i));
+        for (int profile = 0; profile < SysClkProfile_EnumMax; profile++) {
+            for (int module = 0; module < SysClkModule_EnumMax; module++) {
+                uint32_t mhz = title ? title->mhz[profile][module] : 0;
+                if (mhz != legacy->FindMhz(TitleId(i), (SysClkProfile)profile, (SysClkModule)module))
+                    mismatches++;
+            }
+        }
+    }
+    printf("roundtrip     %s (%zu mismatches)\n", mismatches ? "FAILED" : "ok", mismatches);
+
+    // Save failing (temporary file blocked by a directory) while the file is edited externally:
+    // the reload picks up the external edit and keeps the unsaved one dirty for the next try
+    std::string tmp = std::string(opt.path) + CONFIG_STORE_TMP_SUFFIX;
+    SysClkTitleProfileList unsaved = MakeProfiles(rng), external = MakeProfiles(rng);
+    store->SetTitle(TitleId(0), &unsaved);
+    mkdir(tmp.c_str(), 0755);
+    bool saveFailed = !store->Save(opt.path);
+    legacy->SetProfiles(opt.path, TitleId(1), &external);
+    ConfigStore fresh;
+    fresh.Load(opt.path);
+    fresh.KeepUnsaved(*store);
+    *store = std::move(fresh);
+    rmdir(tmp.c_str());
+    bool merged = saveFailed && store->IsDirty() && store->Save(opt.path);
+    check.Load(opt.path);
+    for (auto& [tid, profiles] : { std::pair{ TitleId(0), &unsaved }, std::pair{ TitleId(1), &external } }) {
+        const ConfigTitle* title = check.FindTitle(tid);
+        for (int profile = 0; profile < SysClkProfile_EnumMax; profile++) {
+            for (int module = 0; module < SysClkModule_EnumMax; module++)
+                merged = merged && title && title->mhz[profile][module] == profiles->mhzMap[profile][module];
+        }
+    }
+    printf("failed save   %s\n", merged ? "ok" : "FAILED");
+    mismatches += !merged;
+
+    // GetAutoClockHz lookups
+    const int lookups = 1000000;
+    volatile uint32_t sink = 0;
+    double legacy_lookup = TimeMs(1, [&] {
+        for (int i = 0; i < lookups; i++)
+            sink = sink + legacy->FindMhz(TitleId(i % opt.titles), SysClkProfile_Handheld, (SysClkModule)(i % SysClkModule_EnumMax));
+    });
+    double store_lookup = TimeMs(1, [&] {
+        for (int i = 0; i < lookups; i++) {
+            const ConfigTitle* title = store->FindTitle(TitleId(i % opt.titles));
+            sink = sink + (title ? title->mhz[SysClkProfile_Handheld][i % SysClkModule_EnumMax] : 0);
+        }
+    });
+    printf("lookup        minIni %8.1f ns  store %8.1f ns\n", legacy_lookup * 1e6 / lookups, store_lookup * 1e6 / lookups);
+
+    delete legacy;
+    delete store;
+    remove(opt.path);
+    return mismatches ? -1 : 0;
+}
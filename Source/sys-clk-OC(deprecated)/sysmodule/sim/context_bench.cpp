@@ -0,0 +1,155 @@
+/*
+ * --------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <p-sam@d3vs.net>, <natinusala@gmail.com>, <m4x@m4xw.net>
+ * wrote this file. As long as you retain this notice you can do whatever you
+ * want with this stuff. If you meet any of us some day, and you think this
+ * stuff is worth it, you can buy us a beer in return.  - The sys-clk authors
+ * --------------------------------------------------------------------------
+ */
+
+// Latency of GetCurrentContext (as seen by the IPC server) while ClockManager::Tick is busy.
+//
+// The tick thread loops: slow work (I2C, temperature reads, CSV writes) for busy_us, then
+// updates the context. "mutex" holds the lock over the whole tick, as before; "seqlock"
+// works on a private copy and publishes it with SeqLock at the end of the tick.
+// A reader polls the context like an overlay hammering SysClkIpcCmd_GetCurrentContext.
+//
+// Usage: context_bench [-d duration_ms] [-b busy_us] [-i idle_us] [-p poll_us]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <sysclk/clocks.h>
+#include "seqlock.h"
+
+using Clock = std::chrono::steady_clock;
+
+typedef struct {
+    uint32_t duration_ms = 2000;
+    uint32_t busy_us = 2000;    // Slow part of a tick
+    uint32_t idle_us = 500;     // Sleep between ticks (polling interval)
+    uint32_t poll_us = 100;     // Reader poll interval
+} Options;
+
+static void BusyWork(uint32_t us, SysClkContext* ctx) {
+    // Spin instead of sleeping: with a sleep the OS hides the contention behind scheduling noise
+    auto end = Clock::now() + std::chrono::microseconds(us);
+    while (Clock::now() < end)
+        ctx->temps[0]++;
+}
+
+static void UpdateContext(SysClkContext* ctx, uint32_t gen) {
+    for (int i = 0; i < SysClkModule_EnumMax; i++)
+        ctx->freqs[i] = gen;
+    ctx->perfConfId = gen;
+}
+
+// Every field written by UpdateContext must match, or the reader saw a torn snapshot
+static bool IsConsistent(const SysClkContext& ctx) {
+    for (int i = 0; i < SysClkModule_EnumMax; i++) {
+        if (ctx.freqs[i] != ctx.perfConfId)
+            return false;
+    }
+    return true;
+}
+
+struct MutexContext {
+    std::mutex mutex;
+    SysClkContext context = {};
+
+    void Tick(const Options& opt, uint32_t gen) {
+        std::scoped_lock lock{mutex};
+        BusyWork(opt.busy_us, &context);
+        UpdateContext(&context, gen);
+    }
+
+    SysClkContext Get() {
+        std::scoped_lock lock{mutex};
+        return context;
+    }
+};
+
+struct SeqLockContext {
+    SysClkContext context = {};
+    SeqLock<SysClkContext> published;
+
+    void Tick(const Options& opt, uint32_t gen) {
+        BusyWork(opt.busy_us, &context);
+        UpdateContext(&context, gen);
+        published.Store(context);
+    }
+
+    SysClkContext Get() { return published.Load(); }
+};
+
+template <typename Impl>
+static void Run(const char* name, const Options& opt) {
+    Impl impl;
+    std::atomic_bool running = true;
+
+    std::thread ticker([&] {
+        uint32_t gen = 0;
+        while (running) {
+            impl.Tick(opt, ++gen);
+            std::this_thread::sleep_for(std::chrono::microseconds(opt.idle_us));
+        }
+    });
+
+    std::vector<uint64_t> samples;
+    uint64_t torn = 0;
+    auto end = Clock::now() + std::chrono::milliseconds(opt.duration_ms);
+    while (Clock::now() < end) {
+        auto begin = Clock::now();
+        SysClkContext ctx = impl.Get();
+        samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - begin).count());
+        if (!IsConsistent(ctx))
+            torn++;
+        std::this_thread::sleep_for(std::chrono::microseconds(opt.poll_us));
+    }
+
+    running = false;
+    ticker.join();
+
+    std::sort(samples.begin(), samples.end());
+    auto Percentile = [&](double p) { return samples[std::min(samples.size() - 1, (size_t)(p * samples.size()))] / 1000.; };
+    printf("%-8s %7zu reads  p50 %8.2f us  p99 %8.2f us  max %8.2f us  torn %llu\n",
+           name, samples.size(), Percentile(0.50), Percentile(0.99), samples.back() / 1000., (unsigned long long)torn);
+}
+
+static int Usage(const char* argv0) {
+    fprintf(stderr, "Usage: %s [-d duration_ms] [-b busy_us] [-i idle_us] [-p poll_us]\n", argv0);
+    return -1;
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc)
+            return Usage(argv[0]);
+        uint32_t value = atoi(argv[i + 1]);
+        if (!strcmp(argv[i], "-d"))
+            opt.duration_ms = value;
+        else if (!strcmp(argv[i], "-b"))
+            opt.busy_us = value;
+        else if (!strcmp(argv[i], "-i"))
+            opt.idle_us = value;
+        else if (!strcmp(argv[i], "-p"))
+            opt.poll_us = value;
+        else
+            return Usage(argv[0]);
+        i++;
+    }
+
+    printf("tick: %u us busy, %u us idle; reader polls every %u us for %u ms\n",
+           opt.busy_us, opt.idle_us, opt.poll_us, opt.duration_ms);
+    Run<MutexContext>("mutex", opt);
+    Run<SeqLockContext>("seqlock", opt);
+    return 0;
+}
@@ -0,0 +1,236 @@
+/*
+ * --------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <p-sam@d3vs.net>, <natinusala@gmail.com>, <m4x@m4xw.net>
+ * wrote this file. As long as you retain this notice you can do whatever you
+ * want with this stuff. If you meet any of us some day, and you think this
+ * stuff is worth it, you can buy us a beer in return.  - The sys-clk authors
+ * --------------------------------------------------------------------------
+ */
+
+// Energy of the governor frequency choice with and without GovernorCore::EnergyModel
+// (governor_energy_model in config.ini), for every steady demand from 1% to 100% of max_hz.
+//
+// Energy per second at a step: V^2 * (cycles + leak_hz * busy), busy = cycles / hz.
+// Dynamic energy only depends on the voltage, so the model can only win on leakage: at the
+// same voltage a faster step finishes the same work sooner and the cores power-gate earlier.
+// leak_hz (-L, permille of max_hz) is the leakage while busy, as dynamic cycles at the same voltage.
+//
+// Second part: the model starts without voltages and learns them from the rail after each
+// transition (BaseGovernor::ApplyNewFreqFromTargetHz), over a random walk of demands.
+//
+// Exits with 1 if the model ever picks a step with a higher voltage or more energy than the
+// plain rounding, or never saves anything.
+//
+// Usage: energy_bench [-L leak_permille] [-H headroom] [-n samples] [-v]
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include "governor_core.h"
+
+using namespace GovernorCore;
+
+// Stock Mariko DVFS tables, zero terminated, with the rail voltage read at each step
+// on a unit around speedo 1700 (same as governor_sim)
+static uint32_t cpuHzList[] = {
+     204'000'000,  306'000'000,  408'000'000,  510'000'000,  612'000'000,  714'000'000,
+     816'000'000,  918'000'000, 1020'000'000, 1122'000'000, 1224'000'000, 1326'000'000,
+    1428'000'000, 1581'000'000, 1683'000'000, 1785'000'000, 1887'000'000, 1963'500'000,
+    0
+};
+static uint32_t cpuMvList[] = {
+     620,  620,  620,  620,  620,  620,  620,  620,  620,  644,  677,  713,
+     753,  820,  870,  922,  979, 1026,
+};
+static uint32_t gpuHzList[] = {
+      76'800'000,  153'600'000,  230'400'000,  307'200'000,  384'000'000,  460'800'000,
+     537'600'000,  614'400'000,  691'200'000,  768'000'000,  844'800'000,  921'600'000,
+    0
+};
+static uint32_t gpuMvList[] = {
+     610,  610,  610,  610,  610,  610,  610,  610,  622,  647,  674,  696,
+};
+
+typedef struct {
+    uint32_t leak;      // permille of max_hz
+    uint32_t headroom;
+    uint32_t samples;
+    bool verbose;
+} Options;
+
+typedef struct Module {
+    const char* name;
+    uint32_t* hz_list;
+    uint32_t* mv_list;
+    uint32_t min_hz, max_hz;
+    FreqIndex index;
+
+    uint32_t Mv(uint32_t hz) const {
+        size_t i = 0;
+        while (hz_list[i + 1] && hz_list[i] < hz)
+            i++;
+        return mv_list[i];
+    }
+
+    // Energy per second for cycles per second at hz
+    double Energy(double cycles, uint32_t hz, double leak_hz) const {
+        double v = Mv(hz) / 1000.;
+        return v * v * (cycles + leak_hz * cycles / hz) / 1e9;
+    }
+
+    void BuildModel(EnergyModel& em, bool learned) const {
+        em.Reset();
+        for (size_t i = 0; hz_list[i]; i++)
+            em.Add(hz_list[i], learned ? mv_list[i] : 0);
+        em.Finalize();
+    }
+} Module;
+
+static unsigned errors = 0;
+
+// Steady demand from 1% to 100% of max_hz, fully learned model against next-step rounding
+static void SteadyState(const Module& m, const Options& opt) {
+    EnergyModel em;
+    m.BuildModel(em, true);
+    const double leak_hz = (double)m.max_hz * opt.leak / 1000;
+
+    double base_total = 0, em_total = 0, base_dyn = 0, em_dyn = 0, base_busy = 0, em_busy = 0;
+    uint32_t differ = 0;
+    if (opt.verbose)
+        printf("  %7s %9s %9s %7s %7s %8s\n", "demand", "base MHz", "em MHz", "busy", "busy", "energy");
+
+    for (uint32_t pct = 1; pct <= 100; pct++) {
+        const uint32_t util = pct * 10;
+        const double cycles = (double)m.max_hz * pct / 100;
+        const uint32_t target = TargetHz(m.max_hz, util, opt.headroom);
+        const uint32_t base_hz = RoundHz(m.index, m.min_hz, m.max_hz, target);
+        const uint32_t em_hz = RoundHz(m.index, m.min_hz, m.max_hz, target, &em);
+
+        const double base_e = m.Energy(std::min<double>(cycles, base_hz), base_hz, leak_hz);
+        const double em_e = m.Energy(std::min<double>(cycles, em_hz), em_hz, leak_hz);
+        base_total += base_e;
+        em_total += em_e;
+        base_dyn += m.Energy(std::min<double>(cycles, base_hz), base_hz, 0);
+        em_dyn += m.Energy(std::min<double>(cycles, em_hz), em_hz, 0);
+        base_busy += std::min(1., cycles / base_hz);
+        em_busy += std::min(1., cycles / em_hz);
+
+        if (em_hz < base_hz || m.Mv(em_hz) > m.Mv(base_hz) || em_e > base_e * (1 + 1e-9)) {
+            fprintf(stderr, "[%s] demand %u%%: model picks %u Hz (%u mV) over %u Hz (%u mV)\n",
+                    m.name, pct, em_hz, m.Mv(em_hz), base_hz, m.Mv(base_hz));
+            errors++;
+        }
+        if (em_hz != base_hz) {
+            differ++;
+            if (opt.verbose) {
+                printf("  %6u%% %9.1f %9.1f %6.1f%% %6.1f%% %+7.2f%%\n", pct, base_hz / 1e6, em_hz / 1e6,
+                       100. * cycles / base_hz, 100. * cycles / em_hz, 100. * (em_e / base_e - 1));
+            }
+        }
+    }
+
+    printf("[%s] %u / 100 demand levels on a faster step, energy %.3f of plain rounding "
+           "(dynamic %.3f), busy time %.3f\n", m.name, differ, em_total / base_total,
+           em_dyn / base_dyn, em_busy / base_busy);
+    if (em_total >= base_total) {
+        fprintf(stderr, "[%s] no energy saved\n", m.name);
+        errors++;
+    }
+}
+
+// Model learning from the rail over a random walk, as on console
+static void Learning(const Module& m, const Options& opt) {
+    EnergyModel em, full;
+    m.BuildModel(em, false);
+    m.BuildModel(full, true);
+
+    std::mt19937 rng(7);
+    uint32_t demand = 300, cur_hz = m.max_hz;
+    bool pending = true;
+    uint32_t match_at = 0, converged = 0;
+    size_t steps = 0;
+    while (m.hz_list[steps])
+        steps++;
+
+    for (uint32_t i = 1; i <= opt.samples; i++) {
+        demand = std::clamp<int>((int)demand + (int)(rng() % 201) - 100, 0, (int)UTIL_MAX);
+        if (pending) {
+            pending = false;
+            em.Observe(cur_hz, m.Mv(cur_hz));
+        }
+
+        const uint32_t target = TargetHz(m.max_hz, demand, opt.headroom);
+        const uint32_t base_hz = RoundHz(m.index, m.min_hz, m.max_hz, target);
+        const uint32_t em_hz = RoundHz(m.index, m.min_hz, m.max_hz, target, &em);
+        if (m.Mv(em_hz) > m.Mv(base_hz)) {
+            fprintf(stderr, "[%s] sample %u: partial model picks %u Hz (%u mV) over %u Hz (%u mV)\n",
+                    m.name, i, em_hz, m.Mv(em_hz), base_hz, m.Mv(base_hz));
+            errors++;
+        }
+
+        // Same choice as the fully learned model, for every demand
+        if (!converged) {
+            bool same = true;
+            for (uint32_t u = 0; u <= UTIL_MAX && same; u += 10) {
+                uint32_t t = TargetHz(m.max_hz, u, opt.headroom);
+                same = RoundHz(m.index, m.min_hz, m.max_hz, t, &em) == RoundHz(m.index, m.min_hz, m.max_hz, t, &full);
+            }
+            if (same)
+                converged = i;
+        }
+        if (em_hz == RoundHz(m.index, m.min_hz, m.max_hz, target, &full))
+            match_at++;
+
+        if (em_hz != cur_hz) {
+            cur_hz = em_hz;
+            pending = true;
+        }
+    }
+
+    size_t learned = 0;
+    for (size_t i = 0; i < em.Count(); i++)
+        learned += em[i].mv != 0;
+    printf("[%s] learning: %zu / %zu steps after %u samples, same choice as the full model "
+           "on %.1f%% of samples, for all demands after ", m.name, learned, steps, opt.samples,
+           100. * match_at / opt.samples);
+    if (converged)
+        printf("%u samples\n", converged);
+    else
+        printf("never\n");
+}
+
+static int Usage(const char* argv0) {
+    fprintf(stderr, "Usage: %s [-L leak_permille] [-H headroom] [-n samples] [-v]\n", argv0);
+    return -1;
+}
+
+int main(int argc, char** argv) {
+    Options opt = { .leak = 300, .headroom = HEADROOM_DEFAULT, .samples = 10'000, .verbose = false };
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-L") && i + 1 < argc)
+            opt.leak = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-H") && i + 1 < argc)
+            opt.headroom = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-n") && i + 1 < argc)
+            opt.samples = std::max(1, atoi(argv[++i]));
+        else if (!strcmp(argv[i], "-v"))
+            opt.verbose = true;
+        else
+            return Usage(argv[0]);
+    }
+
+    // Same defaults as governor_sim: 1785 MHz CPU, 921.6 MHz GPU, GPU floor at 153.6 MHz
+    Module cpu = { .name = "CPU", .hz_list = cpuHzList, .mv_list = cpuMvList, .min_hz = cpuHzList[0], .max_hz = 1785'000'000 };
+    Module gpu = { .name = "GPU", .hz_list = gpuHzList, .mv_list = gpuMvList, .min_hz = 153'600'000, .max_hz = 921'600'000 };
+    printf("leakage %u permille of max_hz while busy, headroom %u\n", opt.leak, opt.headroom);
+
+    for (Module* m : { &cpu, &gpu }) {
+        m->index.Build(m->hz_list);
+        SteadyState(*m, opt);
+        Learning(*m, opt);
+    }
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,222 @@
+/*
+ * --------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <p-sam@d3vs.net>, <natinusala@gmail.com>, <m4x@m4xw.net>
+ * wrote this file. As long as you retain this notice you can do whatever you
+ * want with this stuff. If you meet any of us some day, and you think this
+ * stuff is worth it, you can buy us a beer in return.  - The sys-clk authors
+ * --------------------------------------------------------------------------
+ */
+
+// Equivalence check and lookup cost of GovernorCore::FreqIndex against the linear scans
+// it replaces (NearestHzPtr, CeilHz, FloorHz, all in src/governor_core.h).
+//
+// Lookups are piecewise constant between breakpoints (steps and bucket starts), so checking
+// every breakpoint - 1, itself and + 1 covers every Hz value. -f also tries all 2^32 values
+// on the stock tables, -r adds random tables (dense, duplicates, unsorted) to the checks.
+//
+// Usage: freq_index_bench [-f] [-r random_tables] [-n lookups]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "governor_core.h"
+
+using namespace GovernorCore;
+using Clock = std::chrono::steady_clock;
+
+typedef struct {
+    const char* name;
+    std::vector<uint32_t> hz; // Without the terminating zero
+} Table;
+
+// Stock Mariko CPU/GPU DVFS tables and the Erista MEM table with the loader OC ladder
+static std::vector<Table> StockTables() {
+    return {
+        { "CPU", {  204'000'000,  306'000'000,  408'000'000,  510'000'000,  612'000'000,  714'000'000,
+                    816'000'000,  918'000'000, 1020'000'000, 1122'000'000, 1224'000'000, 1326'000'000,
+                   1428'000'000, 1581'000'000, 1683'000'000, 1785'000'000, 1887'000'000, 1963'500'000,
+                   2091'000'000, 2193'000'000, 2295'000'000, 2397'000'000 } },
+        { "GPU", {   76'800'000,  153'600'000,  230'400'000,  307'200'000,  384'000'000,  460'800'000,
+                    537'600'000,  614'400'000,  691'200'000,  768'000'000,  844'800'000,  921'600'000,
+                    998'400'000, 1075'200'000, 1152'000'000, 1228'800'000, 1267'200'000, 1305'600'000 } },
+        { "MEM", {  665'600'000,  800'000'000, 1065'600'000, 1331'200'000, 1600'000'000,
+                   1728'000'000, 1795'200'000, 1862'400'000 } },
+    };
+}
+
+static std::vector<Table> RandomTables(size_t count) {
+    std::vector<Table> tables;
+    std::mt19937 rng(42);
+    for (size_t i = 0; i < count; i++) {
+        Table t = { "random", {} };
+        size_t n = 1 + rng() % FREQ_TABLE_MAX_ENTRY_COUNT;
+        uint32_t gap = i % 3 == 0 ? 1 << 18 : 1 << 27; // Dense tables put several steps in a bucket
+        uint32_t hz = 1 + rng() % gap;
+        for (size_t j = 0; j < n; j++) {
+            t.hz.push_back(hz);
+            uint32_t step = i % 5 == 1 ? 0 : rng() % gap; // Duplicates
+            hz = std::min<uint64_t>(UINT32_MAX, (uint64_t)hz + step);
+        }
+        if (i % 7 == 3)
+            std::shuffle(t.hz.begin(), t.hz.end(), rng);
+        tables.push_back(t);
+    }
+    return tables;
+}
+
+static std::vector<uint32_t> Breakpoints(const Table& t) {
+    std::vector<uint64_t> points = { 0, UINT32_MAX };
+    for (uint32_t hz : t.hz)
+        points.push_back(hz);
+    for (uint64_t b = 0; b < FreqIndex::BUCKETS; b++)
+        points.push_back(b << FreqIndex::BUCKET_SHIFT);
+
+    std::vector<uint32_t> out;
+    for (uint64_t p : points) {
+        for (int64_t d = -1; d <= 1; d++) {
+            int64_t hz = (int64_t)p + d;
+            if (hz >= 0 && hz <= UINT32_MAX)
+                out.push_back(hz);
+        }
+    }
+    return out;
+}
+
+// Returns the number of mismatches, printing the first few
+static uint64_t Check(const Table& t, const FreqIndex& index, uint32_t hz) {
+    const uint32_t* list = t.hz.data();
+    size_t n = t.hz.size();
+    std::vector<uint32_t> zt(t.hz);
+    zt.push_back(0);
+    uint64_t errors = 0;
+
+    auto Report = [&](const char* what, uint64_t expected, uint64_t got) {
+        if (errors++ < 3)
+            fprintf(stderr, "%s table (%zu steps): %s(%u) = %llu, expected %llu\n",
+                    t.name, n, what, hz, (unsigned long long)got, (unsigned long long)expected);
+    };
+
+    if (uint32_t e = CeilHz(zt.data(), hz), g = index.Ceil(hz); e != g)
+        Report("Ceil", e, g);
+    if (uint32_t e = FloorHz(zt.data(), hz), g = index.Floor(hz); e != g)
+        Report("Floor", e, g);
+
+    // Every (min, max) range of FreqRange::FindFreq, from index 0 up to Clocks::GetRange limits
+    for (size_t lo = 0; lo < n; lo++) {
+        for (size_t hi = lo; hi < n; hi++) {
+            size_t e = NearestHzPtr(list + lo, list + hi, hz) - list;
+            size_t g = index.NearestIdx(lo, hi, hz);
+            if (e != g)
+                Report("NearestIdx", e, g);
+        }
+    }
+    return errors;
+}
+
+static uint64_t CheckTable(const Table& t, bool full) {
+    std::vector<uint32_t> zt(t.hz);
+    zt.push_back(0);
+    FreqIndex index;
+    index.Build(zt.data());
+
+    uint64_t errors = 0;
+    for (uint32_t hz : Breakpoints(t))
+        errors += Check(t, index, hz);
+
+    if (full) {
+        // Ceil and Floor only, NearestIdx ranges would take days
+        for (uint64_t hz = 0; hz <= UINT32_MAX; hz++) {
+            if (CeilHz(zt.data(), hz) != index.Ceil(hz) || FloorHz(zt.data(), hz) != index.Floor(hz)) {
+                if (errors++ < 3)
+                    fprintf(stderr, "%s table: full scan mismatch at %llu\n", t.name, (unsigned long long)hz);
+            }
+        }
+    }
+    return errors;
+}
+
+template <typename F>
+static double NsPerLookup(const std::vector<uint32_t>& queries, F fn) {
+    uint64_t sink = 0;
+    auto start = Clock::now();
+    for (uint32_t hz : queries)
+        sink += fn(hz);
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / queries.size();
+    if (sink == 42) // Keep the loop
+        printf(" ");
+    return ns;
+}
+
+static void Bench(const Table& t, size_t lookups) {
+    std::vector<uint32_t> zt(t.hz);
+    zt.push_back(0);
+    const uint32_t* list = zt.data();
+    size_t n = t.hz.size();
+    FreqIndex index;
+    index.Build(list);
+
+    // Governor targets spread over the table, a bit above the last step like TargetHz with headroom
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<uint32_t> dist(0, t.hz.back() + t.hz.back() / 8);
+    std::vector<uint32_t> queries(lookups);
+    for (auto& q : queries)
+        q = dist(rng);
+
+    auto buildStart = Clock::now();
+    FreqIndex rebuilt;
+    rebuilt.Build(list);
+    double buildUs = std::chrono::duration<double, std::micro>(Clock::now() - buildStart).count();
+
+    double linearCeil  = NsPerLookup(queries, [&](uint32_t hz) { return CeilHz(list, hz); });
+    double indexCeil   = NsPerLookup(queries, [&](uint32_t hz) { return index.Ceil(hz); });
+    double linearFloor = NsPerLookup(queries, [&](uint32_t hz) { return FloorHz(list, hz); });
+    double indexFloor  = NsPerLookup(queries, [&](uint32_t hz) { return index.Floor(hz); });
+    double linearNear  = NsPerLookup(queries, [&](uint32_t hz) { return *NearestHzPtr(list, list + n - 1, hz); });
+    double indexNear   = NsPerLookup(queries, [&](uint32_t hz) { return list[index.NearestIdx(0, n - 1, hz)]; });
+
+    printf("%-4s %2zu steps  ceil %5.2f -> %5.2f ns  floor %5.2f -> %5.2f ns  nearest %5.2f -> %5.2f ns  build %6.2f us\n",
+           t.name, n, linearCeil, indexCeil, linearFloor, indexFloor, linearNear, indexNear, buildUs);
+}
+
+static int Usage(const char* argv0) {
+    fprintf(stderr, "Usage: %s [-f] [-r random_tables] [-n lookups]\n", argv0);
+    return -1;
+}
+
+int main(int argc, char** argv) {
+    bool full = false;
+    size_t randomTables = 200;
+    size_t lookups = 10'000'000;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-f"))
+            full = true;
+        else if (!strcmp(argv[i], "-r") && i + 1 < argc)
+            randomTables = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-n") && i + 1 < argc)
+            lookups = std::max(1, atoi(argv[++i]));
+        else
+            return Usage(argv[0]);
+    }
+
+    printf("index: %zu buckets of %u Hz, %zu bytes\n", FreqIndex::BUCKETS, 1u << FreqIndex::BUCKET_SHIFT, sizeof(FreqIndex));
+
+    uint64_t errors = 0;
+    std::vector<Table> stock = StockTables();
+    for (const Table& t : stock)
+        errors += CheckTable(t, full);
+    std::vector<Table> random = RandomTables(randomTables);
+    for (const Table& t : random)
+        errors += CheckTable(t, false);
+    printf("equivalence: %zu stock%s + %zu random tables, %llu mismatches\n",
+           stock.size(), full ? " (all 2^32 Hz)" : "", random.size(), (unsigned long long)errors);
+
+    for (const Table& t : stock)
+        Bench(t, lookups);
+
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,523 @@
+/*
+ * --------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <p-sam@d3vs.net>, <natinusala@gmail.com>, <m4x@m4xw.net>
+ * wrote this file. As long as you retain this notice you can do whatever you
+ * want with this stuff. If you meet any of us some day, and you think this
+ * stuff is worth it, you can buy us a beer in return.  - The sys-clk authors
+ * --------------------------------------------------------------------------
+ */
+
+// Host replay of the CPU/GPU governors in src/oc_extra against recorded traces.
+//
+// Trace (CSV, one row per sample, header line optional):
+//   systick,idle0,idle1,idle2,idle3,gpu_load[,cpu_hz,gpu_hz[,frame_us]]
+// systick and idleN are cumulative counters (armGetSystemTick / IdleTickCount),
+// gpu_load is the raw nvgpu load (0 - 1000). cpu_hz and gpu_hz are the clocks
+// the trace was recorded at; the demand is rescaled to the simulated clocks
+// (work = util * hz). Without them (or 0) the trace is assumed to be recorded at max.
+// frame_us is the average present interval, GPU busy time per frame is rescaled
+// the same way and the frame cannot finish earlier than recorded (vsync, CPU bound).
+//
+// Usage: governor_sim <trace.csv> [timeline.csv] [-c cpu_max_mhz] [-g gpu_max_mhz] [-b] [-e] [-f] [-t]
+//                     [-H headroom] [-l cpu_ms,gpu_ms] [-k cpu_mhz,gpu_mhz@ms]
+// -H and -l take the same values as governor_headroom / governor_*_half_life_ms in config.ini.
+// The trace is replayed at its own rate, so governor_sample_rate cannot be simulated.
+// -k lowers the max clocks during the replay (Governor::SetMaxHz), the exit code is 1 if
+// a governor never gets under its new cap.
+// Every run first checks the util trackers at the maximum tuning (half-life and sample
+// rate), the exit code is 1 if they do not saturate at UTIL_MAX.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <vector>
+#include "governor_core.h"
+
+using namespace GovernorCore;
+
+// Same as BOOST_THRESHOLD in clocks.h
+constexpr uint32_t BOOST_THRESHOLD = 95'0;
+constexpr int CORE_NUMS = 4;
+constexpr int SYS_CORE_ID = CORE_NUMS - 1;
+
+// Stock Mariko DVFS tables, zero terminated (Clocks::freqTable is filled from PCV on console)
+static uint32_t cpuHzList[] = {
+     204'000'000,  306'000'000,  408'000'000,  510'000'000,  612'000'000,  714'000'000,
+     816'000'000,  918'000'000, 1020'000'000, 1122'000'000, 1224'000'000, 1326'000'000,
+    1428'000'000, 1581'000'000, 1683'000'000, 1785'000'000, 1887'000'000, 1963'500'000,
+    0
+};
+static uint32_t gpuHzList[] = {
+      76'800'000,  153'600'000,  230'400'000,  307'200'000,  384'000'000,  460'800'000,
+     537'600'000,  614'400'000,  691'200'000,  768'000'000,  844'800'000,  921'600'000,
+    0
+};
+
+// Rail voltage of each step, as read by Clocks::GetVoltageMv on a unit around speedo 1700.
+// The energy model starts empty and learns them once a step has been applied, like on console.
+static uint32_t cpuMvList[] = {
+     620,  620,  620,  620,  620,  620,  620,  620,  620,  644,  677,  713,
+     753,  820,  870,  922,  979, 1026,
+};
+static uint32_t gpuMvList[] = {
+     610,  610,  610,  610,  610,  610,  610,  610,  622,  647,  674,  696,
+};
+
+typedef struct {
+    uint64_t systick;
+    uint64_t idletick[CORE_NUMS];
+    uint32_t gpu_load;
+    uint32_t cpu_hz, gpu_hz;
+    uint32_t frame_us;
+} Sample;
+
+// Frame interval replayed from trace, as seen with the simulated GPU clock
+class TraceFrameSource : public FrameTimingSource {
+public:
+    uint32_t GetFrameIntervalUs() override { return interval_us; };
+
+    void Update(const Sample& s, uint32_t rec_hz, uint32_t sim_hz) {
+        if (!s.frame_us) {
+            interval_us = 0;
+            return;
+        }
+        uint64_t busy_us = (uint64_t)s.frame_us * s.gpu_load / UTIL_MAX * rec_hz / sim_hz;
+        interval_us = std::max<uint64_t>(s.frame_us, busy_us);
+
+        // Deadline of the frame rate the trace was running at
+        uint32_t period = s.frame_us < FramePacer::PERIOD_45FPS_US ? FramePacer::PERIOD_60FPS_US : FramePacer::PERIOD_30FPS_US;
+        frames++;
+        if (interval_us > period + period / 20)
+            missed++;
+    }
+
+    uint32_t interval_us = 0;
+    uint64_t frames = 0, missed = 0;
+};
+
+// Mock of the Clocks backend: SetHz just records the chosen frequency
+typedef struct MockModule {
+    const char* name;
+    uint32_t* hz_list;
+    uint32_t* mv_list;
+    FreqIndex index;
+    EnergyModel em;
+    bool use_em;
+    bool observe_pending = false;
+    bool use_limiter;
+    TransitionLimiter limiter;
+    uint64_t suppressed = 0, delayed_ns = 0;
+    uint32_t min_hz, max_hz, boost_hz;
+    uint32_t target_hz;
+
+    std::map<uint32_t, uint64_t> time_at_hz;   // hz -> ticks
+    double energy = 0, energy_max = 0;
+    uint32_t transitions = 0;
+
+    void SetHz(uint32_t hz) {
+        if (!hz || hz == target_hz)
+            return;
+        target_hz = hz;
+        transitions++;
+        observe_pending = true;
+    }
+
+    void Init() {
+        index.Build(hz_list);
+        em.Reset();
+        for (size_t i = 0; hz_list[i]; i++)
+            em.Add(hz_list[i]);
+        em.Finalize();
+    }
+
+    // BaseGovernor::ApplyNewFreqFromTargetHz
+    void Govern(uint64_t now_ns, uint32_t target_hz) {
+        if (use_em && observe_pending) {
+            observe_pending = false;
+            em.Observe(this->target_hz, Mv(this->target_hz));
+        }
+
+        uint32_t new_hz = RoundHz(index, min_hz, max_hz, target_hz, use_em ? &em : nullptr);
+        if (!use_limiter) {
+            SetHz(new_hz);
+            return;
+        }
+
+        switch (limiter.Check(now_ns, this->target_hz, target_hz, new_hz, min_hz, max_hz)) {
+            case TransitionLimiter::Decision_Keep:
+                break;
+            case TransitionLimiter::Decision_Apply:
+                delayed_ns += limiter.OnApplied(now_ns);
+                SetHz(new_hz);
+                break;
+            default:
+                suppressed++;
+                break;
+        }
+    }
+
+    uint32_t Mv(uint32_t hz) {
+        size_t i = 0;
+        while (hz_list[i + 1] && hz_list[i] < hz)
+            i++;
+        return mv_list[i];
+    }
+
+    uint32_t Cost(uint32_t hz) { return Mv(hz) * Mv(hz); }
+
+    // Dynamic energy ~ busy cycles * V^2, demand is the util at max_hz.
+    // Idle and leakage power are not modeled.
+    void Account(uint32_t demand) {
+        time_at_hz[target_hz]++;
+        double cycles = std::min<double>((double)demand * max_hz / UTIL_MAX, target_hz);
+        energy     += cycles * Cost(target_hz) / 1e12;
+        energy_max += (double)demand * max_hz / UTIL_MAX * Cost(max_hz) / 1e12;
+    }
+} MockModule;
+
+// Load spike: demand jumps from below half load to above the 1.5x tipping point (66.7%),
+// where SelectHz would pick max_hz for frequency-invariant util
+typedef struct SpikeTracker {
+    int64_t since = -1;
+    uint32_t prev_demand = UTIL_MAX;
+    std::vector<uint64_t> latencies;    // ticks
+    uint32_t missed = 0;
+
+    void Update(uint64_t tick, uint32_t demand, uint32_t hz, uint32_t max_hz) {
+        if (since < 0 && prev_demand < UTIL_MAX / 2 && demand * 3 >= UTIL_MAX * 2)
+            since = tick;
+        if (since >= 0) {
+            if (hz >= max_hz) {
+                latencies.push_back(tick - since);
+                since = -1;
+            } else if (demand < UTIL_MAX / 2) {
+                missed++;
+                since = -1;
+            }
+        }
+        prev_demand = demand;
+    }
+} SpikeTracker;
+
+static bool ParseSample(const char* line, Sample* s) {
+    unsigned long long v[9] = {};
+    int n = sscanf(line, "%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu",
+                   &v[0], &v[1], &v[2], &v[3], &v[4], &v[5], &v[6], &v[7], &v[8]);
+    if (n < 6)
+        return false;
+
+    s->systick = v[0];
+    for (int i = 0; i < CORE_NUMS; i++)
+        s->idletick[i] = v[1 + i];
+    s->gpu_load = std::min<uint32_t>(v[5], UTIL_MAX);
+    s->cpu_hz   = n >= 7 ? v[6] : 0;
+    s->gpu_hz   = n >= 8 ? v[7] : 0;
+    s->frame_us = n >= 9 ? v[8] : 0;
+    return true;
+}
+
+// Demand recorded at rec_hz, replayed at sim_hz
+static uint32_t Rescale(uint32_t util, uint32_t rec_hz, uint32_t sim_hz) {
+    uint64_t scaled = (uint64_t)util * rec_hz / sim_hz;
+    return std::min<uint64_t>(scaled, UTIL_MAX);
+}
+
+static void PrintSummary(MockModule& m, uint64_t ticks) {
+    printf("[%s] transitions: %u, energy proxy: %.1f (%.3f of always-max)\n",
+           m.name, m.transitions, m.energy, m.energy_max ? m.energy / m.energy_max : 0.);
+    if (m.use_limiter) {
+        printf("[%s] limiter: %llu suppressed, %llu ms delayed\n", m.name,
+               (unsigned long long)m.suppressed, (unsigned long long)(m.delayed_ns / 1000'000));
+    }
+    printf("  %10s %10s %8s\n", "MHz", "ms", "%");
+    for (auto& [hz, t] : m.time_at_hz) {
+        printf("  %10.1f %10llu %7.2f%%\n",
+               hz / 1e6, (unsigned long long)(t * TICK_TIME_NS / 1000'000), 100. * t / ticks);
+    }
+}
+
+static void PrintLatency(const char* name, SpikeTracker& s) {
+    if (s.latencies.empty()) {
+        printf("[%s] no load spike reached max (%u missed)\n", name, s.missed);
+        return;
+    }
+    uint64_t sum = 0, worst = 0;
+    for (uint64_t l : s.latencies) {
+        sum += l;
+        worst = std::max(worst, l);
+    }
+    uint64_t tick_ms = TICK_TIME_NS / 1000'000;
+    printf("[%s] spike to max: %zu spikes, avg %.1f ms, worst %llu ms, %u missed\n",
+           name, s.latencies.size(), (double)sum * tick_ms / s.latencies.size(),
+           (unsigned long long)(worst * tick_ms), s.missed);
+}
+
+// Time until the governor gets under a max clock lowered while running
+typedef struct CapTracker {
+    const char* name;
+    uint32_t cap_hz = 0;
+    uint64_t lowered_at = 0, applied_at = 0; // ticks + 1, 0: not yet
+
+    // Governor::SetMaxHz
+    void Lower(MockModule& m, uint32_t hz, uint64_t tick) {
+        m.max_hz = cap_hz = hz;
+        m.min_hz = std::min(m.min_hz, hz);
+        lowered_at = tick + 1;
+    }
+
+    void Update(const MockModule& m, uint64_t tick) {
+        if (lowered_at && !applied_at && m.target_hz <= cap_hz)
+            applied_at = tick + 1;
+    }
+
+    bool Print() const {
+        if (!applied_at) {
+            printf("[%s] cap lowered to %u MHz: never applied\n", name, cap_hz / 1000'000);
+            return false;
+        }
+        printf("[%s] cap lowered to %u MHz: applied after %llu ms\n", name, cap_hz / 1000'000,
+               (unsigned long long)((applied_at - lowered_at) * TICK_TIME_NS / 1000'000));
+        return true;
+    }
+} CapTracker;
+
+// Full then no load at the longest half-life and highest sample rate Tuning allows:
+// util must rise and fall monotonically and saturate at UTIL_MAX
+template <typename Util>
+static bool CheckMaxTuning(const char* name) {
+    Util u;
+    u.SetHalfLife(Tuning::HALF_LIFE_MAX, Tuning::SAMPLE_RATE_MAX);
+    const uint32_t samples = 20 * Tuning::HALF_LIFE_MAX * Tuning::SAMPLE_RATE_MAX / 1000;
+
+    uint32_t prev = 0;
+    bool ok = true;
+    for (uint32_t i = 0; i < samples && ok; i++) {
+        u.Update(UTIL_MAX);
+        ok = u.Get() >= prev && u.Get() <= UTIL_MAX;
+        prev = u.Get();
+    }
+    uint32_t full = prev;
+    ok = ok && full >= UTIL_MAX * 99 / 100;
+    for (uint32_t i = 0; i < samples && ok; i++) {
+        u.Update(0);
+        ok = u.Get() <= prev;
+        prev = u.Get();
+    }
+
+    if (!ok)
+        fprintf(stderr, "[%s] util broken at max tuning: %u at full load, %u after\n", name, full, prev);
+    return ok;
+}
+
+static int Usage(const char* argv0) {
+    fprintf(stderr, "Usage: %s <trace.csv> [timeline.csv] [-c cpu_max_mhz] [-g gpu_max_mhz] [-b] [-e] [-f] [-t]\n", argv0);
+    fprintf(stderr, "       [-H headroom] [-l cpu_ms,gpu_ms] [-k cpu_mhz,gpu_mhz@ms]\n");
+    fprintf(stderr, "  trace:   systick,idle0,idle1,idle2,idle3,gpu_load[,cpu_hz,gpu_hz[,frame_us]]\n");
+    fprintf(stderr, "  -b       enable CPU auto boost on system core\n");
+    fprintf(stderr, "  -e       select frequencies with the energy model\n");
+    fprintf(stderr, "  -f       frame-time GPU governor from frame_us\n");
+    fprintf(stderr, "  -t       limit transitions (up 0, down 50 permille, 10 ms residency, 50 /s)\n");
+    fprintf(stderr, "  -H       headroom over target in permille (default %u)\n", HEADROOM_DEFAULT);
+    fprintf(stderr, "  -l       util decay half-life of CPU and GPU in ms (default: built-in)\n");
+    fprintf(stderr, "  -k       lower max clocks to cpu_mhz,gpu_mhz at ms into the trace\n");
+    return -1;
+}
+
+int main(int argc, char** argv) {
+    if (!CheckMaxTuning<PeltUtil>("PeltUtil") || !CheckMaxTuning<MaxWindow>("MaxWindow"))
+        return 1;
+
+    const char* trace_path = nullptr;
+    const char* timeline_path = nullptr;
+    uint32_t cpu_max_mhz = 1785, gpu_max_mhz = 921;
+    bool auto_boost = false, use_em = false, use_frames = false, use_limiter = false;
+    uint32_t headroom = HEADROOM_DEFAULT, cpu_half_life = 0, gpu_half_life = 0;
+    uint32_t cap_cpu_mhz = 0, cap_gpu_mhz = 0, cap_ms = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-c") && i + 1 < argc)
+            cpu_max_mhz = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-g") && i + 1 < argc)
+            gpu_max_mhz = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-b"))
+            auto_boost = true;
+        else if (!strcmp(argv[i], "-e"))
+            use_em = true;
+        else if (!strcmp(argv[i], "-f"))
+            use_frames = true;
+        else if (!strcmp(argv[i], "-t"))
+            use_limiter = true;
+        else if (!strcmp(argv[i], "-H") && i + 1 < argc)
+            headroom = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-l") && i + 1 < argc) {
+            if (sscanf(argv[++i], "%u,%u", &cpu_half_life, &gpu_half_life) != 2)
+                return Usage(argv[0]);
+        }
+        else if (!strcmp(argv[i], "-k") && i + 1 < argc) {
+            if (sscanf(argv[++i], "%u,%u@%u", &cap_cpu_mhz, &cap_gpu_mhz, &cap_ms) != 3)
+                return Usage(argv[0]);
+        }
+        else if (!trace_path)
+            trace_path = argv[i];
+        else if (!timeline_path)
+            timeline_path = argv[i];
+        else
+            return Usage(argv[0]);
+    }
+    if (!trace_path)
+        return Usage(argv[0]);
+
+    auto NearestHz = [](uint32_t* list, uint32_t mhz) -> uint32_t {
+        uint32_t hz = 0;
+        for (uint32_t* p = list; *p; p++) {
+            if (*p / 1000'000 <= mhz)
+                hz = *p;
+        }
+        return hz ? hz : list[0];
+    };
+
+    TransitionLimiter::Params limits = { .up_threshold = 0, .down_threshold = 50, .min_residency_ms = 10, .max_per_sec = 50 };
+
+    MockModule cpu = { .name = "CPU", .hz_list = cpuHzList, .mv_list = cpuMvList, .use_em = use_em, .use_limiter = use_limiter };
+    cpu.Init();
+    cpu.limiter.SetParams(limits);
+    cpu.max_hz    = NearestHz(cpuHzList, cpu_max_mhz);
+    cpu.min_hz    = cpuHzList[0];
+    cpu.boost_hz  = 1785'000'000;
+    cpu.target_hz = cpu.max_hz;
+
+    MockModule gpu = { .name = "GPU", .hz_list = gpuHzList, .mv_list = gpuMvList, .use_em = use_em, .use_limiter = use_limiter };
+    gpu.Init();
+    gpu.limiter.SetParams(limits);
+    gpu.max_hz    = NearestHz(gpuHzList, gpu_max_mhz);
+    gpu.min_hz    = std::min<uint32_t>(gpu.max_hz, 153'600'000);
+    gpu.target_hz = gpu.max_hz;
+
+    FILE* fp = fopen(trace_path, "r");
+    if (!fp) {
+        fprintf(stderr, "Cannot open %s\n", trace_path);
+        return -1;
+    }
+
+    FILE* out = nullptr;
+    if (timeline_path) {
+        out = fopen(timeline_path, "w");
+        if (!out) {
+            fprintf(stderr, "Cannot open %s\n", timeline_path);
+            fclose(fp);
+            return -1;
+        }
+        fprintf(out, "ms,cpu_util,cpu_pelt,cpu_hz,gpu_util,gpu_window,gpu_hz\n");
+    }
+
+    PeltUtil cpu_util;
+    MaxWindow gpu_util;
+    cpu_util.SetHalfLife(cpu_half_life, SAMPLE_RATE);
+    gpu_util.SetHalfLife(gpu_half_life, SAMPLE_RATE);
+    FramePacer gpu_pacer;
+    TraceFrameSource frame_source;
+    SpikeTracker cpu_spike, gpu_spike;
+    CapTracker cpu_cap = { .name = "CPU" }, gpu_cap = { .name = "GPU" };
+    Sample prev = {}, curr = {};
+    bool has_prev = false;
+    uint64_t ticks = 0;
+    char line[256];
+
+    while (fgets(line, sizeof(line), fp)) {
+        if (!ParseSample(line, &curr))
+            continue;
+        if (!has_prev) {
+            prev = curr;
+            has_prev = true;
+            continue;
+        }
+
+        uint64_t now = ticks * TICK_TIME_NS;
+
+        if (cap_cpu_mhz && !cpu_cap.lowered_at && now >= (uint64_t)cap_ms * 1000'000) {
+            cpu_cap.Lower(cpu, NearestHz(cpuHzList, cap_cpu_mhz), ticks);
+            gpu_cap.Lower(gpu, NearestHz(gpuHzList, cap_gpu_mhz), ticks);
+        }
+
+        // CpuGovernor::Apply: max of normalized per-core util, PELT, boost on system core
+        uint64_t diff_systick = curr.systick - prev.systick;
+        uint32_t util = 0, sys_util = 0, demand = 0;
+        for (int id = 0; id < CORE_NUMS; id++) {
+            uint32_t raw = UtilFromTicks(curr.idletick[id] - prev.idletick[id], diff_systick);
+            uint32_t rec_hz = prev.cpu_hz ? prev.cpu_hz : cpu.max_hz;
+            demand = std::max(demand, Rescale(raw, rec_hz, cpu.max_hz));
+            raw = Rescale(raw, rec_hz, cpu.target_hz);
+
+            uint32_t core_util = NormalizeUtil(raw, cpu.target_hz, cpu.max_hz);
+            util = std::max(util, core_util);
+            if (id == SYS_CORE_ID)
+                sys_util = core_util;
+        }
+        cpu_util.Update(util);
+        if (auto_boost && sys_util > BOOST_THRESHOLD)
+            cpu.SetHz(std::max(cpu.max_hz, cpu.boost_hz));
+        else
+            cpu.Govern(now, TargetHz(cpu.max_hz, cpu_util.Get(), headroom));
+
+        // GpuGovernor::Apply
+        uint32_t gpu_rec_hz = prev.gpu_hz ? prev.gpu_hz : gpu.max_hz;
+        uint32_t gpu_demand = Rescale(curr.gpu_load, gpu_rec_hz, gpu.max_hz);
+        uint32_t gpu_raw = NormalizeUtil(Rescale(curr.gpu_load, gpu_rec_hz, gpu.target_hz), gpu.target_hz, gpu.max_hz);
+        gpu_util.Update(gpu_raw);
+        frame_source.Update(curr, gpu_rec_hz, gpu.target_hz);
+
+        uint32_t frame_hz = use_frames ? gpu_pacer.TargetHz(frame_source.GetFrameIntervalUs(), gpu_raw, gpu.max_hz) : 0;
+        if (frame_hz)
+            gpu.Govern(now, frame_hz);
+        else
+            gpu.Govern(now, TargetHz(gpu.max_hz, gpu_util.Get(), headroom));
+
+        cpu.Account(demand);
+        gpu.Account(gpu_demand);
+        cpu_spike.Update(ticks, demand, cpu.target_hz, cpu.max_hz);
+        gpu_spike.Update(ticks, gpu_demand, gpu.target_hz, gpu.max_hz);
+        cpu_cap.Update(cpu, ticks);
+        gpu_cap.Update(gpu, ticks);
+
+        if (out) {
+            fprintf(out, "%llu,%u,%u,%u,%u,%u,%u\n",
+                    (unsigned long long)(ticks * TICK_TIME_NS / 1000'000),
+                    util, cpu_util.Get(), cpu.target_hz,
+                    gpu_raw, gpu_util.Get(), gpu.target_hz);
+        }
+
+        ticks++;
+        prev = curr;
+    }
+
+    fclose(fp);
+    if (out)
+        fclose(out);
+
+    if (!ticks) {
+        fprintf(stderr, "No samples in %s\n", trace_path);
+        return -1;
+    }
+
+    printf("%llu samples, %llu ms @ %llu Hz\n",
+           (unsigned long long)ticks, (unsigned long long)(ticks * TICK_TIME_NS / 1000'000),
+           (unsigned long long)SAMPLE_RATE);
+    PrintSummary(cpu, ticks);
+    PrintSummary(gpu, ticks);
+    PrintLatency("CPU", cpu_spike);
+    PrintLatency("GPU", gpu_spike);
+    if (frame_source.frames) {
+        printf("[GPU] frames over deadline: %llu / %llu samples (%.2f%%)\n",
+               (unsigned long long)frame_source.missed, (unsigned long long)frame_source.frames,
+               100. * frame_source.missed / frame_source.frames);
+    }
+    if (cap_cpu_mhz) {
+        bool cpu_ok = cpu_cap.Print(), gpu_ok = gpu_cap.Print();
+        if (!cpu_ok || !gpu_ok)
+            return 1;
+    }
+    return 0;
+}
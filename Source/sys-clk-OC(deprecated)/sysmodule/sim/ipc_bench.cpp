@@ -0,0 +1,248 @@
+/*
+ * --------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <p-sam@d3vs.net>, <natinusala@gmail.com>, <m4x@m4xw.net>
+ * wrote this file. As long as you retain this notice you can do whatever you
+ * want with this stuff. If you meet any of us some day, and you think this
+ * stuff is worth it, you can buy us a beer in return.  - The sys-clk authors
+ * --------------------------------------------------------------------------
+ */
+
+// Latency of sys-clk IPC under concurrent clients, single listener against listener + workers
+// (src/ipc_dispatch.h, same split as IpcService).
+//
+// The mock transport keeps the Horizon semantics the server relies on: one session per client,
+// one request in flight per session, and the listener only sees sessions with a pending request.
+// "Query" clients poll GetCurrentContext like the overlay does, "writer" clients send
+// SetConfigValues, which holds the config lock for write_ms (an INI rewrite on the SD card).
+//
+// Usage: ipc_bench [-q query_clients] [-w writer_clients] [-i query_interval_us]
+//                  [-m write_ms] [-d seconds]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <semaphore>
+#include <thread>
+#include <vector>
+#include "ipc_dispatch.h"
+
+using Clock = std::chrono::steady_clock;
+
+typedef struct {
+    uint32_t queryClients = 3;
+    uint32_t writerClients = 1;
+    uint32_t queryIntervalUs = 1000;
+    uint32_t writeMs = 20;
+    uint32_t seconds = 2;
+} Options;
+
+typedef struct MockSession {
+    uint64_t cmdId;
+    bool replied;
+    std::mutex mutex;
+    std::condition_variable cv;
+} MockSession;
+
+// svcWaitSynchronization + svcReplyAndReceive over the sessions of all clients
+class MockTransport {
+public:
+    // Client side, blocks until replied like a synchronous IPC request
+    void Call(MockSession* s, uint64_t cmdId) {
+        s->cmdId = cmdId;
+        s->replied = false;
+        {
+            std::scoped_lock lock{m_mutex};
+            m_pending.push_back(s);
+        }
+        m_cv.notify_one();
+        std::unique_lock lock{s->mutex};
+        s->cv.wait(lock, [s] { return s->replied; });
+    }
+
+    // Listener side, nullptr once stopped
+    MockSession* Receive() {
+        std::unique_lock lock{m_mutex};
+        m_cv.wait(lock, [this] { return m_stop || !m_pending.empty(); });
+        if (m_pending.empty())
+            return nullptr;
+        MockSession* s = m_pending.front();
+        m_pending.pop_front();
+        return s;
+    }
+
+    // Any thread, like ipcServerReply
+    void Reply(MockSession* s) {
+        {
+            std::scoped_lock lock{s->mutex};
+            s->replied = true;
+        }
+        s->cv.notify_one();
+    }
+
+    void Stop() {
+        {
+            std::scoped_lock lock{m_mutex};
+            m_stop = true;
+        }
+        m_cv.notify_all();
+    }
+
+protected:
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<MockSession*> m_pending;
+    bool m_stop = false;
+};
+
+// IpcService::ServiceHandlerFunc stand-in
+class MockService {
+public:
+    MockService(const Options& opt) : m_opt(opt) {}
+
+    void Handle(uint64_t cmdId) {
+        if (IpcDispatch::IsInline(cmdId)) {
+            // Seqlock snapshot copy
+            auto end = Clock::now() + std::chrono::microseconds(2);
+            while (Clock::now() < end)
+                ;
+            return;
+        }
+        std::scoped_lock lock{m_configMutex};
+        std::this_thread::sleep_for(std::chrono::milliseconds(m_opt.writeMs));
+    }
+
+protected:
+    const Options& m_opt;
+    std::mutex m_configMutex;
+};
+
+static constexpr size_t QUEUE_SLOTS = 8; // IPC_QUEUE_SLOTS
+
+typedef struct {
+    std::vector<uint64_t> query, write; // Latency in ns
+} Samples;
+
+static Samples Run(const Options& opt, uint32_t workers) {
+    MockTransport transport;
+    MockService service(opt);
+    IpcDispatch::WorkQueue<MockSession*, QUEUE_SLOTS, std::mutex, std::counting_semaphore<>> queue;
+
+    // IpcService::ProcessThreadFunc, workers == 0 is the previous single loop (ipcServerProcess)
+    std::thread listener([&] {
+        while (MockSession* s = transport.Receive()) {
+            if (workers && !IpcDispatch::IsInline(s->cmdId) && queue.Push(s))
+                continue;
+            service.Handle(s->cmdId);
+            transport.Reply(s);
+        }
+    });
+    std::vector<std::thread> pool;
+    for (uint32_t i = 0; i < workers; i++) {
+        pool.emplace_back([&] {
+            MockSession* s;
+            while (queue.Pop(s)) {
+                service.Handle(s->cmdId);
+                transport.Reply(s);
+            }
+        });
+    }
+
+    std::atomic_bool running = true;
+    std::mutex samplesMutex;
+    Samples samples;
+    auto Client = [&](uint64_t cmdId, uint32_t intervalUs) {
+        MockSession session;
+        std::vector<uint64_t> local;
+        auto next = Clock::now();
+        while (running) {
+            auto start = Clock::now();
+            transport.Call(&session, cmdId);
+            local.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+            next += std::chrono::microseconds(intervalUs);
+            std::this_thread::sleep_until(std::max(next, Clock::now()));
+        }
+        std::scoped_lock lock{samplesMutex};
+        auto& out = cmdId == SysClkIpcCmd_GetCurrentContext ? samples.query : samples.write;
+        out.insert(out.end(), local.begin(), local.end());
+    };
+
+    std::vector<std::thread> clients;
+    for (uint32_t i = 0; i < opt.queryClients; i++)
+        clients.emplace_back(Client, SysClkIpcCmd_GetCurrentContext, opt.queryIntervalUs);
+    for (uint32_t i = 0; i < opt.writerClients; i++)
+        clients.emplace_back(Client, SysClkIpcCmd_SetConfigValues, 0);
+
+    std::this_thread::sleep_for(std::chrono::seconds(opt.seconds));
+    running = false;
+    for (auto& c : clients)
+        c.join();
+
+    // Same order as IpcService::SetRunning(false)
+    transport.Stop();
+    listener.join();
+    queue.Stop(workers);
+    for (auto& w : pool)
+        w.join();
+
+    return samples;
+}
+
+static void Print(const char* name, std::vector<uint64_t>& ns, double seconds) {
+    if (ns.empty()) {
+        printf("  %-6s no calls\n", name);
+        return;
+    }
+    std::sort(ns.begin(), ns.end());
+    auto Percentile = [&](double p) { return ns[std::min(ns.size() - 1, (size_t)(p * ns.size()))] / 1000.; };
+    printf("  %-6s %7.0f calls/s  p50 %9.1f us  p99 %9.1f us  max %9.1f us\n",
+           name, ns.size() / seconds, Percentile(0.50), Percentile(0.99), ns.back() / 1000.);
+}
+
+static int Usage(const char* argv0) {
+    fprintf(stderr, "Usage: %s [-q query_clients] [-w writer_clients] [-i query_interval_us] [-m write_ms] [-d seconds]\n", argv0);
+    return -1;
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc)
+            return Usage(argv[0]);
+        uint32_t value = atoi(argv[i + 1]);
+        if (!strcmp(argv[i], "-q"))
+            opt.queryClients = value;
+        else if (!strcmp(argv[i], "-w"))
+            opt.writerClients = value;
+        else if (!strcmp(argv[i], "-i"))
+            opt.queryIntervalUs = value;
+        else if (!strcmp(argv[i], "-m"))
+            opt.writeMs = value;
+        else if (!strcmp(argv[i], "-d"))
+            opt.seconds = std::max<uint32_t>(1, value);
+        else
+            return Usage(argv[0]);
+        i++;
+    }
+
+    printf("%u query clients every %u us, %u writer clients holding the config for %u ms, %u s each\n",
+           opt.queryClients, opt.queryIntervalUs, opt.writerClients, opt.writeMs, opt.seconds);
+
+    // 0: single listener loop, as before. IPC_WORKER_COUNT is 2
+    for (uint32_t workers : { 0, 1, 2, 4 }) {
+        Samples samples = Run(opt, workers);
+        if (workers)
+            printf("listener + %u workers\n", workers);
+        else
+            printf("single listener\n");
+        Print("query", samples.query, opt.seconds);
+        Print("write", samples.write, opt.seconds);
+    }
+    return 0;
+}
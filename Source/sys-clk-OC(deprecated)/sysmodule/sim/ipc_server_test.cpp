@@ -0,0 +1,277 @@
+/*
+ * --------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <p-sam@d3vs.net>, <natinusala@gmail.com>, <m4x@m4xw.net>
+ * wrote this file. As long as you retain this notice you can do whatever you
+ * want with this stuff. If you meet any of us some day, and you think this
+ * stuff is worth it, you can buy us a beer in return.  - The sys-clk authors
+ * --------------------------------------------------------------------------
+ */
+
+// lib/nxExt/src/ipc_server.c built against the mock kernel in mock_nx, driven like IpcService:
+// one listener thread in ipcServerProcessEx, workers replying through ipcServerReply from
+// the IpcDispatch queue, clients on their own threads.
+//
+// Covers the deferred path end to end: a SetConfigValues held by a worker while another
+// client keeps being answered inline, the parked session coming back to the listener through
+// the wake event, replies racing the defer handler, a client leaving while its request is
+// parked, and the Close command. Exits with 1 on any failure.
+//
+// Usage: ipc_server_test [-n deferred_requests]
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <semaphore>
+#include <thread>
+#include <vector>
+#include "mock_nx.h"
+#include "nxExt/ipc_server.h"
+#include "ipc_dispatch.h"
+
+static constexpr size_t WORKERS = 2;
+static constexpr uint32_t TIMEOUT_MS = 2000;
+
+static unsigned failures = 0;
+static unsigned checks = 0;
+
+#define CHECK(cond, ...)                        \
+    do {                                        \
+        checks++;                               \
+        if (!(cond)) {                          \
+            if (failures++ < 10) {              \
+                fprintf(stderr, "FAIL: ");      \
+                fprintf(stderr, __VA_ARGS__);   \
+                fprintf(stderr, "\n");          \
+            }                                   \
+        }                                       \
+    } while (0)
+
+typedef struct Server {
+    IpcServer server;
+    IpcDispatch::WorkQueue<IpcServerDeferredRequest, 4, std::mutex, std::counting_semaphore<>> queue;
+    // SetConfigValues blocks on gate while hold is set, entered is released when it starts
+    std::atomic<bool> hold = false;
+    std::counting_semaphore<> gate{0};
+    std::counting_semaphore<> entered{0};
+    std::atomic<uint32_t> deferred = 0;
+} Server;
+
+// SetConfigValues doubles its argument, GetCurrentContext (inline) adds one
+static Result Handler(void* arg, const IpcServerRequest* r, u8* out_data, size_t* out_dataSize) {
+    Server* s = (Server*)arg;
+    if (r->data.size < sizeof(u32))
+        return MAKERESULT(Module_Libnx, LibnxError_BadInput);
+    u32 in;
+    memcpy(&in, r->data.ptr, sizeof(in));
+
+    u32 out = 0;
+    switch (r->data.cmdId) {
+        case SysClkIpcCmd_SetConfigValues:
+            s->entered.release();
+            if (s->hold)
+                s->gate.acquire();
+            out = in * 2;
+            break;
+        case SysClkIpcCmd_GetCurrentContext:
+            out = in + 1;
+            break;
+        default:
+            return MAKERESULT(Module_Libnx, LibnxError_BadInput);
+    }
+    memcpy(out_data, &out, sizeof(out));
+    *out_dataSize = sizeof(out);
+    return 0;
+}
+
+// Same as IpcService::DeferHandlerFunc
+static bool Defer(void* arg, const IpcServerRequest* r, const IpcServerDeferredRequest* d) {
+    Server* s = (Server*)arg;
+    if (IpcDispatch::IsInline(r->data.cmdId) || !s->queue.Push(*d))
+        return false;
+    s->deferred++;
+    return true;
+}
+
+static u32 ParkedCount(Server& s) {
+    mutexLock(&s.server.parkedMutex);
+    u32 count = s.server.parkedCount;
+    mutexUnlock(&s.server.parkedMutex);
+    return count;
+}
+
+static Result Call(Handle session, u32 type, u64 cmdId, u32 in, u32* out) {
+    alignas(16) u8 message[IPC_SERVER_EXT_MESSAGE_SIZE] = {};
+    HipcRequest hipc = hipcMakeRequestInline(message,
+        .type = type,
+        .num_data_words = (sizeof(IpcServerRawHeader) + sizeof(in) + 0x10) / 4,
+    );
+    IpcServerRawHeader* header = (IpcServerRawHeader*)cmifGetAlignedDataStart(hipc.data_words, message);
+    header->magic = CMIF_IN_HEADER_MAGIC;
+    header->cmdId = cmdId;
+    memcpy(header + 1, &in, sizeof(in));
+
+    alignas(16) u8 reply[IPC_SERVER_EXT_MESSAGE_SIZE];
+    Result rc = MockNx::Request(session, message, reply, sizeof(reply));
+    if (R_FAILED(rc))
+        return rc;
+
+    HipcParsedRequest parsed = hipcParseRequest(reply);
+    header = (IpcServerRawHeader*)cmifGetAlignedDataStart(parsed.data.data_words, reply);
+    if (header->magic != CMIF_OUT_HEADER_MAGIC)
+        return MAKERESULT(Module_Libnx, LibnxError_BadInput);
+    if (R_SUCCEEDED(header->result) && out)
+        memcpy(out, header + 1, sizeof(*out));
+    return header->result;
+}
+
+static Result Call(Handle session, u64 cmdId, u32 in, u32* out) {
+    return Call(session, CmifCommandType_Request, cmdId, in, out);
+}
+
+static bool Acquire(std::counting_semaphore<>& sem) {
+    return sem.try_acquire_for(std::chrono::milliseconds(TIMEOUT_MS));
+}
+
+// Held SetConfigValues on one session, GetCurrentContext keeps working on another
+static void TestHeldRequest(Server& s, Handle port) {
+    Handle writer = MockNx::Connect(port), reader = MockNx::Connect(port);
+
+    s.hold = true;
+    u32 written = 0;
+    Result writeRc = 1;
+    std::thread client([&] { writeRc = Call(writer, SysClkIpcCmd_SetConfigValues, 21, &written); });
+    CHECK(Acquire(s.entered), "deferred request never reached a worker");
+    CHECK(ParkedCount(s) == 1, "%u sessions parked while a request is held, expected 1", ParkedCount(s));
+
+    bool answered = true;
+    for (u32 i = 0; i < 100 && answered; i++) {
+        u32 out = 0;
+        answered = R_SUCCEEDED(Call(reader, SysClkIpcCmd_GetCurrentContext, i, &out)) && out == i + 1;
+    }
+    CHECK(answered, "inline request not answered while another one is held");
+
+    s.hold = false;
+    s.gate.release();
+    client.join();
+    CHECK(R_SUCCEEDED(writeRc) && written == 42, "held request: rc 0x%x, reply %u", writeRc, written);
+
+    // The listener takes the session back after the wake event
+    u32 out = 0;
+    CHECK(R_SUCCEEDED(Call(writer, SysClkIpcCmd_GetCurrentContext, 7, &out)) && out == 8, "session not listened to after its reply");
+    CHECK(ParkedCount(s) == 0, "%u sessions still parked", ParkedCount(s));
+
+    MockNx::Close(writer);
+    MockNx::Close(reader);
+    CHECK(MockNx::WaitServerClosed(writer, TIMEOUT_MS) && MockNx::WaitServerClosed(reader, TIMEOUT_MS), "closed sessions not released");
+}
+
+// Back to back deferred requests from several clients, replies race the defer handler
+static void TestDeferredStream(Server& s, Handle port, u32 requests) {
+    const u32 deferredBefore = s.deferred;
+    std::vector<std::thread> clients;
+    std::atomic<u32> errors = 0;
+    for (u32 c = 0; c < 3; c++) {
+        clients.emplace_back([&, c] {
+            Handle session = MockNx::Connect(port);
+            for (u32 i = 0; i < requests; i++) {
+                u32 out = 0;
+                u64 cmd = (i + c) % 4 ? SysClkIpcCmd_SetConfigValues : SysClkIpcCmd_GetCurrentContext;
+                Result rc = Call(session, cmd, i, &out);
+                if (R_FAILED(rc) || out != (cmd == SysClkIpcCmd_SetConfigValues ? i * 2 : i + 1))
+                    errors++;
+            }
+            MockNx::Close(session);
+        });
+    }
+    for (auto& t : clients)
+        t.join();
+    while (s.entered.try_acquire());
+
+    CHECK(!errors, "%u of %u requests failed or got a wrong reply", (u32)errors, 3 * requests);
+    CHECK(s.deferred > deferredBefore, "no request went through the workers");
+    CHECK(ParkedCount(s) == 0, "%u sessions still parked", ParkedCount(s));
+}
+
+// Client gone while its request is parked: the failed reply unparks the session
+// and the listener drops it
+static void TestClientGone(Server& s, Handle port) {
+    Handle session = MockNx::Connect(port);
+    s.hold = true;
+    Result rc = 0;
+    std::thread client([&] { rc = Call(session, SysClkIpcCmd_SetConfigValues, 1, nullptr); });
+    CHECK(Acquire(s.entered), "deferred request never reached a worker");
+    MockNx::Close(session);
+    client.join();
+    CHECK(rc == KERNELRESULT(ConnectionClosed), "client of a closed session got 0x%x", rc);
+
+    s.hold = false;
+    s.gate.release();
+    CHECK(MockNx::WaitServerClosed(session, TIMEOUT_MS), "session of a gone client not released");
+    CHECK(ParkedCount(s) == 0, "%u sessions still parked", ParkedCount(s));
+}
+
+static void TestCloseCommand(Handle port) {
+    Handle session = MockNx::Connect(port);
+    u32 out = 0;
+    CHECK(R_SUCCEEDED(Call(session, SysClkIpcCmd_GetCurrentContext, 1, &out)) && out == 2, "request before close");
+    CHECK(R_SUCCEEDED(Call(session, CmifCommandType_Close, 0, 0, nullptr)), "close command not acknowledged");
+    CHECK(MockNx::WaitServerClosed(session, TIMEOUT_MS), "session not released after close command");
+}
+
+int main(int argc, char** argv) {
+    u32 requests = 1000;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-n") && i + 1 < argc) {
+            requests = std::max(1, atoi(argv[++i]));
+        } else {
+            fprintf(stderr, "Usage: %s [-n deferred_requests]\n", argv[0]);
+            return -1;
+        }
+    }
+
+    Server* s = new Server();
+    Result rc = ipcServerInit(&s->server, "sys:clk", 8);
+    if (R_FAILED(rc)) {
+        fprintf(stderr, "ipcServerInit: 0x%x\n", rc);
+        return 1;
+    }
+    Handle port = MockNx::GetService("sys:clk");
+
+    // Same loops as IpcService::ProcessThreadFunc and WorkerThreadFunc
+    std::thread listener([&] {
+        while (ipcServerProcessEx(&s->server, Handler, Defer, s) != KERNELRESULT(Cancelled));
+    });
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < WORKERS; i++) {
+        workers.emplace_back([&] {
+            IpcServerDeferredRequest d;
+            while (s->queue.Pop(d))
+                ipcServerReply(&s->server, &d, Handler, s);
+        });
+    }
+
+    // Stops at the first failing test, the next ones would only wait for lost replies
+    TestHeldRequest(*s, port);
+    if (!failures)
+        TestDeferredStream(*s, port, requests);
+    if (!failures)
+        TestClientGone(*s, port);
+    if (!failures)
+        TestCloseCommand(port);
+
+    MockNx::Cancel();
+    listener.join();
+    s->queue.Stop(WORKERS);
+    for (auto& t : workers)
+        t.join();
+    if (!failures)
+        CHECK(s->server.count == 1, "%u sessions left open", s->server.count - 1);
+    ipcServerExit(&s->server);
+
+    printf("ipc_server: %u checks, %u failures, %u requests deferred\n", checks, failures, (u32)s->deferred);
+    delete s;
+    return failures ? 1 : 0;
+}
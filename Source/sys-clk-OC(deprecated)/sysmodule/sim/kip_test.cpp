@@ -0,0 +1,192 @@
+/*
+ * --------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <p-sam@d3vs.net>, <natinusala@gmail.com>, <m4x@m4xw.net>
+ * wrote this file. As long as you retain this notice you can do whatever you
+ * want with this stuff. If you meet any of us some day, and you think this
+ * stuff is worth it, you can buy us a beer in return.  - The sys-clk authors
+ * --------------------------------------------------------------------------
+ */
+
+// KIP1 header validation and CUST lookup (src/kip_core.h) over synthetic KIPs built in memory.
+//
+// The magic is placed at every offset of .data for segment sizes around the read chunk size:
+// offset 0, both sides of each chunk boundary, straddling it, and the last bytes of the file.
+// Aligned offsets must be found at the right file offset, unaligned ones must not be
+// (CustTable is a u32 array). Also covers the .rodata fallback, compressed segments and
+// malformed headers. Exits with 1 on any failure.
+//
+// Usage: kip_test [-v]
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "kip_core.h"
+
+using namespace KipCore;
+
+static constexpr uint8_t CUST[4] = {'C', 'U', 'S', 'T'};
+static constexpr size_t CHUNK = CHUNK_SIZE;
+
+static bool verbose = false;
+static unsigned failures = 0;
+static unsigned checks = 0;
+
+#define CHECK(cond, ...)                        \
+    do {                                        \
+        checks++;                               \
+        if (!(cond)) {                          \
+            if (failures++ < 10) {              \
+                fprintf(stderr, "FAIL: ");      \
+                fprintf(stderr, __VA_ARGS__);   \
+                fprintf(stderr, "\n");          \
+            }                                   \
+        }                                       \
+    } while (0)
+
+typedef struct {
+    KipHeader header;
+    std::vector<uint8_t> file;
+} Image;
+
+// Segments filled with a byte that never starts the magic
+static Image MakeKip(uint32_t textSize, uint32_t rodataSize, uint32_t dataSize, uint8_t compressedFlags = 0) {
+    Image img {};
+    memcpy(img.header.magic, "KIP1", 4);
+    strncpy(img.header.name, "Loader", sizeof(img.header.name));
+    img.header.flags = compressedFlags;
+    const uint32_t sizes[] = { textSize, rodataSize, dataSize };
+    for (int i = 0; i < Segment_Count; i++) {
+        img.header.segments[i].size = sizes[i];
+        img.header.segments[i].compressed_size = sizes[i];
+    }
+    img.file.assign(sizeof(KipHeader) + textSize + rodataSize + dataSize, 0xAA);
+    memcpy(img.file.data(), &img.header, sizeof(KipHeader));
+    return img;
+}
+
+static void Put(Image& img, int segment, size_t offset, const uint8_t (&magic)[4] = CUST) {
+    memcpy(img.file.data() + SegmentOffset(img.header, segment) + offset, magic, sizeof(magic));
+}
+
+static long Find(const Image& img, unsigned* reads = nullptr) {
+    std::vector<uint8_t> chunk(CHUNK_SIZE);
+    return FindMagic(img.header, CUST, chunk.data(), [&](size_t offset, uint8_t* dst, size_t size) {
+        if (reads)
+            (*reads)++;
+        if (size > CHUNK_SIZE || offset + size > img.file.size())
+            return false;
+        memcpy(dst, img.file.data() + offset, size);
+        return true;
+    });
+}
+
+// Magic at every offset of .data, text and rodata stay in front so .data does not start
+// 4-aligned in the file (only alignment within the segment matters)
+static void TestEveryOffset() {
+    const uint32_t sizes[] = { 3, 4, 5, 7, 8, 15, 16, 17, CHUNK - 1, CHUNK, CHUNK + 1, CHUNK + 3,
+                               2 * CHUNK + 2, 3 * CHUNK, 3 * CHUNK + 6 };
+    for (uint32_t size : sizes) {
+        for (size_t off = 0; off + sizeof(CUST) <= size; off++) {
+            Image img = MakeKip(0x102, 0x41, size);
+            Put(img, Segment_Data, off);
+            const long expected = off % MAGIC_ALIGN ? -1 : (long)(SegmentOffset(img.header, Segment_Data) + off);
+            const long got = Find(img);
+            CHECK(got == expected, ".data size %u, magic at %zu: got %ld, expected %ld", size, off, got, expected);
+        }
+        // Nothing to find: one read per chunk of .data, then of .rodata
+        Image img = MakeKip(0x102, 0x41, size);
+        unsigned reads = 0;
+        const unsigned expected = (size + CHUNK - 1) / CHUNK + (0x41 + CHUNK - 1) / CHUNK;
+        CHECK(Find(img, &reads) == -1, ".data size %u without magic: found", size);
+        CHECK(reads == expected, ".data size %u: %u reads, expected %u", size, reads, expected);
+    }
+}
+
+static void TestPlacements() {
+    const uint32_t size = 3 * CHUNK;
+    const size_t dataOffset = SegmentOffset(MakeKip(0x100, 0x40, size).header, Segment_Data);
+
+    auto Expect = [&](const char* what, size_t off, long expected) {
+        Image img = MakeKip(0x100, 0x40, size);
+        Put(img, Segment_Data, off);
+        long got = Find(img);
+        CHECK(got == expected, "%s (offset %zu): got %ld, expected %ld", what, off, got, expected);
+        if (verbose)
+            printf("  %-28s .data+%-6zu -> %ld\n", what, off, got);
+    };
+
+    Expect("offset 0", 0, dataOffset);
+    for (size_t b = CHUNK; b < size; b += CHUNK) {
+        Expect("ends at chunk boundary", b - 4, dataOffset + b - 4);
+        Expect("straddles chunk boundary", b - 2, -1);
+        Expect("starts at chunk boundary", b, dataOffset + b);
+    }
+    // .data is the last segment with file data (.bss has none)
+    Expect("at EOF", size - 4, dataOffset + size - 4);
+    CHECK(dataOffset + size == MakeKip(0x100, 0x40, size).file.size(), "EOF placement is not at the end of the file");
+
+    // Unaligned decoy before the table: the aligned one is returned
+    Image img = MakeKip(0x100, 0x40, size);
+    Put(img, Segment_Data, 0x11);
+    Put(img, Segment_Data, 0x200);
+    CHECK(Find(img) == (long)(dataOffset + 0x200), "unaligned decoy shadows the table");
+}
+
+static void TestSegments() {
+    // .rodata is the fallback
+    Image img = MakeKip(0x100, 0x2000, 0x100);
+    Put(img, Segment_Rodata, 0x1FFC);
+    CHECK(Find(img) == (long)(SegmentOffset(img.header, Segment_Rodata) + 0x1FFC), ".rodata fallback");
+
+    // .data wins over .rodata
+    Put(img, Segment_Data, 0x40);
+    CHECK(Find(img) == (long)(SegmentOffset(img.header, Segment_Data) + 0x40), ".data first");
+
+    // Compressed segments are skipped, .text is never searched
+    img = MakeKip(0x100, 0x100, 0x100, 1 << Segment_Data);
+    Put(img, Segment_Data, 0);
+    Put(img, Segment_Text, 0);
+    CHECK(Find(img) == -1, "compressed .data or .text searched");
+
+    // Read past the end of a truncated file
+    img = MakeKip(0x100, 0x100, CHUNK * 2);
+    img.file.resize(img.file.size() - 1);
+    CHECK(Find(img) == -1, "truncated file");
+}
+
+static void TestHeader() {
+    Image img = MakeKip(0x100, 0x100, 0x100);
+    CHECK(ValidateHeader(img.header, img.file.size(), "Loader"), "valid header rejected");
+    CHECK(ValidateHeader(img.header, img.file.size()), "valid header rejected without name");
+    CHECK(!ValidateHeader(img.header, img.file.size(), "FS"), "wrong name accepted");
+    CHECK(!ValidateHeader(img.header, img.file.size() - 1), "segments past EOF accepted");
+    CHECK(!ValidateHeader(img.header, sizeof(KipHeader) - 1), "short file accepted");
+
+    KipHeader bad = img.header;
+    bad.magic[3] = '2';
+    CHECK(!ValidateHeader(bad, img.file.size()), "wrong magic accepted");
+
+    bad = img.header;
+    bad.segments[Segment_Rodata].compressed_size = SEGMENT_SIZE_MAX + 1;
+    CHECK(!ValidateHeader(bad, SIZE_MAX), "oversized segment accepted");
+}
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-v")) {
+            verbose = true;
+        } else {
+            fprintf(stderr, "Usage: %s [-v]\n", argv[0]);
+            return -1;
+        }
+    }
+
+    TestEveryOffset();
+    TestPlacements();
+    TestSegments();
+    TestHeader();
+
+    printf("kip: %u checks, %u failures\n", checks, failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,212 @@
+/*
+ * --------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <p-sam@d3vs.net>, <natinusala@gmail.com>, <m4x@m4xw.net>
+ * wrote this file. As long as you retain this notice you can do whatever you
+ * want with this stuff. If you meet any of us some day, and you think this
+ * stuff is worth it, you can buy us a beer in return.  - The sys-clk authors
+ * --------------------------------------------------------------------------
+ */
+
+// Throughput and caller latency of FileUtils::LogLine.
+//
+// "fopen" is the previous implementation: global mutex, fopen in append mode, localtime,
+// write, fclose for every line. "queue" formats into a LogQueue (src/log_queue.h) and a
+// single writer thread keeps the file open, draining every second or once half full.
+// Each producer logs a clock change like line every interval_us, as Tick and the governor do.
+//
+// Usage: log_bench [-t threads] [-n lines_per_thread] [-r interval_us] [-o log_path]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "log_queue.h"
+
+using Clock = std::chrono::steady_clock;
+
+// Same sizing as the sysmodule (FILE_LOG_QUEUE_SLOTS, FILE_LOG_LINE_MAX)
+using Queue = LogQueue<64, 192>;
+
+typedef struct {
+    uint32_t threads = 3;
+    uint32_t lines = 20000;
+    uint32_t interval_us = 20;
+    const char* path = "log_bench.txt";
+} Options;
+
+static uint64_t RealtimeMs() {
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    return now.tv_sec * 1000ULL + now.tv_nsec / 1000000UL;
+}
+
+static void WriteLine(FILE* file, uint64_t timestamp_ms, const char* text, size_t len) {
+    time_t sec = timestamp_ms / 1000;
+    struct tm tm;
+    localtime_r(&sec, &tm);
+    fprintf(file, "[%04d-%02d-%02d %02d:%02d:%02d.%03u] ", tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday,
+            tm.tm_hour, tm.tm_min, tm.tm_sec, (unsigned)(timestamp_ms % 1000));
+    fwrite(text, 1, len, file);
+    fputc('\n', file);
+}
+
+struct FopenLogger {
+    const Options& opt;
+    std::mutex mutex;
+
+    FopenLogger(const Options& opt) : opt(opt) {}
+
+    void Log(const char* format, ...) {
+        std::scoped_lock lock{mutex};
+        FILE* file = fopen(opt.path, "a");
+        if (!file)
+            return;
+        struct timespec now;
+        clock_gettime(CLOCK_REALTIME, &now);
+        struct tm* tm = localtime(&now.tv_sec);
+        fprintf(file, "[%04d-%02d-%02d %02d:%02d:%02d.%03ld] ", tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday,
+                tm->tm_hour, tm->tm_min, tm->tm_sec, now.tv_nsec / 1000000L);
+        va_list args;
+        va_start(args, format);
+        vfprintf(file, format, args);
+        va_end(args);
+        fputc('\n', file);
+        fclose(file);
+    }
+
+    void Finish() {}
+    uint64_t Dropped() const { return 0; }
+};
+
+struct QueueLogger {
+    const Options& opt;
+    Queue queue;
+    FILE* file;
+    std::mutex wake_mutex;
+    std::condition_variable wake;
+    std::atomic_bool running = true;
+    uint64_t dropped = 0;
+    std::thread writer;
+
+    QueueLogger(const Options& opt) : opt(opt), file(fopen(opt.path, "a")), writer([this] { Run(); }) {}
+
+    void Log(const char* format, ...) {
+        va_list args;
+        va_start(args, format);
+        queue.Push(RealtimeMs(), format, args);
+        va_end(args);
+        if (queue.Size() >= queue.Capacity() / 2)
+            wake.notify_one();
+    }
+
+    void Flush() {
+        size_t count = 0;
+        while (queue.Pop([this](uint64_t timestamp_ms, const char* text, size_t len) { WriteLine(file, timestamp_ms, text, len); }))
+            count++;
+        if (size_t d = queue.TakeDropped()) {
+            char text[64];
+            int len = snprintf(text, sizeof(text), "[log] %zu lines dropped (queue full)", d);
+            WriteLine(file, RealtimeMs(), text, len);
+            dropped += d;
+            count++;
+        }
+        if (count)
+            fflush(file);
+    }
+
+    void Run() {
+        while (running) {
+            std::unique_lock lock{wake_mutex};
+            wake.wait_for(lock, std::chrono::seconds(1));
+            lock.unlock();
+            Flush();
+        }
+    }
+
+    void Finish() {
+        running = false;
+        wake.notify_one();
+        writer.join();
+        Flush();
+        fclose(file);
+    }
+
+    uint64_t Dropped() const { return dropped; }
+};
+
+template <typename Impl>
+static void Run(const char* name, const Options& opt) {
+    remove(opt.path);
+    Impl impl(opt);
+
+    std::vector<std::vector<uint64_t>> samples(opt.threads);
+    std::vector<std::thread> producers;
+    auto begin = Clock::now();
+    for (uint32_t t = 0; t < opt.threads; t++) {
+        producers.emplace_back([&, t] {
+            samples[t].reserve(opt.lines);
+            auto next = Clock::now();
+            for (uint32_t i = 0; i < opt.lines; i++) {
+                auto start = Clock::now();
+                impl.Log("[mgr] %s clock set : %u.%u MHz (thread %u, line %u)", t & 1 ? "GPU" : "CPU", 1785 - i % 7, i % 10, t, i);
+                samples[t].push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+                next += std::chrono::microseconds(opt.interval_us);
+                std::this_thread::sleep_until(next);
+            }
+        });
+    }
+    for (auto& p : producers)
+        p.join();
+    impl.Finish();
+    double elapsed = std::chrono::duration<double>(Clock::now() - begin).count();
+
+    std::vector<uint64_t> all;
+    for (auto& s : samples)
+        all.insert(all.end(), s.begin(), s.end());
+    std::sort(all.begin(), all.end());
+    auto Percentile = [&](double p) { return all[std::min(all.size() - 1, (size_t)(p * all.size()))] / 1000.; };
+
+    uint64_t written = all.size() - impl.Dropped();
+    printf("%-6s %8.0f lines/s  caller p50 %7.2f us  p99 %7.2f us  max %8.2f us  written %llu  dropped %llu\n",
+           name, written / elapsed, Percentile(0.50), Percentile(0.99), all.back() / 1000.,
+           (unsigned long long)written, (unsigned long long)impl.Dropped());
+}
+
+static int Usage(const char* argv0) {
+    fprintf(stderr, "Usage: %s [-t threads] [-n lines_per_thread] [-r interval_us] [-o log_path]\n", argv0);
+    return -1;
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc)
+            return Usage(argv[0]);
+        const char* value = argv[i + 1];
+        if (!strcmp(argv[i], "-t"))
+            opt.threads = std::max(1, atoi(value));
+        else if (!strcmp(argv[i], "-n"))
+            opt.lines = std::max(1, atoi(value));
+        else if (!strcmp(argv[i], "-r"))
+            opt.interval_us = atoi(value);
+        else if (!strcmp(argv[i], "-o"))
+            opt.path = value;
+        else
+            return Usage(argv[0]);
+        i++;
+    }
+
+    printf("%u threads x %u lines, one every %u us, to %s\n", opt.threads, opt.lines, opt.interval_us, opt.path);
+    Run<FopenLogger>("fopen", opt);
+    Run<QueueLogger>("queue", opt);
+    remove(opt.path);
+    return 0;
+}
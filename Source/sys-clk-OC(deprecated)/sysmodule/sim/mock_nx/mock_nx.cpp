@@ -0,0 +1,239 @@
+/*
+ * --------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <p-sam@d3vs.net>, <natinusala@gmail.com>, <m4x@m4xw.net>
+ * wrote this file. As long as you retain this notice you can do whatever you
+ * want with this stuff. If you meet any of us some day, and you think this
+ * stuff is worth it, you can buy us a beer in return.  - The sys-clk authors
+ * --------------------------------------------------------------------------
+ */
+
+// Mock kernel for switch.h: ports, sessions and events behind one lock.
+// Keeps the Horizon semantics ipc_server.c relies on: one request in flight per session,
+// a session is signaled while a request waits to be received or once the client closed it,
+// and any thread may reply to a received request.
+
+#include "mock_nx.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace {
+    constexpr size_t MESSAGE_SIZE = 0x100;
+
+    typedef struct {
+        enum { Kind_Port, Kind_Session, Kind_Event } kind;
+        // Port
+        std::deque<Handle> pending;
+        // Session
+        bool requestPending = false;
+        bool received = false;
+        bool replied = false;
+        bool clientClosed = false;
+        bool serverClosed = false;
+        u8 request[MESSAGE_SIZE];
+        u8 reply[MESSAGE_SIZE];
+        // Event
+        bool signaled = false;
+    } Object;
+
+    std::mutex g_mutex;
+    std::condition_variable g_cv;
+    std::map<Handle, Object> g_objects;
+    std::map<std::string, Handle> g_services;
+    Handle g_next = 1;
+    std::atomic<bool> g_cancel = false;
+
+    alignas(16) thread_local u8 g_tls[MESSAGE_SIZE];
+
+    // Caller holds g_mutex
+    Handle Create(decltype(Object::kind) kind) {
+        Object& o = g_objects[g_next];
+        o.kind = kind;
+        return g_next++;
+    }
+
+    bool IsSignaled(const Object& o) {
+        switch (o.kind) {
+            case Object::Kind_Port:    return !o.pending.empty();
+            case Object::Kind_Session: return o.clientClosed || (o.requestPending && !o.received);
+            case Object::Kind_Event:   return o.signaled;
+        }
+        return false;
+    }
+}
+
+extern "C" {
+
+void mutexInit(Mutex* m) { pthread_mutex_init(m, nullptr); }
+void mutexLock(Mutex* m) { pthread_mutex_lock(m); }
+void mutexUnlock(Mutex* m) { pthread_mutex_unlock(m); }
+
+Result eventCreate(Event* t, bool autoclear) {
+    std::scoped_lock lock{g_mutex};
+    t->revent = t->wevent = Create(Object::Kind_Event);
+    t->autoclear = autoclear;
+    return 0;
+}
+
+void eventClose(Event* t) {
+    std::scoped_lock lock{g_mutex};
+    g_objects.erase(t->revent);
+}
+
+Result eventFire(Event* t) {
+    std::scoped_lock lock{g_mutex};
+    g_objects[t->wevent].signaled = true;
+    g_cv.notify_all();
+    return 0;
+}
+
+Result eventClear(Event* t) {
+    std::scoped_lock lock{g_mutex};
+    g_objects[t->revent].signaled = false;
+    return 0;
+}
+
+SmServiceName smEncodeName(const char* name) {
+    SmServiceName out = {};
+    memcpy(out.name, name, strnlen(name, sizeof(out.name)));
+    return out;
+}
+
+Result smRegisterService(Handle* handle_out, SmServiceName name, bool is_light, s32 max_sessions) {
+    std::scoped_lock lock{g_mutex};
+    *handle_out = Create(Object::Kind_Port);
+    g_services[std::string(name.name, strnlen(name.name, sizeof(name.name)))] = *handle_out;
+    return 0;
+}
+
+Result smUnregisterService(SmServiceName name) {
+    std::scoped_lock lock{g_mutex};
+    g_services.erase(std::string(name.name, strnlen(name.name, sizeof(name.name))));
+    return 0;
+}
+
+Result svcCloseHandle(Handle handle) {
+    std::scoped_lock lock{g_mutex};
+    auto it = g_objects.find(handle);
+    if (it == g_objects.end())
+        return KERNELRESULT(InvalidHandle);
+    // Sessions stay around for the client side
+    if (it->second.kind == Object::Kind_Session)
+        it->second.serverClosed = true;
+    else
+        g_objects.erase(it);
+    g_cv.notify_all();
+    return 0;
+}
+
+Result svcAcceptSession(Handle* session_handle, Handle port_handle) {
+    std::scoped_lock lock{g_mutex};
+    Object& port = g_objects[port_handle];
+    if (port.pending.empty())
+        return KERNELRESULT(NotFound);
+    *session_handle = port.pending.front();
+    port.pending.pop_front();
+    return 0;
+}
+
+Result svcWaitSynchronization(s32* index, const Handle* handles, s32 handleCount, u64 timeout) {
+    std::unique_lock lock{g_mutex};
+    for (;;) {
+        if (g_cancel)
+            return KERNELRESULT(Cancelled);
+        for (s32 i = 0; i < handleCount; i++) {
+            if (IsSignaled(g_objects[handles[i]])) {
+                *index = i;
+                return 0;
+            }
+        }
+        g_cv.wait(lock);
+    }
+}
+
+Result svcReplyAndReceive(s32* index, const Handle* handles, s32 handleCount, Handle replyTarget, u64 timeout) {
+    std::unique_lock lock{g_mutex};
+    if (replyTarget) {
+        Object& s = g_objects[replyTarget];
+        if (s.clientClosed)
+            return KERNELRESULT(ConnectionClosed);
+        memcpy(s.reply, g_tls, sizeof(s.reply));
+        s.requestPending = s.received = false;
+        s.replied = true;
+        g_cv.notify_all();
+    }
+    if (!handleCount)
+        return KERNELRESULT(TimedOut);
+
+    // Only single session receives are used
+    Object& s = g_objects[handles[0]];
+    g_cv.wait(lock, [&] { return IsSignaled(s); });
+    if (s.clientClosed)
+        return KERNELRESULT(ConnectionClosed);
+    memcpy(g_tls, s.request, sizeof(s.request));
+    s.received = true;
+    *index = 0;
+    return 0;
+}
+
+void* armGetTls(void) { return g_tls; }
+
+}
+
+namespace MockNx {
+    Handle GetService(const char* name) {
+        std::scoped_lock lock{g_mutex};
+        auto it = g_services.find(name);
+        return it != g_services.end() ? it->second : 0;
+    }
+
+    Handle Connect(Handle port) {
+        std::scoped_lock lock{g_mutex};
+        Handle session = Create(Object::Kind_Session);
+        g_objects[port].pending.push_back(session);
+        g_cv.notify_all();
+        return session;
+    }
+
+    Result Request(Handle session, const void* message, void* reply, size_t size) {
+        std::unique_lock lock{g_mutex};
+        Object& s = g_objects[session];
+        if (s.clientClosed || s.serverClosed)
+            return KERNELRESULT(ConnectionClosed);
+        memcpy(s.request, message, std::min(size, sizeof(s.request)));
+        s.requestPending = true;
+        s.replied = false;
+        g_cv.notify_all();
+        // A reply lost by the server fails the test instead of hanging it
+        if (!g_cv.wait_for(lock, std::chrono::seconds(5), [&] { return s.replied || s.clientClosed || s.serverClosed; }))
+            return KERNELRESULT(TimedOut);
+        if (!s.replied)
+            return KERNELRESULT(ConnectionClosed);
+        memcpy(reply, s.reply, std::min(size, sizeof(s.reply)));
+        return 0;
+    }
+
+    void Close(Handle session) {
+        std::scoped_lock lock{g_mutex};
+        g_objects[session].clientClosed = true;
+        g_cv.notify_all();
+    }
+
+    bool WaitServerClosed(Handle session, unsigned timeout_ms) {
+        std::unique_lock lock{g_mutex};
+        return g_cv.wait_for(lock, std::chrono::milliseconds(timeout_ms), [&] { return g_objects[session].serverClosed; });
+    }
+
+    void Cancel() {
+        std::scoped_lock lock{g_mutex};
+        g_cancel = true;
+        g_cv.notify_all();
+    }
+}
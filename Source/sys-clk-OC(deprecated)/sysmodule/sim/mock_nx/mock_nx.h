@@ -0,0 +1,26 @@
+/*
+ * --------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <p-sam@d3vs.net>, <natinusala@gmail.com>, <m4x@m4xw.net>
+ * wrote this file. As long as you retain this notice you can do whatever you
+ * want with this stuff. If you meet any of us some day, and you think this
+ * stuff is worth it, you can buy us a beer in return.  - The sys-clk authors
+ * --------------------------------------------------------------------------
+ */
+
+#pragma once
+#include "switch.h"
+
+// Client side of the mock kernel, for the tests
+namespace MockNx {
+    Handle GetService(const char* name);
+    Handle Connect(Handle port);
+    // Sends the message and blocks until replied, ConnectionClosed once either side closed,
+    // TimedOut after 5 seconds
+    Result Request(Handle session, const void* message, void* reply, size_t size);
+    void Close(Handle session);
+    // Blocks until the server closed its end, false after timeout_ms
+    bool WaitServerClosed(Handle session, unsigned timeout_ms);
+    // svcWaitSynchronization returns Cancelled from now on
+    void Cancel();
+}
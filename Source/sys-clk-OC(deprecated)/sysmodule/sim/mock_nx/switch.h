@@ -0,0 +1,136 @@
+/*
+ * --------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <p-sam@d3vs.net>, <natinusala@gmail.com>, <m4x@m4xw.net>
+ * wrote this file. As long as you retain this notice you can do whatever you
+ * want with this stuff. If you meet any of us some day, and you think this
+ * stuff is worth it, you can buy us a beer in return.  - The sys-clk authors
+ * --------------------------------------------------------------------------
+ */
+
+// Host stand-in for the parts of libnx used by lib/nxExt/src/ipc_server.c, backed by the
+// mock kernel in mock_nx.cpp. Names and signatures follow libnx; the HIPC layout is
+// simplified (no descriptors) but keeps the 16-byte aligned CMIF data start.
+
+#pragma once
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+typedef uint8_t u8;
+typedef uint32_t u32;
+typedef uint64_t u64;
+typedef int32_t s32;
+typedef u32 Result;
+typedef u32 Handle;
+
+#define R_SUCCEEDED(res) ((res) == 0)
+#define R_FAILED(res) ((res) != 0)
+#define MAKERESULT(module, description) ((((module) & 0x1FF)) | ((description) & 0x1FFF) << 9)
+#define KERNELRESULT(description) MAKERESULT(Module_Kernel, KernelError_##description)
+
+enum { Module_Kernel = 1, Module_Libnx = 345 };
+enum {
+    KernelError_InvalidHandle = 114,
+    KernelError_TimedOut = 117,
+    KernelError_Cancelled = 118,
+    KernelError_NotFound = 121,
+    KernelError_ConnectionClosed = 123,
+};
+enum { LibnxError_OutOfMemory = 2, LibnxError_BadInput = 16, LibnxError_NotFound = 35 };
+
+#define MAX_WAIT_OBJECTS 0x40
+
+typedef pthread_mutex_t Mutex;
+void mutexInit(Mutex* m);
+void mutexLock(Mutex* m);
+void mutexUnlock(Mutex* m);
+
+typedef struct
+{
+    Handle revent;
+    Handle wevent;
+    bool autoclear;
+} Event;
+
+Result eventCreate(Event* t, bool autoclear);
+void eventClose(Event* t);
+Result eventFire(Event* t);
+Result eventClear(Event* t);
+
+typedef struct
+{
+    char name[8];
+} SmServiceName;
+
+SmServiceName smEncodeName(const char* name);
+Result smRegisterService(Handle* handle_out, SmServiceName name, bool is_light, s32 max_sessions);
+Result smUnregisterService(SmServiceName name);
+
+Result svcCloseHandle(Handle handle);
+Result svcAcceptSession(Handle* session_handle, Handle port_handle);
+Result svcWaitSynchronization(s32* index, const Handle* handles, s32 handleCount, u64 timeout);
+Result svcReplyAndReceive(s32* index, const Handle* handles, s32 handleCount, Handle replyTarget, u64 timeout);
+void* armGetTls(void);
+
+typedef enum
+{
+    CmifCommandType_Close = 2,
+    CmifCommandType_Request = 4,
+} CmifCommandType;
+
+#define CMIF_IN_HEADER_MAGIC 0x49434653  // "SFCI"
+#define CMIF_OUT_HEADER_MAGIC 0x4F434653 // "SFCO"
+
+typedef struct
+{
+    u32 type;
+    u32 num_recv_buffers;
+    u32 num_data_words;
+} HipcMetadata;
+
+typedef struct
+{
+    u32* data_words;
+} HipcRequest;
+
+typedef struct
+{
+    HipcMetadata meta;
+    HipcRequest data;
+} HipcParsedRequest;
+
+// Message: type, data word count, then the data words
+static inline HipcRequest hipcMakeRequest(void* base, HipcMetadata meta)
+{
+    u32* words = (u32*)base;
+    words[0] = meta.type;
+    words[1] = meta.num_data_words;
+    HipcRequest r = { words + 2 };
+    return r;
+}
+#define hipcMakeRequestInline(_base, ...) hipcMakeRequest((_base), (HipcMetadata){ __VA_ARGS__ })
+
+static inline HipcParsedRequest hipcParseRequest(void* base)
+{
+    u32* words = (u32*)base;
+    HipcParsedRequest r = { { words[0], 0, words[1] }, { words + 2 } };
+    return r;
+}
+
+static inline void* cmifGetAlignedDataStart(u32* data_words, void* base)
+{
+    intptr_t offset = (u8*)data_words - (u8*)base;
+    return (u8*)base + ((offset + 15) & ~15);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,165 @@
+/*
+ * --------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <p-sam@d3vs.net>, <natinusala@gmail.com>, <m4x@m4xw.net>
+ * wrote this file. As long as you retain this notice you can do whatever you
+ * want with this stuff. If you meet any of us some day, and you think this
+ * stuff is worth it, you can buy us a beer in return.  - The sys-clk authors
+ * --------------------------------------------------------------------------
+ */
+
+// Decode the binary context log (/config/sys-clk-oc/context.bin, see src/telemetry.h).
+//
+// Rows as CSV (stdout or -o), or columns with -c: one little-endian int64 array per
+// column in <dir>/<column>.i64, e.g. numpy.fromfile("cpu_hz.i64", "<i8").
+//
+// Usage: telemetry_decode <context.bin> [-o out.csv] [-c column_dir]
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "telemetry.h"
+
+typedef struct {
+    std::string name;
+    int64_t (*get)(const TelemetryRecord& r, int index);
+    int index;
+    bool hex;
+} Column;
+
+static std::vector<Column> MakeColumns() {
+    std::vector<Column> columns = {
+        { "timestamp",   [](const TelemetryRecord& r, int) -> int64_t { return r.timestampMs; } },
+        { "profile",     [](const TelemetryRecord& r, int) -> int64_t { return r.profile; } },
+        { "real_profile",[](const TelemetryRecord& r, int) -> int64_t { return r.realProfile; } },
+        { "app_tid",     [](const TelemetryRecord& r, int) -> int64_t { return r.applicationId; }, 0, true },
+        { "enabled",     [](const TelemetryRecord& r, int) -> int64_t { return r.enabled; } },
+        { "governor",    [](const TelemetryRecord& r, int) -> int64_t { return r.governorConfig; } },
+        { "perf_conf",   [](const TelemetryRecord& r, int) -> int64_t { return r.perfConfId; }, 0, true },
+    };
+
+    for (int module = 0; module < SysClkModule_EnumMax; module++) {
+        columns.push_back({ std::string(sysclkFormatModule((SysClkModule)module, false)) + "_hz",
+                            [](const TelemetryRecord& r, int i) -> int64_t { return r.freqs[i]; }, module });
+    }
+    for (int sensor = 0; sensor < SysClkThermalSensor_EnumMax; sensor++) {
+        columns.push_back({ std::string(sysclkFormatThermalSensor((SysClkThermalSensor)sensor, false)) + "_milliC",
+                            [](const TelemetryRecord& r, int i) -> int64_t { return r.temps[i]; }, sensor });
+    }
+
+    columns.push_back({ "cpu_util", [](const TelemetryRecord& r, int) -> int64_t { return r.util[0]; } });
+    columns.push_back({ "gpu_util", [](const TelemetryRecord& r, int) -> int64_t { return r.util[1]; } });
+    columns.push_back({ "power_mw", [](const TelemetryRecord& r, int) -> int64_t { return r.powerMw; } });
+    return columns;
+}
+
+static void WriteCsv(FILE* out, const std::vector<Column>& columns, const std::vector<TelemetryRecord>& records) {
+    for (size_t i = 0; i < columns.size(); i++)
+        fprintf(out, "%s%s", i ? "," : "", columns[i].name.c_str());
+    fprintf(out, "\n");
+
+    for (const auto& r : records) {
+        for (size_t i = 0; i < columns.size(); i++) {
+            const Column& c = columns[i];
+            int64_t v = c.get(r, c.index);
+            if (c.name == "profile" || c.name == "real_profile") {
+                const char* name = SYSCLK_ENUM_VALID(SysClkProfile, v) ? sysclkFormatProfile((SysClkProfile)v, false) : nullptr;
+                fprintf(out, "%s%s", i ? "," : "", name ? name : "?");
+            } else {
+                fprintf(out, c.hex ? "%s%016llx" : "%s%lld", i ? "," : "", (long long)v);
+            }
+        }
+        fprintf(out, "\n");
+    }
+}
+
+static bool WriteColumns(const char* dir, const std::vector<Column>& columns, const std::vector<TelemetryRecord>& records) {
+    std::vector<int64_t> values(records.size());
+    for (const auto& c : columns) {
+        for (size_t i = 0; i < records.size(); i++)
+            values[i] = c.get(records[i], c.index);
+
+        std::string path = std::string(dir) + "/" + c.name + ".i64";
+        FILE* fp = fopen(path.c_str(), "wb");
+        if (!fp) {
+            fprintf(stderr, "Cannot open %s\n", path.c_str());
+            return false;
+        }
+        fwrite(values.data(), sizeof(int64_t), values.size(), fp);
+        fclose(fp);
+    }
+    return true;
+}
+
+static int Usage(const char* argv0) {
+    fprintf(stderr, "Usage: %s <context.bin> [-o out.csv] [-c column_dir]\n", argv0);
+    return -1;
+}
+
+int main(int argc, char** argv) {
+    const char* in_path = nullptr;
+    const char* csv_path = nullptr;
+    const char* column_dir = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-o") && i + 1 < argc)
+            csv_path = argv[++i];
+        else if (!strcmp(argv[i], "-c") && i + 1 < argc)
+            column_dir = argv[++i];
+        else if (!in_path)
+            in_path = argv[i];
+        else
+            return Usage(argv[0]);
+    }
+    if (!in_path)
+        return Usage(argv[0]);
+
+    FILE* fp = fopen(in_path, "rb");
+    if (!fp) {
+        fprintf(stderr, "Cannot open %s\n", in_path);
+        return -1;
+    }
+
+    TelemetryHeader header;
+    TelemetryHeader expected = TelemetryMakeHeader();
+    if (fread(&header, sizeof(header), 1, fp) != 1 || header.magic != TELEMETRY_MAGIC) {
+        fprintf(stderr, "%s: not a context log\n", in_path);
+        fclose(fp);
+        return -1;
+    }
+    if (header.version != expected.version || header.recordSize != expected.recordSize ||
+        header.moduleCount != expected.moduleCount || header.sensorCount != expected.sensorCount) {
+        fprintf(stderr, "%s: unsupported layout (version %u, record %u bytes, %u modules, %u sensors)\n",
+                in_path, header.version, header.recordSize, header.moduleCount, header.sensorCount);
+        fclose(fp);
+        return -1;
+    }
+
+    std::vector<TelemetryRecord> records;
+    TelemetryRecord record;
+    while (fread(&record, sizeof(record), 1, fp) == 1)
+        records.push_back(record);
+    fclose(fp);
+
+    std::vector<Column> columns = MakeColumns();
+    if (column_dir) {
+        if (!WriteColumns(column_dir, columns, records))
+            return -1;
+    }
+
+    if (csv_path || !column_dir) {
+        FILE* out = csv_path ? fopen(csv_path, "w") : stdout;
+        if (!out) {
+            fprintf(stderr, "Cannot open %s\n", csv_path);
+            return -1;
+        }
+        WriteCsv(out, columns, records);
+        if (csv_path)
+            fclose(out);
+    }
+
+    fprintf(stderr, "%zu records\n", records.size());
+    return 0;
+}
@@ -15,6 +15,7 @@
 #include "clocks.h"
 #include "process_management.h"
 #include <cstring>
+#include <algorithm>
 
 ClockManager* ClockManager::instance = NULL;
 
@@ -52,9 +53,21 @@ ClockManager::ClockManager()
         this->context->overrideFreqs[i] = 0;
     }
     this->context->perfConfId = 0;
+    this->publishedContext.Store(*this->context);
     this->running = false;
     this->lastTempLogNs = 0;
-    this->lastCsvWriteNs = 0;
+    this->batteryPowerMw = 0;
+    this->ticks = 0;
+
+    /* Each source runs on its own period, the tick only runs what is due */
+    this->pollers[Poller_Profile] = { .name = "profile", .func = &ClockManager::PollProfile };
+    this->pollers[Poller_Charger] = { .name = "charger", .func = &ClockManager::PollCharger, .periodNs = CHARGER_POLL_NS };
+    this->pollers[Poller_Config]  = { .name = "config",  .func = &ClockManager::PollConfig,  .periodNs = CONFIG_POLL_NS };
+    this->pollers[Poller_Title]   = { .name = "title",   .func = &ClockManager::PollTitle };
+    this->pollers[Poller_Clocks]  = { .name = "clocks",  .func = &ClockManager::PollClocks };
+    this->pollers[Poller_Thermal] = { .name = "thermal", .func = &ClockManager::PollThermal, .periodNs = THERMAL_POLL_NS };
+    this->pollers[Poller_Telemetry] = { .name = "telemetry", .func = &ClockManager::PollTelemetry };
+    this->pollers[Poller_Stats]   = { .name = "stats",   .func = &ClockManager::PollStats,   .periodNs = STATS_POLL_NS };
 
     this->oc = new SysClkOcExtra;
     this->oc->systemCoreBoostCPU = false;
@@ -140,10 +153,10 @@ uint32_t ClockManager::GetHz(SysClkModule module)
 
 void ClockManager::Tick()
 {
-    std::scoped_lock lock{this->contextMutex};
-
     if (this->RefreshContext() && this->context->enabled)
     {
+        Clocks::ClockTransaction transaction = {};
+
         for (unsigned int module = 0; module < SysClkModule_EnumMax; module++)
         {
             uint32_t hz = GetHz((SysClkModule)module);
@@ -164,16 +177,30 @@ void ClockManager::Tick()
                     ((module == SysClkModule_CPU && hz <= Clocks::boostCpuFreq) || module == SysClkModule_GPU);
 
                 if (!skipBoost) {
-                    FileUtils::LogLine("[mgr] %s clock set : %u.%u MHz", Clocks::GetModuleName((SysClkModule)module, true), hz/1000000, hz/100000 - hz/1000000*10);
-                    Clocks::SetHz((SysClkModule)module, hz);
-                    uint32_t hz_now = Clocks::GetCurrentHz((SysClkModule)module);
-                    if (hz != hz_now)
-                        FileUtils::LogLine("[mgr] Cannot set %s clock to %u.%u MHz", Clocks::GetModuleName((SysClkModule)module, true), hz/1000000, hz/100000 - hz/1000000*10);
-                    this->context->freqs[module] = hz_now;
+                    transaction.Set((SysClkModule)module, hz, this->context->freqs[module]);
                 }
             }
         }
+
+        if (Clocks::Apply(&transaction, true))
+        {
+            for (unsigned int module = 0; module < SysClkModule_EnumMax; module++)
+            {
+                if (!transaction.IsSet((SysClkModule)module))
+                    continue;
+
+                uint32_t hz = transaction.targetHz[module];
+                uint32_t hz_now = transaction.appliedHz[module];
+                FileUtils::LogLine("[mgr] %s clock set : %u.%u MHz (%u us)", Clocks::GetModuleName((SysClkModule)module, true), hz/1000000, hz/100000 - hz/1000000*10, transaction.latencyUs[module]);
+                if (hz != hz_now)
+                    FileUtils::LogLine("[mgr] Cannot set %s clock to %u.%u MHz", Clocks::GetModuleName((SysClkModule)module, true), hz/1000000, hz/100000 - hz/1000000*10);
+                this->context->freqs[module] = hz_now;
+            }
+        }
     }
+
+    // IPC readers only see complete snapshots and never wait for the tick
+    this->publishedContext.Store(*this->context);
 }
 
 void ClockManager::WaitForNextTick()
@@ -215,29 +242,100 @@ void ClockManager::WaitForNextTick()
 
 bool ClockManager::RefreshContext()
 {
-    PsmExt::ChargingHandler(this->GetInstance());
-
+    std::uint64_t ns = armTicksToNs(armGetSystemTick());
     bool hasChanged = false;
-    SysClkProfile realProfile = Clocks::GetCurrentProfile();
-    if (realProfile != this->oc->realProfile)
-    {
-        FileUtils::LogLine("[mgr] Profile change: %s", Clocks::GetProfileName(realProfile, true));
-        this->oc->realProfile = realProfile;
-        // Signal that power state has been changed, reset the override
-        this->SetBatteryChargingDisabledOverride(false);
-        hasChanged = true;
+
+    this->ticks++;
+    hasChanged |= this->Poll(Poller_Profile, ns);
+    this->Poll(Poller_Charger, ns);
+    hasChanged |= this->Poll(Poller_Config, ns, this->config->HasPendingChanges());
+    hasChanged |= this->Poll(Poller_Title, ns);
+
+    // let ptm module handle boost clocks rather than resetting
+    if (hasChanged && !apmExtIsBoostMode(this->context->perfConfId)) {
+        Clocks::ResetToStock();
     }
 
-    hasChanged = this->config->Refresh();
-    if (hasChanged) {
-        this->rnxSync->ToggleSync(this->GetConfig()->GetConfigValue(SysClkConfigValue_SyncReverseNXMode));
-        bool allowUnsafe = this->GetConfig()->GetConfigValue(SysClkConfigValue_AllowUnsafeFrequencies);
-        Clocks::SetAllowUnsafe(allowUnsafe);
+    hasChanged |= this->Poll(Poller_Clocks, ns);
+
+    // temperatures do not and should not force a refresh, hasChanged untouched
+    this->Poll(Poller_Thermal, ns);
+    this->Poll(Poller_Telemetry, ns);
+    this->Poll(Poller_Stats, ns);
+
+    return hasChanged;
+}
 
-        this->governor->SetAutoCPUBoost(this->GetConfig()->GetConfigValue(SysClkConfigValue_AutoCPUBoost));
-        this->governor->SetCPUBoostHz(Clocks::GetNearestHz(SysClkModule_CPU, this->oc->realProfile, Clocks::boostCpuFreq));
+bool ClockManager::Poll(PollerId id, std::uint64_t ns, bool force)
+{
+    Poller* poller = &this->pollers[id];
+    bool due = force || !poller->lastNs || (ns - poller->lastNs) >= poller->periodNs;
+    if (!due)
+    {
+        poller->skips++;
+        return false;
     }
 
+    poller->lastNs = ns;
+    std::uint64_t start = armGetSystemTick();
+    bool changed = (this->*(poller->func))(ns);
+    std::uint64_t spentNs = armTicksToNs(armGetSystemTick() - start);
+
+    poller->runs++;
+    poller->totalNs += spentNs;
+    poller->maxNs = std::max(poller->maxNs, spentNs);
+    return changed;
+}
+
+bool ClockManager::PollProfile(std::uint64_t ns)
+{
+    SysClkProfile realProfile = Clocks::GetCurrentProfile();
+    if (realProfile == this->oc->realProfile)
+        return false;
+
+    FileUtils::LogLine("[mgr] Profile change: %s", Clocks::GetProfileName(realProfile, true));
+    this->oc->realProfile = realProfile;
+    // Signal that power state has been changed, reset the override
+    this->SetBatteryChargingDisabledOverride(false);
+    // Charger state follows the power state, don't wait for the next period
+    this->pollers[Poller_Charger].lastNs = 0;
+    return true;
+}
+
+bool ClockManager::PollCharger(std::uint64_t ns)
+{
+    PsmExt::ChargingHandler(this);
+    return false;
+}
+
+bool ClockManager::PollConfig(std::uint64_t ns)
+{
+    if (!this->config->Refresh())
+        return false;
+
+    this->rnxSync->ToggleSync(this->GetConfig()->GetConfigValue(SysClkConfigValue_SyncReverseNXMode));
+    bool allowUnsafe = this->GetConfig()->GetConfigValue(SysClkConfigValue_AllowUnsafeFrequencies);
+    Clocks::SetAllowUnsafe(allowUnsafe);
+
+    this->governor->SetAutoCPUBoost(this->GetConfig()->GetConfigValue(SysClkConfigValue_AutoCPUBoost));
+    this->governor->SetCPUBoostHz(Clocks::GetNearestHz(SysClkModule_CPU, this->oc->realProfile, Clocks::boostCpuFreq));
+    this->governor->SetTransitionParams({
+        .up_threshold       = (uint32_t)this->GetConfig()->GetConfigValue(SysClkConfigValue_GovernorUpThreshold),
+        .down_threshold     = (uint32_t)this->GetConfig()->GetConfigValue(SysClkConfigValue_GovernorDownThreshold),
+        .min_residency_ms   = (uint32_t)this->GetConfig()->GetConfigValue(SysClkConfigValue_GovernorMinResidencyMs),
+        .max_per_sec        = (uint32_t)this->GetConfig()->GetConfigValue(SysClkConfigValue_GovernorMaxTransitions),
+    });
+    this->governor->SetEnergyModel(this->GetConfig()->GetConfigValue(SysClkConfigValue_GovernorEnergyModel));
+
+    std::uint64_t csvWriteInterval = this->GetConfig()->GetConfigValue(SysClkConfigValue_CsvWriteIntervalMs) * 1000000ULL;
+    this->pollers[Poller_Telemetry].periodNs = csvWriteInterval;
+    return true;
+}
+
+bool ClockManager::PollTitle(std::uint64_t ns)
+{
+    bool hasChanged = false;
+
     bool enabled = this->GetConfig()->Enabled();
     if(enabled != this->context->enabled)
     {
@@ -265,11 +363,18 @@ bool ClockManager::RefreshContext()
         if (governorConfig != governorConfigTitle)
             governorConfig = governorConfigTitle;
         // Set governor config to disabled if Handheld Only is true
-        if (governorHandheldOnly && (realProfile != SysClkProfile_Handheld))
+        if (governorHandheldOnly && (this->oc->realProfile != SysClkProfile_Handheld))
             governorConfig = SysClkOcGovernorConfig_AllDisabled;
     }
     this->governor->SetConfig(governorConfig);
 
+    GovernorCore::Tuning tuning = this->GetConfig()->GetTitleGovernorTuning(applicationId);
+    if (this->governor->SetTuning(tuning))
+    {
+        FileUtils::LogLine("[mgr] Governor tuning: %u Hz, headroom %u", tuning.GetSampleRate(), tuning.GetHeadroom());
+        hasChanged = true;
+    }
+
     /* Update PerformanceConfigurationId */
     {
         uint32_t confId = 0;
@@ -292,11 +397,12 @@ bool ClockManager::RefreshContext()
             hasChanged = true;
     }
 
-    // let ptm module handle boost clocks rather than resetting
-    if (hasChanged && !apmExtIsBoostMode(this->context->perfConfId)) {
-        Clocks::ResetToStock();
-    }
+    return hasChanged;
+}
 
+bool ClockManager::PollClocks(std::uint64_t ns)
+{
+    bool hasChanged = false;
     std::uint32_t hz = 0;
     for (unsigned int module = 0; module < SysClkModule_EnumMax; module++)
     {
@@ -328,9 +434,12 @@ bool ClockManager::RefreshContext()
         }
     }
 
-    // temperatures do not and should not force a refresh, hasChanged untouched
+    return hasChanged;
+}
+
+bool ClockManager::PollThermal(std::uint64_t ns)
+{
     std::uint32_t millis = 0;
-    std::uint64_t ns = armTicksToNs(armGetSystemTick());
     std::uint64_t tempLogInterval = this->GetConfig()->GetConfigValue(SysClkConfigValue_TempLogIntervalMs) * 1000000ULL;
     bool shouldLogTemp = tempLogInterval && ((ns - this->lastTempLogNs) > tempLogInterval);
     for (unsigned int sensor = 0; sensor < SysClkThermalSensor_EnumMax; sensor++)
@@ -348,15 +457,78 @@ bool ClockManager::RefreshContext()
         this->lastTempLogNs = ns;
     }
 
-    std::uint64_t csvWriteInterval = this->GetConfig()->GetConfigValue(SysClkConfigValue_CsvWriteIntervalMs) * 1000000ULL;
+    // Fuel gauge averages over seconds anyway, sampled with temperatures for telemetry
+    this->batteryPowerMw = I2c_Max17050_GetBatteryCurrent() * I2c_Max17050_GetBatteryVoltage() / 1000;
 
-    if(csvWriteInterval && ((ns - this->lastCsvWriteNs) > csvWriteInterval))
+    return false;
+}
+
+bool ClockManager::PollTelemetry(std::uint64_t ns)
+{
+    // Period is csv_write_interval_ms, 0 disables
+    if (!this->pollers[Poller_Telemetry].periodNs)
     {
-        FileUtils::WriteContextToCsv(this->context);
-        this->lastCsvWriteNs = ns;
+        return false;
     }
 
-    return hasChanged;
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+
+    TelemetryRecord record = {
+        .timestampMs    = (std::uint64_t)now.tv_sec * 1000 + now.tv_nsec / 1000000UL,
+        .applicationId  = this->context->applicationId,
+        .freqs          = {},
+        .temps          = {},
+        .perfConfId     = this->context->perfConfId,
+        .powerMw        = this->batteryPowerMw,
+        .util           = { (std::uint16_t)this->governor->GetUtil(SysClkModule_CPU), (std::uint16_t)this->governor->GetUtil(SysClkModule_GPU) },
+        .profile        = (std::uint8_t)this->context->profile,
+        .realProfile    = (std::uint8_t)this->oc->realProfile,
+        .enabled        = this->context->enabled,
+        .governorConfig = (std::uint8_t)this->governor->GetConfig(),
+    };
+    std::memcpy(record.freqs, this->context->freqs, sizeof(record.freqs));
+    std::memcpy(record.temps, this->context->temps, sizeof(record.temps));
+
+    FileUtils::WriteContextRecord(&record);
+    return false;
+}
+
+bool ClockManager::PollStats(std::uint64_t ns)
+{
+    // Skip the first run at boot, nothing measured yet
+    if (this->ticks > 1)
+    {
+        std::uint64_t totalNs = 0;
+        for (auto& poller : this->pollers)
+        {
+            if (poller.runs)
+            {
+                FileUtils::LogLine("[mgr] Poll %s: %u runs, %u skipped, avg %lu us, max %lu us", poller.name, poller.runs, poller.skips, poller.totalNs / poller.runs / 1000, poller.maxNs / 1000);
+            }
+            totalNs += poller.totalNs;
+        }
+        FileUtils::LogLine("[mgr] Poll total: %u ticks, avg %lu us per tick", this->ticks, totalNs / this->ticks / 1000);
+
+        // Governor calls included
+        Clocks::IpcStats ipc = Clocks::GetIpcStats(true);
+        std::uint64_t calls = 0;
+        for (std::uint64_t count : ipc.calls)
+        {
+            calls += count;
+        }
+        FileUtils::LogLine("[mgr] Clock IPC: %lu calls (%lu get, %lu set, %lu open, %lu close), %lu.%02lu per tick", calls,
+            ipc.calls[Clocks::ClockIpc_Get], ipc.calls[Clocks::ClockIpc_Set], ipc.calls[Clocks::ClockIpc_Open], ipc.calls[Clocks::ClockIpc_Close],
+            calls / this->ticks, calls * 100 / this->ticks % 100);
+    }
+
+    for (auto& poller : this->pollers)
+    {
+        poller.runs = poller.skips = 0;
+        poller.totalNs = poller.maxNs = 0;
+    }
+    this->ticks = 0;
+    return false;
 }
 
 void ClockManager::SetRNXRTMode(ReverseNXMode mode) {
@@ -365,8 +537,7 @@ void ClockManager::SetRNXRTMode(ReverseNXMode mode) {
 
 SysClkContext ClockManager::GetCurrentContext()
 {
-    std::scoped_lock lock{this->contextMutex};
-    return *this->context;
+    return this->publishedContext.Load();
 }
 
 Config* ClockManager::GetConfig()
@@ -382,3 +553,7 @@ Result ClockManager::SetBatteryChargingDisabledOverride(bool toggle_true) {
     this->oc->batteryChargingDisabledOverride = toggle_true;
     return 0;
 }
+
+SysClkGovernorStats ClockManager::GetGovernorStats() {
+    return this->governor->GetStats();
+}
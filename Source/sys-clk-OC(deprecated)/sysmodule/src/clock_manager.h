@@ -18,6 +18,7 @@
 #include <nxExt/cpp/lockable_mutex.h>
 
 #include "oc_extra.h"
+#include "seqlock.h"
 
 // Forward declaration
 class ReverseNXSync;
@@ -39,21 +40,65 @@ class ClockManager
     Config* GetConfig();
     bool GetBatteryChargingDisabledOverride();
     Result SetBatteryChargingDisabledOverride(bool toggle_true);
+    SysClkGovernorStats GetGovernorStats();
 
   protected:
     ClockManager();
     virtual ~ClockManager();
 
+    typedef enum
+    {
+        Poller_Profile = 0,
+        Poller_Charger,
+        Poller_Config,
+        Poller_Title,
+        Poller_Clocks,
+        Poller_Thermal,
+        Poller_Telemetry,
+        Poller_Stats,
+        Poller_EnumMax
+    } PollerId;
+
+    typedef bool (ClockManager::*PollFunc)(std::uint64_t ns);
+
+    typedef struct
+    {
+        const char* name;
+        PollFunc func;
+        std::uint64_t periodNs; // 0: every tick
+        std::uint64_t lastNs;   // 0: due on next tick
+        std::uint32_t runs;
+        std::uint32_t skips;
+        std::uint64_t totalNs;
+        std::uint64_t maxNs;
+    } Poller;
+
+    static constexpr std::uint64_t CHARGER_POLL_NS = 5000'000'000ULL;
+    static constexpr std::uint64_t CONFIG_POLL_NS  = 1000'000'000ULL;
+    static constexpr std::uint64_t THERMAL_POLL_NS = 1000'000'000ULL;
+    static constexpr std::uint64_t STATS_POLL_NS   = 60'000'000'000ULL;
+
     bool RefreshContext();
+    bool Poll(PollerId id, std::uint64_t ns, bool force = false);
+    bool PollProfile(std::uint64_t ns);
+    bool PollCharger(std::uint64_t ns);
+    bool PollConfig(std::uint64_t ns);
+    bool PollTitle(std::uint64_t ns);
+    bool PollClocks(std::uint64_t ns);
+    bool PollThermal(std::uint64_t ns);
+    bool PollTelemetry(std::uint64_t ns);
+    bool PollStats(std::uint64_t ns);
     uint32_t GetHz(SysClkModule);
 
     static ClockManager *instance;
     std::atomic_bool running;
-    LockableMutex contextMutex;
     Config *config;
-    SysClkContext *context;
+    SysClkContext *context; // Owned by the tick thread
+    SeqLock<SysClkContext> publishedContext;
     std::uint64_t lastTempLogNs;
-    std::uint64_t lastCsvWriteNs;
+    std::int32_t batteryPowerMw;
+    Poller pollers[Poller_EnumMax];
+    std::uint32_t ticks;
 
     SysClkOcExtra *oc;
     ReverseNXSync *rnxSync;
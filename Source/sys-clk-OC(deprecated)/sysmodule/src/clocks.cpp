@@ -8,7 +8,11 @@
  * --------------------------------------------------------------------------
  */
 
+#include <algorithm>
+#include <array>
 #include <cstring>
+#include <mutex>
+#include <shared_mutex>
 #include <nxExt.h>
 #include "clocks.h"
 #include "errors.h"
@@ -138,7 +142,29 @@ void Clocks::Initialize()
     if(hosversionAtLeast(8,0,0))
     {
         rc = clkrstInitialize();
-        ASSERT_RESULT_OK(rc, "pcvInitialize");
+        ASSERT_RESULT_OK(rc, "clkrstInitialize");
+
+        for(unsigned int module = 0; module < SysClkModule_EnumMax; module++)
+        {
+            OpenClkrstSession((SysClkModule)module, &clkrstSessions[module]);
+        }
+
+        // Optional: without it the energy model never learns any voltage
+        rgltrReady = R_SUCCEEDED(rgltrInitialize());
+        if (rgltrReady)
+        {
+            const PowerDomainId domains[][2] = {
+                { PcvPowerDomainId_Max77621_Cpu, PcvPowerDomainId_Max77621_Gpu },
+                { PcvPowerDomainId_Max77812_Cpu, PcvPowerDomainId_Max77812_Gpu },
+            };
+            for (SysClkModule module : { SysClkModule_CPU, SysClkModule_GPU })
+            {
+                rc = rgltrOpenSession(&rgltrSessions[module], domains[isMariko][module == SysClkModule_GPU]);
+                rgltrOpened[module] = R_SUCCEEDED(rc);
+                if (!rgltrOpened[module])
+                    FileUtils::LogLine("[clk] No regulator session for %s: [0x%x]", Clocks::GetModuleName(module, false), rc);
+            }
+        }
     }
     else
     {
@@ -170,11 +196,26 @@ void Clocks::Exit()
 {
     if(hosversionAtLeast(8,0,0))
     {
-        pcvExit();
+        for(unsigned int module = 0; module < SysClkModule_EnumMax; module++)
+        {
+            clkrstCloseSession(&clkrstSessions[module]);
+            CountIpc(ClockIpc_Close);
+            if (rgltrOpened[module])
+            {
+                rgltrCloseSession(&rgltrSessions[module]);
+                rgltrOpened[module] = false;
+            }
+        }
+        clkrstExit();
+        if (rgltrReady)
+        {
+            rgltrExit();
+            rgltrReady = false;
+        }
     }
     else
     {
-        clkrstExit();
+        pcvExit();
     }
 
     apmExtExit();
@@ -249,23 +290,99 @@ PcvModuleId Clocks::GetPcvModuleId(SysClkModule sysclkModule)
     return pcvModuleId;
 }
 
+// Ids of sysclk_g_apm_configurations, same order. A lookup hashes the id to its slot and
+// checks the entry id, so the table drifting from this list is only slower, never wrong.
+static constexpr uint32_t apmConfIds[] = {
+    0x00010000, 0x00010001, 0x00010002,
+    0x00020000, 0x00020001, 0x00020002, 0x00020003, 0x00020004, 0x00020005, 0x00020006,
+    0x92220007, 0x92220008, 0x92220009, 0x9222000A, 0x9222000B, 0x9222000C,
+};
+static constexpr uint32_t APM_HASH_BITS = 5;
+static constexpr size_t APM_HASH_SLOTS = 1 << APM_HASH_BITS;
+
+static constexpr uint32_t ApmHash(uint32_t confId, uint32_t mul)
+{
+    return (confId * mul) >> (32 - APM_HASH_BITS);
+}
+
+// First odd multiplier giving every known id its own slot
+static constexpr uint32_t FindApmHashMul()
+{
+    for (uint32_t mul = 0x9E3779B1; mul != 0x9E3779B1 + 2 * 4096; mul += 2)
+    {
+        bool used[APM_HASH_SLOTS] = {};
+        bool perfect = true;
+        for (uint32_t id : apmConfIds)
+        {
+            uint32_t slot = ApmHash(id, mul);
+            perfect = perfect && !used[slot];
+            used[slot] = true;
+        }
+        if (perfect)
+            return mul;
+    }
+    return 0;
+}
+
+static constexpr uint32_t APM_HASH_MUL = FindApmHashMul();
+static_assert(APM_HASH_MUL, "No perfect hash for the apm configuration ids");
+
+// Slot -> index + 1 in sysclk_g_apm_configurations, 0 if free
+static constexpr auto apmHashSlots = [] {
+    std::array<uint8_t, APM_HASH_SLOTS> slots = {};
+    for (size_t i = 0; i < std::size(apmConfIds); i++)
+        slots[ApmHash(apmConfIds[i], APM_HASH_MUL)] = i + 1;
+    return slots;
+}();
+
 SysClkApmConfiguration* Clocks::GetEmbeddedApmConfig(uint32_t confId)
 {
-    SysClkApmConfiguration* apmConfiguration = NULL;
+    if (uint8_t slot = apmHashSlots[ApmHash(confId, APM_HASH_MUL)])
+    {
+        if (sysclk_g_apm_configurations[slot - 1].id == confId)
+            return &sysclk_g_apm_configurations[slot - 1];
+    }
+
     for(size_t i = 0; sysclk_g_apm_configurations[i].id; i++)
     {
         if(sysclk_g_apm_configurations[i].id == confId)
-        {
-            apmConfiguration = &sysclk_g_apm_configurations[i];
-            break;
-        }
+            return &sysclk_g_apm_configurations[i];
     }
 
-    if(!apmConfiguration)
+    return GetUnknownApmConfig(confId);
+}
+
+SysClkApmConfiguration* Clocks::GetUnknownApmConfig(uint32_t confId)
+{
+    std::scoped_lock lock{apmOverflowMutex};
+
+    auto it = apmOverflow.find(confId);
+    if (it != apmOverflow.end())
+        return &it->second;
+
+    // Current clocks may already be overrides or governor steps. Take the lowest stock clocks of the
+    // known configurations of the same family (upper half of the id: docked, handheld, boost),
+    // or of all of them if the family is new too.
+    SysClkApmConfiguration conf = { .id = confId, .cpu_hz = UINT32_MAX, .gpu_hz = UINT32_MAX, .mem_hz = UINT32_MAX };
+    for (bool anyFamily : { false, true })
     {
-        ERROR_THROW("Unknown apm configuration: %x", confId);
+        for (size_t i = 0; sysclk_g_apm_configurations[i].id; i++)
+        {
+            const SysClkApmConfiguration& known = sysclk_g_apm_configurations[i];
+            if (!anyFamily && (known.id >> 16) != (confId >> 16))
+                continue;
+            conf.cpu_hz = std::min(conf.cpu_hz, known.cpu_hz);
+            conf.gpu_hz = std::min(conf.gpu_hz, known.gpu_hz);
+            conf.mem_hz = std::min(conf.mem_hz, known.mem_hz);
+        }
+        if (conf.cpu_hz != UINT32_MAX)
+            break;
     }
-    return apmConfiguration;
+    FileUtils::LogLine("[clk] Unknown apm configuration %x, lowest known stock clocks: CPU %u, GPU %u, MEM %u",
+        confId, conf.cpu_hz, conf.gpu_hz, conf.mem_hz);
+
+    // Node pointers stay valid across rehashes
+    return &apmOverflow.emplace(confId, conf).first->second;
 }
 
 uint32_t Clocks::GetStockClock(SysClkApmConfiguration* apm, SysClkModule module)
@@ -293,18 +410,15 @@ void Clocks::ResetToStock(unsigned int module)
 
         SysClkApmConfiguration* apmConfiguration = GetEmbeddedApmConfig(confId);
 
-        if (module == SysClkModule_EnumMax || module == SysClkModule_CPU)
+        ClockTransaction transaction = {};
+        for (unsigned int m = 0; m < SysClkModule_EnumMax; m++)
         {
-            Clocks::SetHz(SysClkModule_CPU, GetStockClock(apmConfiguration, SysClkModule_CPU));
-        }
-        if (module == SysClkModule_EnumMax || module == SysClkModule_GPU)
-        {
-            Clocks::SetHz(SysClkModule_GPU, GetStockClock(apmConfiguration, SysClkModule_GPU));
-        }
-        if (module == SysClkModule_EnumMax || module == SysClkModule_MEM)
-        {
-            Clocks::SetHz(SysClkModule_MEM, GetStockClock(apmConfiguration, SysClkModule_MEM));
+            if (module == SysClkModule_EnumMax || module == m)
+            {
+                transaction.Set((SysClkModule)m, GetStockClock(apmConfiguration, (SysClkModule)m));
+            }
         }
+        Clocks::Apply(&transaction, false);
     }
     else
     {
@@ -346,26 +460,105 @@ SysClkProfile Clocks::GetCurrentProfile()
     }
 }
 
+void Clocks::OpenClkrstSession(SysClkModule module, ClkrstSession* session)
+{
+    Result rc = clkrstOpenSession(session, Clocks::GetPcvModuleId(module), 3);
+    ASSERT_RESULT_OK(rc, "clkrstOpenSession");
+    CountIpc(ClockIpc_Open);
+}
+
+Result Clocks::ClkrstCall(SysClkModule module, Result (*call)(ClkrstSession* session, void* arg), void* arg)
+{
+    std::uint32_t generation;
+    Result rc;
+    {
+        std::shared_lock lock{clkrstLocks[module]};
+        generation = clkrstGeneration[module];
+        rc = call(&clkrstSessions[module], arg);
+    }
+    if (R_SUCCEEDED(rc))
+    {
+        return rc;
+    }
+
+    // Waits for the calls in flight, none can start on the session while it is reopened
+    std::scoped_lock lock{clkrstLocks[module]};
+    // Another thread may have reopened it already
+    if (generation == clkrstGeneration[module])
+    {
+        FileUtils::LogLine("[clk] Reopening clkrst session for %s: [0x%x]", Clocks::GetModuleName(module, false), rc);
+        clkrstCloseSession(&clkrstSessions[module]);
+        CountIpc(ClockIpc_Close);
+        OpenClkrstSession(module, &clkrstSessions[module]);
+        clkrstGeneration[module]++;
+    }
+
+    return call(&clkrstSessions[module], arg);
+}
+
 void Clocks::SetHz(SysClkModule module, std::uint32_t hz)
 {
     Result rc = 0;
 
     if(hosversionAtLeast(8,0,0))
     {
-        ClkrstSession session = {0};
-
-        rc = clkrstOpenSession(&session, Clocks::GetPcvModuleId(module), 3);
-        ASSERT_RESULT_OK(rc, "clkrstOpenSession");
-        rc = clkrstSetClockRate(&session, hz);
+        rc = ClkrstCall(module, [](ClkrstSession* session, void* arg) {
+            CountIpc(ClockIpc_Set);
+            return clkrstSetClockRate(session, *(std::uint32_t*)arg);
+        }, &hz);
         ASSERT_RESULT_OK(rc, "clkrstSetClockRate");
-
-        clkrstCloseSession(&session);
     }
     else
     {
+        CountIpc(ClockIpc_Set);
         rc = pcvSetClockRate(Clocks::GetPcvModule(module), hz);
         ASSERT_RESULT_OK(rc, "pcvSetClockRate");
     }
+
+    lastKnownHz[module].store(hz, std::memory_order_relaxed);
+}
+
+unsigned int Clocks::Apply(ClockTransaction* transaction, bool readBack)
+{
+    // Consumers going down first, then MEM, then consumers going up: GPU never runs faster than
+    // MEM can feed it and both are never high at once. Each rail is handled by pcv, which raises
+    // voltage before frequency and lowers it after.
+    auto IsLowering = [&](SysClkModule module) {
+        std::uint32_t current = transaction->currentHz[module] ? transaction->currentHz[module] : lastKnownHz[module].load(std::memory_order_relaxed);
+        return current && transaction->targetHz[module] < current;
+    };
+
+    SysClkModule order[SysClkModule_EnumMax];
+    unsigned int count = 0;
+    for (SysClkModule module : { SysClkModule_CPU, SysClkModule_GPU })
+    {
+        if (transaction->IsSet(module) && IsLowering(module))
+            order[count++] = module;
+    }
+    if (transaction->IsSet(SysClkModule_MEM))
+        order[count++] = SysClkModule_MEM;
+    for (SysClkModule module : { SysClkModule_GPU, SysClkModule_CPU })
+    {
+        if (transaction->IsSet(module) && !IsLowering(module))
+            order[count++] = module;
+    }
+
+    for (unsigned int i = 0; i < count; i++)
+    {
+        std::uint64_t start = armGetSystemTick();
+        Clocks::SetHz(order[i], transaction->targetHz[order[i]]);
+        transaction->latencyUs[order[i]] = armTicksToNs(armGetSystemTick() - start) / 1000;
+    }
+
+    if (readBack)
+    {
+        for (unsigned int i = 0; i < count; i++)
+        {
+            transaction->appliedHz[order[i]] = Clocks::GetCurrentHz(order[i]);
+        }
+    }
+
+    return count;
 }
 
 std::uint32_t Clocks::GetCurrentHz(SysClkModule module)
@@ -375,32 +568,41 @@ std::uint32_t Clocks::GetCurrentHz(SysClkModule module)
 
     if(hosversionAtLeast(8,0,0))
     {
-        ClkrstSession session = {0};
-
-        rc = clkrstOpenSession(&session, Clocks::GetPcvModuleId(module), 3);
-        ASSERT_RESULT_OK(rc, "clkrstOpenSession");
-
-        rc = clkrstGetClockRate(&session, &hz);
+        rc = ClkrstCall(module, [](ClkrstSession* session, void* arg) {
+            CountIpc(ClockIpc_Get);
+            return clkrstGetClockRate(session, (std::uint32_t*)arg);
+        }, &hz);
         ASSERT_RESULT_OK(rc, "clkrstGetClockRate");
-
-        clkrstCloseSession(&session);
     }
     else
     {
+        CountIpc(ClockIpc_Get);
         rc = pcvGetClockRate(Clocks::GetPcvModule(module), &hz);
         ASSERT_RESULT_OK(rc, "pcvGetClockRate");
     }
 
+    lastKnownHz[module].store(hz, std::memory_order_relaxed);
     return hz;
 }
 
+Clocks::IpcStats Clocks::GetIpcStats(bool reset)
+{
+    IpcStats stats;
+    for(unsigned int ipc = 0; ipc < ClockIpc_EnumMax; ipc++)
+    {
+        stats.calls[ipc] = reset ? ipcCalls[ipc].exchange(0, std::memory_order_relaxed) : ipcCalls[ipc].load(std::memory_order_relaxed);
+    }
+
+    return stats;
+}
+
 std::uint32_t Clocks::GetNearestHz(SysClkModule module, SysClkProfile profile, std::uint32_t inHz)
 {
     uint32_t *min = nullptr, *max = nullptr;
     if (GetRange(module, profile, &min, &max))
         ERROR_THROW("table lookup failed for SysClkModule: %u", module);
 
-    return *GetNearestHzPtr(min, max, inHz);
+    return *freqRange[module].FindFreq(inHz, profile);
 }
 
 std::int32_t Clocks::GetTsTemperatureMilli(TsLocation location)
@@ -449,4 +651,21 @@ std::uint32_t Clocks::GetTemperatureMilli(SysClkThermalSensor sensor)
     }
 
     return std::max(0, millis);
+}
+
+std::uint32_t Clocks::GetVoltageMv(SysClkModule module)
+{
+    if(!rgltrOpened[module])
+    {
+        return 0;
+    }
+
+    u32 microVolts = 0;
+    Result rc = rgltrGetVoltage(&rgltrSessions[module], &microVolts);
+    if(R_FAILED(rc))
+    {
+        return 0;
+    }
+
+    return microVolts / 1000;
 }
\ No newline at end of file
@@ -9,9 +9,13 @@
  */
 
 #pragma once
+#include <atomic>
 #include <cstdint>
+#include <unordered_map>
 #include <switch.h>
+#include <nxExt.h>
 #include <sysclk.h>
+#include "governor_core.h"
 
 #define MAX_MEM_CLOCK         1862'400'000
 #define MEM_CLOCK_MARIKO_MIN  1600'000'000
@@ -21,18 +25,34 @@
 class Clocks
 {
 public:
-    static inline uint32_t boostCpuFreq = 1785000000;
-    static inline uint32_t maxMemFreq = 0;
+    typedef enum {
+        ClockIpc_Get = 0,
+        ClockIpc_Set,
+        ClockIpc_Open,  // clkrst sessions opened, one per module at boot plus recoveries
+        ClockIpc_Close,
+        ClockIpc_EnumMax,
+    } ClockIpc;
+
+    typedef struct {
+        std::uint64_t calls[ClockIpc_EnumMax];
+    } IpcStats;
 
-    static inline uint32_t* GetNearestHzPtr(uint32_t* hzListStart, uint32_t* hzListEnd, uint32_t freq) {
-        uint32_t* p = hzListStart;
-        while (p < hzListEnd) {
-            if (freq <= *p)
-                return p;
-            p++;
+    // Clocks of several modules set together by Apply()
+    typedef struct ClockTransaction {
+        std::uint32_t targetHz[SysClkModule_EnumMax];  // 0: module left as is
+        std::uint32_t currentHz[SysClkModule_EnumMax]; // Known by the caller, 0 if unknown. Skipped if equal to target
+        std::uint32_t appliedHz[SysClkModule_EnumMax]; // Read back after all transitions if requested
+        std::uint32_t latencyUs[SysClkModule_EnumMax]; // SetHz time, 0 if skipped
+
+        void Set(SysClkModule module, std::uint32_t hz, std::uint32_t current = 0) {
+            targetHz[module] = hz;
+            currentHz[module] = current;
         }
-        return hzListEnd;
-    }
+        bool IsSet(SysClkModule module) const { return targetHz[module] && targetHz[module] != currentHz[module]; }
+    } ClockTransaction;
+
+    static inline uint32_t boostCpuFreq = 1785000000;
+    static inline uint32_t maxMemFreq = 0;
 
     static inline SysClkFrequencyTable freqTable[SysClkModule_EnumMax] = {
         {}, // CPU
@@ -46,7 +66,12 @@ public:
         },
     };
 
+    // Per-step voltage and cost for CPU/GPU governors, built from the loader DVFS tables
+    static inline GovernorCore::EnergyModel energyModel[SysClkModule_EnumMax];
+
     typedef struct FreqRange {
+        uint32_t* table;
+        GovernorCore::FreqIndex index; // Whole table, rebuilt by UpdateFreqRange
         uint32_t* first;
         uint32_t* last;
         uint32_t* min;
@@ -54,7 +79,8 @@ public:
 
         void InitDefault(SysClkModule module) {
             SysClkFrequencyTable* table_head = &freqTable[module];
-            uint32_t* p = this->first = this->min = &table_head->freq[0];
+            uint32_t* p = this->table = this->first = this->min = &table_head->freq[0];
+            this->index.Build(this->table);
 
             // Get pointer to last value
             for (int i = 0; i < FREQ_TABLE_MAX_ENTRY_COUNT; i++) {
@@ -71,7 +97,7 @@ public:
         };
 
         uint32_t* FindFreq(uint32_t freq, SysClkProfile profile = SysClkProfile_Docked) {
-            return GetNearestHzPtr(this->min, this->max[profile], freq);
+            return this->table + this->index.NearestIdx(this->min - this->table, this->max[profile] - this->table, freq);
         };
     } FreqRange;
 
@@ -90,11 +116,17 @@ public:
     static SysClkProfile GetCurrentProfile();
     static std::uint32_t GetCurrentHz(SysClkModule module);
     static void SetHz(SysClkModule module, std::uint32_t hz);
+    // Transitions are issued back to back, returns how many
+    static unsigned int Apply(ClockTransaction* transaction, bool readBack);
     static const char* GetProfileName(SysClkProfile profile, bool pretty);
     static const char* GetModuleName(SysClkModule module, bool pretty);
     static const char* GetThermalSensorName(SysClkThermalSensor sensor, bool pretty);
     static std::uint32_t GetNearestHz(SysClkModule module, SysClkProfile profile, std::uint32_t inHz);
     static std::uint32_t GetTemperatureMilli(SysClkThermalSensor sensor);
+    // CPU/GPU rail voltage, 0 if unknown (HOS < 8.0.0 or no regulator session)
+    static std::uint32_t GetVoltageMv(SysClkModule module);
+    // clkrst/pcv calls since last reset
+    static IpcStats GetIpcStats(bool reset);
 
 protected:
     static inline bool allowUnsafe;
@@ -103,4 +135,26 @@ protected:
     static PcvModule GetPcvModule(SysClkModule sysclkModule);
     static PcvModuleId GetPcvModuleId(SysClkModule sysclkModule);
     static std::uint32_t GetMaxAllowedHz(SysClkModule module, SysClkProfile profile);
+    static SysClkApmConfiguration* GetUnknownApmConfig(uint32_t confId);
+
+    // HOS 8.0.0+: one clkrst session per module, kept open. Calls hold the module lock shared,
+    // a failed call (e.g. after sleep) reopens the session with it held exclusively, once
+    // every call in flight on the old session has returned.
+    static void OpenClkrstSession(SysClkModule module, ClkrstSession* session);
+    static Result ClkrstCall(SysClkModule module, Result (*call)(ClkrstSession* session, void* arg), void* arg);
+    static void CountIpc(ClockIpc ipc) { ipcCalls[ipc].fetch_add(1, std::memory_order_relaxed); };
+
+    static inline ClkrstSession clkrstSessions[SysClkModule_EnumMax];
+    static inline std::uint32_t clkrstGeneration[SysClkModule_EnumMax]; // Reopen count, under clkrstLocks
+    static inline LockableRwLock clkrstLocks[SysClkModule_EnumMax];
+    static inline std::atomic<std::uint64_t> ipcCalls[ClockIpc_EnumMax];
+    // HOS 8.0.0+: rail of CPU and GPU, read by the energy model of the governors
+    static inline RgltrSession rgltrSessions[SysClkModule_EnumMax];
+    static inline bool rgltrOpened[SysClkModule_EnumMax];
+    static inline bool rgltrReady;
+    // Configurations not in sysclk_g_apm_configurations (newer firmwares), stock clocks queried once
+    static inline LockableMutex apmOverflowMutex;
+    static inline std::unordered_map<std::uint32_t, SysClkApmConfiguration> apmOverflow;
+    // Last clock set or read, only orders transitions: others (apm, sleep) may change clocks behind our back
+    static inline std::atomic<std::uint32_t> lastKnownHz[SysClkModule_EnumMax];
 };
@@ -19,30 +19,25 @@
 #include "clocks.h"
 #include "file_utils.h"
 
-Config::Config(std::string path)
+Config::Config(std::string path) : store({ .log = &FileUtils::LogLine, .memMhz = &Config::MemMhzFromIni })
 {
     this->path = path;
     this->loaded = false;
-    this->profileMhzMap = std::map<std::tuple<std::uint64_t, SysClkProfile, SysClkModule>, std::uint32_t>();
-    this->profileCountMap = std::map<std::uint64_t, std::uint8_t>();
-    this->profileGovernorMap = std::map<std::uint64_t, SysClkOcGovernorConfig>();
+    this->saveFailed = false;
+    this->lastChangeNs = 0;
     this->mtime = 0;
     this->enabled = false;
+    this->pendingChanges = false;
     for(unsigned int i = 0; i < SysClkModule_EnumMax; i++)
     {
         this->overrideFreqs[i] = 0;
     }
-
-    for(unsigned int i = 0; i < SysClkConfigValue_EnumMax; i++)
-    {
-        this->configValues[i] = sysclkDefaultConfigValue((SysClkConfigValue)i);
-    }
 }
 
 Config::~Config()
 {
     std::scoped_lock lock{this->configMutex};
-    this->Close();
+    this->Save();
 }
 
 Config *Config::CreateDefault()
@@ -53,49 +48,83 @@ Config *Config::CreateDefault()
     return new Config(FILE_CONFIG_DIR "/config.ini");
 }
 
-void Config::Load()
+bool Config::Reload()
 {
     FileUtils::LogLine("[cfg] Reading %s", this->path.c_str());
 
-    this->Close();
-    this->mtime = this->CheckModificationTime();
-    if(!this->mtime)
+    ConfigStore fresh({ .log = &FileUtils::LogLine, .memMhz = &Config::MemMhzFromIni });
+    if (!fresh.Load(this->path))
     {
         FileUtils::LogLine("[cfg] Error finding file");
     }
-    else if (!ini_browse(&BrowseIniFunc, this, this->path.c_str()))
-    {
-        FileUtils::LogLine("[cfg] Error loading file");
-    }
+    this->mtime = this->CheckModificationTime();
+    // Changes whose save failed stay on top of the file until a retry succeeds
+    fresh.KeepUnsaved(this->store);
 
     // Erista: Disable Mariko only features
     // if (!Clocks::GetIsMariko()) { }
 
+    ConfigStoreDiff diff = fresh.Diff(this->store);
+    this->store = std::move(fresh);
+
+    FileUtils::LogLine("[cfg] %zu titles: %zu added, %zu removed, %zu changed%s%s", this->store.TitleCount(),
+        diff.added, diff.removed, diff.changed, diff.values ? ", values changed" : "", diff.tuning ? ", tuning changed" : "");
+
+    bool wasLoaded = this->loaded;
     this->loaded = true;
+    return !wasLoaded || diff.Any();
 }
 
-void Config::Close()
+bool Config::Save()
 {
-    this->loaded = false;
-    this->profileMhzMap.clear();
-    this->profileCountMap.clear();
-    this->profileGovernorMap.clear();
+    if (!this->store.IsDirty())
+    {
+        return true;
+    }
 
-    for(unsigned int i = 0; i < SysClkConfigValue_EnumMax; i++)
+    this->saveFailed = !this->store.Save(this->path);
+    if (this->saveFailed)
     {
-        this->configValues[i] = sysclkDefaultConfigValue((SysClkConfigValue)i);
+        // Keep changes in memory and retry after another delay
+        FileUtils::LogLine("[cfg] Error saving %s", this->path.c_str());
+        this->lastChangeNs = armTicksToNs(armGetSystemTick());
+        return false;
     }
+
+    // Our own write is not an external change
+    this->mtime = this->CheckModificationTime();
+    return true;
+}
+
+void Config::MarkChanged()
+{
+    this->lastChangeNs = armTicksToNs(armGetSystemTick());
+    this->pendingChanges = true;
 }
 
 bool Config::Refresh()
 {
     std::scoped_lock lock{this->configMutex};
-    if (!this->loaded || this->mtime != this->CheckModificationTime())
+    bool pending = this->pendingChanges.exchange(false);
+    bool modified = !this->loaded || this->mtime != this->CheckModificationTime();
+
+    // Changes made through IPC are merged into the edited file before reading it back.
+    // External edits are still read if that fails, Reload() keeps the unsaved changes.
+    if (this->store.IsDirty() && (modified || (armTicksToNs(armGetSystemTick()) - this->lastChangeNs) >= CONFIG_SAVE_DELAY_NS))
     {
-        this->Load();
-        return true;
+        this->Save();
     }
-    return false;
+
+    if (modified)
+    {
+        return this->Reload() || pending;
+    }
+    return pending;
+}
+
+bool Config::HasPendingChanges()
+{
+    return this->pendingChanges;
 }
 
 bool Config::HasProfilesLoaded()
@@ -116,14 +145,33 @@ time_t Config::CheckModificationTime()
     return mtime;
 }
 
+std::uint32_t Config::MemMhzFromIni(std::uint32_t mhz)
+{
+    // Mem freq > 1600'000'000 will be regarded as Clocks::maxMemFreq for consistency, unless it is an OC ladder step
+    if (mhz <= 1600)
+    {
+        return mhz;
+    }
+
+    for (uint32_t* p = Clocks::freqTable[SysClkModule_MEM].freq; *p; p++)
+    {
+        if (*p / 1000'000 == mhz)
+        {
+            return mhz;
+        }
+    }
+
+    return Clocks::maxMemFreq / 1000'000;
+}
+
 std::uint32_t Config::FindClockMhz(std::uint64_t tid, SysClkModule module, SysClkProfile profile)
 {
     if (this->loaded)
     {
-        std::map<std::tuple<std::uint64_t, SysClkProfile, SysClkModule>, std::uint32_t>::const_iterator it = this->profileMhzMap.find(std::make_tuple(tid, profile, module));
-        if (it != this->profileMhzMap.end())
+        const ConfigTitle* title = this->store.FindTitle(tid);
+        if (title)
         {
-            return it->second;
+            return title->mhz[profile][module];
         }
     }
 
@@ -173,242 +221,71 @@ std::uint32_t Config::GetAutoClockHz(std::uint64_t tid, SysClkModule module, Sys
 
 SysClkOcGovernorConfig Config::GetTitleGovernorConfig(std::uint64_t tid)
 {
+    std::scoped_lock lock{this->configMutex};
     if (this->loaded)
     {
-        std::map<uint64_t, SysClkOcGovernorConfig>::const_iterator it = this->profileGovernorMap.find(tid);
-        if (it != this->profileGovernorMap.end())
+        const ConfigTitle* title = this->store.FindTitle(tid);
+        if (title)
         {
-            return it->second;
+            return (SysClkOcGovernorConfig)title->governorConfig;
         }
     }
 
     return SysClkOcGovernorConfig_Default;
 }
 
-void Config::GetProfiles(std::uint64_t tid, SysClkTitleProfileList* out_profiles)
+GovernorCore::Tuning Config::GetTitleGovernorTuning(std::uint64_t tid)
 {
     std::scoped_lock lock{this->configMutex};
+    GovernorCore::Tuning tuning = {};
 
-    for(unsigned int profile = 0; profile < SysClkProfile_EnumMax; profile++)
+    if (this->loaded)
     {
-        for(unsigned int module = 0; module < SysClkModule_EnumMax; module++)
+        for (std::uint64_t id : {(std::uint64_t)0, tid})
         {
-            out_profiles->mhzMap[profile][module] = FindClockMhz(tid, (SysClkModule)module, (SysClkProfile)profile);
+            const GovernorCore::Tuning* found = this->store.FindTuning(id);
+            if (found)
+            {
+                tuning.Merge(*found);
+            }
         }
     }
 
-    std::map<uint64_t, SysClkOcGovernorConfig>::const_iterator it = this->profileGovernorMap.find(tid);
-    SysClkOcGovernorConfig governor = SysClkOcGovernorConfig_Default;
-    // Found
-    if (it != this->profileGovernorMap.end())
-        governor = it->second;
-    out_profiles->governorConfig = governor;
+    return tuning;
 }
 
-bool Config::SetProfiles(std::uint64_t tid, SysClkTitleProfileList* profiles, bool immediate)
+void Config::GetProfiles(std::uint64_t tid, SysClkTitleProfileList* out_profiles)
 {
     std::scoped_lock lock{this->configMutex};
-    uint8_t numProfiles = 0;
-
-    // String pointer array passed to ini
-    char* iniKeys[static_cast<int>(SysClkProfile_EnumMax) * static_cast<int>(SysClkModule_EnumMax) + 1 + 1];
-    char* iniValues[static_cast<int>(SysClkProfile_EnumMax) * static_cast<int>(SysClkModule_EnumMax) + 1 + 1];
-
-    // Char arrays to build strings
-    char keysStr[static_cast<int>(SysClkProfile_EnumMax) * static_cast<int>(SysClkModule_EnumMax) * 0x40];
-    char valuesStr[static_cast<int>(SysClkProfile_EnumMax) * static_cast<int>(SysClkModule_EnumMax) * 0x10];
-    char section[17] = {0};
-
-    // Iteration pointers
-    char** ik = &iniKeys[0];
-    char** iv = &iniValues[0];
-    char* sk = &keysStr[0];
-    char* sv = &valuesStr[0];
-    std::uint32_t* mhz = &profiles->mhz[0];
-
-    snprintf(section, sizeof(section), "%016lX", tid);
 
     for(unsigned int profile = 0; profile < SysClkProfile_EnumMax; profile++)
     {
         for(unsigned int module = 0; module < SysClkModule_EnumMax; module++)
         {
-            if(*mhz)
-            {
-                numProfiles++;
-
-                // Put key and value as string
-                snprintf(sk, 0x40, "%s_%s", Clocks::GetProfileName((SysClkProfile)profile, false), Clocks::GetModuleName((SysClkModule)module, false));
-                snprintf(sv, 0x10, "%d", *mhz);
-
-                // Add them to the ini key/value str arrays
-                *ik = sk;
-                *iv = sv;
-                ik++;
-                iv++;
-
-                // We used those chars, get to the next ones
-                sk += 0x40;
-                sv += 0x10;
-            }
-
-            mhz++;
-        }
-    }
-
-    if (profiles->governorConfig != SysClkOcGovernorConfig_Default) {
-        snprintf(sk, 0x40, "%s", CONFIG_KEY_TITLE_GOVERNOR_CONFIG);
-        snprintf(sv, 0x10, "%d", profiles->governorConfig);
-        *ik++ = sk;
-        *iv++ = sv;
-    }
-
-    *ik = NULL;
-    *iv = NULL;
-
-    if(!ini_putsection(section, (const char**)iniKeys, (const char**)iniValues, this->path.c_str()))
-    {
-        return false;
-    }
-
-    // Only actually apply changes in memory after a succesful save
-    if(immediate)
-    {
-        mhz = &profiles->mhz[0];
-        this->profileCountMap[tid] = numProfiles;
-        for(unsigned int profile = 0; profile < SysClkProfile_EnumMax; profile++)
-        {
-            for(unsigned int module = 0; module < SysClkModule_EnumMax; module++)
-            {
-                if(*mhz)
-                {
-                    this->profileMhzMap[std::make_tuple(tid, (SysClkProfile)profile, (SysClkModule)module)] = *mhz;
-                }
-                else
-                {
-                    this->profileMhzMap.erase(std::make_tuple(tid, (SysClkProfile)profile, (SysClkModule)module));
-                }
-                mhz++;
-            }
+            out_profiles->mhzMap[profile][module] = FindClockMhz(tid, (SysClkModule)module, (SysClkProfile)profile);
         }
-
-        if (profiles->governorConfig == SysClkOcGovernorConfig_Default)
-            this->profileGovernorMap.erase(tid);
-        else
-            this->profileGovernorMap[tid] = profiles->governorConfig;
     }
 
-    return true;
+    const ConfigTitle* title = this->store.FindTitle(tid);
+    out_profiles->governorConfig = title ? (SysClkOcGovernorConfig)title->governorConfig : SysClkOcGovernorConfig_Default;
 }
 
-std::uint8_t Config::GetProfileCount(std::uint64_t tid)
+bool Config::SetProfiles(std::uint64_t tid, SysClkTitleProfileList* profiles)
 {
-    std::map<std::uint64_t, std::uint8_t>::iterator it = this->profileCountMap.find(tid);
-    if (it == this->profileCountMap.end())
-    {
-        return 0;
-    }
+    std::scoped_lock lock{this->configMutex};
+
+    // Applied in memory right away, written to the file by Refresh() once changes settle
+    this->store.SetTitle(tid, profiles);
+    this->MarkChanged();
 
-    return it->second;
+    return !this->saveFailed;
 }
 
-int Config::BrowseIniFunc(const char* section, const char* key, const char* value, void *userdata)
+std::uint8_t Config::GetProfileCount(std::uint64_t tid)
 {
-    Config* config = (Config*)userdata;
-    std::uint64_t input;
-    if(!strcmp(section, CONFIG_VAL_SECTION))
-    {
-        for(unsigned int kval = 0; kval < SysClkConfigValue_EnumMax; kval++)
-        {
-            if(!strcmp(key, sysclkFormatConfigValue((SysClkConfigValue)kval, false)))
-            {
-                input = strtoul(value, NULL, 0);
-                if(!sysclkValidConfigValue((SysClkConfigValue)kval, input))
-                {
-                    input = sysclkDefaultConfigValue((SysClkConfigValue)kval);
-                    FileUtils::LogLine("[cfg] Invalid value for key '%s' in section '%s': using default %d", key, section, input);
-                }
-                config->configValues[kval] = input;
-                return 1;
-            }
-        }
-
-        FileUtils::LogLine("[cfg] Skipping key '%s' in section '%s': Unrecognized config value", key, section);
-        return 1;
-    }
-
-    std::uint64_t tid = strtoul(section, NULL, 16);
-
-    if(!tid || strlen(section) != 16)
-    {
-        FileUtils::LogLine("[cfg] Skipping key '%s' in section '%s': Invalid TitleID", key, section);
-        return 1;
-    }
-
-    if (!strcmp(key, CONFIG_KEY_TITLE_GOVERNOR_CONFIG)) {
-        input = strtoul(value, NULL, 0);
-        if ((input & SysClkOcGovernorConfig_Mask) != input) {
-            input = SysClkOcGovernorConfig_Default;
-            FileUtils::LogLine("[cfg] Invalid value for key '%s' in section '%s': using default %d", key, section, input);
-        }
-        config->profileGovernorMap[tid] = (SysClkOcGovernorConfig)input;
-        return 1;
-    }
-
-    SysClkProfile parsedProfile = SysClkProfile_EnumMax;
-    SysClkModule parsedModule = SysClkModule_EnumMax;
-
-    for(unsigned int profile = 0; profile < SysClkProfile_EnumMax; profile++)
-    {
-        const char* profileCode = Clocks::GetProfileName((SysClkProfile)profile, false);
-        size_t profileCodeLen = strlen(profileCode);
-
-        if(!strncmp(key, profileCode, profileCodeLen) && key[profileCodeLen] == '_')
-        {
-            const char* subkey = key + profileCodeLen + 1;
-
-            for(unsigned int module = 0; module < SysClkModule_EnumMax; module++)
-            {
-                const char* moduleCode = Clocks::GetModuleName((SysClkModule)module, false);
-                size_t moduleCodeLen = strlen(moduleCode);
-                if(!strncmp(subkey, moduleCode, moduleCodeLen) && subkey[moduleCodeLen] == '\0')
-                {
-                    parsedProfile = (SysClkProfile)profile;
-                    parsedModule = (SysClkModule)module;
-                }
-            }
-        }
-    }
-
-    if(parsedModule == SysClkModule_EnumMax || parsedProfile == SysClkProfile_EnumMax)
-    {
-        FileUtils::LogLine("[cfg] Skipping key '%s' in section '%s': Unrecognized key", key, section);
-        return 1;
-    }
-
-    std::uint32_t mhz = strtoul(value, NULL, 10);
-    if(!mhz)
-    {
-        FileUtils::LogLine("[cfg] Skipping key '%s' in section '%s': Invalid value", key, section);
-        return 1;
-    }
-
-    // Mem freq > 1600'000'000 will be regarded as Clocks::maxMemFreq for consistency
-    if (parsedModule == SysClkModule_MEM && mhz > 1600) {
-        mhz = Clocks::maxMemFreq / 1000'000;
-    }
-
-    config->profileMhzMap[std::make_tuple(tid, parsedProfile, parsedModule)] = mhz;
-    std::map<std::uint64_t, std::uint8_t>::iterator it = config->profileCountMap.find(tid);
-    if (it == config->profileCountMap.end())
-    {
-        config->profileCountMap[tid] = 1;
-    }
-    else
-    {
-        it->second++;
-    }
-
-    return 1;
+    std::scoped_lock lock{this->configMutex};
+    const ConfigTitle* title = this->store.FindTitle(tid);
+    return title ? title->count : 0;
 }
 
 void Config::SetEnabled(bool enabled)
@@ -450,7 +327,7 @@ std::uint64_t Config::GetConfigValue(SysClkConfigValue kval)
         ERROR_THROW("Unhandled SysClkConfigValue: %u", kval);
     }
 
-    return this->configValues[kval];
+    return this->store.GetValue(kval);
 }
 
 const char* Config::GetConfigValueName(SysClkConfigValue kval, bool pretty)
@@ -471,68 +348,16 @@ void Config::GetConfigValues(SysClkConfigValueList* out_configValues)
 
     for(unsigned int kval = 0; kval < SysClkConfigValue_EnumMax; kval++)
     {
-        out_configValues->values[kval] = this->configValues[kval];
+        out_configValues->values[kval] = this->store.GetValue((SysClkConfigValue)kval);
     }
 }
 
-bool Config::SetConfigValues(SysClkConfigValueList* configValues, bool immediate)
+bool Config::SetConfigValues(SysClkConfigValueList* configValues)
 {
     std::scoped_lock lock{this->configMutex};
 
-    // String pointer array passed to ini
-    const char* iniKeys[SysClkConfigValue_EnumMax + 1];
-    char* iniValues[SysClkConfigValue_EnumMax + 1];
-
-    // char arrays to build strings
-    char valuesStr[SysClkConfigValue_EnumMax * 0x20];
-
-    // Iteration pointers
-    char* sv = &valuesStr[0];
-    const char** ik = &iniKeys[0];
-    char** iv = &iniValues[0];
-
-    for(unsigned int kval = 0; kval < SysClkConfigValue_EnumMax; kval++)
-    {
-        if(!sysclkValidConfigValue((SysClkConfigValue)kval, configValues->values[kval]) || configValues->values[kval] == sysclkDefaultConfigValue((SysClkConfigValue)kval))
-        {
-            continue;
-        }
-
-        // Put key and value as string
-        // And add them to the ini key/value str arrays
-        snprintf(sv, 0x20, "%ld", configValues->values[kval]);
-        *ik = sysclkFormatConfigValue((SysClkConfigValue)kval, false);
-        *iv = sv;
-
-        // We used those chars, get to the next ones
-        sv += 0x20;
-        ik++;
-        iv++;
-    }
-
-    *ik = NULL;
-    *iv = NULL;
-
-    if(!ini_putsection(CONFIG_VAL_SECTION, (const char**)iniKeys, (const char**)iniValues, this->path.c_str()))
-    {
-        return false;
-    }
-
-    // Only actually apply changes in memory after a succesful save
-    if(immediate)
-    {
-        for(unsigned int kval = 0; kval < SysClkConfigValue_EnumMax; kval++)
-        {
-            if(sysclkValidConfigValue((SysClkConfigValue)kval, configValues->values[kval]))
-            {
-                this->configValues[kval] = configValues->values[kval];
-            }
-            else
-            {
-                this->configValues[kval] = sysclkDefaultConfigValue((SysClkConfigValue)kval);
-            }
-        }
-    }
+    this->store.SetValues(configValues);
+    this->MarkChanged();
 
-    return true;
+    return !this->saveFailed;
 }
@@ -11,17 +11,15 @@
 #pragma once
 #include <atomic>
 #include <ctime>
-#include <map>
 #include <mutex>
 #include <initializer_list>
 #include <switch.h>
-#include <minIni.h>
 #include <nxExt.h>
 #include "clocks.h"
+#include "config_store.h"
 
-#define CONFIG_VAL_SECTION "values"
-
-#define CONFIG_KEY_TITLE_GOVERNOR_CONFIG "governor_config"
+// Unsaved changes are written once no other change came for this long
+#define CONFIG_SAVE_DELAY_NS 2000000000ULL
 
 class Config
 {
@@ -32,14 +30,16 @@ class Config
     static Config *CreateDefault();
 
     bool Refresh();
+    bool HasPendingChanges();
 
     bool HasProfilesLoaded();
 
     std::uint8_t GetProfileCount(std::uint64_t tid);
     void GetProfiles(std::uint64_t tid, SysClkTitleProfileList* out_profiles);
-    bool SetProfiles(std::uint64_t tid, SysClkTitleProfileList* profiles, bool immediate);
+    bool SetProfiles(std::uint64_t tid, SysClkTitleProfileList* profiles);
     std::uint32_t GetAutoClockHz(std::uint64_t tid, SysClkModule module, SysClkProfile profile);
     SysClkOcGovernorConfig GetTitleGovernorConfig(std::uint64_t tid);
+    GovernorCore::Tuning GetTitleGovernorTuning(std::uint64_t tid);
 
     void SetEnabled(bool enabled);
     bool Enabled();
@@ -49,25 +49,26 @@ class Config
     std::uint64_t GetConfigValue(SysClkConfigValue val);
     const char* GetConfigValueName(SysClkConfigValue val, bool pretty);
     void GetConfigValues(SysClkConfigValueList* out_configValues);
-    bool SetConfigValues(SysClkConfigValueList* configValues, bool immediate);
+    bool SetConfigValues(SysClkConfigValueList* configValues);
   protected:
-    void Load();
-    void Close();
+    bool Reload();
+    bool Save();
+    void MarkChanged();
 
     time_t CheckModificationTime();
     std::uint32_t FindClockMhz(std::uint64_t tid, SysClkModule module, SysClkProfile profile);
     std::uint32_t FindClockHzFromProfiles(std::uint64_t tid, SysClkModule module, std::initializer_list<SysClkProfile> profiles);
-    static int BrowseIniFunc(const char* section, const char* key, const char* value, void *userdata);
+    static std::uint32_t MemMhzFromIni(std::uint32_t mhz);
 
-    std::map<std::tuple<std::uint64_t, SysClkProfile, SysClkModule>, std::uint32_t> profileMhzMap;
-    std::map<std::uint64_t, std::uint8_t> profileCountMap;
-    std::map<std::uint64_t, SysClkOcGovernorConfig> profileGovernorMap;
+    ConfigStore store;
     bool loaded;
+    bool saveFailed;
+    std::uint64_t lastChangeNs;
     std::string path;
     time_t mtime;
     LockableMutex configMutex;
     LockableMutex overrideMutex;
     std::atomic_bool enabled;
+    std::atomic_bool pendingChanges; // Written through IPC, not yet picked up by Refresh()
     std::uint32_t overrideFreqs[SysClkModule_EnumMax];
-    std::uint64_t configValues[SysClkConfigValue_EnumMax];
 };
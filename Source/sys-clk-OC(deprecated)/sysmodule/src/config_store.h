@@ -0,0 +1,561 @@
+/*
+ * --------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <p-sam@d3vs.net>, <natinusala@gmail.com>, <m4x@m4xw.net>
+ * wrote this file. As long as you retain this notice you can do whatever you
+ * want with this stuff. If you meet any of us some day, and you think this
+ * stuff is worth it, you can buy us a beer in return.  - The sys-clk authors
+ * --------------------------------------------------------------------------
+ */
+
+#pragma once
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <sysclk/clocks.h>
+#include <sysclk/config.h>
+#include "governor_core.h"
+
+// Parsed config.ini kept in memory, platform independent, shared with the host benchmark (sysmodule/sim).
+// Changes are tracked per section and written back in one pass by Save(), which copies the file to
+// a temporary one, replacing only the dirty sections, then renames it over the original.
+
+#define CONFIG_VAL_SECTION "values"
+
+#define CONFIG_KEY_TITLE_GOVERNOR_CONFIG "governor_config"
+
+// Governor tuning, global in [governor] section or per title in its own section
+#define CONFIG_GOVERNOR_SECTION "governor"
+#define CONFIG_KEY_GOVERNOR_SAMPLE_RATE "governor_sample_rate"
+#define CONFIG_KEY_GOVERNOR_HEADROOM "governor_headroom"
+#define CONFIG_KEY_GOVERNOR_HALF_LIFE_FMT "governor_%s_half_life_ms"
+#define CONFIG_KEY_GOVERNOR_MIN_FMT "governor_%s_min"
+#define CONFIG_KEY_GOVERNOR_MAX_FMT "governor_%s_max"
+
+#define CONFIG_STORE_TMP_SUFFIX ".tmp"
+#define CONFIG_STORE_LINE_MAX 512
+
+// Per title profiles, packed: 0 MHz when not set
+typedef struct ConfigTitle {
+    std::uint16_t mhz[SysClkProfile_EnumMax][SysClkModule_EnumMax];
+    std::uint8_t governorConfig; // SysClkOcGovernorConfig, Default when not set
+    std::uint8_t count;          // Non zero entries in mhz
+
+    bool operator==(const ConfigTitle& other) const { return !memcmp(this, &other, sizeof(*this)); }
+} ConfigTitle;
+
+typedef struct {
+    size_t added;
+    size_t removed;
+    size_t changed;
+    bool values;
+    bool tuning;
+
+    bool Any() const { return added || removed || changed || values || tuning; }
+} ConfigStoreDiff;
+
+class ConfigStore
+{
+  public:
+    typedef struct {
+        void (*log)(const char* format, ...);
+        // Maps a MEM profile value read from the file to a supported one
+        std::uint32_t (*memMhz)(std::uint32_t mhz);
+    } Hooks;
+
+    ConfigStore(Hooks hooks = {}) : hooks(hooks)
+    {
+        this->Reset();
+    }
+
+    void Reset()
+    {
+        this->titles.clear();
+        this->tunings.clear();
+        this->dirtyTitles.clear();
+        this->dirtyValues = false;
+        for (unsigned int kval = 0; kval < SysClkConfigValue_EnumMax; kval++)
+        {
+            this->values[kval] = sysclkDefaultConfigValue((SysClkConfigValue)kval);
+        }
+    }
+
+    // Replaces the whole content, false if the file cannot be read
+    bool Load(const std::string& path)
+    {
+        this->Reset();
+
+        FILE* fp = fopen(path.c_str(), "rb");
+        if (!fp)
+        {
+            // Interrupted Save(): the original is gone, the temporary file is complete
+            std::string tmp = path + CONFIG_STORE_TMP_SUFFIX;
+            if (rename(tmp.c_str(), path.c_str()) || !(fp = fopen(path.c_str(), "rb")))
+                return false;
+        }
+
+        this->titles.reserve(64);
+        char line[CONFIG_STORE_LINE_MAX];
+        char section[CONFIG_STORE_LINE_MAX] = "";
+        while (fgets(line, sizeof(line), fp))
+        {
+            char* p = Trim(line);
+            if (!*p || *p == ';' || *p == '#')
+                continue;
+
+            if (*p == '[')
+            {
+                char* end = strrchr(p, ']');
+                if (end)
+                {
+                    *end = '\0';
+                    strcpy(section, Trim(p + 1));
+                }
+                continue;
+            }
+
+            char* sep = strchr(p, '=');
+            if (!sep)
+                sep = strchr(p, ':');
+            if (!sep)
+                continue;
+            *sep = '\0';
+            this->ParseKey(section, Trim(p), ParseValue(sep + 1));
+        }
+
+        fclose(fp);
+        return true;
+    }
+
+    // Writes dirty sections back, other sections and comments are copied as is
+    bool Save(const std::string& path)
+    {
+        if (!this->IsDirty())
+            return true;
+
+        std::string tmp = path + CONFIG_STORE_TMP_SUFFIX;
+        FILE* wfp = fopen(tmp.c_str(), "wb");
+        if (!wfp)
+            return false;
+
+        std::unordered_set<std::uint64_t> written;
+        bool valuesWritten = false;
+        bool skipping = false;
+        bool ok = true;
+
+        if (FILE* rfp = fopen(path.c_str(), "rb"))
+        {
+            char line[CONFIG_STORE_LINE_MAX];
+            while (ok && fgets(line, sizeof(line), rfp))
+            {
+                char* p = Trim(line, false);
+                char* end = *p == '[' ? strrchr(p, ']') : nullptr;
+                if (end)
+                {
+                    std::string section(p + 1, end - p - 1);
+                    std::uint64_t tid = ParseTitleSection(section.c_str());
+                    if (section == CONFIG_VAL_SECTION && this->dirtyValues)
+                    {
+                        skipping = true;
+                        if (!valuesWritten)
+                            ok = this->WriteValues(wfp);
+                        valuesWritten = true;
+                        continue;
+                    }
+                    if (tid && this->dirtyTitles.count(tid))
+                    {
+                        skipping = true;
+                        if (written.insert(tid).second)
+                            ok = this->WriteTitle(wfp, tid);
+                        continue;
+                    }
+                    skipping = false;
+                }
+
+                if (!skipping)
+                    ok = fputs(line, wfp) >= 0;
+            }
+            fclose(rfp);
+        }
+
+        if (ok && this->dirtyValues && !valuesWritten)
+            ok = this->WriteValues(wfp);
+        for (std::uint64_t tid : this->dirtyTitles)
+        {
+            if (ok && !written.count(tid))
+                ok = this->WriteTitle(wfp, tid);
+        }
+
+        ok = !fclose(wfp) && ok;
+        if (!ok)
+        {
+            remove(tmp.c_str());
+            return false;
+        }
+
+        // Horizon fs cannot rename over an existing file, Load() recovers the temporary one if interrupted here
+        remove(path.c_str());
+        if (rename(tmp.c_str(), path.c_str()))
+            return false;
+
+        this->dirtyTitles.clear();
+        this->dirtyValues = false;
+        return true;
+    }
+
+    // What changed from prev to this
+    ConfigStoreDiff Diff(const ConfigStore& prev) const
+    {
+        ConfigStoreDiff diff = {};
+        for (const auto& [tid, title] : this->titles)
+        {
+            auto it = prev.titles.find(tid);
+            if (it == prev.titles.end())
+                diff.added++;
+            else if (!(it->second == title))
+                diff.changed++;
+        }
+        diff.removed = prev.titles.size() + diff.added - this->titles.size();
+        diff.values = memcmp(this->values, prev.values, sizeof(this->values));
+        diff.tuning = this->tunings.size() != prev.tunings.size();
+        for (const auto& [tid, tuning] : this->tunings)
+        {
+            auto it = prev.tunings.find(tid);
+            if (it == prev.tunings.end() || it->second != tuning)
+                diff.tuning = true;
+        }
+        return diff;
+    }
+
+    // Re-applies the changes prev could not save yet on top of a fresh Load(), still dirty
+    void KeepUnsaved(const ConfigStore& prev)
+    {
+        if (prev.dirtyValues)
+        {
+            memcpy(this->values, prev.values, sizeof(this->values));
+            this->dirtyValues = true;
+        }
+        for (std::uint64_t tid : prev.dirtyTitles)
+        {
+            auto it = prev.titles.find(tid);
+            if (it != prev.titles.end())
+                this->titles[tid] = it->second;
+            else
+                this->titles.erase(tid);
+            this->dirtyTitles.insert(tid);
+        }
+    }
+
+    bool IsDirty() const { return this->dirtyValues || !this->dirtyTitles.empty(); }
+    size_t TitleCount() const { return this->titles.size(); }
+
+    const ConfigTitle* FindTitle(std::uint64_t tid) const
+    {
+        auto it = this->titles.find(tid);
+        return it != this->titles.end() ? &it->second : nullptr;
+    }
+
+    // tid 0: [governor] section
+    const GovernorCore::Tuning* FindTuning(std::uint64_t tid) const
+    {
+        auto it = this->tunings.find(tid);
+        return it != this->tunings.end() ? &it->second : nullptr;
+    }
+
+    void SetTitle(std::uint64_t tid, const SysClkTitleProfileList* profiles)
+    {
+        ConfigTitle title = {};
+        for (unsigned int profile = 0; profile < SysClkProfile_EnumMax; profile++)
+        {
+            for (unsigned int module = 0; module < SysClkModule_EnumMax; module++)
+            {
+                std::uint32_t mhz = profiles->mhzMap[profile][module];
+                title.mhz[profile][module] = mhz <= UINT16_MAX ? mhz : 0;
+                title.count += title.mhz[profile][module] ? 1 : 0;
+            }
+        }
+        title.governorConfig = profiles->governorConfig & SysClkOcGovernorConfig_Mask;
+
+        if (!title.count && title.governorConfig == SysClkOcGovernorConfig_Default)
+            this->titles.erase(tid);
+        else
+            this->titles[tid] = title;
+        this->dirtyTitles.insert(tid);
+    }
+
+    std::uint64_t GetValue(SysClkConfigValue kval) const { return this->values[kval]; }
+
+    // Invalid values are reset to default
+    void SetValues(const SysClkConfigValueList* configValues)
+    {
+        for (unsigned int kval = 0; kval < SysClkConfigValue_EnumMax; kval++)
+        {
+            std::uint64_t input = configValues->values[kval];
+            this->values[kval] = sysclkValidConfigValue((SysClkConfigValue)kval, input) ? input : sysclkDefaultConfigValue((SysClkConfigValue)kval);
+        }
+        this->dirtyValues = true;
+    }
+
+    // Calls fn(key, field, max) for every governor tuning key
+    template <typename F>
+    static void ForEachGovernorTuningKey(GovernorCore::Tuning* tuning, F fn)
+    {
+        using GovernorCore::Tuning;
+        char key[0x40];
+
+        fn(CONFIG_KEY_GOVERNOR_SAMPLE_RATE, &tuning->sample_rate, Tuning::SAMPLE_RATE_MAX);
+        fn(CONFIG_KEY_GOVERNOR_HEADROOM, &tuning->headroom, Tuning::HEADROOM_MAX);
+        for (unsigned int module = 0; module < SysClkModule_EnumMax; module++)
+        {
+            const char* name = sysclkFormatModule((SysClkModule)module, false);
+            snprintf(key, sizeof(key), CONFIG_KEY_GOVERNOR_HALF_LIFE_FMT, name);
+            fn(key, &tuning->modules[module].half_life_ms, Tuning::HALF_LIFE_MAX);
+            snprintf(key, sizeof(key), CONFIG_KEY_GOVERNOR_MIN_FMT, name);
+            fn(key, &tuning->modules[module].min_mhz, (std::uint32_t)UINT16_MAX);
+            snprintf(key, sizeof(key), CONFIG_KEY_GOVERNOR_MAX_FMT, name);
+            fn(key, &tuning->modules[module].max_mhz, (std::uint32_t)UINT16_MAX);
+        }
+    }
+
+  protected:
+    template <typename... Args>
+    void Log(const char* format, Args... args) const
+    {
+        if (this->hooks.log)
+            this->hooks.log(format, args...);
+    }
+
+    static char* Trim(char* s, bool trailing = true)
+    {
+        while (isspace((unsigned char)*s))
+            s++;
+        if (trailing)
+        {
+            char* end = s + strlen(s);
+            while (end > s && isspace((unsigned char)end[-1]))
+                *--end = '\0';
+        }
+        return s;
+    }
+
+    // Strips comments and quotes like minIni
+    static char* ParseValue(char* s)
+    {
+        s = Trim(s);
+        if (*s == '"')
+        {
+            char* end = strchr(s + 1, '"');
+            if (end)
+                *end = '\0';
+            return s + 1;
+        }
+        char* comment = strpbrk(s, ";#");
+        if (comment)
+            *comment = '\0';
+        return Trim(s);
+    }
+
+    // 0 if not a title section
+    static std::uint64_t ParseTitleSection(const char* section)
+    {
+        if (strlen(section) != 16)
+            return 0;
+        return strtoull(section, NULL, 16);
+    }
+
+    bool ParseGovernorTuningKey(const char* key, const char* value, GovernorCore::Tuning* tuning) const
+    {
+        bool found = false;
+        ForEachGovernorTuningKey(tuning, [&](const char* name, std::uint32_t* field, std::uint32_t max) {
+            if (found || strcmp(key, name))
+                return;
+
+            found = true;
+            std::uint32_t input = strtoul(value, NULL, 0);
+            if (input > max || (field == &tuning->sample_rate && input && input < GovernorCore::Tuning::SAMPLE_RATE_MIN))
+            {
+                this->Log("[cfg] Invalid value for key '%s': using default", key);
+                input = 0;
+            }
+            *field = input;
+        });
+
+        return found;
+    }
+
+    void ParseKey(const char* section, const char* key, const char* value)
+    {
+        std::uint64_t input;
+        if (!strcmp(section, CONFIG_VAL_SECTION))
+        {
+            for (unsigned int kval = 0; kval < SysClkConfigValue_EnumMax; kval++)
+            {
+                if (!strcmp(key, sysclkFormatConfigValue((SysClkConfigValue)kval, false)))
+                {
+                    input = strtoul(value, NULL, 0);
+                    if (!sysclkValidConfigValue((SysClkConfigValue)kval, input))
+                    {
+                        input = sysclkDefaultConfigValue((SysClkConfigValue)kval);
+                        this->Log("[cfg] Invalid value for key '%s' in section '%s': using default %llu", key, section, (unsigned long long)input);
+                    }
+                    this->values[kval] = input;
+                    return;
+                }
+            }
+
+            this->Log("[cfg] Skipping key '%s' in section '%s': Unrecognized config value", key, section);
+            return;
+        }
+
+        if (!strcmp(section, CONFIG_GOVERNOR_SECTION))
+        {
+            if (!this->ParseGovernorTuningKey(key, value, &this->tunings[0]))
+            {
+                this->Log("[cfg] Skipping key '%s' in section '%s': Unrecognized key", key, section);
+            }
+            return;
+        }
+
+        std::uint64_t tid = ParseTitleSection(section);
+        if (!tid)
+        {
+            this->Log("[cfg] Skipping key '%s' in section '%s': Invalid TitleID", key, section);
+            return;
+        }
+
+        if (!strcmp(key, CONFIG_KEY_TITLE_GOVERNOR_CONFIG))
+        {
+            input = strtoul(value, NULL, 0);
+            if ((input & SysClkOcGovernorConfig_Mask) != input)
+            {
+                input = SysClkOcGovernorConfig_Default;
+                this->Log("[cfg] Invalid value for key '%s' in section '%s': using default %llu", key, section, (unsigned long long)input);
+            }
+            this->GetOrCreateTitle(tid)->governorConfig = input;
+            return;
+        }
+
+        // Tuning keys are rare, skip formatting their names for every profile key
+        if (!strncmp(key, "governor_", 9))
+        {
+            GovernorCore::Tuning tuning = {};
+            if (const GovernorCore::Tuning* prev = this->FindTuning(tid))
+                tuning = *prev;
+            if (this->ParseGovernorTuningKey(key, value, &tuning))
+            {
+                this->tunings[tid] = tuning;
+                return;
+            }
+        }
+
+        SysClkProfile parsedProfile = SysClkProfile_EnumMax;
+        SysClkModule parsedModule = SysClkModule_EnumMax;
+
+        for (unsigned int profile = 0; profile < SysClkProfile_EnumMax; profile++)
+        {
+            const char* profileCode = sysclkFormatProfile((SysClkProfile)profile, false);
+            size_t profileCodeLen = strlen(profileCode);
+
+            if (!strncmp(key, profileCode, profileCodeLen) && key[profileCodeLen] == '_')
+            {
+                const char* subkey = key + profileCodeLen + 1;
+
+                for (unsigned int module = 0; module < SysClkModule_EnumMax; module++)
+                {
+                    if (!strcmp(subkey, sysclkFormatModule((SysClkModule)module, false)))
+                    {
+                        parsedProfile = (SysClkProfile)profile;
+                        parsedModule = (SysClkModule)module;
+                    }
+                }
+            }
+        }
+
+        if (parsedModule == SysClkModule_EnumMax || parsedProfile == SysClkProfile_EnumMax)
+        {
+            this->Log("[cfg] Skipping key '%s' in section '%s': Unrecognized key", key, section);
+            return;
+        }
+
+        std::uint32_t mhz = strtoul(value, NULL, 10);
+        if (parsedModule == SysClkModule_MEM && this->hooks.memMhz)
+            mhz = this->hooks.memMhz(mhz);
+        if (!mhz || mhz > UINT16_MAX)
+        {
+            this->Log("[cfg] Skipping key '%s' in section '%s': Invalid value", key, section);
+            return;
+        }
+
+        ConfigTitle* title = this->GetOrCreateTitle(tid);
+        if (!title->mhz[parsedProfile][parsedModule])
+            title->count++;
+        title->mhz[parsedProfile][parsedModule] = mhz;
+    }
+
+    ConfigTitle* GetOrCreateTitle(std::uint64_t tid)
+    {
+        auto [it, inserted] = this->titles.try_emplace(tid);
+        if (inserted)
+            it->second.governorConfig = SysClkOcGovernorConfig_Default;
+        return &it->second;
+    }
+
+    bool WriteValues(FILE* fp) const
+    {
+        bool ok = fprintf(fp, "[%s]\n", CONFIG_VAL_SECTION) > 0;
+        for (unsigned int kval = 0; ok && kval < SysClkConfigValue_EnumMax; kval++)
+        {
+            if (this->values[kval] == sysclkDefaultConfigValue((SysClkConfigValue)kval))
+                continue;
+            ok = fprintf(fp, "%s=%llu\n", sysclkFormatConfigValue((SysClkConfigValue)kval, false), (unsigned long long)this->values[kval]) > 0;
+        }
+        return ok && fputs("\n", fp) >= 0;
+    }
+
+    // Section is dropped once it has nothing left
+    bool WriteTitle(FILE* fp, std::uint64_t tid) const
+    {
+        const ConfigTitle* title = this->FindTitle(tid);
+        const GovernorCore::Tuning* tuning = this->FindTuning(tid);
+        if (!title && !tuning)
+            return true;
+
+        bool ok = fprintf(fp, "[%016llX]\n", (unsigned long long)tid) > 0;
+        if (title)
+        {
+            for (unsigned int profile = 0; profile < SysClkProfile_EnumMax; profile++)
+            {
+                for (unsigned int module = 0; module < SysClkModule_EnumMax; module++)
+                {
+                    if (!title->mhz[profile][module])
+                        continue;
+                    ok = ok && fprintf(fp, "%s_%s=%u\n", sysclkFormatProfile((SysClkProfile)profile, false),
+                                       sysclkFormatModule((SysClkModule)module, false), title->mhz[profile][module]) > 0;
+                }
+            }
+            if (title->governorConfig != SysClkOcGovernorConfig_Default)
+                ok = ok && fprintf(fp, "%s=%u\n", CONFIG_KEY_TITLE_GOVERNOR_CONFIG, title->governorConfig) > 0;
+        }
+        if (tuning)
+        {
+            GovernorCore::Tuning copy = *tuning;
+            ForEachGovernorTuningKey(&copy, [&](const char* name, std::uint32_t* field, std::uint32_t) {
+                if (*field)
+                    ok = ok && fprintf(fp, "%s=%u\n", name, *field) > 0;
+            });
+        }
+        return ok && fputs("\n", fp) >= 0;
+    }
+
+    Hooks hooks;
+    std::unordered_map<std::uint64_t, ConfigTitle> titles;
+    std::unordered_map<std::uint64_t, GovernorCore::Tuning> tunings; // tid 0: [governor] section
+    std::unordered_set<std::uint64_t> dirtyTitles;
+    bool dirtyValues;
+    std::uint64_t values[SysClkConfigValue_EnumMax];
+};
@@ -10,16 +10,33 @@
 
 #include "file_utils.h"
 #include "clocks.h"
+#include "kip.h"
+// Loader header shared by path, the rest of its directory stays off the include path
+#include "../../../Atmosphere/stratosphere/loader/source/oc/oc_emc_ladder.hpp"
 #include <dirent.h>
 #include <nxExt.h>
 #include "errors.h"
 
 static LockableMutex g_log_mutex;
-static LockableMutex g_csv_mutex;
+static LockableMutex g_context_file_mutex;
 static std::atomic_bool g_has_initialized = false;
-static bool g_log_enabled = false;
+static std::atomic_bool g_log_enabled = false;
 static std::uint64_t g_last_flag_check = 0;
 
+// 64 preformatted lines (~13 KB), lines logged while full are dropped and counted
+static LogQueue<FILE_LOG_QUEUE_SLOTS, FILE_LOG_LINE_MAX> g_log_queue;
+static FILE* g_log_file = nullptr;
+
+// 256 records: 2.5 s at 100 Hz, flushed once half full
+static SpscRing<TelemetryRecord, 256> g_context_ring;
+static TelemetryRecord g_context_block[decltype(g_context_ring)::Capacity()];
+static std::uint64_t g_last_context_flush = 0;
+
+// Single background writer for the log and the context records
+static Thread g_writer;
+static UEvent g_writer_event;
+static std::atomic_bool g_writer_running = false;
+
 extern "C" void __libnx_init_time(void);
 
 static void _FileUtils_InitializeThreadFunc(void *args)
@@ -27,6 +44,24 @@ static void _FileUtils_InitializeThreadFunc(void *args)
     FileUtils::Initialize();
 }
 
+static void _FileUtils_WriteLogLine(FILE* file, std::uint64_t timestamp_ms, const char* text, size_t len)
+{
+    time_t sec = timestamp_ms / 1000;
+    struct tm nowTm;
+    localtime_r(&sec, &nowTm);
+
+    fprintf(file, "[%04d-%02d-%02d %02d:%02d:%02d.%03u] ", nowTm.tm_year+1900, nowTm.tm_mon+1, nowTm.tm_mday, nowTm.tm_hour, nowTm.tm_min, nowTm.tm_sec, (unsigned)(timestamp_ms % 1000));
+    fwrite(text, 1, len, file);
+    fputc('\n', file);
+}
+
+static std::uint64_t _FileUtils_RealtimeMs()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    return now.tv_sec * 1000ULL + now.tv_nsec / 1000000UL;
+}
+
 bool FileUtils::IsInitialized()
 {
     return g_has_initialized;
@@ -34,79 +69,125 @@ bool FileUtils::IsInitialized()
 
 void FileUtils::LogLine(const char *format, ...)
 {
+    if (!g_has_initialized || !g_log_enabled)
+    {
+        return;
+    }
+
     va_list args;
     va_start(args, format);
-    if (g_has_initialized)
+    g_log_queue.Push(_FileUtils_RealtimeMs(), format, args);
+    va_end(args);
+
+    if (!g_writer_running)
+    {
+        // No writer thread, write synchronously
+        FileUtils::FlushLog();
+    }
+    else if (g_log_queue.Size() >= g_log_queue.Capacity() / 2)
     {
-        g_log_mutex.Lock();
+        ueventSignal(&g_writer_event);
+    }
+}
 
-        FileUtils::RefreshFlags(false);
+void FileUtils::FlushLog()
+{
+    std::scoped_lock lock{g_log_mutex};
 
-        if(g_log_enabled)
+    FileUtils::RefreshFlags(false);
+
+    if (g_log_enabled && !g_log_file)
+    {
+        g_log_file = fopen(FILE_LOG_FILE_PATH, "a");
+    }
+
+    if (!g_log_enabled || !g_log_file)
+    {
+        // Discard queued lines, keep them only while the file can be written
+        while (g_log_queue.Pop([](std::uint64_t, const char*, size_t) {}));
+        g_log_queue.TakeDropped();
+        if (g_log_file)
         {
-            FILE *file = fopen(FILE_LOG_FILE_PATH, "a");
-
-            if (file)
-            {
-                struct timespec now;
-                clock_gettime(CLOCK_REALTIME, &now);
-                struct tm* nowTm = localtime(&now.tv_sec);
-
-                fprintf(file, "[%04d-%02d-%02d %02d:%02d:%02d.%03ld] ", nowTm->tm_year+1900, nowTm->tm_mon+1, nowTm->tm_mday, nowTm->tm_hour, nowTm->tm_min, nowTm->tm_sec, now.tv_nsec / 1000000UL);
-                vfprintf(file, format, args);
-                fprintf(file, "\n");
-                fclose(file);
-            }
+            fclose(g_log_file);
+            g_log_file = nullptr;
         }
+        return;
+    }
 
-        g_log_mutex.Unlock();
+    size_t count = 0;
+    while (g_log_queue.Pop([](std::uint64_t timestamp_ms, const char* text, size_t len) {
+        _FileUtils_WriteLogLine(g_log_file, timestamp_ms, text, len);
+    }))
+    {
+        count++;
+    }
+
+    if (size_t dropped = g_log_queue.TakeDropped())
+    {
+        char text[64];
+        int len = snprintf(text, sizeof(text), "[log] %zu lines dropped (queue full)", dropped);
+        _FileUtils_WriteLogLine(g_log_file, _FileUtils_RealtimeMs(), text, len);
+        count++;
+    }
+
+    if (count)
+    {
+        fflush(g_log_file);
     }
-    va_end(args);
 }
 
-void FileUtils::WriteContextToCsv(const SysClkContext* context)
+void FileUtils::WriteContextRecord(const TelemetryRecord* record)
 {
-    std::scoped_lock lock{g_csv_mutex};
+    if (!g_has_initialized)
+    {
+        return;
+    }
 
-    FILE *file = fopen(FILE_CONTEXT_CSV_PATH, "a");
+    g_context_ring.Push(*record);
+    if (g_context_ring.Size() >= g_context_ring.Capacity() / 2)
+    {
+        ueventSignal(&g_writer_event);
+    }
+}
+
+void FileUtils::FlushContextRecords()
+{
+    std::scoped_lock lock{g_context_file_mutex};
+
+    size_t count = g_context_ring.Pop(g_context_block, g_context_ring.Capacity());
+    if (!count)
+    {
+        return;
+    }
+
+    FILE *file = fopen(FILE_CONTEXT_LOG_PATH, "ab");
 
     if (file)
     {
-        // Print header
         if(!ftell(file))
         {
-            fprintf(file, "timestamp,profile,app_tid");
-
-            for (unsigned int module = 0; module < SysClkModule_EnumMax; module++)
-            {
-                fprintf(file, ",%s_hz", sysclkFormatModule((SysClkModule)module, false));
-            }
-
-            for (unsigned int sensor = 0; sensor < SysClkThermalSensor_EnumMax; sensor++)
-            {
-                fprintf(file, ",%s_milliC", sysclkFormatThermalSensor((SysClkThermalSensor)sensor, false));
-            }
-
-            fprintf(file, "\n");
+            TelemetryHeader header = TelemetryMakeHeader();
+            fwrite(&header, sizeof(header), 1, file);
         }
 
-        struct timespec now;
-        clock_gettime(CLOCK_REALTIME, &now);
-
-        fprintf(file, "%ld%03ld,%s,%016lx", now.tv_sec, now.tv_nsec / 1000000UL, sysclkFormatProfile(context->profile, false), context->applicationId);
+        fwrite(g_context_block, sizeof(TelemetryRecord), count, file);
+        fclose(file);
+    }
+}
 
-        for (unsigned int module = 0; module < SysClkModule_EnumMax; module++)
-        {
-            fprintf(file, ",%d", context->freqs[module]);
-        }
+void FileUtils::WriterThread(void* args)
+{
+    while (g_writer_running)
+    {
+        waitSingle(waiterForUEvent(&g_writer_event), FILE_LOG_FLUSH_INTERVAL_NS);
+        FileUtils::FlushLog();
 
-        for (unsigned int sensor = 0; sensor < SysClkThermalSensor_EnumMax; sensor++)
+        std::uint64_t now = armTicksToNs(armGetSystemTick());
+        if (g_context_ring.Size() >= g_context_ring.Capacity() / 2 || (now - g_last_context_flush) >= FILE_CONTEXT_FLUSH_INTERVAL_NS)
         {
-            fprintf(file, ",%d", context->temps[sensor]);
+            FileUtils::FlushContextRecords();
+            g_last_context_flush = now;
         }
-
-        fprintf(file, "\n");
-        fclose(file);
     }
 }
 
@@ -163,6 +244,18 @@ Result FileUtils::Initialize()
     {
         FileUtils::RefreshFlags(true);
         g_has_initialized = true;
+
+        // Without the writer, log lines are written synchronously and context records dropped once the ring is full
+        ueventCreate(&g_writer_event, true);
+        g_writer_running = true;
+        if (R_FAILED(threadCreate(&g_writer, &FileUtils::WriterThread, NULL, NULL, 0x2000, 0x3F, -2)))
+        {
+            g_writer_running = false;
+        }
+        else
+        {
+            threadStart(&g_writer);
+        }
         FileUtils::LogLine("=== " TARGET " " TARGET_VERSION " ===");
     }
 
@@ -177,17 +270,45 @@ void FileUtils::Exit()
     }
 
     g_has_initialized = false;
+
+    if (g_writer_running.exchange(false))
+    {
+        ueventSignal(&g_writer_event);
+        threadWaitForExit(&g_writer);
+        threadClose(&g_writer);
+    }
+    FileUtils::FlushContextRecords();
+    FileUtils::FlushLog();
+
     g_log_enabled = false;
+    if (g_log_file)
+    {
+        fclose(g_log_file);
+        g_log_file = nullptr;
+    }
 
     fsdevUnmountAll();
     fsExit();
 }
 
 void FileUtils::ParseLoaderKip() {
-    const char* dirs[] = { "/", "/atmosphere/", "/atmosphere/kips/", "/bootloader/" };
+    // Path found on a previous boot
     char* full_path = new char[0x200];
     SCOPE_EXIT { delete[] full_path; };
 
+    if (FILE* fp = fopen(FILE_KIP_PATH_CACHE_PATH, "r")) {
+        bool read = fgets(full_path, 0x200, fp);
+        fclose(fp);
+        if (read) {
+            full_path[strcspn(full_path, "\r\n")] = '\0';
+            if (R_SUCCEEDED(CustParser(full_path))) {
+                LogLine("Parsed cust config from \"%s\" (cached path)", full_path);
+                return;
+            }
+        }
+    }
+
+    const char* dirs[] = { "/", "/atmosphere/", "/atmosphere/kips/", "/bootloader/" };
     for (auto const& dir : dirs) {
         struct dirent *entry = NULL;
         DIR *dp = opendir(dir);
@@ -199,31 +320,22 @@ void FileUtils::ParseLoaderKip() {
             if (entry->d_type != DT_REG)
                 continue;
 
-            snprintf(full_path, 0x200, "%s%s", dir, entry->d_name);
-
-            FILE* fp = fopen(full_path, "r");
-            if (!fp)
-                continue;
-
-            fseek(fp, 0, SEEK_END);
-            long res = ftell(fp);
-            fclose(fp);
-            if (res == -1)
-                continue;
-
-            size_t filesize = (size_t)res;
-            if (filesize < 0x1000 || filesize > 512 * 1024)
-                continue;
-
             const char kip_ext[] = {'.', 'k', 'i', 'p'};
             size_t file_name_len = strnlen(reinterpret_cast<const char*>(&entry->d_name), 256);
+            if (file_name_len < sizeof(kip_ext))
+                continue;
             const char* file_ext = &entry->d_name[file_name_len - sizeof(kip_ext)];
 
             if (strncasecmp((const char*)kip_ext, file_ext, sizeof(kip_ext)))
                 continue;
 
-            if (R_SUCCEEDED(CustParser(full_path, filesize))) {
+            snprintf(full_path, 0x200, "%s%s", dir, entry->d_name);
+            if (R_SUCCEEDED(CustParser(full_path))) {
                 LogLine("Parsed cust config from \"%s\"", full_path);
+                if (FILE* fp = fopen(FILE_KIP_PATH_CACHE_PATH, "w")) {
+                    fputs(full_path, fp);
+                    fclose(fp);
+                }
                 return;
             }
         }
@@ -232,7 +344,7 @@ void FileUtils::ParseLoaderKip() {
     ERROR_THROW("Cannot locate loader.kip in /, /atmosphere/, /atmosphere/kips/ and /bootloader/");
 }
 
-Result FileUtils::CustParser(const char* filepath, size_t filesize) {
+Result FileUtils::CustParser(const char* filepath) {
     enum ParseError {
         ParseError_Success = 0,
         ParseError_OpenReadFailed,
@@ -246,39 +358,25 @@ Result FileUtils::CustParser(const char* filepath, size_t filesize) {
         return ParseError_OpenReadFailed;
     SCOPE_EXIT { fclose(fp); };
 
-    constexpr uint8_t KIP_MAGIC[] = {'K', 'I', 'P', '1', 'L', 'o', 'a', 'd', 'e', 'r'};
-    constexpr size_t  BLOCK_SIZE = 0x1000;
-
-    char* tmp_block = new char[BLOCK_SIZE];
-    SCOPE_EXIT { delete[] tmp_block; };
-    fread(tmp_block, sizeof(char), BLOCK_SIZE, fp);
+    if (fseek(fp, 0, SEEK_END))
+        return ParseError_OpenReadFailed;
+    long filesize = ftell(fp);
+    if (filesize < 0x1000 || filesize > 512 * 1024)
+        return ParseError_OpenReadFailed;
 
-    if (memcmp(KIP_MAGIC, tmp_block, sizeof(KIP_MAGIC)))
+    // Only the header is read for any other KIP
+    KipHeader header;
+    if (!Kip::ReadHeader(fp, filesize, &header, "Loader"))
         return ParseError_WrongKipMagic;
 
     CustTable table {};
 
-    fpos_t cust_pos = 0;
-    long block_pos = 0;
-    while ((block_pos = ftell(fp)) >= 0 && (size_t)block_pos < filesize) {
-        for (size_t i = 0; i < BLOCK_SIZE; i += sizeof(table.cust)) {
-            if (memcmp(table.cust, &tmp_block[i], sizeof(table.cust)))
-                continue;
-
-            fgetpos(fp, &cust_pos);
-            cust_pos = cust_pos + i - BLOCK_SIZE;
-            goto found;
-        }
-        fread(tmp_block, sizeof(char), BLOCK_SIZE, fp);
-    }
-
-  found:
-    if (!cust_pos)
+    long cust_pos = Kip::FindMagic(fp, header, table.cust);
+    if (cust_pos < 0)
         return ParseError_CustNotFound;
 
     memset(reinterpret_cast<void*>(&table), 0, sizeof(CustTable));
-    fsetpos(fp, &cust_pos);
-    if (!fread(reinterpret_cast<char*>(&table), 1, sizeof(CustTable), fp))
+    if (fseek(fp, cust_pos, SEEK_SET) || !fread(reinterpret_cast<char*>(&table), 1, sizeof(CustTable), fp))
         return ParseError_OpenReadFailed;
 
     if (table.custRev != CUST_REV)
@@ -327,7 +425,15 @@ Result FileUtils::CustParser(const char* filepath, size_t filesize) {
         gpu_dvfs_table = &table.eristaGpuDvfsTable;
     }
 
-    // Fill Clocks::freqTable
+    // Only GPU UV mode 3 has fixed voltages, other steps get theirs from the rail once applied
+    const bool gpu_volt_array = Clocks::GetIsMariko() && table.marikoGpuUV == 3;
+
+    // Fill Clocks::freqTable and Clocks::energyModel
+    GovernorCore::EnergyModel* cpu_em = &Clocks::energyModel[SysClkModule_CPU];
+    GovernorCore::EnergyModel* gpu_em = &Clocks::energyModel[SysClkModule_GPU];
+    cpu_em->Reset();
+    gpu_em->Reset();
+
     cvb_entry_t* cpu_dvfs_entry = reinterpret_cast<cvb_entry_t *>(cpu_dvfs_table);
     for (size_t i = 0, j = 0; i < FREQ_TABLE_MAX_ENTRY_COUNT; i++) {
         // Skip CPU frequencies < 408 MHz that are not usable
@@ -335,16 +441,32 @@ Result FileUtils::CustParser(const char* filepath, size_t filesize) {
         if (freq < 408'000)
             continue;
         Clocks::freqTable[SysClkModule_CPU].freq[j++] = freq * 1000;
+        cpu_em->Add(freq * 1000);
     }
 
     cvb_entry_t* gpu_dvfs_entry = reinterpret_cast<cvb_entry_t *>(gpu_dvfs_table);
     for (size_t i = 0; i < FREQ_TABLE_MAX_ENTRY_COUNT; i++) {
         Clocks::freqTable[SysClkModule_GPU].freq[i] = gpu_dvfs_entry[i].freq * 1000;
+
+        uint32_t mv = 0;
+        if (gpu_volt_array && i < sizeof(table.marikoGpuVoltArray) / sizeof(table.marikoGpuVoltArray[0]))
+            mv = table.marikoGpuVoltArray[i];
+        gpu_em->Add(gpu_dvfs_entry[i].freq * 1000, mv);
     }
 
-    // Appending maximum mem freq to freqTable
+    cpu_em->Finalize();
+    gpu_em->Finalize();
+
+    // Appending OC mem freqs to freqTable, intermediate steps exist on Erista only
     uint32_t* mem_entry = &Clocks::freqTable[SysClkModule_MEM].freq[0];
     while (*(++mem_entry));
+    if (!Clocks::GetIsMariko() && Clocks::maxMemFreq > MEM_CLOCK_DOCK) {
+        // Same steps as the tables loader generated, the last one is maxMemFreq
+        uint32_t ladder[emc_oc_ladder::Slots];
+        size_t steps = emc_oc_ladder::Get(Clocks::maxMemFreq / 1000, table.mtcConf == MTC_CONF_AUTO_ADJ_ALL, ladder);
+        for (size_t i = 0; i + 1 < steps; i++)
+            *mem_entry++ = ladder[i] * 1000;
+    }
     *mem_entry = Clocks::maxMemFreq;
 
     return ParseError_Success;
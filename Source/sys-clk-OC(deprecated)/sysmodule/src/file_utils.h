@@ -17,12 +17,19 @@
 #include <atomic>
 #include <cstdarg>
 #include <sysclk.h>
+#include "log_queue.h"
+#include "telemetry.h"
 
 #define FILE_CONFIG_DIR "/config/sys-clk-oc"
 #define FILE_FLAG_CHECK_INTERVAL_NS 5000000000ULL
-#define FILE_CONTEXT_CSV_PATH FILE_CONFIG_DIR "/context.csv"
+#define FILE_CONTEXT_LOG_PATH FILE_CONFIG_DIR "/context.bin"
+#define FILE_CONTEXT_FLUSH_INTERVAL_NS 5000000000ULL
 #define FILE_LOG_FLAG_PATH FILE_CONFIG_DIR "/log.flag"
 #define FILE_LOG_FILE_PATH FILE_CONFIG_DIR "/log.txt"
+#define FILE_LOG_FLUSH_INTERVAL_NS 1000000000ULL
+#define FILE_LOG_QUEUE_SLOTS 64
+#define FILE_LOG_LINE_MAX 192
+#define FILE_KIP_PATH_CACHE_PATH FILE_CONFIG_DIR "/loader_kip_path.txt"
 
 typedef struct cvb_coefficients {
     s32 c0 = 0;
@@ -44,6 +51,7 @@ using CustomizeCpuDvfsTable = cvb_entry_t[FREQ_TABLE_MAX_ENTRY_COUNT];
 using CustomizeGpuDvfsTable = cvb_entry_t[FREQ_TABLE_MAX_ENTRY_COUNT];
 
 constexpr uint32_t CUST_REV = 10;
+constexpr uint32_t MTC_CONF_AUTO_ADJ_ALL = 0; // Loader MtcConfig
 
 typedef struct CustTable {
     u8  cust[4] = {'C', 'U', 'S', 'T'};
@@ -87,11 +95,16 @@ class FileUtils
     static Result Initialize();
     static bool IsInitialized();
     static void InitializeAsync();
+    // Never blocks: lines are queued and written in batches by a background thread
     static void LogLine(const char *format, ...);
-    static void WriteContextToCsv(const SysClkContext* context);
+    // Queued in memory, written in batches by a background thread
+    static void WriteContextRecord(const TelemetryRecord* record);
+    static void FlushContextRecords();
     static void ParseLoaderKip();
     static Result mkdir_p(const char* dirpath);
   protected:
     static void RefreshFlags(bool force);
-    static Result CustParser(const char* path, size_t filesize);
+    static void FlushLog();
+    static void WriterThread(void* args);
+    static Result CustParser(const char* path);
 };
@@ -0,0 +1,593 @@
+/*
+ * --------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <p-sam@d3vs.net>, <natinusala@gmail.com>, <m4x@m4xw.net>
+ * wrote this file. As long as you retain this notice you can do whatever you
+ * want with this stuff. If you meet any of us some day, and you think this
+ * stuff is worth it, you can buy us a beer in return.  - The sys-clk authors
+ * --------------------------------------------------------------------------
+ */
+
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <sysclk/clocks.h>
+
+// Platform independent governor math, shared by oc_extra and the host simulator (sysmodule/sim)
+
+constexpr uint64_t SAMPLE_RATE = 200;
+constexpr uint64_t TICK_TIME_NS = 1000'000'000 / SAMPLE_RATE;
+constexpr uint64_t SYSTICK_HZ = 19200000;
+
+namespace GovernorCore {
+    constexpr uint32_t UTIL_MAX = 1000;
+
+    // Utilization from idle tick and system tick deltas of one core
+    inline uint32_t UtilFromTicks(uint64_t diff_idletick, uint64_t diff_systick) {
+        if (!diff_systick)
+            return 0;
+        if (diff_idletick > diff_systick)
+            diff_idletick = diff_systick;
+        return UTIL_MAX - diff_idletick * 10 * 100ULL / diff_systick;
+    }
+
+    // Approximate the would-be frequency-invariant utilization
+    inline uint32_t NormalizeUtil(uint32_t rawUtil, uint32_t curr_hz, uint32_t max_hz) {
+        return max_hz ? ((uint64_t)rawUtil * curr_hz / max_hz) : 0;
+    }
+
+    // Energy model: https://github.com/torvalds/linux/blob/master/include/linux/energy_model.h
+    // Dynamic energy per cycle ~ C * V^2, so a step is inefficient when a faster step
+    // runs at the same voltage: it costs the same per unit of work and finishes later.
+    // Steps are added in frequency order at config load time. Voltages depend on the fused
+    // speedo and the temperature, so they are learned from the rail (Observe) once a step
+    // has been applied. A step with no voltage yet is never merged with its neighbours.
+    class EnergyModel {
+    public:
+        typedef struct {
+            uint32_t hz;
+            uint32_t mv;        // 0: not observed yet
+            uint32_t cost;      // mV^2, relative energy per cycle
+            uint32_t efficient; // fastest step index with the same cost
+        } Step;
+
+        void Reset() { m_count = 0; };
+
+        // Must be called in ascending frequency order, mv = 0 when unknown
+        bool Add(uint32_t hz, uint32_t mv = 0) {
+            if (!hz || m_count >= FREQ_TABLE_MAX_ENTRY_COUNT)
+                return false;
+            if (m_count && hz <= m_steps[m_count - 1].hz)
+                return false;
+
+            m_steps[m_count] = { hz, mv, mv * mv, (uint32_t)m_count };
+            m_count++;
+            return true;
+        }
+
+        // Voltage measured while running at hz, returns true if the model has changed
+        bool Observe(uint32_t hz, uint32_t mv) {
+            Step* end = m_steps + m_count;
+            Step* step = std::lower_bound(m_steps, end, hz,
+                [](const Step& s, uint32_t hz) { return s.hz < hz; });
+            if (!mv || step == end || step->hz != hz || step->mv == mv)
+                return false;
+
+            step->mv = mv;
+            step->cost = mv * mv;
+            Finalize();
+            return true;
+        }
+
+        void Finalize() {
+            for (size_t i = m_count; i-- > 0; ) {
+                // Voltage never goes down with a higher frequency, a lower reading is noise or temperature
+                const Step& s = m_steps[i];
+                bool plateau = i + 1 < m_count && s.mv && m_steps[i + 1].mv && m_steps[i + 1].cost <= s.cost;
+                m_steps[i].efficient = plateau ? m_steps[i + 1].efficient : i;
+            }
+        }
+
+        bool IsValid() const { return m_count != 0; };
+        size_t Count() const { return m_count; };
+        const Step& operator[](size_t i) const { return m_steps[i]; };
+
+        // Cheapest step (per unit of work) that meets target_hz, capped to max_hz
+        uint32_t SelectHz(uint32_t target_hz, uint32_t max_hz) const {
+            const Step* end = m_steps + m_count;
+            const Step* step = std::lower_bound(m_steps, end, target_hz,
+                [](const Step& s, uint32_t hz) { return s.hz < hz; });
+            if (step == end)
+                return max_hz;
+
+            const Step* cap = std::upper_bound(m_steps, end, max_hz,
+                [](uint32_t hz, const Step& s) { return hz < s.hz; });
+            if (cap == m_steps)
+                return max_hz;
+
+            size_t idx = std::min<size_t>(step->efficient, cap - m_steps - 1);
+            return std::max(m_steps[idx].hz, step->hz);
+        }
+
+    protected:
+        Step m_steps[FREQ_TABLE_MAX_ENTRY_COUNT] = {};
+        size_t m_count = 0;
+    };
+
+    // Lowest step >= hz in a zero terminated ascending list, or the last one
+    inline uint32_t CeilHz(const uint32_t* hz_list, uint32_t hz) {
+        const uint32_t* p = hz_list;
+        for (; *p != 0; p++) {
+            if (hz <= *p)
+                return *p;
+        }
+        return *(--p);
+    }
+
+    // Highest step <= hz, or the first one
+    inline uint32_t FloorHz(const uint32_t* hz_list, uint32_t hz) {
+        uint32_t floor = hz_list[0];
+        for (const uint32_t* p = hz_list; *p != 0 && *p <= hz; p++)
+            floor = *p;
+        return floor;
+    }
+
+    // First p in [start, end) with hz <= *p, or end
+    inline const uint32_t* NearestHzPtr(const uint32_t* start, const uint32_t* end, uint32_t hz) {
+        const uint32_t* p = start;
+        while (p < end) {
+            if (hz <= *p)
+                return p;
+            p++;
+        }
+        return end;
+    }
+
+    // Constant time version of the scans above for the governor path. Hz are split in
+    // 4.19 MHz buckets (hz >> BUCKET_SHIFT), each holding the first step >= its start:
+    // a lookup reads one bucket then skips the steps inside it, at most one with DVFS
+    // tables. Unsorted lists fall back to the scans.
+    class FreqIndex {
+    public:
+        static constexpr uint32_t BUCKET_SHIFT = 22;
+        static constexpr size_t BUCKETS = (UINT32_MAX >> BUCKET_SHIFT) + 1;
+
+        // hz_list is zero terminated or FREQ_TABLE_MAX_ENTRY_COUNT long. Nothing is written
+        // when it is unchanged, so rebuilding never disturbs readers on other threads.
+        void Build(const uint32_t* hz_list) {
+            size_t count = 0;
+            while (count < FREQ_TABLE_MAX_ENTRY_COUNT && hz_list[count])
+                count++;
+            if (m_built && count == m_count && std::equal(hz_list, hz_list + count, m_steps))
+                return;
+
+            std::copy(hz_list, hz_list + count, m_steps);
+            m_steps[count] = 0;
+            m_count = count;
+            m_sorted = std::is_sorted(m_steps, m_steps + count);
+
+            size_t idx = 0;
+            for (size_t b = 0; b < BUCKETS; b++) {
+                uint64_t start = (uint64_t)b << BUCKET_SHIFT;
+                while (idx < count && m_steps[idx] < start)
+                    idx++;
+                m_buckets[b] = idx;
+            }
+            m_built = true;
+        }
+
+        size_t Count() const { return m_count; };
+
+        // Lowest step index >= hz, Count() if none
+        size_t CeilIdx(uint32_t hz) const {
+            size_t idx = m_sorted ? m_buckets[hz >> BUCKET_SHIFT] : 0;
+            while (idx < m_count && m_steps[idx] < hz)
+                idx++;
+            return idx;
+        }
+
+        // Same as NearestHzPtr(&list[lo], &list[hi], hz) - list
+        size_t NearestIdx(size_t lo, size_t hi, uint32_t hz) const {
+            if (!m_sorted)
+                return NearestHzPtr(m_steps + lo, m_steps + hi, hz) - m_steps;
+            return std::min(std::max(CeilIdx(hz), lo), hi);
+        }
+
+        // Same as CeilHz(list, hz)
+        uint32_t Ceil(uint32_t hz) const {
+            if (!m_count)
+                return 0;
+            return m_steps[std::min(CeilIdx(hz), m_count - 1)];
+        }
+
+        // Same as FloorHz(list, hz)
+        uint32_t Floor(uint32_t hz) const {
+            if (!m_sorted)
+                return FloorHz(m_steps, hz);
+            size_t idx = CeilIdx(hz);
+            if (idx < m_count && m_steps[idx] == hz)
+                return hz;
+            return m_steps[idx ? idx - 1 : 0];
+        }
+
+    protected:
+        uint32_t m_steps[FREQ_TABLE_MAX_ENTRY_COUNT + 1] = {}; // Zero terminated
+        uint8_t m_buckets[BUCKETS];
+        size_t m_count = 0;
+        bool m_sorted = true;
+        bool m_built = false;
+
+        static_assert(FREQ_TABLE_MAX_ENTRY_COUNT <= UINT8_MAX, "bucket entries are 8-bit");
+    };
+
+    // Steps come from a FreqIndex. With a valid energy model, the target is
+    // rounded up to the most efficient step instead of the next one.
+    inline uint32_t RoundHz(const FreqIndex& index, uint32_t min_hz, uint32_t max_hz, uint32_t next_freq,
+                            const EnergyModel* em = nullptr) {
+        if (next_freq >= max_hz)
+            return max_hz;
+        if (em && em->IsValid())
+            return em->SelectHz(std::max(next_freq, min_hz), max_hz);
+        if (next_freq <= min_hz)
+            return min_hz;
+        return index.Ceil(next_freq);
+    }
+
+    // Schedutil: https://github.com/torvalds/linux/blob/master/kernel/sched/cpufreq_schedutil.c
+    // C = 1.25, tipping-point 80.0% (used in Linux schedutil), 1.25 -> 1 + (1 >> 2)
+    // C = 1.5,  tipping-point 66.7%, 1.5 -> 1 + (1 >> 1)
+    // Utilization is frequency-invariant :
+    //   target_freq = C * max_freq * util / max
+    // Approximate the would-be frequency-invariant utilization (normalized) :
+    //   target_freq = C * curr_freq * util_raw / max
+    // Headroom over the target in permille, C = 1 + headroom / 1000
+    constexpr uint32_t HEADROOM_DEFAULT = 500;
+
+    inline uint32_t TargetHz(uint32_t max_hz, uint32_t normUtil, uint32_t headroom = HEADROOM_DEFAULT) {
+        uint64_t next_freq = max_hz / UTIL_MAX * normUtil;
+        next_freq += next_freq * headroom / 1000;
+        return next_freq < UINT32_MAX ? next_freq : UINT32_MAX;
+    }
+
+    inline uint32_t SelectHz(const FreqIndex& index, uint32_t min_hz, uint32_t max_hz, uint32_t normUtil,
+                             const EnergyModel* em = nullptr, uint32_t headroom = HEADROOM_DEFAULT) {
+        return RoundHz(index, min_hz, max_hz, TargetHz(max_hz, normUtil, headroom), em);
+    }
+
+    // Per-title governor parameters, 0 keeps the inherited value.
+    // Resolved as: built-in <- [governor] section <- title section
+    typedef struct Tuning {
+        uint32_t sample_rate;       // Hz
+        uint32_t headroom;          // permille
+        struct {
+            uint32_t half_life_ms;  // Util decay, 0: built-in per-sample decay
+            uint32_t min_mhz;
+            uint32_t max_mhz;
+        } modules[SysClkModule_EnumMax];
+
+        static constexpr uint32_t SAMPLE_RATE_MIN = 50;
+        static constexpr uint32_t SAMPLE_RATE_MAX = 1000;
+        static constexpr uint32_t HEADROOM_MAX    = 1000;
+        static constexpr uint32_t HALF_LIFE_MAX   = 1000;
+
+        uint32_t GetSampleRate() const  { return sample_rate ? sample_rate : SAMPLE_RATE; };
+        uint32_t GetHeadroom() const    { return headroom ? headroom : HEADROOM_DEFAULT; };
+        uint64_t GetTickNs() const      { return 1000'000'000 / GetSampleRate(); };
+
+        // Fields of other override this
+        void Merge(const Tuning& other) {
+            auto Pick = [](uint32_t& dst, uint32_t src) { if (src) dst = src; };
+            Pick(sample_rate, other.sample_rate);
+            Pick(headroom, other.headroom);
+            for (size_t i = 0; i < SysClkModule_EnumMax; i++) {
+                Pick(modules[i].half_life_ms, other.modules[i].half_life_ms);
+                Pick(modules[i].min_mhz, other.modules[i].min_mhz);
+                Pick(modules[i].max_mhz, other.modules[i].max_mhz);
+            }
+        }
+
+        bool operator==(const Tuning& other) const {
+            if (sample_rate != other.sample_rate || headroom != other.headroom)
+                return false;
+            for (size_t i = 0; i < SysClkModule_EnumMax; i++) {
+                if (modules[i].half_life_ms != other.modules[i].half_life_ms ||
+                    modules[i].min_mhz != other.modules[i].min_mhz ||
+                    modules[i].max_mhz != other.modules[i].max_mhz)
+                    return false;
+            }
+            return true;
+        }
+        bool operator!=(const Tuning& other) const { return !(*this == other); };
+    } Tuning;
+
+    // Exponential decay per sample, D = divident / DECAY_DIVISOR.
+    // Util_acc_max = UTIL_MAX / (1 - D)
+    typedef struct Decay {
+        static constexpr uint32_t DECAY_DIVISOR = 8192;
+
+        uint32_t divident;
+        uint32_t acc_max;
+
+        // D^n = 1/2, n = half_life * sample_rate
+        static Decay FromHalfLife(uint32_t half_life_ms, uint32_t sample_rate) {
+            double n = (double)half_life_ms * sample_rate / 1000;
+            uint32_t divident = n > 0 ? DECAY_DIVISOR * std::exp2(-1 / n) : 0;
+            divident = std::clamp<uint32_t>(divident, 1, DECAY_DIVISOR - 1);
+            return { divident, UTIL_MAX * DECAY_DIVISOR / (DECAY_DIVISOR - divident) };
+        }
+    } Decay;
+
+    // Hysteresis and rate limit for governor steps. Boost and stuck-core paths bypass it.
+    //   up/down threshold: target must be off the current clock by this much (permille)
+    //   min residency:     a step is held at least this long
+    //   max per second:    token bucket, refilled continuously, burst of one second
+    class TransitionLimiter {
+    public:
+        typedef enum {
+            Decision_Keep = 0,  // new step is the current one
+            Decision_Apply,
+            Decision_SuppressedThreshold,
+            Decision_SuppressedResidency,
+            Decision_SuppressedRate,
+        } Decision;
+
+        typedef struct {
+            uint32_t up_threshold;
+            uint32_t down_threshold;
+            uint32_t min_residency_ms;
+            uint32_t max_per_sec;       // 0: unlimited
+        } Params;
+
+        void SetParams(const Params& params) { m_params = params; };
+
+        // target_hz is the requested clock before rounding to new_hz within [min_hz, max_hz]
+        Decision Check(uint64_t now_ns, uint32_t curr_hz, uint32_t target_hz, uint32_t new_hz,
+                       uint32_t min_hz, uint32_t max_hz) {
+            if (new_hz == curr_hz) {
+                m_pending_since = 0;
+                return Decision_Keep;
+            }
+
+            // Limits moved past the current clock (cap lowered, ResetToStock) or the target is
+            // clamped: thresholds compare against a target the clamp never lets through
+            bool clamped = (new_hz == max_hz && target_hz > max_hz) || (new_hz == min_hz && target_hz < min_hz);
+            if (clamped || curr_hz < min_hz || curr_hz > max_hz)
+                return Decision_Apply;
+
+            Decision d = Decision_Apply;
+            if (new_hz > curr_hz && target_hz <= (uint64_t)curr_hz * (1000 + m_params.up_threshold) / 1000)
+                d = Decision_SuppressedThreshold;
+            else if (new_hz < curr_hz && target_hz >= (uint64_t)curr_hz * (1000 - m_params.down_threshold) / 1000)
+                d = Decision_SuppressedThreshold;
+            else if (now_ns - m_last_ns < (uint64_t)m_params.min_residency_ms * 1000'000)
+                d = Decision_SuppressedResidency;
+            else if (m_params.max_per_sec && Tokens(now_ns) < COST_NS(m_params.max_per_sec))
+                d = Decision_SuppressedRate;
+
+            if (d != Decision_Apply && !m_pending_since)
+                m_pending_since = now_ns;
+            return d;
+        }
+
+        // Returns how long the applied step had been pending, in ns
+        uint64_t OnApplied(uint64_t now_ns) {
+            if (m_params.max_per_sec)
+                m_tokens_ns = Tokens(now_ns) - COST_NS(m_params.max_per_sec);
+            m_tokens_at = m_last_ns = now_ns;
+
+            uint64_t delay = m_pending_since ? now_ns - m_pending_since : 0;
+            m_pending_since = 0;
+            return delay;
+        }
+
+    protected:
+        static constexpr uint64_t BUCKET_NS = 1000'000'000;
+        static constexpr uint64_t COST_NS(uint32_t per_sec) { return BUCKET_NS / per_sec; };
+
+        uint64_t Tokens(uint64_t now_ns) {
+            uint64_t tokens = m_tokens_ns + (now_ns - m_tokens_at);
+            return tokens < BUCKET_NS ? tokens : BUCKET_NS;
+        }
+
+        Params m_params = {};
+        uint64_t m_last_ns = 0;
+        uint64_t m_tokens_ns = BUCKET_NS;
+        uint64_t m_tokens_at = 0;
+        uint64_t m_pending_since = 0;
+    };
+
+    // PELT: https://github.com/torvalds/linux/blob/master/kernel/sched/pelt.c
+    // Util_acc_n = Util_0 + Util_1 * D + Util_2 * D^2 + ... + Util_n * D^n
+    // To approximate D (decay multiplier):
+    //   After 50 ms (if SAMPLE_RATE == 200, 10 samples)
+    //   UTIL_MAX * D^10 ≈ 1 (UTIL_MAX decayed to 1)
+    // D = 4129 / 8192
+    // Util_acc_max = Util_acc_inf = 2012
+    typedef struct PeltUtil {
+        uint32_t util_acc = 0;
+
+        static constexpr uint32_t DECAY_DIVIDENT = 4129;
+        static constexpr uint32_t DECAY_DIVISOR  = Decay::DECAY_DIVISOR;
+        static constexpr uint32_t UTIL_ACC_MAX   = 2012;
+
+        Decay decay = { DECAY_DIVIDENT, UTIL_ACC_MAX };
+
+        // 64-bit: acc_max reaches ~1.4M at the longest half-life and highest sample rate (Tuning)
+        uint32_t Get()              { return ((uint64_t)util_acc * UTIL_MAX / decay.acc_max); };
+        void Update(uint32_t util)  { util_acc = (uint64_t)util_acc * decay.divident / DECAY_DIVISOR + util; };
+
+        // Keeps current util across the change
+        void SetHalfLife(uint32_t half_life_ms, uint32_t sample_rate) {
+            Decay next = half_life_ms ? Decay::FromHalfLife(half_life_ms, sample_rate) : Decay{ DECAY_DIVIDENT, UTIL_ACC_MAX };
+            util_acc = (uint64_t)util_acc * next.acc_max / decay.acc_max;
+            decay = next;
+        };
+    } PeltUtil;
+
+    // Get average value from a sliding window in O(1)
+    template <typename T, size_t WINDOW_SIZE>
+    class SWindowAvg {
+    public:
+        SWindowAvg() {}
+
+        void Add(T item) {
+            T pop = m_queue[m_next];
+            m_queue[m_next] = item;
+            m_next = (m_next + 1) % WINDOW_SIZE;
+            m_sum -= pop;
+            m_sum += item;
+        }
+
+        T Get() { return m_sum / WINDOW_SIZE; }
+
+    protected:
+        size_t m_next = 0;
+        T m_sum = 0;
+        T m_queue[WINDOW_SIZE] = {};
+    };
+
+    // Get max value from a sliding window in O(1)
+    template <typename T, size_t WINDOW_SIZE>
+    class SWindowMax {
+    protected:
+        typedef struct {
+            T item;
+            T max;
+        } s_Entry;
+
+        struct s_Stack {
+            s_Entry m_stack[WINDOW_SIZE] = {};
+            size_t m_next = WINDOW_SIZE;
+
+            bool  empty() { return m_next == 0; };
+            s_Entry top() { return m_stack[m_next-1]; };
+            s_Entry pop() { return m_stack[--m_next]; };
+            void   push(s_Entry item) {
+                if (m_next == WINDOW_SIZE)
+                    return;
+                m_stack[m_next++] = item;
+            };
+        };
+
+        s_Stack enqStack;
+        s_Stack deqStack;
+
+        void Push(s_Stack& stack, T item) {
+            s_Entry n = {
+                .item = item,
+                .max  = enqStack.empty() ? item : std::max(item, enqStack.top().max)
+            };
+            stack.push(n);
+        }
+
+        T Pop() {
+            if (deqStack.empty()) {
+                while (!enqStack.empty())
+                    Push(deqStack, enqStack.pop().max);
+            }
+            return deqStack.pop().item;
+        }
+
+    public:
+        SWindowMax() {}
+
+        void Add(T item) { Pop(); Push(enqStack, item); }
+
+        T Get() {
+            if (!enqStack.empty()) {
+                T enqMax = enqStack.top().max;
+                if (!deqStack.empty()) {
+                    T deqMax = deqStack.top().max;
+                    return std::max(deqMax, enqMax);
+                }
+                return enqMax;
+            }
+            if (!deqStack.empty())
+                return deqStack.top().max;
+            return 0;
+        }
+    };
+
+    typedef struct MaxWindow {
+        SWindowMax<uint32_t, 32> window {};
+        uint32_t util_acc = 0;
+
+        //   After 160 ms (if SAMPLE_RATE == 200, 32 samples)
+        //   UTIL_MAX * D^32 ≈ 1 (UTIL_MAX decayed to 1)
+        // D = 6880 / 8192
+        // Util_acc_max = Util_acc_inf = 6145
+        static constexpr uint32_t DECAY_DIVIDENT = 6880;
+        static constexpr uint32_t DECAY_DIVISOR  = Decay::DECAY_DIVISOR;
+        static constexpr uint32_t UTIL_ACC_MAX   = 6145;
+
+        Decay decay = { DECAY_DIVIDENT, UTIL_ACC_MAX };
+
+        uint32_t Get()              { return ((uint64_t)util_acc * UTIL_MAX / decay.acc_max + window.Get()) / 2; };
+        void Update(uint32_t util)  { window.Add(util); util_acc = (uint64_t)util_acc * decay.divident / DECAY_DIVISOR + util; };
+
+        // Window length stays 32 samples, only the decaying half follows the half-life
+        void SetHalfLife(uint32_t half_life_ms, uint32_t sample_rate) {
+            Decay next = half_life_ms ? Decay::FromHalfLife(half_life_ms, sample_rate) : Decay{ DECAY_DIVIDENT, UTIL_ACC_MAX };
+            util_acc = (uint64_t)util_acc * next.acc_max / decay.acc_max;
+            decay = next;
+        };
+    } MaxWindow;
+
+    // Frame timing signal: intervals between frames presented by the game. Display vsync
+    // events do not qualify, they tick at the panel rate whatever the game renders.
+    class FrameTimingSource {
+    public:
+        virtual ~FrameTimingSource() {}
+
+        // Average frame interval since last call, 0 if unknown
+        virtual uint32_t GetFrameIntervalUs() = 0;
+    };
+
+    // Just enough clock to hold the nearest of 60 / 30 fps.
+    // GPU busy time per frame is util * interval; to fit in the target period
+    // at a new clock with headroom C:
+    //   target_freq = C * max_freq * util / max * interval / period
+    // Vsync-bound frames (interval == period) scale down by util alone, missed
+    // frames (interval > period) scale up. C = 1.25, 1 + (1 >> 2)
+    class FramePacer {
+    public:
+        static constexpr uint32_t PERIOD_60FPS_US = 1000'000 / 60;
+        static constexpr uint32_t PERIOD_30FPS_US = 1000'000 / 30;
+        static constexpr uint32_t PERIOD_45FPS_US = 1000'000 / 45;
+        static constexpr uint32_t INTERVAL_MAX_US = 100'000; // Below 10 fps: loading screens, menus
+
+        // Target frequency, or 0 to fall back to load based governor
+        uint32_t TargetHz(uint32_t interval_us, uint32_t normUtil, uint32_t max_hz) {
+            if (!interval_us || interval_us > INTERVAL_MAX_US) {
+                m_valid = 0;
+                return 0;
+            }
+
+            m_interval.Add(interval_us);
+            m_util.Add(normUtil);
+            // Wait for the window to fill up after fallback
+            if (m_valid < WINDOW_SIZE) {
+                m_valid++;
+                return 0;
+            }
+
+            uint32_t interval = m_interval.Get();
+            uint32_t period = interval < PERIOD_45FPS_US ? PERIOD_60FPS_US : PERIOD_30FPS_US;
+            // Within 5% of period is on target (vsync jitter)
+            if (interval <= period + period / 20)
+                interval = period;
+
+            uint64_t next_freq = (uint64_t)max_hz * m_util.Get() / UTIL_MAX * interval / period;
+            next_freq += next_freq >> 2;
+            return next_freq < max_hz ? next_freq : max_hz;
+        }
+
+    protected:
+        static constexpr size_t WINDOW_SIZE = 8; // 40 ms, longer than a frame at 30 fps
+        SWindowAvg<uint32_t, WINDOW_SIZE> m_interval;
+        SWindowAvg<uint32_t, WINDOW_SIZE> m_util;
+        size_t m_valid = 0;
+    };
+}
@@ -0,0 +1,77 @@
+/*
+ * --------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <p-sam@d3vs.net>, <natinusala@gmail.com>, <m4x@m4xw.net>
+ * wrote this file. As long as you retain this notice you can do whatever you
+ * want with this stuff. If you meet any of us some day, and you think this
+ * stuff is worth it, you can buy us a beer in return.  - The sys-clk authors
+ * --------------------------------------------------------------------------
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <sysclk/ipc.h>
+
+// IPC dispatch between the listener thread and the workers.
+// Platform independent, shared with the host benchmark in sysmodule/sim.
+namespace IpcDispatch {
+    // Answered on the listener: no lock shared with the clock manager or the config
+    // (context is a seqlock snapshot, tables only change on unsafe mode toggle)
+    inline bool IsInline(uint64_t cmdId) {
+        switch (cmdId) {
+            case SysClkIpcCmd_GetApiVersion:
+            case SysClkIpcCmd_GetVersionString:
+            case SysClkIpcCmd_GetCurrentContext:
+            case SysClkIpcCmd_GetFrequencyTable:
+            case SysClkIpcCmd_GetIsMariko:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    // Bounded FIFO of requests for the workers. Push never blocks: when full the listener
+    // handles the request itself. Mutex and Semaphore follow the std interfaces
+    // (LockableMutex and CountingSemaphore on console).
+    template <typename T, size_t SLOTS, typename Mutex, typename Semaphore>
+    class WorkQueue {
+    public:
+        bool Push(const T& item) {
+            {
+                std::scoped_lock lock{m_mutex};
+                if (m_count == SLOTS)
+                    return false;
+                m_items[(m_head + m_count++) % SLOTS] = item;
+            }
+            m_ready.release();
+            return true;
+        }
+
+        // Blocks until an item is available, false once stopped and drained
+        bool Pop(T& out) {
+            m_ready.acquire();
+            std::scoped_lock lock{m_mutex};
+            if (!m_count)
+                return false;
+            out = m_items[m_head];
+            m_head = (m_head + 1) % SLOTS;
+            m_count--;
+            return true;
+        }
+
+        // After the last Push: each of the workers returns from Pop once the queue is empty
+        void Stop(size_t workers) {
+            for (size_t i = 0; i < workers; i++)
+                m_ready.release();
+        }
+
+    protected:
+        Mutex m_mutex;
+        Semaphore m_ready{0};
+        T m_items[SLOTS];
+        size_t m_head = 0;
+        size_t m_count = 0;
+    };
+}
@@ -24,6 +24,11 @@ IpcService::IpcService()
     ASSERT_RESULT_OK(rc, "ipcServerInit");
     rc = threadCreate(&this->thread, &IpcService::ProcessThreadFunc, this, NULL, 0x2000, priority, -2);
     ASSERT_RESULT_OK(rc, "threadCreate");
+    for(Thread& worker : this->workers)
+    {
+        rc = threadCreate(&worker, &IpcService::WorkerThreadFunc, this, NULL, 0x2000, priority, -2);
+        ASSERT_RESULT_OK(rc, "threadCreate");
+    }
     this->running = false;
 }
 
@@ -39,13 +44,24 @@ void IpcService::SetRunning(bool running)
 
     if(running)
     {
+        for(Thread& worker : this->workers)
+        {
+            Result rc = threadStart(&worker);
+            ASSERT_RESULT_OK(rc, "threadStart");
+        }
         Result rc = threadStart(&this->thread);
         ASSERT_RESULT_OK(rc, "threadStart");
     }
     else
     {
+        // Listener first, workers reply to what is already queued
         svcCancelSynchronization(this->thread.handle);
         threadWaitForExit(&this->thread);
+        this->queue.Stop(IPC_WORKER_COUNT);
+        for(Thread& worker : this->workers)
+        {
+            threadWaitForExit(&worker);
+        }
     }
 }
 
@@ -54,6 +70,11 @@ IpcService::~IpcService()
     this->SetRunning(false);
     Result rc = threadClose(&this->thread);
     ASSERT_RESULT_OK(rc, "threadClose");
+    for(Thread& worker : this->workers)
+    {
+        rc = threadClose(&worker);
+        ASSERT_RESULT_OK(rc, "threadClose");
+    }
     rc = ipcServerExit(&this->server);
     ASSERT_RESULT_OK(rc, "ipcServerExit");
 }
@@ -64,7 +85,7 @@ void IpcService::ProcessThreadFunc(void *arg)
     IpcService* ipcSrv = (IpcService*)arg;
     while(true)
     {
-        rc = ipcServerProcess(&ipcSrv->server, &IpcService::ServiceHandlerFunc, arg);
+        rc = ipcServerProcessEx(&ipcSrv->server, &IpcService::ServiceHandlerFunc, &IpcService::DeferHandlerFunc, arg);
         if(R_FAILED(rc))
         {
             if(rc == KERNELRESULT(Cancelled))
@@ -79,6 +100,27 @@ void IpcService::ProcessThreadFunc(void *arg)
     }
 }
 
+void IpcService::WorkerThreadFunc(void *arg)
+{
+    IpcService* ipcSrv = (IpcService*)arg;
+    IpcServerDeferredRequest d;
+    while(ipcSrv->queue.Pop(d))
+    {
+        Result rc = ipcServerReply(&ipcSrv->server, &d, &IpcService::ServiceHandlerFunc, arg);
+        if(R_FAILED(rc) && rc != KERNELRESULT(ConnectionClosed))
+        {
+            FileUtils::LogLine("[ipc] ipcServerReply: [0x%x] %04d-%04d", rc, R_MODULE(rc), R_DESCRIPTION(rc));
+        }
+    }
+}
+
+bool IpcService::DeferHandlerFunc(void* arg, const IpcServerRequest* r, const IpcServerDeferredRequest* d)
+{
+    IpcService* ipcSrv = (IpcService*)arg;
+    // Queue full: answered inline, as before
+    return !IpcDispatch::IsInline(r->data.cmdId) && ipcSrv->queue.Push(*d);
+}
+
 Result IpcService::ServiceHandlerFunc(void* arg, const IpcServerRequest* r, u8* out_data, size_t* out_dataSize)
 {
     IpcService* ipcSrv = (IpcService*)arg;
@@ -180,6 +222,9 @@ Result IpcService::ServiceHandlerFunc(void* arg, const IpcServerRequest* r, u8*
                 return ipcSrv->SetBatteryChargingDisabledOverride(toggle_true);
             }
             break;
+        case SysClkIpcCmd_GetGovernorStats:
+            *out_dataSize = sizeof(SysClkGovernorStats);
+            return ipcSrv->GetGovernorStats((SysClkGovernorStats*)out_data);
     }
 
     return SYSCLK_ERROR(Generic);
@@ -254,7 +299,7 @@ Result IpcService::SetProfiles(SysClkIpc_SetProfiles_Args* args)
 
     SysClkTitleProfileList profiles = args->profiles;
 
-    if(!config->SetProfiles(args->tid, &profiles, true))
+    if(!config->SetProfiles(args->tid, &profiles))
     {
         return SYSCLK_ERROR(ConfigSaveFailed);
     }
@@ -309,7 +354,7 @@ Result IpcService::SetConfigValues(SysClkConfigValueList* configValues)
 
     SysClkConfigValueList configValuesCopy = *configValues;
 
-    if(!config->SetConfigValues(&configValuesCopy, true))
+    if(!config->SetConfigValues(&configValuesCopy))
     {
         return SYSCLK_ERROR(ConfigSaveFailed);
     }
@@ -341,3 +386,7 @@ Result IpcService::SetBatteryChargingDisabledOverride(bool toggle_true) {
     return ClockManager::GetInstance()->SetBatteryChargingDisabledOverride(toggle_true);
 }
 
+Result IpcService::GetGovernorStats(SysClkGovernorStats* out_stats) {
+    *out_stats = ClockManager::GetInstance()->GetGovernorStats();
+    return 0;
+}
@@ -13,6 +13,12 @@
 #include <atomic>
 #include <nxExt.h>
 #include <sysclk.h>
+#include "ipc_dispatch.h"
+
+// Requests that could wait on the config or clock manager locks are handed to workers,
+// so queries from other clients are still answered meanwhile
+#define IPC_WORKER_COUNT 2
+#define IPC_QUEUE_SLOTS  8
 
 class IpcService
 {
@@ -23,7 +29,9 @@ class IpcService
 
   protected:
     static void ProcessThreadFunc(void *arg);
+    static void WorkerThreadFunc(void *arg);
     static Result ServiceHandlerFunc(void* arg, const IpcServerRequest* r, std::uint8_t* out_data, size_t* out_dataSize);
+    static bool DeferHandlerFunc(void* arg, const IpcServerRequest* r, const IpcServerDeferredRequest* d);
 
     Result GetApiVersion(u32* out_version);
     Result GetVersionString(char* out_buf, size_t bufSize);
@@ -41,9 +49,12 @@ class IpcService
     Result GetIsMariko(bool* out_is_mariko);
     Result GetBatteryChargingDisabledOverride(bool* out_is_true);
     Result SetBatteryChargingDisabledOverride(bool toggle_true);
+    Result GetGovernorStats(SysClkGovernorStats* out_stats);
 
     bool running;
     Thread thread;
+    Thread workers[IPC_WORKER_COUNT];
     LockableMutex threadMutex;
     IpcServer server;
+    IpcDispatch::WorkQueue<IpcServerDeferredRequest, IPC_QUEUE_SLOTS, LockableMutex, CountingSemaphore> queue;
 };
@@ -0,0 +1,29 @@
+/*
+ * --------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <p-sam@d3vs.net>, <natinusala@gmail.com>, <m4x@m4xw.net>
+ * wrote this file. As long as you retain this notice you can do whatever you
+ * want with this stuff. If you meet any of us some day, and you think this
+ * stuff is worth it, you can buy us a beer in return.  - The sys-clk authors
+ * --------------------------------------------------------------------------
+ */
+
+#include "kip.h"
+#include <memory>
+
+bool Kip::ReadHeader(FILE* fp, size_t filesize, KipHeader* out, const char* name)
+{
+    if (filesize < sizeof(KipHeader) || fseek(fp, 0, SEEK_SET))
+        return false;
+    if (fread(out, sizeof(KipHeader), 1, fp) != 1)
+        return false;
+    return KipCore::ValidateHeader(*out, filesize, name);
+}
+
+long Kip::FindMagic(FILE* fp, const KipHeader& header, const u8 (&magic)[4])
+{
+    std::unique_ptr<u8[]> chunk(new u8[KipCore::CHUNK_SIZE]);
+    return KipCore::FindMagic(header, magic, chunk.get(), [fp](size_t offset, u8* dst, size_t size) {
+        return !fseek(fp, offset, SEEK_SET) && fread(dst, size, 1, fp) == 1;
+    });
+}
@@ -0,0 +1,25 @@
+/*
+ * --------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <p-sam@d3vs.net>, <natinusala@gmail.com>, <m4x@m4xw.net>
+ * wrote this file. As long as you retain this notice you can do whatever you
+ * want with this stuff. If you meet any of us some day, and you think this
+ * stuff is worth it, you can buy us a beer in return.  - The sys-clk authors
+ * --------------------------------------------------------------------------
+ */
+
+#pragma once
+#include <switch.h>
+#include <cstdio>
+#include <cstddef>
+#include "kip_core.h"
+
+class Kip
+{
+  public:
+    // Reads and validates the KIP1 header, name is compared when given
+    static bool ReadHeader(FILE* fp, size_t filesize, KipHeader* out, const char* name = nullptr);
+
+    // File offset of magic in the uncompressed segments of the KIP, -1 if not found (KipCore::FindMagic)
+    static long FindMagic(FILE* fp, const KipHeader& header, const u8 (&magic)[4]);
+};
@@ -0,0 +1,143 @@
+/*
+ * --------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <p-sam@d3vs.net>, <natinusala@gmail.com>, <m4x@m4xw.net>
+ * wrote this file. As long as you retain this notice you can do whatever you
+ * want with this stuff. If you meet any of us some day, and you think this
+ * stuff is worth it, you can buy us a beer in return.  - The sys-clk authors
+ * --------------------------------------------------------------------------
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+typedef struct KipSegment {
+    uint32_t address;
+    uint32_t size;
+    uint32_t compressed_size;
+    uint32_t attribute;     // affinity_mask / stack_size / unused
+} KipSegment;
+
+typedef struct KipHeader {
+    uint8_t  magic[4];
+    char     name[12];
+    uint64_t program_id;
+    uint32_t version;
+    uint8_t  priority;
+    uint8_t  ideal_core;
+    uint8_t  reserved_1e;
+    uint8_t  flags;         // Bit 0..2: text / rodata / data compressed
+    KipSegment segments[4]; // text, rodata, data, bss
+    uint8_t  reserved_60[0x20];
+    uint32_t capabilities[0x20];
+} KipHeader;
+static_assert(sizeof(KipHeader) == 0x100);
+
+// KIP1 layout and magic search. Platform independent, shared with the host test in sysmodule/sim.
+// File access goes through a read(offset, dst, size) -> bool callback.
+namespace KipCore {
+    enum Segment {
+        Segment_Text = 0,
+        Segment_Rodata,
+        Segment_Data,
+        Segment_Count,
+    };
+
+    constexpr uint32_t SEGMENT_SIZE_MAX = 512 * 1024;
+
+    // Tables searched for are u32 arrays, so only 4-aligned offsets (from the segment start,
+    // i.e. the load address) are candidates. Also skips matches inside strings and code.
+    constexpr size_t MAGIC_ALIGN = 4;
+
+    // Segments are read in chunks of this size. Chunks start 4-aligned within the segment,
+    // so an aligned match never straddles two of them.
+    constexpr size_t CHUNK_SIZE = 4 * 1024;
+    static_assert(CHUNK_SIZE % MAGIC_ALIGN == 0);
+
+    // Validates magic, name (when given) and segment sizes against the file size
+    inline bool ValidateHeader(const KipHeader& header, size_t filesize, const char* name = nullptr) {
+        constexpr uint8_t KIP_MAGIC[] = {'K', 'I', 'P', '1'};
+
+        if (filesize < sizeof(KipHeader) || memcmp(header.magic, KIP_MAGIC, sizeof(KIP_MAGIC)))
+            return false;
+        if (name && strncmp(header.name, name, sizeof(header.name)))
+            return false;
+
+        size_t end = sizeof(KipHeader);
+        for (int i = 0; i < Segment_Count; i++) {
+            if (header.segments[i].compressed_size > SEGMENT_SIZE_MAX)
+                return false;
+            end += header.segments[i].compressed_size;
+        }
+        return end <= filesize;
+    }
+
+    // Segments are stored back to back after the header
+    inline size_t SegmentOffset(const KipHeader& header, int segment) {
+        size_t offset = sizeof(KipHeader);
+        for (int i = 0; i < segment; i++)
+            offset += header.segments[i].compressed_size;
+        return offset;
+    }
+
+    // First 4-aligned occurrence of magic in buf, nullptr if none. buf is expected to be 4-aligned
+    // relative to the segment start, the tail past the last aligned word is ignored.
+    inline const uint8_t* Search(const uint8_t* buf, size_t size, const uint8_t (&magic)[4]) {
+        static_assert(sizeof(magic) == MAGIC_ALIGN);
+        uint32_t word;
+        memcpy(&word, magic, sizeof(word));
+
+        const uint8_t* p = buf;
+        const uint8_t* const end = buf + size;
+
+#if defined(__ARM_NEON)
+        // 4 aligned candidates per iteration
+        const uint32x4_t m = vdupq_n_u32(word);
+        for (; p + 16 <= end; p += 16) {
+            uint32x4_t hit = vceqq_u32(vreinterpretq_u32_u8(vld1q_u8(p)), m);
+            if (!vmaxvq_u32(hit))
+                continue;
+            for (int i = 0; i < 16; i += MAGIC_ALIGN) {
+                if (!memcmp(p + i, magic, sizeof(magic)))
+                    return p + i;
+            }
+        }
+#endif
+
+        for (; p + sizeof(magic) <= end; p += MAGIC_ALIGN) {
+            uint32_t candidate;
+            memcpy(&candidate, p, sizeof(candidate));
+            if (candidate == word)
+                return p;
+        }
+        return nullptr;
+    }
+
+    // File offset of magic in the uncompressed segments of the KIP, -1 if not found or on read error.
+    // .data is searched first, as that is where initialized tables like CustTable live.
+    // chunk must hold CHUNK_SIZE bytes.
+    template <typename ReadFn>
+    long FindMagic(const KipHeader& header, const uint8_t (&magic)[4], uint8_t* chunk, ReadFn read) {
+        for (int i : { Segment_Data, Segment_Rodata }) {
+            const bool compressed = header.flags & (1 << i);
+            const size_t size = header.segments[i].compressed_size;
+            if (compressed || !size)
+                continue;
+
+            const size_t base = SegmentOffset(header, i);
+            for (size_t pos = 0; pos < size; pos += CHUNK_SIZE) {
+                const size_t len = size - pos < CHUNK_SIZE ? size - pos : CHUNK_SIZE;
+                if (!read(base + pos, chunk, len))
+                    return -1;
+                if (const uint8_t* p = Search(chunk, len, magic))
+                    return base + pos + (p - chunk);
+            }
+        }
+        return -1;
+    }
+}
@@ -0,0 +1,91 @@
+/*
+ * --------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <p-sam@d3vs.net>, <natinusala@gmail.com>, <m4x@m4xw.net>
+ * wrote this file. As long as you retain this notice you can do whatever you
+ * want with this stuff. If you meet any of us some day, and you think this
+ * stuff is worth it, you can buy us a beer in return.  - The sys-clk authors
+ * --------------------------------------------------------------------------
+ */
+
+#pragma once
+#include <atomic>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+// Bounded lock-free log queue: many producers, one consumer (Vyukov's bounded queue).
+// Producers format straight into a claimed slot and never wait: when the queue is full
+// the line is dropped and counted. Memory footprint is SLOTS * (TEXT_MAX + 16) bytes.
+// Platform independent, shared with the host benchmark in sysmodule/sim.
+template <size_t SLOTS, size_t TEXT_MAX>
+class LogQueue {
+    static_assert((SLOTS & (SLOTS - 1)) == 0, "SLOTS must be a power of 2");
+
+public:
+    LogQueue() {
+        for (size_t i = 0; i < SLOTS; i++)
+            m_slots[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    // Lines longer than TEXT_MAX - 1 are truncated
+    bool Push(uint64_t timestamp_ms, const char* format, va_list args) {
+        size_t pos = m_enqueue.load(std::memory_order_relaxed);
+        Slot* slot;
+        for (;;) {
+            slot = &m_slots[pos & (SLOTS - 1)];
+            size_t seq = slot->seq.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+            if (diff == 0) {
+                if (m_enqueue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            } else if (diff < 0) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else {
+                pos = m_enqueue.load(std::memory_order_relaxed);
+            }
+        }
+
+        int len = vsnprintf(slot->text, TEXT_MAX, format, args);
+        slot->len = len < 0 ? 0 : (len < (int)TEXT_MAX ? len : TEXT_MAX - 1);
+        slot->timestamp_ms = timestamp_ms;
+        slot->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Single consumer, calls fn(timestamp_ms, text, len) for the oldest line if any
+    template <typename F>
+    bool Pop(F fn) {
+        size_t pos = m_dequeue.load(std::memory_order_relaxed);
+        Slot* slot = &m_slots[pos & (SLOTS - 1)];
+        if (slot->seq.load(std::memory_order_acquire) != pos + 1)
+            return false;
+
+        fn(slot->timestamp_ms, (const char*)slot->text, (size_t)slot->len);
+        slot->seq.store(pos + SLOTS, std::memory_order_release);
+        m_dequeue.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Approximate, used by producers to decide when to wake the consumer
+    size_t Size() const { return m_enqueue.load(std::memory_order_relaxed) - m_dequeue.load(std::memory_order_relaxed); }
+
+    // Dropped lines since last call
+    size_t TakeDropped() { return m_dropped.exchange(0, std::memory_order_relaxed); }
+    static constexpr size_t Capacity() { return SLOTS; }
+
+protected:
+    typedef struct {
+        std::atomic<size_t> seq;
+        uint64_t timestamp_ms;
+        uint32_t len;
+        char text[TEXT_MAX];
+    } Slot;
+
+    Slot m_slots[SLOTS];
+    std::atomic<size_t> m_enqueue = 0;
+    std::atomic<size_t> m_dequeue = 0; // Written by the consumer only
+    std::atomic<size_t> m_dropped = 0;
+};
@@ -10,21 +10,19 @@ uint32_t CpuCoreUtil::Get() {
     } begin, end;
 
     begin.systick  = armGetSystemTick();
-    begin.idletick = GetIdleTickCount();
+    begin.idletick = GetIdleTickCount(m_core_id);
 
     svcSleepThread(m_wait_time_ns);
 
     end.systick = armGetSystemTick();
-    end.idletick = GetIdleTickCount();
+    end.idletick = GetIdleTickCount(m_core_id);
 
-    uint64_t diff_idletick = end.idletick - begin.idletick;
-    uint64_t diff_systick  = end.systick - begin.systick;
-    return UTIL_MAX - diff_idletick * 10 * 100ULL / diff_systick;
+    return GovernorCore::UtilFromTicks(end.idletick - begin.idletick, end.systick - begin.systick);
 }
 
-uint64_t CpuCoreUtil::GetIdleTickCount() {
+uint64_t CpuCoreUtil::GetIdleTickCount(int coreid) {
     uint64_t idletick = 0;
-    svcGetInfo(&idletick, InfoType_IdleTickCount, INVALID_HANDLE, m_core_id);
+    svcGetInfo(&idletick, InfoType_IdleTickCount, INVALID_HANDLE, coreid);
     return idletick;
 }
 
@@ -115,14 +113,14 @@ void PsmExt::ChargingHandler(ClockManager* instance) {
             I2c_Bq24193_SetFastChargeCurrentLimit(chargingCurrent);
     }
 
-    PsmChargeInfo* info = new PsmChargeInfo;
+    PsmChargeInfo info = {};
     Service* session = psmGetServiceSession();
-    serviceDispatchOut(session, Psm_GetBatteryChargeInfoFields, *info);
+    serviceDispatchOut(session, Psm_GetBatteryChargeInfoFields, info);
 
-    if (PsmIsChargerConnected(info)) {
+    if (PsmIsChargerConnected(&info)) {
         u32 chargeNow = 0;
         if (R_SUCCEEDED(psmGetBatteryChargePercentage(&chargeNow))) {
-            bool isCharging = PsmIsCharging(info);
+            bool isCharging = PsmIsCharging(&info);
             u32 chargingLimit = instance->GetConfig()->GetConfigValue(SysClkConfigValue_ChargingLimitPercentage);
             bool forceDisabled = instance->GetBatteryChargingDisabledOverride();
             if (isCharging && (forceDisabled || chargingLimit <= chargeNow))
@@ -131,45 +129,46 @@ void PsmExt::ChargingHandler(ClockManager* instance) {
                 serviceDispatch(session, Psm_EnableBatteryCharging);
         }
     }
-
-    delete info;
 }
 
 namespace GovernorImpl {
 
-// Schedutil: https://github.com/torvalds/linux/blob/master/kernel/sched/cpufreq_schedutil.c
-// C = 1.25, tipping-point 80.0% (used in Linux schedutil), 1.25 -> 1 + (1 >> 2)
-// C = 1.5,  tipping-point 66.7%, 1.5 -> 1 + (1 >> 1)
-// Utilization is frequency-invariant :
-//   target_freq = C * max_freq * util / max
-// Approximate the would-be frequency-invariant utilization (normalized) :
-//   target_freq = C * curr_freq * util_raw / max
 void BaseGovernor::ApplyNewFreqFromNormUtil(uint32_t normUtil) {
-    uint32_t curr_hz = m_target_hz;
+    ApplyNewFreqFromTargetHz(GovernorCore::TargetHz(max_hz, normUtil, m_headroom));
+}
 
-    auto FindHzInTable = [](uint32_t* list, uint32_t hz) -> uint32_t {
-        uint32_t* p = list;
-        for (; *p != 0; p++) {
-            if (hz <= *p)
-                return *p;
-        }
-        return *(--p);
-    };
-
-    //uint32_t next_freq = m_ref_hz / UTIL_MAX * normUtil;
-    uint32_t next_freq = max_hz / UTIL_MAX * normUtil;
-    next_freq += next_freq >> 1;
-
-    uint32_t new_hz;
-    if (next_freq >= max_hz)
-        new_hz = max_hz;
-    else if (next_freq <= min_hz)
-        new_hz = min_hz;
-    else
-        new_hz = FindHzInTable(m_hz_list, next_freq);
+void BaseGovernor::ApplyNewFreqFromTargetHz(uint32_t hz) {
+    GovernorCore::EnergyModel* em = m_energy_model.load(std::memory_order_relaxed);
+    if (em && m_observe_pending.exchange(false))
+        em->Observe(m_target_hz, Clocks::GetVoltageMv(m_module));
 
-    if (new_hz != curr_hz)
-        ApplyTargetFreq(new_hz);
+    uint32_t new_hz = GovernorCore::RoundHz(*m_freq_index, min_hz, max_hz, hz, em);
+    ApplyLimitedFreq(hz, new_hz);
+}
+
+void BaseGovernor::ApplyLimitedFreq(uint32_t target_hz, uint32_t new_hz) {
+    using Limiter = GovernorCore::TransitionLimiter;
+
+    uint64_t now = armTicksToNs(armGetSystemTick());
+    switch (m_limiter.Check(now, m_target_hz, target_hz, new_hz, min_hz, max_hz)) {
+        case Limiter::Decision_Keep:
+            return;
+        case Limiter::Decision_Apply:
+            m_stats.delayedMs += m_limiter.OnApplied(now) / 1000'000;
+            m_stats.applied++;
+            ApplyTargetFreq(new_hz);
+            break;
+        case Limiter::Decision_SuppressedThreshold:
+            m_stats.suppressedThreshold++;
+            break;
+        case Limiter::Decision_SuppressedResidency:
+            m_stats.suppressedResidency++;
+            break;
+        case Limiter::Decision_SuppressedRate:
+            m_stats.suppressedRate++;
+            break;
+    }
+    m_published_stats.Store(m_stats);
 }
 
 void CpuGovernor::GovernorWorker::Start() {
@@ -177,17 +176,26 @@ void CpuGovernor::GovernorWorker::Start() {
         return;
 
     this->running = true;
+    this->seq = 0;
+    this->snapshot = 0;
+
     Result rc = 0;
-    for (int id = 0; id < CORE_NUMS; id++) {
-        WorkerContext* s = &contexts[id];
-        s->super = this->super;
-        s->id    = id;
-        int prio = (id == CORE_NUMS - 1) ? 0x3F : 0x3B; // Pre-emptive MT
-        rc = threadCreate(&threads[id], &WorkerContext::Loop, (void*)s, NULL, 0x400, prio, id);
+    for (int id = 0; id < SYS_CORE_ID; id++) {
+        CoreReader* r = &readers[id];
+        r->super = this->super;
+        r->id    = id;
+        r->seq   = 0;
+        ueventCreate(&r->signal, true);
+        rc = threadCreate(&threads[id], &CoreReader::Loop, (void*)r, NULL, 0x400, 0x3B, id); // Pre-emptive MT
         ASSERT_RESULT_OK(rc, "threadCreate");
         rc = threadStart(&threads[id]);
         ASSERT_RESULT_OK(rc, "threadStart");
     }
+
+    rc = threadCreate(&sampler, &Sampler, (void*)this, NULL, 0x400, 0x3F, SYS_CORE_ID);
+    ASSERT_RESULT_OK(rc, "threadCreate");
+    rc = threadStart(&sampler);
+    ASSERT_RESULT_OK(rc, "threadStart");
 }
 
 void CpuGovernor::GovernorWorker::Stop() {
@@ -195,7 +203,11 @@ void CpuGovernor::GovernorWorker::Stop() {
         return;
 
     this->running = false;
-    svcSleepThread(TICK_TIME_NS);
+    threadWaitForExit(&sampler);
+    threadClose(&sampler);
+
+    for (auto &r : readers)
+        ueventSignal(&r.signal);
 
     for (auto &t : threads) {
         threadWaitForExit(&t);
@@ -204,60 +216,124 @@ void CpuGovernor::GovernorWorker::Stop() {
 }
 
 void CpuGovernor::Apply() {
-    uint32_t util = 0;
-    for (auto& ctx : this->m_worker.contexts) {
-        uint32_t core_util = ctx.util;
+    uint64_t snapshot = this->m_worker.snapshot.load(std::memory_order_acquire);
+
+    uint32_t util = 0, sys_util = 0;
+    for (int id = 0; id < CORE_NUMS; id++) {
+        uint32_t core_util = this->CalcNormalizedUtil(SnapshotUtil(snapshot, id));
         if (util < core_util)
             util = core_util;
+        if (id == SYS_CORE_ID)
+            sys_util = core_util;
     }
 
     this->m_util.Update(util);
-    if (this->auto_boost && this->m_worker.contexts[SYS_CORE_ID].util > BOOST_THRESHOLD)
+    this->m_last_util.store(this->m_util.Get(), std::memory_order_relaxed);
+    if (this->auto_boost && sys_util > BOOST_THRESHOLD)
         this->ApplyBoost();
     else
         this->ApplyNewFreqFromNormUtil(this->m_util.Get());
 }
 
-void CpuGovernor::WorkerContext::Loop(void* args) {
-    WorkerContext* s = static_cast<WorkerContext*>(args);
+void CpuGovernor::CoreReader::Loop(void* args) {
+    CoreReader* s = static_cast<CoreReader*>(args);
     CpuGovernor* self = s->super;
     GovernorWorker* worker = &(self->m_worker);
-    int coreid = s->id;
 
     while (worker->running) {
-        uint64_t tick = s->tick = armGetSystemTick();
-        s->util = self->CalcNormalizedUtil(CpuCoreUtil(coreid, TICK_TIME_NS).Get());
+        Result rc = waitSingle(waiterForUEvent(&s->signal), 10 * self->m_manager->GetTickNs());
+        if (!worker->running)
+            break;
 
-        if (apmExtIsCPUBoosted(self->m_manager->GetPerfConf())) {
-            svcSleepThread(TICK_TIME_NS);
+        // No signal for 10 ticks: sampler is stuck on system core
+        if (R_VALUE(rc) == KERNELRESULT(TimedOut)) {
+            if (!apmExtIsCPUBoosted(self->m_manager->GetPerfConf()))
+                self->auto_boost ? self->ApplyBoost() : self->ApplyTargetFreq(self->max_hz);
             continue;
         }
 
-        // Check if other cores are stuck
-        for (int id = 0; id < CORE_NUMS; id++) {
-            if (id == coreid)
-                continue;
+        s->idletick.store(CpuCoreUtil::GetIdleTickCount(s->id), std::memory_order_relaxed);
+        s->seq.store(worker->seq.load(std::memory_order_relaxed), std::memory_order_release);
+    }
+}
 
-            uint64_t diff = std::abs((int64_t)worker->contexts[id].tick - (int64_t)tick);
-            if (diff < SYSTICK_HZ / SAMPLE_RATE * 10)
-                continue;
+// Sample all cores from a single timestamp on system core. Readers answer the signal
+// within the tick, so the interval ending at the previous signal is evaluated each tick.
+void CpuGovernor::GovernorWorker::Sampler(void* args) {
+    GovernorWorker* worker = static_cast<GovernorWorker*>(args);
+    CpuGovernor* self = worker->super;
 
-            // Stuck on system core and auto boost enabled, apply boost
-            if (id == SYS_CORE_ID && self->auto_boost) {
-                self->ApplyBoost();
-                break;
+    typedef struct {
+        uint64_t systick;
+        uint64_t idletick[CORE_NUMS];
+    } Sample;
+
+    Sample prev = {}, pending = {};
+    bool has_prev = false;
+    uint32_t missed[CORE_NUMS] = {};
+
+    while (worker->running) {
+        uint32_t seq = worker->seq.load(std::memory_order_relaxed);
+        if (seq) {
+            Sample curr = pending;
+            for (int id = 0; id < SYS_CORE_ID; id++) {
+                CoreReader* r = &worker->readers[id];
+                if (r->seq.load(std::memory_order_acquire) == seq) {
+                    curr.idletick[id] = r->idletick.load(std::memory_order_relaxed);
+                    missed[id] = 0;
+                } else {
+                    // Reader could not run, consider the core fully busy
+                    curr.idletick[id] = prev.idletick[id];
+                    missed[id]++;
+                }
             }
 
-            // Stuck on other cores or auto boost disabled, apply max hz
-            self->ApplyTargetFreq(self->max_hz);
-            break;
+            if (has_prev) {
+                uint64_t snapshot = 0;
+                for (int id = 0; id < CORE_NUMS; id++) {
+                    uint32_t util = GovernorCore::UtilFromTicks(curr.idletick[id] - prev.idletick[id], curr.systick - prev.systick);
+                    snapshot |= (uint64_t)util << (16 * id);
+                }
+                worker->snapshot.store(snapshot, std::memory_order_release);
+            }
+            prev = curr;
+            has_prev = true;
+
+            // Stuck on other cores, apply max hz
+            if (!apmExtIsCPUBoosted(self->m_manager->GetPerfConf())) {
+                for (int id = 0; id < SYS_CORE_ID; id++) {
+                    if (missed[id] >= 10) {
+                        self->ApplyTargetFreq(self->max_hz);
+                        break;
+                    }
+                }
+            }
         }
+
+        pending.systick = armGetSystemTick();
+        pending.idletick[SYS_CORE_ID] = CpuCoreUtil::GetIdleTickCount(SYS_CORE_ID);
+        worker->seq.store(seq + 1, std::memory_order_relaxed);
+        for (auto& r : worker->readers)
+            ueventSignal(&r.signal);
+
+        svcSleepThread(self->m_manager->GetTickNs());
     }
 }
 
 void GpuGovernor::Apply() {
     uint32_t util = this->CalcNormalizedUtil(GpuCoreUtil(m_nvgpu_field).Get());
     this->m_util.Update(util);
+    this->m_last_util.store(this->m_util.Get(), std::memory_order_relaxed);
+
+    GovernorCore::FrameTimingSource* source = this->m_frame_source;
+    if (source) {
+        uint32_t hz = this->m_pacer.TargetHz(source->GetFrameIntervalUs(), util, this->max_hz);
+        if (hz) {
+            this->ApplyNewFreqFromTargetHz(hz);
+            return;
+        }
+    }
+
     this->ApplyNewFreqFromNormUtil(this->m_util.Get());
 }
 
@@ -272,6 +348,70 @@ void Governor::SetConfig(SysClkOcGovernorConfig config) {
     m_manager.onConfigUpdated(config);
 };
 
+SysClkGovernorStats Governor::GetStats() {
+    SysClkGovernorStats stats = {};
+    stats.modules[SysClkModule_CPU] = m_cpu_gov->GetStats();
+    stats.modules[SysClkModule_GPU] = m_gpu_gov->GetStats();
+    return stats;
+}
+
+bool Governor::SetTuning(const GovernorCore::Tuning& tuning) {
+    if (tuning == m_tuning)
+        return false;
+
+    m_tuning = tuning;
+    m_tick_ns = tuning.GetTickNs();
+    {
+        std::scoped_lock lock{m_tuning_mutex};
+        m_pending_tuning = tuning;
+    }
+    m_tuning_dirty = true;
+    return true;
+}
+
+// Util trackers are owned by the governor thread, no restart needed
+void Governor::ApplyTuning() {
+    GovernorCore::Tuning tuning;
+    {
+        std::scoped_lock lock{m_tuning_mutex};
+        tuning = m_pending_tuning;
+    }
+
+    uint32_t rate = tuning.GetSampleRate();
+    m_cpu_gov->SetHalfLife(tuning.modules[SysClkModule_CPU].half_life_ms, rate);
+    m_gpu_gov->SetHalfLife(tuning.modules[SysClkModule_GPU].half_life_ms, rate);
+    m_cpu_gov->SetHeadroom(tuning.GetHeadroom());
+    m_gpu_gov->SetHeadroom(tuning.GetHeadroom());
+}
+
+uint32_t Governor::TuneMaxHz(SysClkModule module, uint32_t hz) {
+    uint32_t mhz = m_tuning.modules[module].max_mhz;
+    if (!mhz)
+        return hz;
+    return std::min(hz, Clocks::freqRange[module].index.Floor(mhz * 1000'000));
+}
+
+uint32_t Governor::TuneMinHz(SysClkModule module, uint32_t hz) {
+    uint32_t mhz = m_tuning.modules[module].min_mhz;
+    if (!mhz)
+        return hz;
+    return std::max(hz, Clocks::freqRange[module].index.Ceil(mhz * 1000'000));
+}
+
+uint32_t Governor::GetUtil(SysClkModule module) {
+    if (!IsHandledByGovernor(module))
+        return 0;
+
+    switch (module) {
+        case SysClkModule_CPU:
+            return m_cpu_gov->GetUtil();
+        case SysClkModule_GPU:
+            return m_gpu_gov->GetUtil();
+        default:
+            return 0;
+    }
+}
+
 void Governor::SetPerfConf(uint32_t id) {
     m_perf_conf_id = id;
     m_apm_conf = Clocks::GetEmbeddedApmConfig(id);
@@ -281,13 +421,16 @@ void Governor::SetMaxHz(uint32_t maxHz, SysClkModule module) {
     if (!maxHz) // Fallback to apm configuration
         maxHz = Clocks::GetStockClock(m_apm_conf, (SysClkModule)module);
 
+    maxHz = TuneMaxHz(module, maxHz);
+
     switch (module) {
         case SysClkModule_CPU:
             m_cpu_gov->max_hz = maxHz;
+            m_cpu_gov->min_hz = std::min(m_cpu_gov->min_hz, maxHz);
             break;
         case SysClkModule_GPU:
             m_gpu_gov->max_hz = maxHz;
-            m_gpu_gov->min_hz = (maxHz <= 153'600'000) ? maxHz : 153'600'000;
+            m_gpu_gov->min_hz = std::min(TuneMinHz(module, 153'600'000), maxHz);
             break;
         default:
             break;
@@ -296,7 +439,7 @@ void Governor::SetMaxHz(uint32_t maxHz, SysClkModule module) {
 
 void Governor::SetMinHz(uint32_t minHz, SysClkModule module) {
     if (module == SysClkModule_CPU) {
-        m_cpu_gov->min_hz = minHz;
+        m_cpu_gov->min_hz = TuneMinHz(module, minHz);
     }
 }
 
@@ -324,21 +467,27 @@ void Governor::GovernorManager::Stop() {
 void Governor::GovernorManager::ContextManager(void* args) {
     Governor* self = static_cast<Governor*>(args);
 
-    constexpr uint64_t UPDATE_CONTEXT_RATE = SAMPLE_RATE / 2;
-    uint64_t update_ticks = UPDATE_CONTEXT_RATE;
+    constexpr uint64_t UPDATE_CONTEXT_NS = 500'000'000;
+    uint64_t update_ticks = UPDATE_CONTEXT_NS / self->GetTickNs();
     bool cpuBoosted = false, gpuThrottled = false;
 
     while (self->m_manager.running) {
-        bool shouldUpdateContext = ++update_ticks >= UPDATE_CONTEXT_RATE;
+        if (self->m_tuning_dirty.exchange(false))
+            self->ApplyTuning();
+
+        uint64_t tick_ns = self->GetTickNs();
+        bool shouldUpdateContext = ++update_ticks >= UPDATE_CONTEXT_NS / tick_ns;
         if (shouldUpdateContext) {
             update_ticks = 0;
 
             uint32_t hz = self->m_gpu_gov->RefreshContext();
             // Sleep mode detected, wait 10 ticks
             while (!hz) {
-                svcSleepThread(10 * TICK_TIME_NS);
+                svcSleepThread(10 * tick_ns);
                 hz = self->m_gpu_gov->RefreshContext();
             }
+            // Clocks may have been set behind the governor (ResetToStock, Tick)
+            self->m_cpu_gov->RefreshContext();
 
             uint32_t perf_conf = self->GetPerfConf();
             if ((gpuThrottled = apmExtIsBoostMode(perf_conf)) && self->IsHandledByGovernor(SysClkModule_GPU))
@@ -353,6 +502,6 @@ void Governor::GovernorManager::ContextManager(void* args) {
         if (!cpuBoosted && self->IsHandledByGovernor(SysClkModule_CPU))
             self->m_cpu_gov->Apply();
 
-        svcSleepThread(TICK_TIME_NS);
+        svcSleepThread(tick_ns);
     }
 };
@@ -9,6 +9,8 @@
 #include "errors.h"
 #include "file_utils.h"
 #include "clocks.h"
+#include "seqlock.h"
+#include "governor_core.h"
 
 // Forward declaration
 class ClockManager;
@@ -21,13 +23,14 @@ public:
     CpuCoreUtil (int coreid, uint64_t ns);
     uint32_t Get();
 
+    // Kernel only reports the idle ticks of the calling core (or -1 for current core)
+    static uint64_t GetIdleTickCount(int coreid);
+
 protected:
     const int m_core_id;
     const uint64_t m_wait_time_ns;
     static constexpr uint64_t IDLETICKS_PER_MS = 192;
     static constexpr uint32_t UTIL_MAX = 100'0;
-
-    uint64_t GetIdleTickCount();
 };
 
 
@@ -71,43 +74,62 @@ namespace PsmExt {
 }
 
 
-constexpr uint64_t SAMPLE_RATE = 200;
-constexpr uint64_t TICK_TIME_NS = 1000'000'000 / SAMPLE_RATE;
-constexpr uint64_t SYSTICK_HZ = 19200000;
-
 namespace GovernorImpl {
-    constexpr uint32_t UTIL_MAX = 1000;
+    using GovernorCore::UTIL_MAX;
 
     class BaseGovernor {
     public:
         BaseGovernor(SysClkModule module) : m_module(module) {
-            m_hz_list = Clocks::freqTable[module].freq;
+            m_freq_index = &Clocks::freqRange[module].index;
             m_ref_hz  = *Clocks::freqRange[module].last;
         };
 
-        uint32_t RefreshContext() { return this->m_target_hz = Clocks::GetCurrentHz(this->m_module); };
+        uint32_t RefreshContext() {
+            m_observe_pending = true;
+            return this->m_target_hz = Clocks::GetCurrentHz(this->m_module);
+        };
+
+        void SetTransitionParams(const GovernorCore::TransitionLimiter::Params& params) { m_limiter.SetParams(params); };
+        SysClkGovernorModuleStats GetStats() { return m_published_stats.Load(); };
+        void SetHeadroom(uint32_t headroom) { m_headroom = headroom; };
+        uint32_t GetUtil() { return m_last_util.load(std::memory_order_relaxed); };
+
+        // Rounds to the most efficient step when enabled. Voltages are learned from the rail,
+        // read once on the sample after each transition.
+        void SetEnergyModel(bool enabled) { m_energy_model = enabled ? &Clocks::energyModel[m_module] : nullptr; };
 
         uint32_t min_hz, max_hz, boost_hz;
 
     protected:
         uint32_t CalcNormalizedUtil(uint32_t rawUtil) {
-            //return ((uint64_t)rawUtil * m_target_hz / m_ref_hz);
-            return ((uint64_t)rawUtil * m_target_hz / max_hz);
+            return GovernorCore::NormalizeUtil(rawUtil, m_target_hz.load(std::memory_order_relaxed), max_hz);
         };
 
         void ApplyNewFreqFromNormUtil(uint32_t norm);
+        void ApplyNewFreqFromTargetHz(uint32_t hz);
+        void ApplyLimitedFreq(uint32_t target_hz, uint32_t new_hz);
 
         void ApplyTargetFreq(uint32_t hz) {
             if (!hz)
                 return;
 
-            m_target_hz = hz;
+            if (m_target_hz.exchange(hz, std::memory_order_relaxed) != hz)
+                m_observe_pending = true;
             Clocks::SetHz(m_module, hz);
         };
 
         SysClkModule m_module;
-        uint32_t* m_hz_list;
-        uint32_t m_target_hz, m_ref_hz;
+        const GovernorCore::FreqIndex* m_freq_index;
+        uint32_t m_ref_hz;
+        std::atomic<uint32_t> m_target_hz = 0; // Also set by the stuck-core paths of the CPU sampler and readers
+        uint32_t m_headroom = GovernorCore::HEADROOM_DEFAULT;
+        std::atomic<uint32_t> m_last_util = 0; // For telemetry
+        std::atomic<GovernorCore::EnergyModel*> m_energy_model = nullptr;
+        std::atomic_bool m_observe_pending = false;
+
+        GovernorCore::TransitionLimiter m_limiter;
+        SysClkGovernorModuleStats m_stats = {};     // Governor thread only
+        SeqLock<SysClkGovernorModuleStats> m_published_stats;
 
         friend Governor;
     };
@@ -128,49 +150,47 @@ namespace GovernorImpl {
             ApplyTargetFreq((max_hz > boost_hz) ? max_hz : boost_hz);
         };
 
+        void SetHalfLife(uint32_t half_life_ms, uint32_t sample_rate) { m_util.SetHalfLife(half_life_ms, sample_rate); };
+
         bool auto_boost;
 
     protected:
         static constexpr int CORE_NUMS = 4;
         static constexpr int SYS_CORE_ID = CORE_NUMS - 1;
 
-        // PELT: https://github.com/torvalds/linux/blob/master/kernel/sched/pelt.c
-        // Util_acc_n = Util_0 + Util_1 * D + Util_2 * D^2 + ... + Util_n * D^n
-        // To approximate D (decay multiplier):
-        //   After 50 ms (if SAMPLE_RATE == 200, 10 samples)
-        //   UTIL_MAX * D^10 ≈ 1 (UTIL_MAX decayed to 1)
-        // D = 4129 / 8192
-        // Util_acc_max = Util_acc_inf = 2012
-        typedef struct PeltUtil {
-            uint32_t util_acc = 0;
-
-            static constexpr uint32_t DECAY_DIVIDENT = 4129;
-            static constexpr uint32_t DECAY_DIVISOR  = 8192;
-            static constexpr uint32_t UTIL_ACC_MAX   = 2012;
-
-            uint32_t Get()              { return (util_acc * UTIL_MAX / UTIL_ACC_MAX); };
-            void Update(uint32_t util)  { util_acc = util_acc * DECAY_DIVIDENT / DECAY_DIVISOR + util; };
-        } PeltUtil;
+        typedef GovernorCore::PeltUtil PeltUtil;
         PeltUtil m_util;
 
-        typedef struct {
+        // Per-core raw util packed in 16-bit lanes, published by the sampler,
+        // normalized by Apply() on the governor thread
+        static uint32_t SnapshotUtil(uint64_t snapshot, int id) { return (snapshot >> (16 * id)) & 0xFFFF; };
+
+        // IdleTickCount can only be read on its own core, so application cores keep a
+        // reader that blocks on its event and samples once per signal from the sampler
+        typedef struct CoreReader {
             CpuGovernor*super;
             int         id;
-            uint32_t    util;
-            uint64_t    tick;
+            UEvent      signal;
+            std::atomic<uint32_t> seq;
+            std::atomic<uint64_t> idletick;
 
             static void Loop(void* args);
-        } WorkerContext;
+        } CoreReader;
 
         typedef struct GovernorWorker {
-            Thread threads[CORE_NUMS];
-            WorkerContext contexts[CORE_NUMS];
+            Thread sampler;
+            Thread threads[SYS_CORE_ID];
+            CoreReader readers[SYS_CORE_ID];
+            std::atomic<uint32_t> seq;
+            std::atomic<uint64_t> snapshot;
             bool running;
             CpuGovernor* super;
 
             void Start();
             void Stop();
 
+            static void Sampler(void* args);
+
             void onConfigUpdated(SysClkOcGovernorConfig config) {
                 bool expected = (config >> SysClkOcGovernorConfig_CPU_Shift) & 1;
                 if (expected != running)
@@ -209,108 +229,19 @@ namespace GovernorImpl {
 
         void Apply();
 
-    protected:
-        // Get average value from a sliding window in O(1)
-        template <typename T, size_t WINDOW_SIZE>
-        class SWindowAvg {
-        public:
-            SWindowAvg() {}
-
-            void Add(T item) {
-                T pop = m_queue[m_next];
-                m_queue[m_next] = item;
-                m_next = (m_next + 1) % WINDOW_SIZE;
-                m_sum -= pop;
-                m_sum += item;
-            }
-
-            T Get() { return m_sum / WINDOW_SIZE; }
-
-        protected:
-            size_t m_next = 0;
-            T m_sum = 0;
-            T m_queue[WINDOW_SIZE] = {};
-        };
-
-        // Get max value from a sliding window in O(1)
-        template <typename T, size_t WINDOW_SIZE>
-        class SWindowMax {
-        protected:
-            typedef struct {
-                T item;
-                T max;
-            } s_Entry;
-
-            struct s_Stack {
-                s_Entry m_stack[WINDOW_SIZE] = {};
-                size_t m_next = WINDOW_SIZE;
-
-                bool  empty() { return m_next == 0; };
-                s_Entry top() { return m_stack[m_next-1]; };
-                s_Entry pop() { return m_stack[--m_next]; };
-                void   push(s_Entry item) {
-                    if (m_next == WINDOW_SIZE)
-                        return;
-                    m_stack[m_next++] = item;
-                };
-            };
+        void SetHalfLife(uint32_t half_life_ms, uint32_t sample_rate) { m_util.SetHalfLife(half_life_ms, sample_rate); };
 
-            s_Stack enqStack;
-            s_Stack deqStack;
+        // Frame-time mode when a source is set and reports frames, load based otherwise.
+        // Nothing is attached on console yet: present timing lives in the game process.
+        void SetFrameTimingSource(GovernorCore::FrameTimingSource* source) { m_frame_source = source; };
 
-            void Push(s_Stack& stack, T item) {
-                s_Entry n = {
-                    .item = item,
-                    .max  = enqStack.empty() ? item : std::max(item, enqStack.top().max)
-                };
-                stack.push(n);
-            }
-
-            T Pop() {
-                if (deqStack.empty()) {
-                    while (!enqStack.empty())
-                        Push(deqStack, enqStack.pop().max);
-                }
-                return deqStack.pop().item;
-            }
-
-        public:
-            SWindowMax() {}
-
-            void Add(T item) { Pop(); Push(enqStack, item); }
-
-            T Get() {
-                if (!enqStack.empty()) {
-                    T enqMax = enqStack.top().max;
-                    if (!deqStack.empty()) {
-                        T deqMax = deqStack.top().max;
-                        return std::max(deqMax, enqMax);
-                    }
-                    return enqMax;
-                }
-                if (!deqStack.empty())
-                    return deqStack.top().max;
-                return 0;
-            }
-        };
-
-        typedef struct MaxWindow {
-            SWindowMax<uint32_t, 32> window {};
-            uint32_t util_acc = 0;
-
-            //   After 160 ms (if SAMPLE_RATE == 200, 32 samples)
-            //   UTIL_MAX * D^32 ≈ 1 (UTIL_MAX decayed to 1)
-            // D = 6880 / 8192
-            // Util_acc_max = Util_acc_inf = 6145
-            static constexpr uint32_t DECAY_DIVIDENT = 6880;
-            static constexpr uint32_t DECAY_DIVISOR  = 8192;
-            static constexpr uint32_t UTIL_ACC_MAX   = 6145;
-
-            uint32_t Get()              { return ((util_acc * UTIL_MAX / UTIL_ACC_MAX) + window.Get()) / 2; };
-            void Update(uint32_t util)  { window.Add(util); util_acc = util_acc * DECAY_DIVIDENT / DECAY_DIVISOR + util; };
-        } MaxWindow;
+    protected:
+        typedef GovernorCore::MaxWindow MaxWindow;
         MaxWindow m_util;
 
+        std::atomic<GovernorCore::FrameTimingSource*> m_frame_source = nullptr;
+        GovernorCore::FramePacer m_pacer;
+
         uint32_t m_nvgpu_field;
     };
 
@@ -341,6 +272,23 @@ public:
 
     void SetAutoCPUBoost(bool enabled) { m_cpu_gov->auto_boost = enabled; };
     void SetCPUBoostHz(uint32_t boostHz) { m_cpu_gov->boost_hz = boostHz; };
+    void SetFrameTimingSource(GovernorCore::FrameTimingSource* source) { m_gpu_gov->SetFrameTimingSource(source); };
+    void SetEnergyModel(bool enabled) {
+        m_cpu_gov->SetEnergyModel(enabled);
+        m_gpu_gov->SetEnergyModel(enabled);
+    };
+
+    void SetTransitionParams(const GovernorCore::TransitionLimiter::Params& params) {
+        m_cpu_gov->SetTransitionParams(params);
+        m_gpu_gov->SetTransitionParams(params);
+    };
+    SysClkGovernorStats GetStats();
+    uint32_t GetUtil(SysClkModule module);
+
+    // Clamps take effect on next SetMaxHz / SetMinHz, the rest on the governor thread.
+    // Returns true if tuning has changed.
+    bool SetTuning(const GovernorCore::Tuning& tuning);
+    uint64_t GetTickNs() { return m_tick_ns; };
 
 protected:
     typedef struct GovernorManager {
@@ -359,6 +307,16 @@ protected:
 
     SysClkOcGovernorConfig m_config = SysClkOcGovernorConfig_AllDisabled;
 
+    void ApplyTuning();
+    uint32_t TuneMaxHz(SysClkModule module, uint32_t hz);
+    uint32_t TuneMinHz(SysClkModule module, uint32_t hz);
+
+    GovernorCore::Tuning m_tuning = {};
+    GovernorCore::Tuning m_pending_tuning = {};
+    LockableMutex m_tuning_mutex;
+    std::atomic_bool m_tuning_dirty = false;
+    std::atomic<uint64_t> m_tick_ns = TICK_TIME_NS;
+
     uint32_t m_perf_conf_id;
     SysClkApmConfiguration* m_apm_conf;
 
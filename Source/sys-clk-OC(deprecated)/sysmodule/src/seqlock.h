@@ -0,0 +1,78 @@
+/*
+ * --------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <p-sam@d3vs.net>, <natinusala@gmail.com>, <m4x@m4xw.net>
+ * wrote this file. As long as you retain this notice you can do whatever you
+ * want with this stuff. If you meet any of us some day, and you think this
+ * stuff is worth it, you can buy us a beer in return.  - The sys-clk authors
+ * --------------------------------------------------------------------------
+ */
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// Single writer, many readers snapshot publication (seqcount latch, as in Linux raw_write_seqcount_latch).
+// Two copies are kept and the writer only touches the one readers are not pointed at,
+// so a reader never waits for a store in progress. It retries only if it was preempted
+// for a whole publication, which happens at most once per tick.
+// Platform independent, shared with the host benchmark in sysmodule/sim.
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable_v<T>, "SeqLock needs a trivially copyable type");
+
+public:
+    SeqLock() : SeqLock(T{}) {}
+    explicit SeqLock(const T& value) { Store(value); }
+
+    // Only one thread may store
+    void Store(const T& value) {
+        uint32_t words[WORD_COUNT] = {};
+        std::memcpy(words, &value, sizeof(T));
+
+        for (int i = 0; i < 2; i++) {
+            // Odd seq points readers at copy 1 while copy 0 is written, and vice versa
+            uint32_t seq = m_seq.load(std::memory_order_relaxed) + 1;
+            m_seq.store(seq, std::memory_order_release);
+            std::atomic_thread_fence(std::memory_order_release);
+            Write(m_copies[(seq + 1) & 1], words);
+        }
+    }
+
+    T Load() const {
+        uint32_t words[WORD_COUNT];
+        uint32_t seq;
+        do {
+            seq = m_seq.load(std::memory_order_acquire);
+            Read(m_copies[seq & 1], words);
+            std::atomic_thread_fence(std::memory_order_acquire);
+        } while (seq != m_seq.load(std::memory_order_relaxed));
+
+        T value;
+        std::memcpy(&value, words, sizeof(T));
+        return value;
+    }
+
+    // Number of stores, for diagnostics
+    uint32_t Generation() const { return m_seq.load(std::memory_order_relaxed) / 2; }
+
+protected:
+    static constexpr size_t WORD_COUNT = (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+    typedef std::atomic<uint32_t> Copy[WORD_COUNT];
+
+    static void Write(Copy& copy, const uint32_t* words) {
+        for (size_t i = 0; i < WORD_COUNT; i++)
+            copy[i].store(words[i], std::memory_order_relaxed);
+    }
+
+    static void Read(const Copy& copy, uint32_t* words) {
+        for (size_t i = 0; i < WORD_COUNT; i++)
+            words[i] = copy[i].load(std::memory_order_relaxed);
+    }
+
+    std::atomic<uint32_t> m_seq = 0;
+    Copy m_copies[2] = {};
+};
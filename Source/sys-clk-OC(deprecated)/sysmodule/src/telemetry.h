@@ -0,0 +1,98 @@
+/*
+ * --------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <p-sam@d3vs.net>, <natinusala@gmail.com>, <m4x@m4xw.net>
+ * wrote this file. As long as you retain this notice you can do whatever you
+ * want with this stuff. If you meet any of us some day, and you think this
+ * stuff is worth it, you can buy us a beer in return.  - The sys-clk authors
+ * --------------------------------------------------------------------------
+ */
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <sysclk/clocks.h>
+
+// Binary context log, platform independent, shared with the host decoder (sysmodule/sim).
+// File layout: TelemetryHeader, then TelemetryRecord * n, all little-endian.
+
+#define TELEMETRY_MAGIC     0x4C544353 // "SCTL"
+#define TELEMETRY_VERSION   1
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t recordSize;
+    uint8_t  moduleCount;
+    uint8_t  sensorCount;
+    uint8_t  reserved[6];
+} TelemetryHeader;
+static_assert(sizeof(TelemetryHeader) == 16);
+
+typedef struct {
+    uint64_t timestampMs;   // Realtime, ms since epoch
+    uint64_t applicationId;
+    uint32_t freqs[SysClkModule_EnumMax];
+    uint32_t temps[SysClkThermalSensor_EnumMax];
+    uint32_t perfConfId;
+    int32_t  powerMw;       // Battery, negative when discharging
+    uint16_t util[2];       // Governor util of CPU and GPU (0 - 1000), 0 when not governed
+    uint8_t  profile;
+    uint8_t  realProfile;
+    uint8_t  enabled;
+    uint8_t  governorConfig;
+} TelemetryRecord;
+static_assert(sizeof(TelemetryRecord) == 56);
+
+inline TelemetryHeader TelemetryMakeHeader() {
+    return {
+        .magic       = TELEMETRY_MAGIC,
+        .version     = TELEMETRY_VERSION,
+        .recordSize  = sizeof(TelemetryRecord),
+        .moduleCount = SysClkModule_EnumMax,
+        .sensorCount = SysClkThermalSensor_EnumMax,
+        .reserved    = {},
+    };
+}
+
+// Single producer, single consumer ring. Push never blocks, a full ring drops the record.
+template <typename T, size_t CAPACITY>
+class SpscRing {
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY must be a power of 2");
+
+public:
+    bool Push(const T& item) {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) >= CAPACITY) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        m_items[head & (CAPACITY - 1)] = item;
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t Pop(T* out, size_t max) {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        size_t count = m_head.load(std::memory_order_acquire) - tail;
+        if (count > max)
+            count = max;
+
+        for (size_t i = 0; i < count; i++)
+            out[i] = m_items[(tail + i) & (CAPACITY - 1)];
+        m_tail.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    size_t Size() const { return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire); }
+    size_t Dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+    static constexpr size_t Capacity() { return CAPACITY; }
+
+protected:
+    std::atomic<size_t> m_head = 0;
+    std::atomic<size_t> m_tail = 0;
+    std::atomic<size_t> m_dropped = 0;
+    T m_items[CAPACITY];
+};